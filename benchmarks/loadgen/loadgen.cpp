@@ -0,0 +1,349 @@
+/**
+ * clove_loadgen - syscall load generator and soak-test harness.
+ *
+ * Opens M concurrent connections to a running kernel's Unix socket and
+ * replays a syscall mix at a target rate, then reports throughput and
+ * latency percentiles per opcode. The mix is either synthetic (opcode
+ * weights) or replayed from a JSONL recording.
+ *
+ * Usage:
+ *   clove_loadgen [--socket /tmp/clove.sock] [--connections 8]
+ *                 [--rate 0] [--duration 10]
+ *                 [--weights NOOP:40,STORE:20,FETCH:20,KEYS:10,LIST:10]
+ *                 [--mix recorded.jsonl]
+ *
+ * --rate is total requests/sec across all connections (0 = unthrottled).
+ * --mix lines look like {"op": "STORE", "payload": {"key": "k", ...}}.
+ */
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "ipc/protocol.hpp"
+
+using json = nlohmann::json;
+using clove::ipc::Message;
+using clove::ipc::SyscallOp;
+
+namespace {
+
+struct Options {
+    std::string socket_path = "/tmp/clove.sock";
+    int connections = 8;
+    double rate = 0.0;      // total req/s, 0 = unthrottled
+    double duration = 10.0; // seconds
+    std::string weights = "NOOP:40,STORE:20,FETCH:20,KEYS:10,LIST:10";
+    std::string mix_file;
+};
+
+struct WorkItem {
+    SyscallOp op;
+    std::string payload;
+};
+
+// Per-opcode samples collected by one worker
+struct OpSamples {
+    uint64_t errors = 0;
+    std::vector<uint32_t> latencies_us;
+};
+
+const std::map<std::string, SyscallOp> OP_NAMES = {
+    {"NOOP", SyscallOp::SYS_NOOP},     {"EXEC", SyscallOp::SYS_EXEC},
+    {"READ", SyscallOp::SYS_READ},     {"WRITE", SyscallOp::SYS_WRITE},
+    {"LIST", SyscallOp::SYS_LIST},     {"SEND", SyscallOp::SYS_SEND},
+    {"RECV", SyscallOp::SYS_RECV},     {"REGISTER", SyscallOp::SYS_REGISTER},
+    {"STORE", SyscallOp::SYS_STORE},   {"FETCH", SyscallOp::SYS_FETCH},
+    {"DELETE", SyscallOp::SYS_DELETE}, {"KEYS", SyscallOp::SYS_KEYS},
+    {"INCR", SyscallOp::SYS_INCR},     {"EMIT", SyscallOp::SYS_EMIT},
+    {"POLL_EVENTS", SyscallOp::SYS_POLL_EVENTS},
+    {"GET_PERMS", SyscallOp::SYS_GET_PERMS},
+    {"METRICS_SYSTEM", SyscallOp::SYS_METRICS_SYSTEM},
+};
+
+// Default payload per opcode for the synthetic mix
+std::string default_payload(SyscallOp op, int worker) {
+    std::string key = "loadgen_" + std::to_string(worker);
+    switch (op) {
+        case SyscallOp::SYS_STORE:
+            return json{{"key", key}, {"value", {{"seq", worker}}}, {"scope", "agent"}}.dump();
+        case SyscallOp::SYS_FETCH:
+        case SyscallOp::SYS_DELETE:
+            return json{{"key", key}}.dump();
+        case SyscallOp::SYS_KEYS:
+            return json{{"prefix", "loadgen_"}}.dump();
+        case SyscallOp::SYS_INCR:
+            return json{{"key", key + "_ctr"}, {"delta", 1}}.dump();
+        case SyscallOp::SYS_EMIT:
+            return json{{"type", "CUSTOM"}, {"data", {{"src", "loadgen"}}}}.dump();
+        default:
+            return "{}";
+    }
+}
+
+bool write_full(int fd, const uint8_t* data, size_t len) {
+    size_t off = 0;
+    while (off < len) {
+        ssize_t n = write(fd, data + off, len - off);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        off += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool read_full(int fd, uint8_t* data, size_t len) {
+    size_t off = 0;
+    while (off < len) {
+        ssize_t n = read(fd, data + off, len - off);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            return false;
+        }
+        off += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+int connect_kernel(const std::string& path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    struct sockaddr_un addr {};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// One request/response round trip; returns latency in usecs, -1 on I/O error
+int64_t round_trip(int fd, const WorkItem& item, bool& is_error) {
+    Message msg(0, item.op, item.payload);
+    auto wire = msg.serialize();
+
+    auto start = std::chrono::steady_clock::now();
+    if (!write_full(fd, wire.data(), wire.size())) {
+        return -1;
+    }
+
+    uint8_t header_buf[clove::ipc::HEADER_SIZE];
+    if (!read_full(fd, header_buf, sizeof(header_buf))) {
+        return -1;
+    }
+    uint64_t payload_size;
+    memcpy(&payload_size, header_buf + 9, sizeof(payload_size));
+    std::vector<uint8_t> payload(payload_size);
+    if (payload_size > 0 && !read_full(fd, payload.data(), payload_size)) {
+        return -1;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // Kernel errors come back as {"success":false,...} or {"error":...}
+    is_error = memmem(payload.data(), payload.size(), "\"error\"", 7) != nullptr;
+
+    return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+}
+
+void worker(int id, const Options& opts, const std::vector<WorkItem>& deck,
+            std::map<uint8_t, OpSamples>& samples, std::atomic<uint64_t>& io_errors) {
+    int fd = connect_kernel(opts.socket_path);
+    if (fd < 0) {
+        fprintf(stderr, "worker %d: cannot connect to %s: %s\n",
+            id, opts.socket_path.c_str(), strerror(errno));
+        io_errors++;
+        return;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(opts.duration));
+
+    // Each worker paces itself at rate/M
+    std::chrono::steady_clock::duration interval{0};
+    if (opts.rate > 0) {
+        interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(opts.connections / opts.rate));
+    }
+    auto next_send = std::chrono::steady_clock::now();
+
+    size_t cursor = static_cast<size_t>(id);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (opts.rate > 0) {
+            std::this_thread::sleep_until(next_send);
+            next_send += interval;
+        }
+
+        const WorkItem& item = deck[cursor++ % deck.size()];
+        bool is_error = false;
+        int64_t lat = round_trip(fd, item, is_error);
+        if (lat < 0) {
+            io_errors++;
+            break; // connection gone
+        }
+
+        OpSamples& s = samples[static_cast<uint8_t>(item.op)];
+        s.latencies_us.push_back(static_cast<uint32_t>(lat));
+        if (is_error) {
+            s.errors++;
+        }
+    }
+
+    close(fd);
+}
+
+uint32_t percentile(const std::vector<uint32_t>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t idx = static_cast<size_t>(p * (sorted.size() - 1));
+    return sorted[idx];
+}
+
+std::vector<WorkItem> build_deck(const Options& opts) {
+    std::vector<WorkItem> deck;
+
+    if (!opts.mix_file.empty()) {
+        std::ifstream ifs(opts.mix_file);
+        if (!ifs) {
+            fprintf(stderr, "cannot open mix file: %s\n", opts.mix_file.c_str());
+            return deck;
+        }
+        std::string line;
+        while (std::getline(ifs, line)) {
+            if (line.empty()) continue;
+            try {
+                json j = json::parse(line);
+                auto it = OP_NAMES.find(j.value("op", ""));
+                if (it == OP_NAMES.end()) continue;
+                deck.push_back({it->second, j.value("payload", json::object()).dump()});
+            } catch (const std::exception&) {
+                // Skip malformed lines
+            }
+        }
+        return deck;
+    }
+
+    // Synthetic mix: "NOOP:40,STORE:20,..." expands into a weighted,
+    // shuffled deck the workers cycle through
+    std::string spec = opts.weights;
+    size_t pos = 0;
+    while (pos < spec.size()) {
+        size_t comma = spec.find(',', pos);
+        std::string entry = spec.substr(pos, comma == std::string::npos ? comma : comma - pos);
+        pos = (comma == std::string::npos) ? spec.size() : comma + 1;
+
+        size_t colon = entry.find(':');
+        std::string name = entry.substr(0, colon);
+        int weight = (colon == std::string::npos) ? 1 : atoi(entry.c_str() + colon + 1);
+
+        auto it = OP_NAMES.find(name);
+        if (it == OP_NAMES.end()) {
+            fprintf(stderr, "unknown opcode in weights: %s\n", name.c_str());
+            continue;
+        }
+        for (int i = 0; i < weight; i++) {
+            deck.push_back({it->second, default_payload(it->second, i % 16)});
+        }
+    }
+
+    std::shuffle(deck.begin(), deck.end(), std::mt19937{42});
+    return deck;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opts;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto next = [&]() -> const char* { return (i + 1 < argc) ? argv[++i] : ""; };
+        if (arg == "--socket") opts.socket_path = next();
+        else if (arg == "--connections") opts.connections = atoi(next());
+        else if (arg == "--rate") opts.rate = atof(next());
+        else if (arg == "--duration") opts.duration = atof(next());
+        else if (arg == "--weights") opts.weights = next();
+        else if (arg == "--mix") opts.mix_file = next();
+        else {
+            fprintf(stderr, "unknown option: %s\n", arg.c_str());
+            return 1;
+        }
+    }
+
+    auto deck = build_deck(opts);
+    if (deck.empty()) {
+        fprintf(stderr, "empty workload\n");
+        return 1;
+    }
+
+    printf("clove_loadgen: %d connections, %s, %.0fs against %s\n",
+        opts.connections,
+        opts.rate > 0 ? (std::to_string(static_cast<int>(opts.rate)) + " req/s").c_str()
+                      : "unthrottled",
+        opts.duration, opts.socket_path.c_str());
+
+    std::vector<std::map<uint8_t, OpSamples>> per_worker(opts.connections);
+    std::atomic<uint64_t> io_errors{0};
+
+    auto wall_start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < opts.connections; i++) {
+        threads.emplace_back(worker, i, std::cref(opts), std::cref(deck),
+                             std::ref(per_worker[i]), std::ref(io_errors));
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    double wall_secs = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - wall_start).count();
+
+    // Merge per-worker samples by opcode
+    std::map<uint8_t, OpSamples> merged;
+    for (auto& worker_samples : per_worker) {
+        for (auto& [op, s] : worker_samples) {
+            auto& m = merged[op];
+            m.errors += s.errors;
+            m.latencies_us.insert(m.latencies_us.end(),
+                s.latencies_us.begin(), s.latencies_us.end());
+        }
+    }
+
+    printf("\n%-16s %10s %8s %10s %8s %8s %8s %8s\n",
+        "opcode", "count", "errors", "req/s", "p50_us", "p90_us", "p99_us", "max_us");
+
+    uint64_t total = 0, total_errors = 0;
+    for (auto& [op, s] : merged) {
+        std::sort(s.latencies_us.begin(), s.latencies_us.end());
+        total += s.latencies_us.size();
+        total_errors += s.errors;
+        printf("%-16s %10zu %8lu %10.0f %8u %8u %8u %8u\n",
+            clove::ipc::opcode_to_string(static_cast<SyscallOp>(op)),
+            s.latencies_us.size(),
+            static_cast<unsigned long>(s.errors),
+            s.latencies_us.size() / wall_secs,
+            percentile(s.latencies_us, 0.50),
+            percentile(s.latencies_us, 0.90),
+            percentile(s.latencies_us, 0.99),
+            s.latencies_us.empty() ? 0 : s.latencies_us.back());
+    }
+
+    printf("\ntotal: %lu requests in %.2fs (%.0f req/s), %lu syscall errors, %lu I/O errors\n",
+        static_cast<unsigned long>(total), wall_secs, total / wall_secs,
+        static_cast<unsigned long>(total_errors),
+        static_cast<unsigned long>(io_errors.load()));
+
+    return 0;
+}
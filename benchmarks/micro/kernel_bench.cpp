@@ -0,0 +1,208 @@
+/**
+ * Microbenchmarks for kernel hot paths.
+ *
+ * The Python runners under benchmarks/ measure end-to-end syscall
+ * latency through a live kernel; these Google Benchmark suites isolate
+ * the individual paths so a regression can be attributed to one of
+ * them: wire (de)serialization, syscall dispatch, mailbox IPC, the
+ * state store, the event bus, and permission path checks.
+ *
+ * Build with -DCLOVE_BUILD_BENCHMARKS=ON, run ./clove_bench.
+ */
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
+#include "ipc/protocol.hpp"
+#include "kernel/event_bus.hpp"
+#include "kernel/ipc_mailbox.hpp"
+#include "kernel/permissions.hpp"
+#include "kernel/state_store.hpp"
+#include "kernel/syscall_router.hpp"
+
+using json = nlohmann::json;
+using namespace clove;
+
+// ----------------------------------------------------------------------------
+// Message wire format
+// ----------------------------------------------------------------------------
+
+static void BM_MessageSerialize(benchmark::State& state) {
+    std::string payload(state.range(0), 'x');
+    ipc::Message msg(42, ipc::SyscallOp::SYS_NOOP, payload);
+
+    for (auto _ : state) {
+        auto wire = msg.serialize();
+        benchmark::DoNotOptimize(wire.data());
+    }
+    state.SetBytesProcessed(state.iterations() * (ipc::HEADER_SIZE + payload.size()));
+}
+BENCHMARK(BM_MessageSerialize)->Arg(64)->Arg(4096)->Arg(65536);
+
+static void BM_MessageDeserialize(benchmark::State& state) {
+    std::string payload(state.range(0), 'x');
+    auto wire = ipc::Message(42, ipc::SyscallOp::SYS_NOOP, payload).serialize();
+
+    for (auto _ : state) {
+        auto msg = ipc::Message::deserialize(wire.data(), wire.size());
+        benchmark::DoNotOptimize(msg);
+    }
+    state.SetBytesProcessed(state.iterations() * wire.size());
+}
+BENCHMARK(BM_MessageDeserialize)->Arg(64)->Arg(4096)->Arg(65536);
+
+// ----------------------------------------------------------------------------
+// Syscall dispatch
+// ----------------------------------------------------------------------------
+
+static void BM_RouterDispatch(benchmark::State& state) {
+    kernel::SyscallRouter router;
+    router.register_handler(ipc::SyscallOp::SYS_NOOP,
+        [](const ipc::Message& msg) {
+            return ipc::Message(msg.agent_id, msg.opcode, R"({"success":true})");
+        });
+
+    ipc::Message msg(1, ipc::SyscallOp::SYS_NOOP, R"({"echo":"ping"})");
+    for (auto _ : state) {
+        auto reply = router.handle(msg);
+        benchmark::DoNotOptimize(reply.payload.data());
+    }
+}
+BENCHMARK(BM_RouterDispatch);
+
+// ----------------------------------------------------------------------------
+// Mailbox IPC
+// ----------------------------------------------------------------------------
+
+static kernel::IPCMessage make_ipc_message(uint32_t from_id) {
+    kernel::IPCMessage msg;
+    msg.from_id = from_id;
+    msg.from_name = "bench_sender";
+    msg.body = std::make_shared<const std::string>(R"({"type":"ping","seq":1})");
+    msg.timestamp = std::chrono::steady_clock::now();
+    return msg;
+}
+
+static void BM_MailboxEnqueueDequeue(benchmark::State& state) {
+    kernel::AgentMailboxRegistry registry;
+    registry.register_name(1, "sender");
+    registry.register_name(2, "receiver");
+
+    auto msg = make_ipc_message(1);
+    for (auto _ : state) {
+        registry.enqueue(2, msg);
+        auto drained = registry.dequeue(2, 10);
+        benchmark::DoNotOptimize(drained.data());
+    }
+}
+BENCHMARK(BM_MailboxEnqueueDequeue);
+
+static void BM_MailboxBroadcast(benchmark::State& state) {
+    const int agent_count = static_cast<int>(state.range(0));
+    kernel::AgentMailboxRegistry registry;
+    for (int i = 1; i <= agent_count; i++) {
+        registry.register_name(i, "agent_" + std::to_string(i));
+    }
+
+    // One broadcast plus draining every mailbox, so queues stay bounded
+    auto msg = make_ipc_message(1);
+    for (auto _ : state) {
+        int delivered = registry.broadcast(msg, true);
+        benchmark::DoNotOptimize(delivered);
+        for (int i = 1; i <= agent_count; i++) {
+            auto drained = registry.dequeue(i, 10);
+            benchmark::DoNotOptimize(drained.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * agent_count);
+}
+BENCHMARK(BM_MailboxBroadcast)->Arg(8)->Arg(64);
+
+// ----------------------------------------------------------------------------
+// State store
+// ----------------------------------------------------------------------------
+
+static void BM_StateStoreStore(benchmark::State& state) {
+    kernel::StateStore store;
+    json value = {{"status", "running"}, {"progress", 0.5}};
+
+    uint64_t i = 0;
+    for (auto _ : state) {
+        auto result = store.store(1, "task_" + std::to_string(i++ % 1024),
+                                  value, "agent", std::nullopt);
+        benchmark::DoNotOptimize(result.success);
+    }
+}
+BENCHMARK(BM_StateStoreStore);
+
+static void BM_StateStoreFetch(benchmark::State& state) {
+    kernel::StateStore store;
+    json value = {{"status", "running"}, {"progress", 0.5}};
+    for (int i = 0; i < 1024; i++) {
+        store.store(1, "task_" + std::to_string(i), value, "agent", std::nullopt);
+    }
+
+    uint64_t i = 0;
+    for (auto _ : state) {
+        auto result = store.fetch(1, "task_" + std::to_string(i++ % 1024));
+        benchmark::DoNotOptimize(result.exists);
+    }
+}
+BENCHMARK(BM_StateStoreFetch);
+
+// ----------------------------------------------------------------------------
+// Event bus
+// ----------------------------------------------------------------------------
+
+static void BM_EventBusEmitPoll(benchmark::State& state) {
+    kernel::EventBus bus;
+    bus.subscribe(1, {kernel::KernelEventType::CUSTOM});
+
+    json data = {{"kind", "bench"}, {"value", 42}};
+    for (auto _ : state) {
+        bus.emit(kernel::KernelEventType::CUSTOM, data, 2);
+        auto batch = bus.poll(1, 10);
+        benchmark::DoNotOptimize(batch.count);
+    }
+}
+BENCHMARK(BM_EventBusEmitPoll);
+
+// ----------------------------------------------------------------------------
+// Permission path checks
+// ----------------------------------------------------------------------------
+
+static void BM_PermissionsPathCheck(benchmark::State& state) {
+    kernel::AgentPermissions perms;
+    perms.allowed_read_paths = {
+        "/workspace/*", "/workspace/src/*", "/tmp/clove/*",
+        "/data/models/*.bin", "/etc/hosts",
+    };
+    perms.blocked_paths = {"/etc/shadow", "/root/*"};
+    perms.compile_path_matchers();
+
+    const std::string paths[] = {
+        "/workspace/main.py",       // glob hit
+        "/etc/hosts",               // literal hit
+        "/var/log/syslog",          // miss
+        "/data/models/llama.bin",   // suffix glob hit
+    };
+
+    size_t i = 0;
+    for (auto _ : state) {
+        bool allowed = perms.can_read_path(paths[i++ % 4]);
+        benchmark::DoNotOptimize(allowed);
+    }
+}
+BENCHMARK(BM_PermissionsPathCheck);
+
+int main(int argc, char** argv) {
+    // Hot paths log at debug level; keep the timings clean
+    spdlog::set_level(spdlog::level::off);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -24,6 +24,7 @@ Environment Variables:
 import asyncio
 import json
 import base64
+import zlib
 import logging
 import argparse
 import os
@@ -66,6 +67,14 @@ class RelayServer:
         self.router: MessageRouter = get_router()
         self._server = None
         self._running = False
+        # Partial response streams from kernels, keyed by
+        # (kernel connection, agent_id, stream_id). Kernels split large
+        # responses into chunks so small replies to other agents can
+        # interleave on the shared socket; we reassemble before
+        # forwarding to the agent.
+        self._chunk_buffers = {}
+
+    MAX_STREAM_BYTES = 64 * 1024 * 1024
 
     async def handle_connection(self, websocket: WebSocketServerProtocol):
         """Handle a new WebSocket connection"""
@@ -111,6 +120,10 @@ class RelayServer:
         finally:
             # Clean up on disconnect
             if connection_type == "kernel":
+                # Drop any half-assembled response streams from this kernel
+                stale = [k for k in self._chunk_buffers if k[0] == id(websocket)]
+                for k in stale:
+                    del self._chunk_buffers[k]
                 await self.router.unregister_kernel(websocket)
             elif connection_type == "agent":
                 await self.router.unregister_remote_agent(websocket)
@@ -141,13 +154,21 @@ class RelayServer:
         # Register kernel
         await self.router.register_kernel(websocket, machine_id)
 
+        # Negotiate payload compression: pick deflate if the kernel
+        # offered it (older kernels omit the field and get none)
+        offered = auth_data.get("compression", [])
+        compression = "deflate" if "deflate" in offered else ""
+        if machine_id in self.router.kernels:
+            self.router.kernels[machine_id].compression = compression
+
         # Send auth success
-        await websocket.send(json.dumps({
-            "type": "auth_ok",
-            "machine_id": machine_id
-        }))
+        auth_ok = {"type": "auth_ok", "machine_id": machine_id}
+        if compression:
+            auth_ok["compression"] = compression
+        await websocket.send(json.dumps(auth_ok))
 
-        logger.info(f"Kernel authenticated: {machine_id}")
+        logger.info(f"Kernel authenticated: {machine_id}"
+                    + (f" (compression={compression})" if compression else ""))
 
         # Message loop for kernel
         async for message in websocket:
@@ -171,10 +192,50 @@ class RelayServer:
             payload_b64 = data.get("payload", "")
             payload = base64.b64decode(payload_b64) if payload_b64 else b""
 
+            if data.get("c") == "deflate":
+                try:
+                    payload = zlib.decompress(payload)
+                except zlib.error:
+                    logger.warning(f"Undecodable compressed response "
+                                   f"for agent {agent_id}")
+                    return
+
             await self.router.route_response_to_agent(
                 websocket, agent_id, opcode, payload
             )
 
+        elif msg_type == "response_chunk":
+            # One chunk of a multiplexed response stream
+            agent_id = data.get("agent_id")
+            opcode = data.get("opcode", 0)
+            stream_id = data.get("stream_id")
+            payload_b64 = data.get("payload", "")
+            payload = base64.b64decode(payload_b64) if payload_b64 else b""
+
+            key = (id(websocket), agent_id, stream_id)
+            buffer = self._chunk_buffers.setdefault(key, [])
+            buffer.append(payload)
+
+            if sum(len(c) for c in buffer) > self.MAX_STREAM_BYTES:
+                logger.warning(f"Dropping oversized response stream {stream_id} "
+                               f"for agent {agent_id}")
+                del self._chunk_buffers[key]
+                return
+
+            if data.get("final"):
+                del self._chunk_buffers[key]
+                full = b"".join(buffer)
+                if data.get("c") == "deflate":
+                    try:
+                        full = zlib.decompress(full)
+                    except zlib.error:
+                        logger.warning(f"Undecodable compressed stream "
+                                       f"{stream_id} for agent {agent_id}")
+                        return
+                await self.router.route_response_to_agent(
+                    websocket, agent_id, opcode, full
+                )
+
         elif msg_type == "list_remotes":
             # List connected remote agents
             agents = self.router.list_remote_agents_for_kernel(machine_id)
@@ -9,6 +9,7 @@ import asyncio
 import json
 import base64
 import logging
+import zlib
 from dataclasses import dataclass, field
 from datetime import datetime
 from typing import Dict, Optional, Set, Tuple, Any
@@ -24,6 +25,8 @@ class KernelConnection:
     machine_id: str
     connected_at: datetime = field(default_factory=datetime.now)
     local_agent_ids: Set[int] = field(default_factory=set)
+    # Negotiated payload compression ("deflate" or "")
+    compression: str = ""
     # Stats
     messages_received: int = 0
     messages_sent: int = 0
@@ -219,13 +222,19 @@ class MessageRouter:
             logger.error(f"Kernel {machine_id} not connected")
             return False
 
-        # Forward to kernel
+        # Forward to kernel, deflating large payloads when negotiated
         msg = {
             "type": "syscall",
             "agent_id": agent_id,
             "opcode": opcode,
-            "payload": base64.b64encode(payload).decode() if payload else ""
         }
+        if kernel.compression == "deflate" and len(payload) >= 512:
+            compressed = zlib.compress(payload)
+            if len(compressed) < len(payload):
+                msg["c"] = "deflate"
+                msg["raw_len"] = len(payload)
+                payload = compressed
+        msg["payload"] = base64.b64encode(payload).decode() if payload else ""
 
         try:
             await kernel.ws.send(json.dumps(msg))
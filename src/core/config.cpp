@@ -1,10 +1,107 @@
 #include "core/config.hpp"
 #include "core/paths.hpp"
+#include <atomic>
 #include <cstdlib>
 #include <fstream>
+#include <unordered_set>
+
+extern char** environ;
 
 namespace clove::core::config {
 
+namespace {
+
+// Current published snapshot; swapped wholesale on reload. Readers do a
+// single atomic load and never block writers (or each other).
+std::atomic<std::shared_ptr<const Snapshot>> g_snapshot{
+    std::make_shared<const Snapshot>()};
+std::atomic<uint64_t> g_version{0};
+
+// The .env file found at startup and the keys it populated. Keys the
+// file owns may change value on reload; keys from the real environment
+// always win (matching load_dotenv's setenv precedence).
+std::filesystem::path g_env_file;
+std::unordered_set<std::string> g_file_owned_keys;
+
+// Parse KEY=VALUE lines from a .env file (comments, whitespace and
+// quoting handled the same way load_dotenv always has).
+std::unordered_map<std::string, std::string> parse_env_file(
+        const std::filesystem::path& env_path) {
+    std::unordered_map<std::string, std::string> pairs;
+
+    std::ifstream file(env_path);
+    std::string line;
+    while (std::getline(file, line)) {
+        // Trim whitespace
+        size_t start = line.find_first_not_of(" \t\r\n");
+        if (start == std::string::npos) continue;
+        line = line.substr(start);
+
+        // Skip comments
+        if (line.empty() || line[0] == '#') continue;
+
+        // Find = separator
+        size_t eq_pos = line.find('=');
+        if (eq_pos == std::string::npos) continue;
+
+        std::string key = line.substr(0, eq_pos);
+        std::string value = line.substr(eq_pos + 1);
+
+        // Trim key
+        size_t key_end = key.find_last_not_of(" \t");
+        if (key_end != std::string::npos) key = key.substr(0, key_end + 1);
+
+        // Trim value and remove quotes
+        start = value.find_first_not_of(" \t");
+        if (start != std::string::npos) value = value.substr(start);
+        size_t val_end = value.find_last_not_of(" \t\r\n");
+        if (val_end != std::string::npos) value = value.substr(0, val_end + 1);
+
+        if (value.size() >= 2) {
+            if ((value.front() == '"' && value.back() == '"') ||
+                (value.front() == '\'' && value.back() == '\'')) {
+                value = value.substr(1, value.size() - 2);
+            }
+        }
+
+        if (!key.empty()) {
+            pairs[key] = value;
+        }
+    }
+
+    return pairs;
+}
+
+// Build and publish a snapshot: process environment first, then the
+// .env file's current contents for keys the file owns (or keys absent
+// from the environment entirely).
+uint64_t publish_snapshot() {
+    auto snap = std::make_shared<Snapshot>();
+
+    for (char** env = environ; *env != nullptr; ++env) {
+        std::string entry(*env);
+        size_t eq_pos = entry.find('=');
+        if (eq_pos == std::string::npos) continue;
+        snap->values[entry.substr(0, eq_pos)] = entry.substr(eq_pos + 1);
+    }
+
+    if (!g_env_file.empty() && std::filesystem::exists(g_env_file)) {
+        for (auto& [key, value] : parse_env_file(g_env_file)) {
+            if (g_file_owned_keys.count(key) || !snap->values.count(key)) {
+                snap->values[key] = std::move(value);
+            }
+        }
+    }
+
+    snap->version = g_version.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint64_t version = snap->version;
+    g_snapshot.store(std::shared_ptr<const Snapshot>(std::move(snap)),
+                     std::memory_order_release);
+    return version;
+}
+
+} // namespace
+
 void load_dotenv(const std::vector<std::filesystem::path>& extra_search_paths) {
     static bool loaded = false;
     if (loaded) return;
@@ -21,47 +118,17 @@ void load_dotenv(const std::vector<std::filesystem::path>& extra_search_paths) {
             continue;
         }
 
-        std::ifstream file(env_path);
-        std::string line;
-        while (std::getline(file, line)) {
-            // Trim whitespace
-            size_t start = line.find_first_not_of(" \t\r\n");
-            if (start == std::string::npos) continue;
-            line = line.substr(start);
-
-            // Skip comments
-            if (line.empty() || line[0] == '#') continue;
-
-            // Find = separator
-            size_t eq_pos = line.find('=');
-            if (eq_pos == std::string::npos) continue;
-
-            std::string key = line.substr(0, eq_pos);
-            std::string value = line.substr(eq_pos + 1);
-
-            // Trim key
-            size_t key_end = key.find_last_not_of(" \t");
-            if (key_end != std::string::npos) key = key.substr(0, key_end + 1);
-
-            // Trim value and remove quotes
-            start = value.find_first_not_of(" \t");
-            if (start != std::string::npos) value = value.substr(start);
-            size_t val_end = value.find_last_not_of(" \t\r\n");
-            if (val_end != std::string::npos) value = value.substr(0, val_end + 1);
-
-            if (value.size() >= 2) {
-                if ((value.front() == '"' && value.back() == '"') ||
-                    (value.front() == '\'' && value.back() == '\'')) {
-                    value = value.substr(1, value.size() - 2);
-                }
-            }
-
-            if (!key.empty() && std::getenv(key.c_str()) == nullptr) {
+        g_env_file = env_path;
+        for (const auto& [key, value] : parse_env_file(env_path)) {
+            if (std::getenv(key.c_str()) == nullptr) {
                 setenv(key.c_str(), value.c_str(), 0);
+                g_file_owned_keys.insert(key);
             }
         }
         break;
     }
+
+    publish_snapshot();
 }
 
 std::string get_env(const std::string& key) {
@@ -74,4 +141,29 @@ std::string get_env_or(const std::string& key, const std::string& fallback) {
     return value.empty() ? fallback : value;
 }
 
+std::string Snapshot::get_or(const std::string& key, const std::string& fallback) const {
+    auto it = values.find(key);
+    return it == values.end() || it->second.empty() ? fallback : it->second;
+}
+
+int Snapshot::get_int_or(const std::string& key, int fallback) const {
+    auto it = values.find(key);
+    if (it == values.end() || it->second.empty()) {
+        return fallback;
+    }
+    try {
+        return std::stoi(it->second);
+    } catch (...) {
+        return fallback;
+    }
+}
+
+std::shared_ptr<const Snapshot> snapshot() {
+    return g_snapshot.load(std::memory_order_acquire);
+}
+
+uint64_t reload() {
+    return publish_snapshot();
+}
+
 } // namespace clove::core::config
@@ -1,11 +1,15 @@
 #pragma once
+#include <cstdint>
 #include <filesystem>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace clove::core::config {
 
-// Load environment variables from a .env file (idempotent).
+// Load environment variables from a .env file (idempotent). Also
+// publishes the initial config snapshot.
 void load_dotenv(const std::vector<std::filesystem::path>& extra_search_paths = {});
 
 // Get environment variable, empty string if missing.
@@ -14,4 +18,28 @@ std::string get_env(const std::string& key);
 // Get environment variable with default fallback.
 std::string get_env_or(const std::string& key, const std::string& fallback);
 
+// Immutable configuration snapshot. Readers fetch the current snapshot
+// with a single atomic shared_ptr load and then read plain memory — no
+// locks, no getenv, and no torn view of related keys mid-operation. A
+// reload builds a fresh snapshot and swaps the pointer; in-progress
+// operations keep whatever snapshot they already hold.
+struct Snapshot {
+    uint64_t version = 0;                                 // bumped on every reload
+    std::unordered_map<std::string, std::string> values;  // .env merged with process env
+
+    std::string get_or(const std::string& key, const std::string& fallback) const;
+    int get_int_or(const std::string& key, int fallback) const;
+};
+
+// Current snapshot (one atomic load). Never null — an empty snapshot is
+// returned before the first load_dotenv()/reload().
+std::shared_ptr<const Snapshot> snapshot();
+
+// Re-read the .env file, overlay the process environment, and publish a
+// new snapshot. Variables set in the real environment at startup keep
+// precedence; keys the file owns pick up their edited values. The
+// process environment itself is not modified — only snapshot readers
+// see the change. Returns the new snapshot version.
+uint64_t reload();
+
 } // namespace clove::core::config
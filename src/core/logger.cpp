@@ -1,17 +1,36 @@
 #include "core/logger.hpp"
+#include <spdlog/async.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
 namespace clove::core {
 
 void init_logger() {
-    auto console = spdlog::stdout_color_mt("clove");
-    spdlog::set_default_logger(console);
+    // Async logging: callers only format into a bounded ring buffer; a
+    // dedicated sink thread does the actual writes, so a stalled fd or
+    // disk can't add milliseconds to a syscall on the reactor thread.
+    // On overflow the oldest entries are dropped instead of blocking.
+    spdlog::init_thread_pool(8192, 1);
+
+    auto console = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+    auto logger = std::make_shared<spdlog::async_logger>(
+        "clove", console, spdlog::thread_pool(),
+        spdlog::async_overflow_policy::overrun_oldest);
+
+    spdlog::set_default_logger(logger);
     spdlog::set_level(spdlog::level::debug);
     spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] %v");
+
+    // Errors bypass the ring's laziness so they hit the sink promptly
+    spdlog::flush_on(spdlog::level::err);
 }
 
 void set_log_level(spdlog::level::level_enum level) {
     spdlog::set_level(level);
 }
 
+void shutdown_logger() {
+    // Drains the ring and joins the sink thread
+    spdlog::shutdown();
+}
+
 } // namespace clove::core
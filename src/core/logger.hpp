@@ -3,10 +3,13 @@
 
 namespace clove::core {
 
-// Initialize logging with console output
+// Initialize async logging with console output
 void init_logger();
 
 // Set log level
 void set_log_level(spdlog::level::level_enum level);
 
+// Flush pending log entries and stop the sink thread (call at exit)
+void shutdown_logger();
+
 } // namespace clove::core
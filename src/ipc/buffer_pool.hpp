@@ -0,0 +1,70 @@
+/**
+ * Shared pool of large receive buffers.
+ *
+ * Readiness handlers lease a 64KB buffer for the duration of one wakeup
+ * instead of reading through a small stack buffer; buffers return to the
+ * pool when the lease goes out of scope. Thread-safe (shard reactors
+ * lease concurrently); the free list is capped so bursts don't pin
+ * memory forever.
+ */
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace clove::ipc {
+
+class BufferPool {
+public:
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;
+    static constexpr size_t MAX_POOLED = 32;
+
+    class Lease {
+    public:
+        Lease(BufferPool& pool, std::vector<uint8_t> buffer)
+            : pool_(&pool), buffer_(std::move(buffer)) {}
+        ~Lease() {
+            if (pool_) {
+                pool_->release(std::move(buffer_));
+            }
+        }
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        uint8_t* data() { return buffer_.data(); }
+        size_t size() const { return buffer_.size(); }
+
+    private:
+        BufferPool* pool_;
+        std::vector<uint8_t> buffer_;
+    };
+
+    Lease acquire() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!free_.empty()) {
+                auto buffer = std::move(free_.back());
+                free_.pop_back();
+                return Lease(*this, std::move(buffer));
+            }
+        }
+        return Lease(*this, std::vector<uint8_t>(BUFFER_SIZE));
+    }
+
+private:
+    friend class Lease;
+
+    void release(std::vector<uint8_t> buffer) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_.size() < MAX_POOLED) {
+            free_.push_back(std::move(buffer));
+        }
+    }
+
+    std::mutex mutex_;
+    std::vector<std::vector<uint8_t>> free_;
+};
+
+} // namespace clove::ipc
@@ -21,6 +21,25 @@ constexpr size_t HEADER_SIZE = 17;
 constexpr size_t MAX_PAYLOAD_SIZE = 1024 * 1024; // 1MB max
 constexpr uint16_t PROTOCOL_VERSION = 1;
 
+// Shared-memory payload fast path (negotiated at SYS_HELLO).
+// When this bit is set in MessageHeader::payload_size, the frame body is a
+// 16-byte ShmDescriptor and the actual payload lives in the connection's
+// shared-memory ring instead of on the socket.
+constexpr uint64_t SHM_PAYLOAD_FLAG = 1ULL << 63;
+constexpr size_t SHM_PAYLOAD_THRESHOLD = 256 * 1024; // inline below this
+
+struct __attribute__((packed)) ShmDescriptor {
+    uint64_t offset;  // monotonic ring counter; byte offset = offset % ring size
+    uint64_t length;  // payload bytes
+};
+
+static_assert(sizeof(ShmDescriptor) == 16, "Descriptor size mismatch");
+
+// Ceiling for one assembled streamed transfer (SYS_STREAM_*). Chunks are
+// individually bounded by MAX_PAYLOAD_SIZE; this bounds kernel memory for
+// a single in-flight transfer per connection.
+constexpr size_t MAX_STREAM_SIZE = 256 * 1024 * 1024; // 256MB
+
 // Syscall operations
 enum class SyscallOp : uint8_t {
     SYS_NOOP   = 0x00,  // For testing / echo
@@ -31,6 +50,7 @@ enum class SyscallOp : uint8_t {
     SYS_SPAWN  = 0x10,  // Spawn a sandboxed agent
     SYS_KILL   = 0x11,  // Kill an agent
     SYS_LIST   = 0x12,  // List running agents
+    SYS_SPAWN_BATCH = 0x13,  // Spawn multiple agents in one call
     SYS_PAUSE  = 0x14,  // Pause an agent (SIGSTOP)
     SYS_RESUME = 0x15,  // Resume a paused agent (SIGCONT)
     // IPC - Inter-Agent Communication
@@ -43,6 +63,11 @@ enum class SyscallOp : uint8_t {
     SYS_FETCH     = 0x31,  // Retrieve value by key
     SYS_DELETE    = 0x32,  // Delete a key
     SYS_KEYS      = 0x33,  // List keys with optional prefix
+    SYS_INCR      = 0x34,  // Atomically add to a numeric value
+    SYS_CAS       = 0x35,  // Compare-and-swap a value
+    SYS_APPEND    = 0x36,  // Atomically append to a list value
+    SYS_WATCH     = 0x37,  // Subscribe to pushes on a key or prefix
+    SYS_UNWATCH   = 0x38,  // Remove key-watch subscriptions
     // Permissions
     SYS_GET_PERMS = 0x40,  // Get own permissions
     SYS_SET_PERMS = 0x41,  // Set agent permissions (privileged)
@@ -74,6 +99,9 @@ enum class SyscallOp : uint8_t {
     SYS_METRICS_AGENT     = 0xC1,  // Get metrics for specific agent
     SYS_METRICS_ALL_AGENTS = 0xC2, // Get metrics for all agents
     SYS_METRICS_CGROUP    = 0xC3,  // Get cgroup metrics for sandboxed agent
+    SYS_METRICS_SUBSCRIBE = 0xC4,  // Subscribe to pushed binary metrics frames
+    SYS_METRICS_UNSUBSCRIBE = 0xC5, // Cancel a metrics subscription
+    SYS_METRICS_PUSH      = 0xC6,  // Kernel->agent pushed metrics frame (binary)
     // Audit Logging
     SYS_GET_AUDIT_LOG     = 0x76,  // Get audit log entries
     SYS_SET_AUDIT_CONFIG  = 0x77,  // Configure audit logging
@@ -83,8 +111,15 @@ enum class SyscallOp : uint8_t {
     SYS_RECORD_STATUS  = 0x72,  // Get recording status
     SYS_REPLAY_START   = 0x73,  // Start replay
     SYS_REPLAY_STATUS  = 0x74,  // Get replay status
+    SYS_TRACE          = 0x75,  // Snapshot the syscall trace ring
     // Async Results
     SYS_ASYNC_POLL     = 0x80,  // Poll for async syscall results
+    // Batching
+    SYS_BATCH          = 0x81,  // Submit multiple syscalls in one message
+    // Streaming (lifts the per-frame 1MB payload ceiling)
+    SYS_STREAM_BEGIN   = 0x82,  // Open a chunked transfer {"opcode": n}
+    SYS_STREAM_CHUNK   = 0x83,  // Raw payload chunk (pipelined, no reply)
+    SYS_STREAM_END     = 0x84,  // Dispatch assembled syscall, reply follows
     // Kernel info / capabilities
     SYS_LLM_REPORT     = 0xF0,  // Report SDK LLM usage to kernel
     SYS_HELLO          = 0xFE,  // Handshake / capability query
@@ -205,7 +240,7 @@ struct Message {
 };
 
 // Convert opcode to string for logging
-inline const char* opcode_to_string(SyscallOp op) {
+constexpr const char* opcode_to_string(SyscallOp op) {
     switch (op) {
         case SyscallOp::SYS_NOOP:      return "NOOP";
         case SyscallOp::SYS_THINK:     return "THINK";
@@ -215,6 +250,7 @@ inline const char* opcode_to_string(SyscallOp op) {
         case SyscallOp::SYS_SPAWN:     return "SPAWN";
         case SyscallOp::SYS_KILL:      return "KILL";
         case SyscallOp::SYS_LIST:      return "LIST";
+        case SyscallOp::SYS_SPAWN_BATCH: return "SPAWN_BATCH";
         case SyscallOp::SYS_PAUSE:     return "PAUSE";
         case SyscallOp::SYS_RESUME:    return "RESUME";
         case SyscallOp::SYS_SEND:      return "SEND";
@@ -225,6 +261,11 @@ inline const char* opcode_to_string(SyscallOp op) {
         case SyscallOp::SYS_FETCH:     return "FETCH";
         case SyscallOp::SYS_DELETE:    return "DELETE";
         case SyscallOp::SYS_KEYS:      return "KEYS";
+        case SyscallOp::SYS_INCR:      return "INCR";
+        case SyscallOp::SYS_CAS:       return "CAS";
+        case SyscallOp::SYS_APPEND:    return "APPEND";
+        case SyscallOp::SYS_WATCH:     return "WATCH";
+        case SyscallOp::SYS_UNWATCH:   return "UNWATCH";
         case SyscallOp::SYS_GET_PERMS: return "GET_PERMS";
         case SyscallOp::SYS_SET_PERMS: return "SET_PERMS";
         case SyscallOp::SYS_HTTP:      return "HTTP";
@@ -250,6 +291,9 @@ inline const char* opcode_to_string(SyscallOp op) {
         case SyscallOp::SYS_METRICS_AGENT:     return "METRICS_AGENT";
         case SyscallOp::SYS_METRICS_ALL_AGENTS: return "METRICS_ALL_AGENTS";
         case SyscallOp::SYS_METRICS_CGROUP:    return "METRICS_CGROUP";
+        case SyscallOp::SYS_METRICS_SUBSCRIBE: return "METRICS_SUBSCRIBE";
+        case SyscallOp::SYS_METRICS_UNSUBSCRIBE: return "METRICS_UNSUBSCRIBE";
+        case SyscallOp::SYS_METRICS_PUSH:      return "METRICS_PUSH";
         case SyscallOp::SYS_GET_AUDIT_LOG:     return "GET_AUDIT_LOG";
         case SyscallOp::SYS_SET_AUDIT_CONFIG:  return "SET_AUDIT_CONFIG";
         case SyscallOp::SYS_RECORD_START:   return "RECORD_START";
@@ -257,7 +301,12 @@ inline const char* opcode_to_string(SyscallOp op) {
         case SyscallOp::SYS_RECORD_STATUS:  return "RECORD_STATUS";
         case SyscallOp::SYS_REPLAY_START:   return "REPLAY_START";
         case SyscallOp::SYS_REPLAY_STATUS:  return "REPLAY_STATUS";
+        case SyscallOp::SYS_TRACE:       return "TRACE";
         case SyscallOp::SYS_ASYNC_POLL:  return "ASYNC_POLL";
+        case SyscallOp::SYS_BATCH:       return "BATCH";
+        case SyscallOp::SYS_STREAM_BEGIN: return "STREAM_BEGIN";
+        case SyscallOp::SYS_STREAM_CHUNK: return "STREAM_CHUNK";
+        case SyscallOp::SYS_STREAM_END:   return "STREAM_END";
         case SyscallOp::SYS_LLM_REPORT:  return "LLM_REPORT";
         case SyscallOp::SYS_HELLO:       return "HELLO";
         case SyscallOp::SYS_EXIT:      return "EXIT";
@@ -0,0 +1,103 @@
+#include "ipc/shm_channel.hpp"
+#include <spdlog/spdlog.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+namespace clove::ipc {
+
+namespace {
+constexpr size_t CONTROL_PAGE = 4096;
+}
+
+ShmChannel::~ShmChannel() {
+    if (base_) {
+        munmap(base_, map_size_);
+    }
+    if (memfd_ >= 0) {
+        close(memfd_);
+    }
+}
+
+bool ShmChannel::init() {
+    map_size_ = CONTROL_PAGE + 2 * RING_SIZE;
+
+    memfd_ = memfd_create("clove-shm-ring", MFD_CLOEXEC);
+    if (memfd_ < 0) {
+        spdlog::error("memfd_create failed: {}", strerror(errno));
+        return false;
+    }
+
+    if (ftruncate(memfd_, static_cast<off_t>(map_size_)) < 0) {
+        spdlog::error("ftruncate on shm ring failed: {}", strerror(errno));
+        close(memfd_);
+        memfd_ = -1;
+        return false;
+    }
+
+    void* p = mmap(nullptr, map_size_, PROT_READ | PROT_WRITE, MAP_SHARED, memfd_, 0);
+    if (p == MAP_FAILED) {
+        spdlog::error("mmap of shm ring failed: {}", strerror(errno));
+        close(memfd_);
+        memfd_ = -1;
+        return false;
+    }
+
+    base_ = static_cast<uint8_t*>(p);
+    new (base_) Control{};
+    return true;
+}
+
+uint8_t* ShmChannel::c2k_region() {
+    return base_ + CONTROL_PAGE;
+}
+
+uint8_t* ShmChannel::k2c_region() {
+    return base_ + CONTROL_PAGE + RING_SIZE;
+}
+
+bool ShmChannel::read_payload(const ShmDescriptor& desc, std::vector<uint8_t>& out) {
+    if (desc.length > RING_SIZE) {
+        return false;
+    }
+
+    size_t pos = desc.offset % RING_SIZE;
+    if (pos + desc.length > RING_SIZE) {
+        return false; // producer never splits across the wrap
+    }
+
+    out.resize(desc.length);
+    std::memcpy(out.data(), c2k_region() + pos, desc.length);
+
+    // Release the slot so the agent can reuse the space
+    control()->c2k_tail.store(desc.offset + desc.length, std::memory_order_release);
+    return true;
+}
+
+std::optional<ShmDescriptor> ShmChannel::write_payload(const uint8_t* data, size_t len) {
+    if (len == 0 || len > RING_SIZE / 2) {
+        return std::nullopt;
+    }
+
+    uint64_t head = control()->k2c_head.load(std::memory_order_relaxed);
+    uint64_t tail = control()->k2c_tail.load(std::memory_order_acquire);
+
+    // Pad to the region boundary rather than splitting the payload;
+    // the consumer's tail jumps over the pad with the next descriptor
+    uint64_t pos = head % RING_SIZE;
+    if (pos + len > RING_SIZE) {
+        head += RING_SIZE - pos;
+    }
+
+    if (head + len - tail > RING_SIZE) {
+        return std::nullopt; // ring full, caller sends inline
+    }
+
+    std::memcpy(k2c_region() + (head % RING_SIZE), data, len);
+    control()->k2c_head.store(head + len, std::memory_order_release);
+
+    return ShmDescriptor{head, len};
+}
+
+} // namespace clove::ipc
@@ -0,0 +1,69 @@
+/**
+ * Per-connection shared-memory payload channel.
+ *
+ * Negotiated at SYS_HELLO: the kernel creates a memfd, passes it to the
+ * agent over the Unix socket via SCM_RIGHTS, and both sides map it. Large
+ * syscall payloads then travel through two ring regions inside the memfd
+ * (agent->kernel and kernel->agent) while the 17-byte wire header carries
+ * only an offset/length descriptor (SHM_PAYLOAD_FLAG set in payload_size).
+ * Small payloads keep using the inline socket path.
+ *
+ * Layout: [control page][c2k ring][k2c ring]. head/tail are monotonic
+ * byte counters; the producer pads to the region boundary instead of
+ * splitting a payload across the wrap, and the consumer publishes
+ * tail = descriptor.offset + length after copying out.
+ */
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+#include <vector>
+#include "ipc/protocol.hpp"
+
+namespace clove::ipc {
+
+class ShmChannel {
+public:
+    // Total ring bytes per direction (memfd is control page + 2x this)
+    static constexpr size_t RING_SIZE = 8 * 1024 * 1024;
+
+    ShmChannel() = default;
+    ~ShmChannel();
+
+    // Non-copyable
+    ShmChannel(const ShmChannel&) = delete;
+    ShmChannel& operator=(const ShmChannel&) = delete;
+
+    // Create the memfd and map it; false on failure
+    bool init();
+
+    // Fd to pass to the agent via SCM_RIGHTS
+    int fd() const { return memfd_; }
+
+    // Copy a payload out of the agent->kernel ring and release the slot.
+    // False if the descriptor is out of bounds.
+    bool read_payload(const ShmDescriptor& desc, std::vector<uint8_t>& out);
+
+    // Reserve space in the kernel->agent ring and copy the payload in.
+    // nullopt when the ring is full (caller falls back to inline send).
+    std::optional<ShmDescriptor> write_payload(const uint8_t* data, size_t len);
+
+private:
+    struct Control {
+        std::atomic<uint64_t> c2k_head;
+        std::atomic<uint64_t> c2k_tail;
+        std::atomic<uint64_t> k2c_head;
+        std::atomic<uint64_t> k2c_tail;
+    };
+
+    int memfd_ = -1;
+    uint8_t* base_ = nullptr;
+    size_t map_size_ = 0;
+
+    Control* control() { return reinterpret_cast<Control*>(base_); }
+    uint8_t* c2k_region();
+    uint8_t* k2c_region();
+};
+
+} // namespace clove::ipc
@@ -1,6 +1,9 @@
 #include "ipc/transport/socket_server.hpp"
 #include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
+#include <sys/sendfile.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <unistd.h>
 #include <fcntl.h>
@@ -9,6 +12,105 @@
 
 namespace clove::ipc {
 
+namespace {
+// Frames gathered per writev; deeper queues drain over further calls
+constexpr int MAX_FLUSH_IOV = 16;
+} // namespace
+
+void SendQueue::append_file(int fd, size_t len) {
+    Chunk chunk;
+    chunk.file_fd = fd;
+    chunk.file_remaining = len;
+    chunks.push_back(std::move(chunk));
+}
+
+void SendQueue::consume(size_t n) {
+    while (n > 0 && !chunks.empty() && !chunks.front().is_file()) {
+        size_t remaining = chunks.front().bytes.size() - head_offset;
+        if (n < remaining) {
+            head_offset += n;
+            return;
+        }
+        n -= remaining;
+        head_offset = 0;
+        chunks.pop_front();
+    }
+}
+
+std::vector<uint8_t> SendQueue::take_all() {
+    std::vector<uint8_t> out;
+    if (chunks.size() == 1 && head_offset == 0 && !chunks.front().is_file()) {
+        out = std::move(chunks.front().bytes);
+        chunks.clear();
+        return out;
+    }
+
+    size_t total = 0;
+    for (const auto& chunk : chunks) {
+        total += chunk.size();
+    }
+    out.reserve(total - head_offset);
+    size_t skip = head_offset;
+    for (auto& chunk : chunks) {
+        if (chunk.is_file()) {
+            // Completion transports pin one memory slab per send, so a
+            // queued file region is read in rather than sendfile'd
+            size_t off = out.size();
+            out.resize(off + chunk.file_remaining);
+            size_t got = 0;
+            while (got < chunk.file_remaining) {
+                ssize_t n = pread(chunk.file_fd, out.data() + off + got,
+                                  chunk.file_remaining - got,
+                                  chunk.file_offset + static_cast<off_t>(got));
+                if (n <= 0) {
+                    break;
+                }
+                got += static_cast<size_t>(n);
+            }
+            out.resize(off + got);  // short read: send what the file had
+            close(chunk.file_fd);
+            chunk.file_fd = -1;
+        } else {
+            out.insert(out.end(), chunk.bytes.begin() + static_cast<ptrdiff_t>(skip),
+                       chunk.bytes.end());
+        }
+        skip = 0;
+    }
+    chunks.clear();
+    head_offset = 0;
+    return out;
+}
+
+void SendQueue::clear() {
+    for (auto& chunk : chunks) {
+        if (chunk.is_file()) {
+            close(chunk.file_fd);
+        }
+    }
+    chunks.clear();
+    head_offset = 0;
+}
+
+void ClientConnection::reset(int new_fd, uint32_t id) {
+    fd = new_fd;
+    agent_id = id;
+    recv_buffer.clear();
+    send_queue.clear();
+    want_write = false;
+    shm.reset();
+    fd_to_send = -1;
+    if (pending_file_fd >= 0) {
+        close(pending_file_fd);
+    }
+    pending_file_fd = -1;
+    pending_file_len = 0;
+    cbor_encoding = false;
+    inbound_scratch.payload.clear();
+    stream.active = false;
+    stream.opcode = SyscallOp::SYS_NOOP;
+    stream.data.clear();
+}
+
 SocketServer::SocketServer(const std::string& socket_path)
     : socket_path_(socket_path) {}
 
@@ -91,28 +193,135 @@ int SocketServer::accept_connection() {
     int flags = fcntl(client_fd, F_GETFL, 0);
     fcntl(client_fd, F_SETFL, flags | O_NONBLOCK);
 
-    // Assign agent ID
+    register_client(client_fd);
+    return client_fd;
+}
+
+uint32_t SocketServer::register_client(int client_fd) {
+    std::lock_guard<std::mutex> lock(clients_mutex_);
     uint32_t agent_id = next_agent_id_++;
-    clients_[client_fd] = std::make_unique<ClientConnection>(client_fd, agent_id);
+
+    if (static_cast<size_t>(client_fd) >= slots_.size()) {
+        slots_.resize(client_fd + 1);
+    }
+    if (!pool_.empty()) {
+        slots_[client_fd] = std::move(pool_.back());
+        pool_.pop_back();
+        slots_[client_fd]->reset(client_fd, agent_id);
+    } else {
+        slots_[client_fd] = std::make_unique<ClientConnection>(client_fd, agent_id);
+    }
 
     spdlog::info("Agent {} connected (fd={})", agent_id, client_fd);
-    return client_fd;
+    return agent_id;
+}
+
+ClientConnection* SocketServer::find_client(int client_fd) const {
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    if (client_fd < 0 || static_cast<size_t>(client_fd) >= slots_.size()) {
+        return nullptr;
+    }
+    return slots_[client_fd].get();
+}
+
+void SocketServer::on_bytes_received(int client_fd, const uint8_t* data, size_t len) {
+    ClientConnection* client = find_client(client_fd);
+    if (!client) {
+        return;
+    }
+
+    // Fast path: with nothing buffered, complete frames dispatch
+    // straight out of the transport's receive block; only a trailing
+    // partial is copied into recv_buffer
+    if (client->recv_buffer.empty()) {
+        size_t consumed = dispatch_inline(*client, data, len);
+        data += consumed;
+        len -= consumed;
+        if (len == 0) {
+            return;
+        }
+    }
+
+    client->recv_buffer.insert(client->recv_buffer.end(), data, data + len);
+    process_messages(*client);
+}
+
+std::vector<uint8_t> SocketServer::take_pending(int client_fd) {
+    ClientConnection* client = find_client(client_fd);
+    return client ? client->send_queue.take_all() : std::vector<uint8_t>{};
+}
+
+uint32_t SocketServer::agent_id_for_fd(int client_fd) const {
+    ClientConnection* client = find_client(client_fd);
+    return client ? client->agent_id : 0;
+}
+
+void SocketServer::push_message(int client_fd, const Message& msg) {
+    ClientConnection* client = find_client(client_fd);
+    if (client) {
+        queue_response(*client, msg);
+    }
+}
+
+bool SocketServer::attach_fd(uint32_t agent_id, int fd) {
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    for (auto& client : slots_) {
+        if (client && client->agent_id == agent_id) {
+            client->fd_to_send = fd;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SocketServer::stream_file(uint32_t agent_id, int fd, size_t len) {
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    for (auto& client : slots_) {
+        if (client && client->agent_id == agent_id) {
+            if (client->pending_file_fd >= 0) {
+                close(client->pending_file_fd);  // superseded before it was queued
+            }
+            client->pending_file_fd = fd;
+            client->pending_file_len = len;
+            return true;
+        }
+    }
+    return false;
 }
 
 bool SocketServer::handle_client(int client_fd) {
-    auto it = clients_.find(client_fd);
-    if (it == clients_.end()) {
+    ClientConnection* client_ptr = find_client(client_fd);
+    if (!client_ptr) {
         return false;
     }
 
-    auto& client = *it->second;
-    uint8_t buffer[4096];
+    auto& client = *client_ptr;
+
+    // Lease a large pooled buffer for this wakeup; edge-triggered
+    // registration means we must drain the socket here anyway
+    auto lease = recv_pool_.acquire();
 
     // Read available data
     while (true) {
-        ssize_t n = read(client_fd, buffer, sizeof(buffer));
+        ssize_t n = read(client_fd, lease.data(), lease.size());
         if (n > 0) {
-            client.recv_buffer.insert(client.recv_buffer.end(), buffer, buffer + n);
+            const uint8_t* data = lease.data();
+            size_t len = static_cast<size_t>(n);
+
+            // Fast path for the dominant traffic shape: a small request
+            // arriving whole in one read dispatches straight from the
+            // lease, never touching recv_buffer (no append, no re-scan,
+            // no compaction). Partials and bytes behind them take the
+            // buffered path below.
+            if (client.recv_buffer.empty()) {
+                size_t consumed = dispatch_inline(client, data, len);
+                data += consumed;
+                len -= consumed;
+            }
+            if (len > 0) {
+                client.recv_buffer.insert(client.recv_buffer.end(),
+                                          data, data + len);
+            }
         } else if (n == 0) {
             // Client disconnected
             spdlog::info("Agent {} disconnected (fd={})", client.agent_id, client_fd);
@@ -126,94 +335,444 @@ bool SocketServer::handle_client(int client_fd) {
         }
     }
 
-    // Process complete messages
-    process_messages(client);
+    // Process whatever needed buffering (the fast path above already
+    // dispatched everything else)
+    if (!client.recv_buffer.empty()) {
+        process_messages(client);
+    }
     return true;
 }
 
-void SocketServer::process_messages(ClientConnection& client) {
-    while (true) {
-        // Check if we have a complete message
-        auto msg_size = Message::get_message_size(
-            client.recv_buffer.data(),
-            client.recv_buffer.size()
-        );
+size_t SocketServer::consume_frame(ClientConnection& client, const uint8_t* cursor,
+                                   size_t available) {
+    if (available < HEADER_SIZE) {
+        return 0; // Need more data
+    }
 
-        if (!msg_size || client.recv_buffer.size() < *msg_size) {
-            break; // Need more data
+    MessageHeader header;
+    std::memcpy(&header, cursor, HEADER_SIZE);
+
+    if (header.magic != MAGIC_BYTES) {
+        spdlog::warn("Invalid message from agent {}", client.agent_id);
+        return HEADER_SIZE; // skip bad data
+    }
+
+    // Shm frames carry a 16-byte descriptor instead of the payload
+    bool shm_frame = (header.payload_size & SHM_PAYLOAD_FLAG) != 0;
+    uint64_t body_size = shm_frame ? sizeof(ShmDescriptor) : header.payload_size;
+
+    if (!shm_frame && body_size > MAX_PAYLOAD_SIZE) {
+        spdlog::warn("Oversized message from agent {}", client.agent_id);
+        return HEADER_SIZE;
+    }
+
+    size_t frame_size = HEADER_SIZE + body_size;
+    if (available < frame_size) {
+        return 0; // Need more data
+    }
+
+    // Reuse the connection's scratch message so the payload vector's
+    // capacity survives across requests instead of reallocating
+    Message& msg = client.inbound_scratch;
+    msg.agent_id = client.agent_id; // client may send 0 initially
+    msg.opcode = header.opcode;
+    msg.payload.clear();
+
+    bool valid = true;
+    if (shm_frame) {
+        ShmDescriptor desc;
+        std::memcpy(&desc, cursor + HEADER_SIZE, sizeof(desc));
+        if (!client.shm || !client.shm->read_payload(desc, msg.payload)) {
+            spdlog::warn("Bad shm descriptor from agent {}", client.agent_id);
+            valid = false;
         }
+    } else if (body_size > 0) {
+        msg.payload.assign(cursor + HEADER_SIZE, cursor + frame_size);
+    }
 
-        // Parse message
-        auto msg = Message::deserialize(
-            client.recv_buffer.data(),
-            client.recv_buffer.size()
-        );
+    if (!valid || !handler_) {
+        return frame_size;
+    }
 
-        if (!msg) {
-            spdlog::warn("Invalid message from agent {}", client.agent_id);
-            // Remove bad data - skip header
-            client.recv_buffer.erase(
-                client.recv_buffer.begin(),
-                client.recv_buffer.begin() + HEADER_SIZE
-            );
-            continue;
+    // Chunked transfers are assembled in the transport
+    if (msg.opcode == SyscallOp::SYS_STREAM_BEGIN ||
+        msg.opcode == SyscallOp::SYS_STREAM_CHUNK ||
+        msg.opcode == SyscallOp::SYS_STREAM_END) {
+        handle_stream_frame(client, msg);
+        return frame_size;
+    }
+
+    // CBOR connections: decode to JSON text for the handlers
+    if (client.cbor_encoding && msg.opcode != SyscallOp::SYS_HELLO &&
+        !msg.payload.empty()) {
+        auto decoded = nlohmann::json::from_cbor(msg.payload, true, false);
+        if (!decoded.is_discarded()) {
+            auto dumped = decoded.dump();
+            msg.payload.assign(dumped.begin(), dumped.end());
         }
+    }
 
-        spdlog::debug("Agent {} -> {} ({}B payload)",
-            client.agent_id,
-            opcode_to_string(msg->opcode),
-            msg->payload.size()
-        );
+    SPDLOG_DEBUG("Agent {} -> {} ({}B payload)",
+        client.agent_id,
+        opcode_to_string(msg.opcode),
+        msg.payload.size()
+    );
+
+    Message response = handler_(msg);
+    response.agent_id = client.agent_id;
 
-        // Remove processed message from buffer
+    if (msg.opcode == SyscallOp::SYS_HELLO) {
+        negotiate_shm(client, msg, response);
+        negotiate_encoding(client, msg, response);
+    }
+
+    queue_response(client, response);
+    return frame_size;
+}
+
+size_t SocketServer::dispatch_inline(ClientConnection& client, const uint8_t* data,
+                                     size_t len) {
+    size_t pos = 0;
+    while (pos < len) {
+        size_t consumed = consume_frame(client, data + pos, len - pos);
+        if (consumed == 0) {
+            break; // Trailing partial: the caller buffers it
+        }
+        pos += consumed;
+    }
+    return pos;
+}
+
+void SocketServer::process_messages(ClientConnection& client) {
+    // Parse with a cursor and compact once at the end: erase-from-front
+    // per message was O(n^2) memmove under burst loads
+    size_t pos = 0;
+    while (pos < client.recv_buffer.size()) {
+        size_t consumed = consume_frame(client, client.recv_buffer.data() + pos,
+                                        client.recv_buffer.size() - pos);
+        if (consumed == 0) {
+            break; // Need more data
+        }
+        pos += consumed;
+    }
+
+    // Single compaction for everything consumed this wakeup
+    if (pos > 0) {
         client.recv_buffer.erase(
             client.recv_buffer.begin(),
-            client.recv_buffer.begin() + *msg_size
+            client.recv_buffer.begin() + pos
         );
+    }
+}
+
+void SocketServer::handle_stream_frame(ClientConnection& client, const Message& msg) {
+    switch (msg.opcode) {
+        case SyscallOp::SYS_STREAM_BEGIN: {
+            auto j = nlohmann::json::parse(msg.payload_str(), nullptr, false);
+            if (!j.is_object() || !j.contains("opcode")) {
+                nlohmann::json err = {{"success", false},
+                                      {"error", "stream begin requires opcode"}};
+                queue_response(client, Message(client.agent_id,
+                    SyscallOp::SYS_STREAM_END, err.dump()));
+                return;
+            }
+            client.stream.active = true;
+            client.stream.opcode = static_cast<SyscallOp>(j["opcode"].get<uint8_t>());
+            client.stream.data.clear();
+            // No reply: chunks are pipelined behind the BEGIN
+            return;
+        }
 
-        // Call handler and queue response
-        if (handler_) {
-            // Override message agent_id with actual client ID (client may send 0 initially)
-            msg->agent_id = client.agent_id;
-            Message response = handler_(*msg);
+        case SyscallOp::SYS_STREAM_CHUNK: {
+            if (!client.stream.active) {
+                return; // stray chunk (e.g. after an overflow abort)
+            }
+            if (client.stream.data.size() + msg.payload.size() > MAX_STREAM_SIZE) {
+                spdlog::warn("Agent {} exceeded stream cap, aborting transfer",
+                    client.agent_id);
+                client.stream.active = false;
+                client.stream.data.clear();
+                client.stream.data.shrink_to_fit();
+                nlohmann::json err = {{"success", false},
+                                      {"error", "stream exceeds maximum size"}};
+                queue_response(client, Message(client.agent_id,
+                    SyscallOp::SYS_STREAM_END, err.dump()));
+                return;
+            }
+            client.stream.data.insert(client.stream.data.end(),
+                msg.payload.begin(), msg.payload.end());
+            return;
+        }
+
+        case SyscallOp::SYS_STREAM_END: {
+            if (!client.stream.active) {
+                return;
+            }
+            SPDLOG_DEBUG("Agent {} -> {} ({}B payload via stream)",
+                client.agent_id,
+                opcode_to_string(client.stream.opcode),
+                client.stream.data.size());
+
+            Message inner;
+            inner.agent_id = client.agent_id;
+            inner.opcode = client.stream.opcode;
+            inner.payload = std::move(client.stream.data);
+            client.stream.active = false;
+            client.stream.data = {};
+
+            Message response = handler_(inner);
             response.agent_id = client.agent_id;
 
-            auto serialized = response.serialize();
-            client.send_buffer.insert(
-                client.send_buffer.end(),
-                serialized.begin(),
-                serialized.end()
-            );
+            if (response.payload.size() > MAX_PAYLOAD_SIZE) {
+                queue_streamed_response(client, response);
+            } else {
+                queue_response(client, response);
+            }
+            return;
+        }
+
+        default:
+            return;
+    }
+}
+
+void SocketServer::queue_streamed_response(ClientConnection& client,
+                                           const Message& response) {
+    nlohmann::json begin = {
+        {"opcode", static_cast<uint8_t>(response.opcode)},
+        {"total_size", response.payload.size()}
+    };
+    queue_encoded_response(client, Message(client.agent_id,
+        SyscallOp::SYS_STREAM_BEGIN, begin.dump()));
+
+    for (size_t off = 0; off < response.payload.size(); off += MAX_PAYLOAD_SIZE) {
+        size_t len = std::min(MAX_PAYLOAD_SIZE, response.payload.size() - off);
+        Message chunk(client.agent_id, SyscallOp::SYS_STREAM_CHUNK,
+            std::vector<uint8_t>(response.payload.begin() + off,
+                                 response.payload.begin() + off + len));
+        queue_encoded_response(client, chunk);
+    }
+
+    queue_encoded_response(client, Message(client.agent_id,
+        SyscallOp::SYS_STREAM_END, std::vector<uint8_t>{}));
+
+    SPDLOG_DEBUG("Agent {} <- {} ({}B payload via stream)",
+        client.agent_id,
+        opcode_to_string(response.opcode),
+        response.payload.size());
+}
+
+void SocketServer::negotiate_shm(ClientConnection& client, const Message& request,
+                                 Message& response) {
+    auto req = nlohmann::json::parse(request.payload_str(), nullptr, false);
+    bool requested = req.is_object() && req.value("shm_ring", false);
+
+    if (!requested || client.shm) {
+        return;
+    }
+
+    auto channel = std::make_unique<ShmChannel>();
+    if (!channel->init()) {
+        return;
+    }
+
+    // Advertise the ring in the HELLO response; the memfd itself rides
+    // along via SCM_RIGHTS on the next flush
+    try {
+        auto resp = nlohmann::json::parse(response.payload_str());
+        resp["shm_ring"] = {
+            {"ring_size", ShmChannel::RING_SIZE},
+            {"threshold", SHM_PAYLOAD_THRESHOLD}
+        };
+        response.payload.clear();
+        auto dumped = resp.dump();
+        response.payload.assign(dumped.begin(), dumped.end());
+    } catch (...) {
+        return; // leave response as-is, no shm
+    }
+
+    client.fd_to_send = channel->fd();
+    client.shm = std::move(channel);
+    spdlog::info("Agent {} negotiated shm payload ring ({}MB/direction)",
+        client.agent_id, ShmChannel::RING_SIZE / (1024 * 1024));
+}
+
+void SocketServer::negotiate_encoding(ClientConnection& client, const Message& request,
+                                      Message& response) {
+    auto req = nlohmann::json::parse(request.payload_str(), nullptr, false);
+    if (!req.is_object() || req.value("encoding", "json") != "cbor") {
+        return;
+    }
+
+    // Confirm in the (still JSON) HELLO response; everything after it is CBOR
+    auto resp = nlohmann::json::parse(response.payload_str(), nullptr, false);
+    if (resp.is_discarded()) {
+        return;
+    }
+    resp["encoding"] = "cbor";
+    auto dumped = resp.dump();
+    response.payload.assign(dumped.begin(), dumped.end());
+
+    client.cbor_encoding = true;
+    spdlog::info("Agent {} negotiated CBOR payload encoding", client.agent_id);
+}
+
+void SocketServer::queue_response(ClientConnection& client, const Message& response) {
+    // CBOR connections: compact JSON-text responses at the wire boundary
+    if (client.cbor_encoding && response.opcode != SyscallOp::SYS_HELLO &&
+        !response.payload.empty()) {
+        auto dom = nlohmann::json::parse(response.payload_str(), nullptr, false);
+        if (!dom.is_discarded()) {
+            Message encoded(response.agent_id, response.opcode,
+                            nlohmann::json::to_cbor(dom));
+            queue_encoded_response(client, encoded);
+            return;
+        }
+    }
+    queue_encoded_response(client, response);
+}
+
+void SocketServer::queue_encoded_response(ClientConnection& client, const Message& response) {
+    // Large payloads go through the shm ring when one is negotiated
+    if (client.shm && response.payload.size() >= SHM_PAYLOAD_THRESHOLD) {
+        auto desc = client.shm->write_payload(response.payload.data(),
+                                              response.payload.size());
+        if (desc) {
+            MessageHeader header;
+            header.magic = MAGIC_BYTES;
+            header.agent_id = response.agent_id;
+            header.opcode = response.opcode;
+            header.payload_size = SHM_PAYLOAD_FLAG | sizeof(ShmDescriptor);
+
+            std::vector<uint8_t> frame(HEADER_SIZE + sizeof(ShmDescriptor));
+            std::memcpy(frame.data(), &header, HEADER_SIZE);
+            std::memcpy(frame.data() + HEADER_SIZE, &*desc, sizeof(ShmDescriptor));
+            client.send_queue.append(std::move(frame));
             client.want_write = true;
 
-            spdlog::debug("Agent {} <- {} ({}B payload)",
+            SPDLOG_DEBUG("Agent {} <- {} ({}B payload via shm)",
                 client.agent_id,
                 opcode_to_string(response.opcode),
                 response.payload.size()
             );
+            return;
         }
+        // Ring full: fall through to inline send
+    }
+
+    // Serialize into a frame the queue pins until it's fully sent; the
+    // flush path gathers queued frames into a single writev
+    MessageHeader header;
+    header.magic = MAGIC_BYTES;
+    header.agent_id = response.agent_id;
+    header.opcode = response.opcode;
+    header.payload_size = response.payload.size();
+
+    std::vector<uint8_t> frame(HEADER_SIZE + response.payload.size());
+    std::memcpy(frame.data(), &header, HEADER_SIZE);
+    if (!response.payload.empty()) {
+        std::memcpy(frame.data() + HEADER_SIZE,
+                    response.payload.data(), response.payload.size());
+    }
+    client.send_queue.append(std::move(frame));
+
+    // A raw-mode file region rides out right behind its response frame
+    if (client.pending_file_fd >= 0) {
+        client.send_queue.append_file(client.pending_file_fd, client.pending_file_len);
+        client.pending_file_fd = -1;
+        client.pending_file_len = 0;
     }
+    client.want_write = true;
+
+    SPDLOG_DEBUG("Agent {} <- {} ({}B payload)",
+        client.agent_id,
+        opcode_to_string(response.opcode),
+        response.payload.size()
+    );
 }
 
 bool SocketServer::flush_client(int client_fd) {
-    auto it = clients_.find(client_fd);
-    if (it == clients_.end()) {
+    ClientConnection* client_ptr = find_client(client_fd);
+    if (!client_ptr) {
         return false;
     }
 
-    auto& client = *it->second;
+    auto& client = *client_ptr;
+    auto& queue = client.send_queue;
+
+    // Pending shm memfd rides along with the first bytes via SCM_RIGHTS
+    if (client.fd_to_send >= 0 && !queue.empty() && !queue.chunks.front().is_file()) {
+        struct iovec iov;
+        iov.iov_base = queue.chunks.front().bytes.data() + queue.head_offset;
+        iov.iov_len = queue.chunks.front().bytes.size() - queue.head_offset;
+
+        char cmsg_buf[CMSG_SPACE(sizeof(int))] = {};
+        struct msghdr msg = {};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = cmsg_buf;
+        msg.msg_controllen = sizeof(cmsg_buf);
+
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        std::memcpy(CMSG_DATA(cmsg), &client.fd_to_send, sizeof(int));
+
+        ssize_t n = sendmsg(client_fd, &msg, MSG_NOSIGNAL);
+        if (n > 0) {
+            client.fd_to_send = -1;
+            queue.consume(static_cast<size_t>(n));
+        } else if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+            spdlog::error("sendmsg error for agent {}: {}", client.agent_id, strerror(errno));
+            return false;
+        }
+    }
 
-    while (!client.send_buffer.empty()) {
-        ssize_t n = write(client_fd,
-            client.send_buffer.data(),
-            client.send_buffer.size()
-        );
+    while (!queue.empty()) {
+        SendQueue::Chunk& front = queue.chunks.front();
+
+        // File region at the head: pump it straight from the page cache
+        // to the socket — the bytes never enter userspace
+        if (front.is_file()) {
+            ssize_t n = sendfile(client_fd, front.file_fd, &front.file_offset,
+                                 front.file_remaining);
+            if (n > 0) {
+                front.file_remaining -= static_cast<size_t>(n);
+                if (front.file_remaining == 0) {
+                    close(front.file_fd);
+                    queue.chunks.pop_front();
+                }
+                continue;
+            }
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break; // Socket full, resume on the next WRITABLE
+            }
+            // 0 with bytes remaining means the file shrank underneath
+            // us; either way the stream can't be completed
+            spdlog::error("sendfile error for agent {}: {}", client.agent_id,
+                          n < 0 ? strerror(errno) : "file truncated");
+            return false;
+        }
 
+        // Gather queued frames up to the next file region so responses
+        // that piled up behind backpressure leave in one syscall
+        struct iovec iov[MAX_FLUSH_IOV];
+        int iovcnt = 0;
+        size_t skip = queue.head_offset;
+        for (auto& chunk : queue.chunks) {
+            if (iovcnt == MAX_FLUSH_IOV || chunk.is_file()) {
+                break;
+            }
+            iov[iovcnt].iov_base = chunk.bytes.data() + skip;
+            iov[iovcnt].iov_len = chunk.bytes.size() - skip;
+            iovcnt++;
+            skip = 0;
+        }
+
+        ssize_t n = writev(client_fd, iov, iovcnt);
         if (n > 0) {
-            client.send_buffer.erase(
-                client.send_buffer.begin(),
-                client.send_buffer.begin() + n
-            );
+            queue.consume(static_cast<size_t>(n));
         } else if (n < 0) {
             if (errno == EAGAIN || errno == EWOULDBLOCK) {
                 break; // Would block, try later
@@ -223,35 +782,45 @@ bool SocketServer::flush_client(int client_fd) {
         }
     }
 
-    client.want_write = !client.send_buffer.empty();
+    client.want_write = !queue.empty();
     return true;
 }
 
 bool SocketServer::client_wants_write(int client_fd) const {
-    auto it = clients_.find(client_fd);
-    if (it == clients_.end()) {
-        return false;
-    }
-    return it->second->want_write;
+    ClientConnection* client = find_client(client_fd);
+    return client && client->want_write;
 }
 
 uint32_t SocketServer::remove_client(int client_fd) {
-    auto it = clients_.find(client_fd);
-    if (it != clients_.end()) {
-        uint32_t agent_id = it->second->agent_id;
-        close(client_fd);
-        clients_.erase(it);
-        return agent_id;
-    }
-    return 0;
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    if (client_fd < 0 || static_cast<size_t>(client_fd) >= slots_.size() ||
+        !slots_[client_fd]) {
+        return 0;
+    }
+    uint32_t agent_id = slots_[client_fd]->agent_id;
+    close(client_fd);
+    // Release owned fds now rather than when the slot is reused
+    slots_[client_fd]->send_queue.clear();
+    if (slots_[client_fd]->pending_file_fd >= 0) {
+        close(slots_[client_fd]->pending_file_fd);
+        slots_[client_fd]->pending_file_fd = -1;
+    }
+    pool_.push_back(std::move(slots_[client_fd]));
+    return agent_id;
 }
 
 void SocketServer::stop() {
     // Close all clients
-    for (auto& [fd, client] : clients_) {
-        close(fd);
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        for (auto& client : slots_) {
+            if (client) {
+                close(client->fd);
+            }
+        }
+        slots_.clear();
+        pool_.clear();
     }
-    clients_.clear();
 
     // Close server socket
     if (server_fd_ >= 0) {
@@ -1,22 +1,100 @@
 #pragma once
 #include <string>
+#include <deque>
 #include <functional>
+#include <mutex>
 #include <vector>
-#include <unordered_map>
 #include <memory>
+#include "ipc/buffer_pool.hpp"
 #include "ipc/protocol.hpp"
+#include "ipc/shm_channel.hpp"
 
 namespace clove::ipc {
 
+// Outbound frame queue. Each response stays in its own pinned buffer
+// until it is fully on the wire; the flush path hands the whole chain
+// to writev, so queued responses leave in one syscall and a partial
+// send just advances an offset — nothing is memmoved under
+// backpressure, no matter how deep the queue gets.
+struct SendQueue {
+    // One queue entry: either a framed byte buffer, or a region of an
+    // open file pumped straight to the socket with sendfile (SYS_READ
+    // raw mode) — file bytes never touch userspace on the flush path
+    struct Chunk {
+        std::vector<uint8_t> bytes;
+        int file_fd = -1;        // owned by the queue; closed when drained
+        off_t file_offset = 0;
+        size_t file_remaining = 0;
+
+        bool is_file() const { return file_fd >= 0; }
+        size_t size() const { return is_file() ? file_remaining : bytes.size(); }
+    };
+
+    std::deque<Chunk> chunks;
+    size_t head_offset = 0;  // bytes of chunks.front() already sent
+
+    ~SendQueue() { clear(); }
+
+    bool empty() const { return chunks.empty(); }
+    void append(std::vector<uint8_t> frame) { chunks.push_back({std::move(frame)}); }
+    void append_file(int fd, size_t len);
+
+    // Mark n bytes of leading byte chunks as sent, releasing fully
+    // drained buffers (file chunks advance through their own offset)
+    void consume(size_t n);
+
+    // Drain everything into one contiguous buffer (the io_uring
+    // transport pins a single slab per in-flight send); queued file
+    // regions are read into the buffer as a fallback
+    std::vector<uint8_t> take_all();
+
+    // Drop everything, closing any queued file fds
+    void clear();
+};
+
 // Client connection state
 struct ClientConnection {
     int fd;
     uint32_t agent_id;
     std::vector<uint8_t> recv_buffer;
-    std::vector<uint8_t> send_buffer;
+    SendQueue send_queue;
     bool want_write = false;
 
+    // Shared-memory payload ring, set up when the agent requests it at
+    // SYS_HELLO. The memfd is handed over with the HELLO response via
+    // SCM_RIGHTS on the epoll flush path.
+    std::unique_ptr<ShmChannel> shm;
+    int fd_to_send = -1;
+
+    // CBOR wire encoding, negotiated at SYS_HELLO ({"encoding":"cbor"}).
+    // Payloads are transcoded at the socket boundary; syscall handlers
+    // keep speaking JSON text internally.
+    bool cbor_encoding = false;
+
+    // One raw-mode file region waiting to ride out right behind the
+    // next queued response frame (SYS_READ raw mode). Owned here until
+    // handed to the send queue.
+    int pending_file_fd = -1;
+    size_t pending_file_len = 0;
+
+    // Scratch message reused for every inbound request on this connection
+    // so the payload allocation amortizes across the connection's lifetime
+    Message inbound_scratch;
+
+    // One in-flight chunked transfer (SYS_STREAM_BEGIN..END). Chunks are
+    // pipelined without per-chunk replies; END dispatches the assembled
+    // syscall and gets the (possibly streamed-back) response.
+    struct StreamState {
+        bool active = false;
+        SyscallOp opcode = SyscallOp::SYS_NOOP;
+        std::vector<uint8_t> data;
+    } stream;
+
     explicit ClientConnection(int fd, uint32_t id) : fd(fd), agent_id(id) {}
+
+    // Recycle a pooled connection object for a new fd: buffers keep
+    // their capacity, negotiated per-connection state is wiped
+    void reset(int new_fd, uint32_t id);
 };
 
 // Message handler callback type
@@ -43,6 +121,37 @@ public:
     // Accept new connection, returns client fd
     int accept_connection();
 
+    // Register an externally accepted fd (io_uring transport accepts
+    // through the ring). Returns the assigned agent_id.
+    uint32_t register_client(int client_fd);
+
+    // Completion-driven entry point: append received bytes and dispatch
+    // any complete messages (what handle_client does after read(2))
+    void on_bytes_received(int client_fd, const uint8_t* data, size_t len);
+
+    // Drain pending output for a completion-driven send; empty if
+    // nothing is queued or the fd is unknown
+    std::vector<uint8_t> take_pending(int client_fd);
+
+    // Agent id for a connection fd, 0 if unknown
+    uint32_t agent_id_for_fd(int client_fd) const;
+
+    // Queue a kernel-initiated message (e.g. a pushed async completion).
+    // Must run on the thread that owns the fd; caller flushes.
+    void push_message(int client_fd, const Message& msg);
+
+    // Attach an fd to ride along with the agent's next outbound bytes
+    // via SCM_RIGHTS (e.g. the event-notification eventfd). Non-owning:
+    // the fd stays open on the kernel side. Returns false if the agent
+    // has no connection.
+    bool attach_fd(uint32_t agent_id, int fd);
+
+    // Queue a file region to stream to the agent right behind its next
+    // response frame, pumped kernel-to-socket via sendfile (SYS_READ
+    // raw mode). Takes ownership of fd. Returns false if the agent has
+    // no connection.
+    bool stream_file(uint32_t agent_id, int fd, size_t len);
+
     // Handle client data (read/process/respond)
     // Returns false if client disconnected
     bool handle_client(int client_fd);
@@ -66,11 +175,59 @@ private:
     std::string socket_path_;
     int server_fd_ = -1;
     uint32_t next_agent_id_ = 1;
-    std::unordered_map<int, std::unique_ptr<ClientConnection>> clients_;
+    // Guards the slot table itself: with sharded reactors each client fd
+    // is only touched by its owning shard, but inserts (accept) and
+    // erases race with lookups on other shards. Connection objects are
+    // pointer-stable.
+    mutable std::mutex clients_mutex_;
+    // Connections indexed by fd — fds are small dense integers, so the
+    // per-event lookup is a bounds check and a pointer load instead of
+    // a hash probe. The table grows to the high-water fd and never
+    // shrinks.
+    std::vector<std::unique_ptr<ClientConnection>> slots_;
+    // Disconnected connection objects, recycled on the next accept so
+    // bursts of short-lived connections do no per-accept allocation
+    std::vector<std::unique_ptr<ClientConnection>> pool_;
     MessageHandler handler_;
+    BufferPool recv_pool_;
+
+    // Lock-free-after-lookup accessor (see clients_mutex_ note)
+    ClientConnection* find_client(int client_fd) const;
+
+    // Parse and dispatch one frame at `cursor`; returns bytes consumed,
+    // or 0 when the frame is still incomplete (caller buffers the rest)
+    size_t consume_frame(ClientConnection& client, const uint8_t* cursor,
+                         size_t available);
+
+    // Fast path for small messages: dispatch complete frames straight
+    // out of a fresh read block while recv_buffer is empty, skipping
+    // the append/re-scan/compact cycle entirely. Returns bytes consumed;
+    // a trailing partial stays for the caller to buffer.
+    size_t dispatch_inline(ClientConnection& client, const uint8_t* data, size_t len);
 
     // Process complete messages in client buffer
     void process_messages(ClientConnection& client);
+
+    // Serialize a response, using the shm ring for large payloads when
+    // the connection negotiated one
+    void queue_response(ClientConnection& client, const Message& response);
+
+    // SYS_HELLO shm negotiation (creates the ring, amends the response)
+    void negotiate_shm(ClientConnection& client, const Message& request,
+                       Message& response);
+
+    // SYS_HELLO payload-encoding negotiation (JSON text vs CBOR)
+    void negotiate_encoding(ClientConnection& client, const Message& request,
+                            Message& response);
+
+    // Frame an already-encoded response onto the send buffer
+    void queue_encoded_response(ClientConnection& client, const Message& response);
+
+    // SYS_STREAM_* frames (chunked transfers above MAX_PAYLOAD_SIZE)
+    void handle_stream_frame(ClientConnection& client, const Message& msg);
+
+    // Stream a response larger than MAX_PAYLOAD_SIZE back as chunks
+    void queue_streamed_response(ClientConnection& client, const Message& response);
 };
 
 } // namespace clove::ipc
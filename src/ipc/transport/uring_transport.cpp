@@ -0,0 +1,337 @@
+#include "ipc/transport/uring_transport.hpp"
+#include "ipc/transport/socket_server.hpp"
+#include <spdlog/spdlog.h>
+
+#ifdef HAS_IO_URING
+
+#include <liburing.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace clove::ipc {
+
+namespace {
+
+constexpr unsigned QUEUE_DEPTH = 256;
+constexpr unsigned RECV_BUFFERS = 64;            // must be a power of two
+constexpr size_t RECV_BUFFER_SIZE = 64 * 1024;
+constexpr uint16_t RECV_BGID = 0;                // provided-buffer group id
+
+// Completion routing: operation in the top byte, fd in the low 32 bits
+enum class UringOp : uint8_t { ACCEPT = 1, RECV = 2, SEND = 3 };
+
+uint64_t make_user_data(UringOp op, int fd) {
+    return (static_cast<uint64_t>(op) << 56) | static_cast<uint32_t>(fd);
+}
+
+UringOp user_data_op(uint64_t ud) { return static_cast<UringOp>(ud >> 56); }
+int user_data_fd(uint64_t ud) { return static_cast<int>(ud & 0xFFFFFFFFu); }
+
+// The SQ holds QUEUE_DEPTH entries but one completion batch can want
+// more (every recv queues a send, dropped multishots re-arm), and poll()
+// only submits after the whole CQE loop. When io_uring_get_sqe runs dry,
+// flush the queued SQEs and retry instead of letting a prep_* call write
+// through nullptr.
+io_uring_sqe* get_sqe(io_uring* ring) {
+    io_uring_sqe* sqe = io_uring_get_sqe(ring);
+    while (!sqe) {
+        int rc = io_uring_submit(ring);
+        if (rc < 0 && rc != -EINTR) {
+            spdlog::error("io_uring submit failed flushing full SQ: {}", strerror(-rc));
+            return nullptr;
+        }
+        sqe = io_uring_get_sqe(ring);
+    }
+    return sqe;
+}
+
+} // namespace
+
+struct UringTransport::Ring {
+    io_uring ring{};
+    io_uring_buf_ring* buf_ring = nullptr;
+    std::vector<uint8_t> buf_pool;
+    // One in-flight send per client; bytes are pinned here until the CQE
+    // arrives because SocketServer may grow the send queue in the meantime.
+    std::unordered_map<int, std::vector<uint8_t>> inflight_sends;
+    bool initialized = false;
+};
+
+UringTransport::UringTransport(SocketServer& server)
+    : server_(server), ring_(std::make_unique<Ring>()) {}
+
+UringTransport::~UringTransport() {
+    stop();
+}
+
+bool UringTransport::supported() {
+    return true;
+}
+
+bool UringTransport::init() {
+    int rc = io_uring_queue_init(QUEUE_DEPTH, &ring_->ring, 0);
+    if (rc < 0) {
+        spdlog::error("io_uring_queue_init failed: {}", strerror(-rc));
+        return false;
+    }
+
+    // Registered provided-buffer ring for multishot recv
+    ring_->buf_pool.resize(static_cast<size_t>(RECV_BUFFERS) * RECV_BUFFER_SIZE);
+    int ring_err = 0;
+    ring_->buf_ring = io_uring_setup_buf_ring(&ring_->ring, RECV_BUFFERS,
+                                              RECV_BGID, 0, &ring_err);
+    if (!ring_->buf_ring) {
+        spdlog::error("io_uring_setup_buf_ring failed: {}", strerror(-ring_err));
+        io_uring_queue_exit(&ring_->ring);
+        return false;
+    }
+
+    for (unsigned i = 0; i < RECV_BUFFERS; i++) {
+        io_uring_buf_ring_add(ring_->buf_ring,
+            ring_->buf_pool.data() + static_cast<size_t>(i) * RECV_BUFFER_SIZE,
+            RECV_BUFFER_SIZE, i,
+            io_uring_buf_ring_mask(RECV_BUFFERS), static_cast<int>(i));
+    }
+    io_uring_buf_ring_advance(ring_->buf_ring, RECV_BUFFERS);
+
+    // Multishot accept on the listening socket
+    io_uring_sqe* sqe = get_sqe(&ring_->ring);
+    if (!sqe) {
+        io_uring_free_buf_ring(&ring_->ring, ring_->buf_ring, RECV_BUFFERS, RECV_BGID);
+        ring_->buf_ring = nullptr;
+        io_uring_queue_exit(&ring_->ring);
+        return false;
+    }
+    io_uring_prep_multishot_accept(sqe, server_.get_server_fd(), nullptr, nullptr, 0);
+    io_uring_sqe_set_data64(sqe, make_user_data(UringOp::ACCEPT, server_.get_server_fd()));
+    io_uring_submit(&ring_->ring);
+
+    ring_->initialized = true;
+    spdlog::info("io_uring transport active ({} recv buffers x {}KB)",
+        RECV_BUFFERS, RECV_BUFFER_SIZE / 1024);
+    return true;
+}
+
+int UringTransport::poll(int timeout_ms) {
+    if (!ring_->initialized) {
+        return -1;
+    }
+
+    __kernel_timespec ts;
+    ts.tv_sec = timeout_ms / 1000;
+    ts.tv_nsec = static_cast<long>(timeout_ms % 1000) * 1000000L;
+
+    io_uring_cqe* cqe = nullptr;
+    int rc = io_uring_submit_and_wait_timeout(&ring_->ring, &cqe, 1, &ts, nullptr);
+    if (rc < 0 && rc != -ETIME && rc != -EINTR) {
+        spdlog::error("io_uring wait failed: {}", strerror(-rc));
+        return -1;
+    }
+
+    int handled = 0;
+    unsigned head;
+    io_uring_for_each_cqe(&ring_->ring, head, cqe) {
+        uint64_t ud = io_uring_cqe_get_data64(cqe);
+        switch (user_data_op(ud)) {
+            case UringOp::ACCEPT:
+                handle_accept(cqe->res, cqe->flags);
+                break;
+            case UringOp::RECV:
+                handle_recv(user_data_fd(ud), cqe->res, cqe->flags);
+                break;
+            case UringOp::SEND:
+                handle_send(user_data_fd(ud), cqe->res);
+                break;
+        }
+        handled++;
+    }
+    io_uring_cq_advance(&ring_->ring, handled);
+
+    // Pick up responses queued outside recv completions (e.g. on_tick work)
+    if (handled > 0) {
+        io_uring_submit(&ring_->ring);
+    }
+    return handled;
+}
+
+void UringTransport::handle_accept(int res, uint32_t flags) {
+    if (res >= 0) {
+        server_.register_client(res);
+
+        io_uring_sqe* sqe = get_sqe(&ring_->ring);
+        if (!sqe) {
+            drop_client(res); // no recv armed means the fd would hang forever
+            return;
+        }
+        io_uring_prep_recv_multishot(sqe, res, nullptr, 0, 0);
+        sqe->buf_group = RECV_BGID;
+        sqe->flags |= IOSQE_BUFFER_SELECT;
+        io_uring_sqe_set_data64(sqe, make_user_data(UringOp::RECV, res));
+    } else if (res != -EAGAIN) {
+        spdlog::error("io_uring accept failed: {}", strerror(-res));
+    }
+
+    // Multishot accept stops posting CQEs when the kernel drops it; re-arm
+    if (!(flags & IORING_CQE_F_MORE)) {
+        io_uring_sqe* sqe = get_sqe(&ring_->ring);
+        if (!sqe) {
+            spdlog::error("io_uring: cannot re-arm accept, new connections stalled");
+            return;
+        }
+        io_uring_prep_multishot_accept(sqe, server_.get_server_fd(), nullptr, nullptr, 0);
+        io_uring_sqe_set_data64(sqe, make_user_data(UringOp::ACCEPT, server_.get_server_fd()));
+    }
+}
+
+void UringTransport::handle_recv(int client_fd, int res, uint32_t flags) {
+    if (res > 0) {
+        unsigned bid = flags >> IORING_CQE_BUFFER_SHIFT;
+        const uint8_t* data =
+            ring_->buf_pool.data() + static_cast<size_t>(bid) * RECV_BUFFER_SIZE;
+
+        server_.on_bytes_received(client_fd, data, static_cast<size_t>(res));
+
+        // Hand the buffer back to the kernel
+        io_uring_buf_ring_add(ring_->buf_ring,
+            ring_->buf_pool.data() + static_cast<size_t>(bid) * RECV_BUFFER_SIZE,
+            RECV_BUFFER_SIZE, bid,
+            io_uring_buf_ring_mask(RECV_BUFFERS), 0);
+        io_uring_buf_ring_advance(ring_->buf_ring, 1);
+
+        submit_send(client_fd);
+    } else if (res == 0) {
+        drop_client(client_fd);
+        return;
+    } else if (res != -ENOBUFS && res != -EAGAIN) {
+        spdlog::error("io_uring recv failed (fd={}): {}", client_fd, strerror(-res));
+        drop_client(client_fd);
+        return;
+    }
+
+    // Re-arm when the multishot recv terminated (ENOBUFS or F_MORE cleared)
+    if (!(flags & IORING_CQE_F_MORE)) {
+        io_uring_sqe* sqe = get_sqe(&ring_->ring);
+        if (!sqe) {
+            drop_client(client_fd);
+            return;
+        }
+        io_uring_prep_recv_multishot(sqe, client_fd, nullptr, 0, 0);
+        sqe->buf_group = RECV_BGID;
+        sqe->flags |= IOSQE_BUFFER_SELECT;
+        io_uring_sqe_set_data64(sqe, make_user_data(UringOp::RECV, client_fd));
+    }
+}
+
+void UringTransport::submit_send(int client_fd) {
+    if (ring_->inflight_sends.count(client_fd)) {
+        return; // one send in flight per client; handle_send chains the rest
+    }
+
+    std::vector<uint8_t> pending = server_.take_pending(client_fd);
+    if (pending.empty()) {
+        return;
+    }
+
+    io_uring_sqe* sqe = get_sqe(&ring_->ring);
+    if (!sqe) {
+        drop_client(client_fd); // response bytes lost; a stale reply is worse
+        return;
+    }
+
+    auto& slab = ring_->inflight_sends[client_fd];
+    slab = std::move(pending);
+    io_uring_prep_send(sqe, client_fd, slab.data(), slab.size(), MSG_NOSIGNAL);
+    io_uring_sqe_set_data64(sqe, make_user_data(UringOp::SEND, client_fd));
+}
+
+void UringTransport::handle_send(int client_fd, int res) {
+    auto it = ring_->inflight_sends.find(client_fd);
+    if (it == ring_->inflight_sends.end()) {
+        return;
+    }
+
+    if (res < 0) {
+        spdlog::error("io_uring send failed (fd={}): {}", client_fd, strerror(-res));
+        ring_->inflight_sends.erase(it);
+        drop_client(client_fd);
+        return;
+    }
+
+    // Short send: keep the remainder in flight
+    if (static_cast<size_t>(res) < it->second.size()) {
+        it->second.erase(it->second.begin(), it->second.begin() + res);
+        io_uring_sqe* sqe = get_sqe(&ring_->ring);
+        if (!sqe) {
+            ring_->inflight_sends.erase(it);
+            drop_client(client_fd);
+            return;
+        }
+        io_uring_prep_send(sqe, client_fd, it->second.data(), it->second.size(),
+                           MSG_NOSIGNAL);
+        io_uring_sqe_set_data64(sqe, make_user_data(UringOp::SEND, client_fd));
+        return;
+    }
+
+    ring_->inflight_sends.erase(it);
+    submit_send(client_fd); // responses queued while we were sending
+}
+
+void UringTransport::drop_client(int client_fd) {
+    ring_->inflight_sends.erase(client_fd);
+    uint32_t agent_id = server_.remove_client(client_fd);
+    if (agent_id > 0 && on_disconnect_) {
+        on_disconnect_(agent_id);
+    }
+}
+
+void UringTransport::stop() {
+    if (ring_ && ring_->initialized) {
+        if (ring_->buf_ring) {
+            io_uring_free_buf_ring(&ring_->ring, ring_->buf_ring, RECV_BUFFERS, RECV_BGID);
+            ring_->buf_ring = nullptr;
+        }
+        io_uring_queue_exit(&ring_->ring);
+        ring_->initialized = false;
+        spdlog::info("io_uring transport stopped");
+    }
+}
+
+} // namespace clove::ipc
+
+#else // !HAS_IO_URING
+
+namespace clove::ipc {
+
+struct UringTransport::Ring {};
+
+UringTransport::UringTransport(SocketServer& server)
+    : server_(server) {}
+
+UringTransport::~UringTransport() = default;
+
+bool UringTransport::supported() {
+    return false;
+}
+
+bool UringTransport::init() {
+    spdlog::warn("io_uring transport requested but kernel was built without liburing");
+    return false;
+}
+
+int UringTransport::poll(int) { return 0; }
+
+void UringTransport::handle_accept(int, uint32_t) {}
+void UringTransport::handle_recv(int, int, uint32_t) {}
+void UringTransport::handle_send(int, int) {}
+void UringTransport::submit_send(int) {}
+void UringTransport::drop_client(int) {}
+
+void UringTransport::stop() {}
+
+} // namespace clove::ipc
+
+#endif // HAS_IO_URING
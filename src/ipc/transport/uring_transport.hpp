@@ -0,0 +1,65 @@
+/**
+ * io_uring-backed transport for the kernel IPC socket.
+ *
+ * Alternative to the epoll readiness path: accept/recv/send are driven
+ * through an io_uring submission queue (multishot accept + multishot recv
+ * with a provided-buffer ring), so steady-state traffic costs one
+ * io_uring_enter per batch of completions instead of one read/write
+ * syscall per wakeup. Parsed bytes are fed into the same SocketServer
+ * buffers and handler, so syscall dispatch is identical in both modes.
+ *
+ * Only available when built with liburing (HAS_IO_URING); init() fails
+ * cleanly otherwise and the kernel falls back to the epoll Reactor.
+ */
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace clove::ipc {
+
+class SocketServer;
+
+class UringTransport {
+public:
+    explicit UringTransport(SocketServer& server);
+    ~UringTransport();
+
+    // Non-copyable
+    UringTransport(const UringTransport&) = delete;
+    UringTransport& operator=(const UringTransport&) = delete;
+
+    // True if liburing support was compiled in
+    static bool supported();
+
+    // Called with the agent_id when a client is dropped on a completion
+    // (the epoll path does this cleanup in Kernel::on_client_event)
+    using DisconnectHandler = std::function<void(uint32_t agent_id)>;
+    void set_on_disconnect(DisconnectHandler handler) { on_disconnect_ = std::move(handler); }
+
+    // Set up the ring, registered buffers, and the multishot accept.
+    // SocketServer::init() must have been called first.
+    bool init();
+
+    // Reap completions (blocking up to timeout_ms), dispatch messages,
+    // and submit any pending sends. Returns completions handled, -1 on
+    // unrecoverable ring error.
+    int poll(int timeout_ms);
+
+    // Tear down the ring (client sockets are closed via SocketServer)
+    void stop();
+
+private:
+    struct Ring; // liburing state, defined in the .cpp
+    SocketServer& server_;
+    std::unique_ptr<Ring> ring_;
+    DisconnectHandler on_disconnect_;
+
+    void handle_accept(int res, uint32_t flags);
+    void handle_recv(int client_fd, int res, uint32_t flags);
+    void handle_send(int client_fd, int res);
+    void submit_send(int client_fd);
+    void drop_client(int client_fd);
+};
+
+} // namespace clove::ipc
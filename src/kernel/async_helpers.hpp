@@ -5,6 +5,7 @@
 #include "ipc/protocol.hpp"
 #include "kernel/context.hpp"
 #include "kernel/async_task_manager.hpp"
+#include "kernel/opcode_table.hpp"
 
 namespace clove::kernel::async_helpers {
 
@@ -18,6 +19,12 @@ inline bool should_async(const json& j, bool default_async) {
     return default_async;
 }
 
+// Opcode-aware variant: the default comes from the opcode's AsyncMode
+// row in OPCODE_TABLE instead of a literal at each call site
+inline bool should_async(const json& j, ipc::SyscallOp op) {
+    return should_async(j, opcode_info(op).async_mode == AsyncMode::ASYNC);
+}
+
 inline ipc::Message submit_async(KernelContext& context, const ipc::Message& msg,
                                  const json& request, SyncFn sync_fn) {
     uint64_t request_id = request.value("request_id", 0ULL);
@@ -25,6 +32,10 @@ inline ipc::Message submit_async(KernelContext& context, const ipc::Message& msg
         request_id = context.async_tasks.next_request_id();
     }
 
+    // Optional per-request deadline: the executor answers with a timeout
+    // once it passes, whether the task is still queued or mid-flight
+    int deadline_ms = request.value("deadline_ms", 0);
+
     std::string payload = msg.payload_str();
     context.async_tasks.submit(msg.agent_id, msg.opcode, request_id,
         [payload, agent_id = msg.agent_id, opcode = msg.opcode, &context, sync_fn]() {
@@ -39,7 +50,8 @@ inline ipc::Message submit_async(KernelContext& context, const ipc::Message& msg
                 response["error"] = std::string("invalid request: ") + e.what();
                 return ipc::Message(agent_id, opcode, response.dump());
             }
-        });
+        },
+        deadline_ms);
 
     json response;
     response["success"] = true;
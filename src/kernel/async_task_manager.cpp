@@ -1,41 +1,108 @@
 #include "kernel/async_task_manager.hpp"
+#include "kernel/thread_placement.hpp"
+#include <spdlog/spdlog.h>
+#include <chrono>
 
 namespace clove::kernel {
 
+namespace {
+
+// Token of the task currently running on this pool thread, consulted by
+// current_cancelled(). Null outside run_task (and on non-pool threads).
+thread_local AsyncTaskManager::CancelToken* t_current_token = nullptr;
+
+constexpr const char* CANCELLED_PAYLOAD =
+    R"({"success":false,"error":"cancelled","cancelled":true})";
+constexpr const char* DEADLINE_PAYLOAD =
+    R"({"success":false,"error":"deadline exceeded","timed_out":true})";
+
+} // namespace
+
 AsyncTaskManager::AsyncTaskManager(size_t worker_count) {
     if (worker_count == 0) {
-        worker_count = 1;
+        worker_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Reserve a small slow lane for LLM calls so they can't starve
+    // short tasks; everything else gets the rest. On boxes with fewer
+    // cores than the slow-lane minimum, split what's there instead —
+    // worker_count - slow_count must not underflow.
+    size_t slow_count = std::max<size_t>(2, worker_count / 4);
+    if (slow_count >= worker_count) {
+        slow_count = std::max<size_t>(1, worker_count / 2);
+    }
+    size_t fast_count = std::max<size_t>(1, worker_count - slow_count);
+
+    for (size_t i = 0; i < fast_count; ++i) {
+        fast_lane_.workers.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < slow_count; ++i) {
+        slow_lane_.workers.push_back(std::make_unique<Worker>());
     }
-    workers_.reserve(worker_count);
-    for (size_t i = 0; i < worker_count; ++i) {
-        workers_.emplace_back([this]() { worker_loop(); });
+
+    threads_.reserve(fast_count + slow_count);
+    for (size_t i = 0; i < fast_count; ++i) {
+        threads_.emplace_back([this, i]() { worker_loop(fast_lane_, i); });
+    }
+    for (size_t i = 0; i < slow_count; ++i) {
+        threads_.emplace_back([this, i]() { worker_loop(slow_lane_, i); });
     }
+
+    spdlog::debug("Async executor: {} fast + {} slow workers", fast_count, slow_count);
 }
 
 AsyncTaskManager::~AsyncTaskManager() {
     stopping_ = true;
-    queue_cv_.notify_all();
-    for (auto& worker : workers_) {
-        if (worker.joinable()) {
-            worker.join();
+    fast_lane_.cv.notify_all();
+    slow_lane_.cv.notify_all();
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
         }
     }
 }
 
+void AsyncTaskManager::set_completion_handler(CompletionHandler handler) {
+    completion_handler_ = std::move(handler);
+}
+
 uint64_t AsyncTaskManager::next_request_id() {
     return next_request_id_.fetch_add(1, std::memory_order_relaxed);
 }
 
-bool AsyncTaskManager::submit(uint32_t agent_id, ipc::SyscallOp opcode, uint64_t request_id, TaskFn task) {
+AsyncTaskManager::Lane& AsyncTaskManager::lane_for(ipc::SyscallOp opcode) {
+    return opcode == ipc::SyscallOp::SYS_THINK ? slow_lane_ : fast_lane_;
+}
+
+bool AsyncTaskManager::submit(uint32_t agent_id, ipc::SyscallOp opcode, uint64_t request_id,
+                              TaskFn task, int deadline_ms) {
     if (stopping_) {
         return false;
     }
 
+    auto token = std::make_shared<CancelToken>();
+    if (deadline_ms > 0) {
+        token->has_deadline = true;
+        token->deadline = std::chrono::steady_clock::now() +
+                          std::chrono::milliseconds(deadline_ms);
+    }
     {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        queue_.push_back(Task{agent_id, request_id, opcode, std::move(task)});
+        std::lock_guard<std::mutex> lock(active_mutex_);
+        active_[request_id] = ActiveEntry{agent_id, opcode, token};
     }
-    queue_cv_.notify_one();
+
+    Lane& lane = lane_for(opcode);
+    size_t idx = lane.next_worker.fetch_add(1, std::memory_order_relaxed)
+                 % lane.workers.size();
+
+    {
+        std::lock_guard<std::mutex> lock(lane.workers[idx]->mutex);
+        lane.workers[idx]->queue.push_back(
+            Task{agent_id, request_id, opcode, std::move(task),
+                 std::chrono::steady_clock::now(), std::move(token)});
+    }
+    lane.pending.fetch_add(1, std::memory_order_release);
+    lane.cv.notify_one();
     return true;
 }
 
@@ -60,27 +127,179 @@ std::vector<AsyncTaskManager::AsyncResult> AsyncTaskManager::poll(uint32_t agent
     return results;
 }
 
-void AsyncTaskManager::worker_loop() {
+void AsyncTaskManager::worker_loop(Lane& lane, size_t worker_idx) {
+    // Node-local cpuset: successive workers land on alternating NUMA
+    // nodes, so neither lane's deques all share one memory controller
+    placement::pin_current(placement::ThreadClass::ASYNC_WORKER);
+
     while (true) {
         Task task;
+        bool got_task = false;
+
+        // Own deque first (front = oldest)
         {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            queue_cv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
-            if (stopping_ && queue_.empty()) {
+            auto& own = *lane.workers[worker_idx];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.queue.empty()) {
+                task = std::move(own.queue.front());
+                own.queue.pop_front();
+                got_task = true;
+            }
+        }
+
+        // Steal from a neighbour's back
+        if (!got_task) {
+            for (size_t i = 1; i < lane.workers.size() && !got_task; ++i) {
+                auto& victim = *lane.workers[(worker_idx + i) % lane.workers.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.queue.empty()) {
+                    task = std::move(victim.queue.back());
+                    victim.queue.pop_back();
+                    got_task = true;
+                }
+            }
+        }
+
+        if (!got_task) {
+            if (stopping_) {
                 return;
             }
-            task = std::move(queue_.front());
-            queue_.pop_front();
+            std::unique_lock<std::mutex> lock(lane.cv_mutex);
+            lane.cv.wait_for(lock, std::chrono::milliseconds(100), [this, &lane]() {
+                return stopping_.load() ||
+                       lane.pending.load(std::memory_order_acquire) > 0;
+            });
+            continue;
         }
 
+        lane.pending.fetch_sub(1, std::memory_order_relaxed);
+
+        auto& wait_hist = &lane == &slow_lane_ ? slow_wait_hist_ : fast_wait_hist_;
+        wait_hist.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - task.enqueued_at).count()));
+
+        run_task(task);
+    }
+}
+
+void AsyncTaskManager::run_task(Task& task) {
+    CancelToken& token = *task.token;
+
+    // Cancelled or expired while still queued: answer without running
+    if (token.cancelled.load(std::memory_order_acquire) || token.expired()) {
+        if (!token.result_posted.exchange(true)) {
+            const char* payload =
+                token.cancelled.load(std::memory_order_relaxed)
+                    ? CANCELLED_PAYLOAD : DEADLINE_PAYLOAD;
+            complete(task.agent_id,
+                     AsyncResult{task.request_id, task.opcode, payload});
+        }
+    } else {
+        t_current_token = task.token.get();
         ipc::Message response = task.fn();
-        AsyncResult result{task.request_id, response.opcode, response.payload_str()};
+        t_current_token = nullptr;
 
-        {
-            std::lock_guard<std::mutex> lock(results_mutex_);
-            results_[task.agent_id].push_back(std::move(result));
+        // The deadline sweep may have answered already; the late result
+        // is dropped rather than delivered on top of the timeout
+        if (!token.result_posted.exchange(true)) {
+            complete(task.agent_id,
+                     AsyncResult{task.request_id, response.opcode,
+                                 response.payload_str()});
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(active_mutex_);
+    active_.erase(task.request_id);
+}
+
+bool AsyncTaskManager::current_cancelled() {
+    return t_current_token != nullptr &&
+           (t_current_token->cancelled.load(std::memory_order_acquire) ||
+            t_current_token->expired());
+}
+
+void AsyncTaskManager::expire_deadlines() {
+    // Collect under the lock, deliver outside it — complete() can call
+    // back into the connection layer
+    std::vector<std::pair<uint32_t, AsyncResult>> due;
+    {
+        std::lock_guard<std::mutex> lock(active_mutex_);
+        for (auto& [request_id, entry] : active_) {
+            if (entry.token->expired() &&
+                !entry.token->result_posted.exchange(true)) {
+                entry.token->cancelled.store(true, std::memory_order_release);
+                due.emplace_back(entry.agent_id,
+                    AsyncResult{request_id, entry.opcode, DEADLINE_PAYLOAD});
+            }
+        }
+    }
+
+    for (auto& [agent_id, result] : due) {
+        spdlog::debug("Async request {} for agent {} hit its deadline",
+                      result.request_id, agent_id);
+        complete(agent_id, std::move(result));
+    }
+}
+
+void AsyncTaskManager::purge_agent(uint32_t agent_id) {
+    // Queued-but-unstarted tasks are dropped outright; lane.pending has
+    // to shrink with the deques or the cv predicate spins on work that
+    // no longer exists
+    for (Lane* lane : {&fast_lane_, &slow_lane_}) {
+        for (auto& worker : lane->workers) {
+            size_t erased = 0;
+            {
+                std::lock_guard<std::mutex> lock(worker->mutex);
+                erased = std::erase_if(worker->queue,
+                    [agent_id](const Task& t) { return t.agent_id == agent_id; });
+            }
+            if (erased > 0) {
+                lane->pending.fetch_sub(static_cast<int>(erased),
+                                        std::memory_order_release);
+            }
         }
     }
+
+    // Flag everything still registered for the agent as cancelled and
+    // already answered: a running handler bails at its next check and
+    // its result is discarded, not parked for a dead agent. Entries for
+    // tasks dropped above are erased here; a running task's own erase
+    // in run_task is then a no-op.
+    size_t purged = 0;
+    {
+        std::lock_guard<std::mutex> lock(active_mutex_);
+        purged = std::erase_if(active_, [agent_id](auto& kv) {
+            if (kv.second.agent_id != agent_id) {
+                return false;
+            }
+            kv.second.token->cancelled.store(true, std::memory_order_release);
+            kv.second.token->result_posted.store(true, std::memory_order_release);
+            return true;
+        });
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(results_mutex_);
+        results_.erase(agent_id);
+    }
+
+    if (purged > 0) {
+        spdlog::debug("Purged {} async task(s) for agent {}", purged, agent_id);
+    }
+}
+
+void AsyncTaskManager::complete(uint32_t agent_id, AsyncResult result) {
+    // Push the completion to the agent's connection; park it for
+    // SYS_ASYNC_POLL only when delivery isn't possible
+    if (completion_handler_ && completion_handler_(agent_id, result)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(results_mutex_);
+        results_[agent_id].push_back(std::move(result));
+    }
 }
 
 } // namespace clove::kernel
@@ -4,14 +4,26 @@
 #include <cstdint>
 #include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <unordered_map>
 #include <vector>
+#include <chrono>
 #include "ipc/protocol.hpp"
+#include "metrics/histogram.hpp"
 
 namespace clove::kernel {
 
+// Async task executor with per-worker deques and work stealing.
+//
+// Sized to hardware_concurrency by default (KernelConfig::async_workers
+// to override). Workers are split into two lanes so long-running LLM
+// calls can't occupy every thread: SYS_THINK tasks go to a small "slow"
+// lane, everything else (SYS_EXEC, SYS_HTTP, ...) to the "fast" lane.
+// Within a lane, submit round-robins across worker deques; an idle
+// worker drains its own deque from the front and steals from its
+// neighbours' backs, so one hot queue can't leave cores idle.
 class AsyncTaskManager {
 public:
     using TaskFn = std::function<ipc::Message()>;
@@ -22,31 +34,114 @@ public:
         std::string payload;
     };
 
-    explicit AsyncTaskManager(size_t worker_count = 4);
+    // Cancellation/deadline state shared between the executor and the
+    // running task. result_posted arbitrates who answers the request:
+    // whichever side flips it first (the worker with the real result,
+    // the deadline sweep with a timeout, or purge_agent) wins, and the
+    // loser's result is dropped instead of delivered twice.
+    struct CancelToken {
+        std::atomic<bool> cancelled{false};
+        std::atomic<bool> result_posted{false};
+        bool has_deadline = false;
+        std::chrono::steady_clock::time_point deadline{};
+
+        bool expired() const {
+            return has_deadline && std::chrono::steady_clock::now() >= deadline;
+        }
+    };
+
+    // Tries to push a finished result to the agent's connection; returns
+    // false if it could not be delivered (result is then parked for
+    // SYS_ASYNC_POLL as before). Set once during kernel init, before any
+    // task can complete.
+    using CompletionHandler = std::function<bool(uint32_t agent_id, const AsyncResult&)>;
+
+    // worker_count 0 = hardware_concurrency
+    explicit AsyncTaskManager(size_t worker_count = 0);
     ~AsyncTaskManager();
 
+    void set_completion_handler(CompletionHandler handler);
+
     uint64_t next_request_id();
-    bool submit(uint32_t agent_id, ipc::SyscallOp opcode, uint64_t request_id, TaskFn task);
+
+    // deadline_ms 0 = no deadline. Expired tasks are skipped at dequeue;
+    // ones already running get a timeout result from expire_deadlines()
+    // and keep running detached until their next cancellation check.
+    bool submit(uint32_t agent_id, ipc::SyscallOp opcode, uint64_t request_id,
+                TaskFn task, int deadline_ms = 0);
     std::vector<AsyncResult> poll(uint32_t agent_id, int max_results);
 
+    // True when the task running on this pool thread was cancelled or
+    // overran its deadline. Long-running handlers (SYS_EXEC drain loop,
+    // SYS_HTTP) poll this at safe points to bail out early; returns
+    // false on non-pool threads.
+    static bool current_cancelled();
+
+    // Post timeout results for tasks past their deadline. Called from
+    // the main loop tick so a wedged handler can't delay its own
+    // timeout indefinitely.
+    void expire_deadlines();
+
+    // Reclaim everything an exiting agent left behind: drop its queued
+    // tasks, flag its running ones cancelled, discard its parked
+    // results. Called on SYS_KILL and on disconnect.
+    void purge_agent(uint32_t agent_id);
+
+    // Deliver a result produced outside the worker pool (e.g. a coroutine
+    // handler finishing on the reactor thread): push it to the agent's
+    // connection, or park it for SYS_ASYNC_POLL
+    void complete(uint32_t agent_id, AsyncResult result);
+
 private:
     struct Task {
         uint32_t agent_id;
         uint64_t request_id;
         ipc::SyscallOp opcode;
         TaskFn fn;
+        std::chrono::steady_clock::time_point enqueued_at;
+        std::shared_ptr<CancelToken> token;
     };
 
-    void worker_loop();
+    // Submitted-but-unfinished tasks, indexed by request_id so the
+    // deadline sweep and purge_agent can reach their tokens
+    struct ActiveEntry {
+        uint32_t agent_id;
+        ipc::SyscallOp opcode;
+        std::shared_ptr<CancelToken> token;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> queue;
+    };
 
-    std::deque<Task> queue_;
-    std::mutex queue_mutex_;
-    std::condition_variable queue_cv_;
-    std::vector<std::thread> workers_;
+    struct Lane {
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::mutex cv_mutex;
+        std::condition_variable cv;
+        std::atomic<size_t> next_worker{0};
+        std::atomic<int> pending{0};
+    };
+
+    void worker_loop(Lane& lane, size_t worker_idx);
+    void run_task(Task& task);
+    Lane& lane_for(ipc::SyscallOp opcode);
+
+    Lane fast_lane_;
+    Lane slow_lane_;
+    std::vector<std::thread> threads_;
     std::atomic<bool> stopping_{false};
 
+    // Time from submit to a worker starting the task, per lane
+    metrics::LatencyHistogram fast_wait_hist_{"async_fast_queue_wait_us"};
+    metrics::LatencyHistogram slow_wait_hist_{"async_slow_queue_wait_us"};
+
+    std::unordered_map<uint64_t, ActiveEntry> active_;
+    std::mutex active_mutex_;
+
     std::unordered_map<uint32_t, std::deque<AsyncResult>> results_;
     std::mutex results_mutex_;
+    CompletionHandler completion_handler_;
 
     std::atomic<uint64_t> next_request_id_{1};
 };
@@ -1,5 +1,10 @@
 #include "kernel/audit_log.hpp"
+#include "kernel/thread_placement.hpp"
 #include <spdlog/spdlog.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 
@@ -7,6 +12,23 @@ namespace clove::kernel {
 
 using json = nlohmann::json;
 
+namespace {
+
+// Cheap per-thread xorshift for sampling decisions; quality doesn't
+// matter here, staying off the hot path does
+bool sample_hit(double rate) {
+    if (rate >= 1.0) return true;
+    if (rate <= 0.0) return false;
+    thread_local uint64_t state =
+        0x9E3779B97F4A7C15ull ^ std::hash<std::thread::id>{}(std::this_thread::get_id());
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return (state >> 11) * (1.0 / 9007199254740992.0) < rate;
+}
+
+} // namespace
+
 // ============================================================================
 // AuditLogEntry Implementation
 // ============================================================================
@@ -58,18 +80,59 @@ bool AuditConfig::is_enabled(AuditCategory cat) const {
     }
 }
 
+double AuditConfig::sample_rate(AuditCategory cat) const {
+    switch (cat) {
+        case AuditCategory::SYSCALL:     return sample_syscalls;
+        case AuditCategory::IPC:         return sample_ipc;
+        case AuditCategory::STATE_STORE: return sample_state;
+        case AuditCategory::NETWORK:     return sample_network;
+        default: return 1.0;  // security/lifecycle/resource/world are never sampled down
+    }
+}
+
 // ============================================================================
 // AuditLogger Implementation
 // ============================================================================
 
 AuditLogger::AuditLogger() : config_() {
+    writer_ = std::thread(&AuditLogger::writer_loop, this);
     spdlog::debug("AuditLogger initialized with default config");
 }
 
 AuditLogger::AuditLogger(const AuditConfig& config) : config_(config) {
+    writer_ = std::thread(&AuditLogger::writer_loop, this);
     spdlog::debug("AuditLogger initialized (max_entries={})", config_.max_entries);
 }
 
+AuditLogger::~AuditLogger() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        stopping_ = true;
+    }
+    queue_cv_.notify_all();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+    if (sink_fd_ >= 0) {
+        ::fsync(sink_fd_);
+        ::close(sink_fd_);
+    }
+}
+
+bool AuditLogger::enable_file_sink(const std::string& path) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        spdlog::error("AuditLogger: cannot open sink {}: {}", path, strerror(errno));
+        return false;
+    }
+    int old_fd = sink_fd_.exchange(fd);
+    if (old_fd >= 0) {
+        ::close(old_fd);
+    }
+    spdlog::info("Audit file sink enabled: {}", path);
+    return true;
+}
+
 void AuditLogger::log(AuditCategory category,
                       const std::string& event_type,
                       uint32_t agent_id,
@@ -81,10 +144,13 @@ void AuditLogger::log(AuditCategory category,
         return;
     }
 
-    std::lock_guard<std::mutex> lock(mutex_);
+    // Statistical sampling for high-volume categories
+    if (!sample_hit(config_.sample_rate(category))) {
+        return;
+    }
 
     AuditLogEntry entry;
-    entry.id = next_id_++;
+    entry.id = next_id_.fetch_add(1, std::memory_order_relaxed);
     entry.timestamp = std::chrono::system_clock::now();
     entry.category = category;
     entry.event_type = event_type;
@@ -93,14 +159,84 @@ void AuditLogger::log(AuditCategory category,
     entry.details = details;
     entry.success = success;
 
-    entries_.push_back(entry);
-    trim_entries();
+    // Hand off to the writer thread; formatting and I/O never happen
+    // on the syscall path
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        queue_.push_back(std::move(entry));
+        writer_idle_ = false;
+    }
+    queue_cv_.notify_one();
 
     spdlog::trace("Audit[{}]: {} agent_id={} success={}",
                   audit_category_to_string(category),
                   event_type, agent_id, success);
 }
 
+void AuditLogger::writer_loop() {
+    placement::pin_current(placement::ThreadClass::BACKGROUND);
+
+    using clock = std::chrono::steady_clock;
+    auto last_fsync = clock::now();
+    std::string buffer;
+
+    for (;;) {
+        std::deque<AuditLogEntry> batch;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (stopping_ && queue_.empty()) {
+                return;
+            }
+            batch.swap(queue_);
+        }
+
+        // Format the whole batch into one buffer, then a single write
+        buffer.clear();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& entry : batch) {
+                if (sink_fd_ >= 0) {
+                    buffer += entry.to_jsonl();
+                }
+                entries_.push_back(std::move(entry));
+            }
+            trim_entries();
+        }
+
+        if (sink_fd_ >= 0 && !buffer.empty()) {
+            size_t off = 0;
+            while (off < buffer.size()) {
+                ssize_t n = ::write(sink_fd_, buffer.data() + off, buffer.size() - off);
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    spdlog::error("AuditLogger: sink write failed: {}", strerror(errno));
+                    break;
+                }
+                off += static_cast<size_t>(n);
+            }
+            auto now = clock::now();
+            if (now - last_fsync >= std::chrono::seconds(1)) {
+                ::fsync(sink_fd_);
+                last_fsync = now;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            if (queue_.empty()) {
+                writer_idle_ = true;
+                drained_cv_.notify_all();
+            }
+        }
+    }
+}
+
+void AuditLogger::wait_drained() const {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    drained_cv_.wait(lock, [this] { return writer_idle_ || stopping_; });
+}
+
 void AuditLogger::log_security(const std::string& event_type,
                                uint32_t agent_id,
                                const std::string& agent_name,
@@ -133,6 +269,7 @@ std::vector<AuditLogEntry> AuditLogger::get_entries(
     uint64_t since_id,
     size_t limit) const {
 
+    wait_drained();  // make recently enqueued entries visible
     std::lock_guard<std::mutex> lock(mutex_);
     std::vector<AuditLogEntry> result;
 
@@ -171,6 +308,7 @@ std::vector<AuditLogEntry> AuditLogger::get_entries_by_category(
 }
 
 std::string AuditLogger::export_jsonl(size_t limit) const {
+    wait_drained();
     std::lock_guard<std::mutex> lock(mutex_);
     std::ostringstream oss;
 
@@ -194,19 +332,25 @@ void AuditLogger::set_config(const AuditConfig& config) {
 }
 
 void AuditLogger::clear() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        queue_.clear();
+        writer_idle_ = true;
+    }
+    drained_cv_.notify_all();
     std::lock_guard<std::mutex> lock(mutex_);
     entries_.clear();
     spdlog::debug("AuditLogger cleared");
 }
 
 size_t AuditLogger::entry_count() const {
+    wait_drained();
     std::lock_guard<std::mutex> lock(mutex_);
     return entries_.size();
 }
 
 uint64_t AuditLogger::last_entry_id() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return next_id_ - 1;
+    return next_id_.load(std::memory_order_relaxed) - 1;
 }
 
 void AuditLogger::trim_entries() {
@@ -6,11 +6,14 @@
  * configurable retention and export capabilities.
  */
 #pragma once
+#include <atomic>
 #include <string>
 #include <vector>
+#include <condition_variable>
 #include <deque>
 #include <mutex>
 #include <chrono>
+#include <thread>
 #include <unordered_set>
 #include <cstdint>
 #include <nlohmann/json.hpp>
@@ -87,8 +90,19 @@ struct AuditConfig {
     bool log_network = false;                 // Log network events
     bool log_world = false;                   // Log world events
 
+    // Per-category sampling rates (1.0 = log everything). Lets
+    // high-volume categories be statistically sampled instead of
+    // fully logged.
+    double sample_syscalls = 1.0;
+    double sample_ipc = 1.0;
+    double sample_state = 1.0;
+    double sample_network = 1.0;
+
     // Check if category is enabled
     bool is_enabled(AuditCategory cat) const;
+
+    // Sampling rate for a category (1.0 for unsampled categories)
+    double sample_rate(AuditCategory cat) const;
 };
 
 // Audit logger class
@@ -96,7 +110,12 @@ class AuditLogger {
 public:
     AuditLogger();
     explicit AuditLogger(const AuditConfig& config);
-    ~AuditLogger() = default;
+    ~AuditLogger();
+
+    // Append entries as JSONL to a file. Formatting and writes happen
+    // on the writer thread, batched, with a periodic fsync — the
+    // syscall path only enqueues.
+    bool enable_file_sink(const std::string& path);
 
     // Log an event
     void log(AuditCategory category,
@@ -146,7 +165,22 @@ private:
     AuditConfig config_;
     std::deque<AuditLogEntry> entries_;
     mutable std::mutex mutex_;
-    uint64_t next_id_ = 1;
+    std::atomic<uint64_t> next_id_{1};
+
+    // Producer queue drained by the writer thread; log() never
+    // formats or touches the file
+    std::deque<AuditLogEntry> queue_;
+    mutable std::mutex queue_mutex_;
+    std::condition_variable queue_cv_;
+    mutable std::condition_variable drained_cv_;
+    std::thread writer_;
+    bool stopping_ = false;
+    bool writer_idle_ = true;
+
+    std::atomic<int> sink_fd_{-1};
+
+    void writer_loop();
+    void wait_drained() const;  // blocks until the queue is empty
 
     // Trim entries to max size
     void trim_entries();
@@ -0,0 +1,94 @@
+#include "kernel/checkpoint.hpp"
+#include <spdlog/spdlog.h>
+#include <unistd.h>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace clove::kernel::checkpoint {
+
+namespace {
+
+constexpr uint32_t CKPT_MAGIC = 0x31504B43;  // "CKP1"
+constexpr uint32_t CKPT_VERSION = 1;
+
+struct ImageHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t payload_size;
+};
+
+} // namespace
+
+bool write_image(const std::string& path, const nlohmann::json& image) {
+    std::vector<uint8_t> payload = nlohmann::json::to_msgpack(image);
+
+    ImageHeader header{CKPT_MAGIC, CKPT_VERSION, payload.size()};
+
+    // Write to a temp file and rename into place so a crash mid-write
+    // leaves either the old image or none — never a torn one
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            spdlog::error("Checkpoint: cannot open {} for writing", tmp_path);
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(payload.data()),
+                  static_cast<std::streamsize>(payload.size()));
+        out.flush();
+        if (!out) {
+            spdlog::error("Checkpoint: write to {} failed", tmp_path);
+            ::unlink(tmp_path.c_str());
+            return false;
+        }
+    }
+
+    if (::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        spdlog::error("Checkpoint: rename {} -> {} failed: {}",
+                      tmp_path, path, strerror(errno));
+        ::unlink(tmp_path.c_str());
+        return false;
+    }
+
+    spdlog::info("Checkpoint written: {} ({} bytes)", path, payload.size());
+    return true;
+}
+
+std::optional<nlohmann::json> read_image(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return std::nullopt;
+    }
+
+    ImageHeader header{};
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || header.magic != CKPT_MAGIC) {
+        spdlog::warn("Checkpoint: {} is not a checkpoint image", path);
+        return std::nullopt;
+    }
+    if (header.version != CKPT_VERSION) {
+        spdlog::warn("Checkpoint: {} is version {}, expected {} — ignoring",
+                     path, header.version, CKPT_VERSION);
+        return std::nullopt;
+    }
+
+    std::vector<uint8_t> payload(header.payload_size);
+    in.read(reinterpret_cast<char*>(payload.data()),
+            static_cast<std::streamsize>(payload.size()));
+    if (!in) {
+        spdlog::warn("Checkpoint: {} is truncated — ignoring", path);
+        return std::nullopt;
+    }
+
+    try {
+        return nlohmann::json::from_msgpack(payload);
+    } catch (const std::exception& e) {
+        spdlog::warn("Checkpoint: {} failed to parse: {}", path, e.what());
+        return std::nullopt;
+    }
+}
+
+} // namespace clove::kernel::checkpoint
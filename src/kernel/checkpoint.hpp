@@ -0,0 +1,28 @@
+/**
+ * Kernel checkpoint image
+ *
+ * One file holding every kernel registry a restart would otherwise
+ * forget: mailbox names and queued IPC, event subscriptions, permission
+ * grants, and the agents to respawn under their preserved IDs. Written
+ * on clean shutdown, adopted (and consumed) by the next boot, so a
+ * kernel binary swap costs one boot instead of a cold re-provision.
+ *
+ * Format: a fixed header (magic, version, payload size) followed by the
+ * image as one contiguous MessagePack blob — a single sequential read
+ * at boot, no parsing until the blob is in memory.
+ */
+#pragma once
+#include <optional>
+#include <string>
+#include <nlohmann/json.hpp>
+
+namespace clove::kernel::checkpoint {
+
+// Serialize the image to path (atomically: temp file + rename).
+bool write_image(const std::string& path, const nlohmann::json& image);
+
+// Read and validate an image; nullopt if missing, truncated or from an
+// incompatible version.
+std::optional<nlohmann::json> read_image(const std::string& path);
+
+} // namespace clove::kernel::checkpoint
@@ -7,6 +7,16 @@ namespace clove::kernel {
 struct KernelConfig {
     std::string socket_path = "/tmp/clove.sock";
     bool enable_sandboxing = true;
+    bool use_io_uring = false;           // Drive IPC via io_uring (needs liburing build)
+    int reactor_shards = 0;              // Client event-loop shards; 0 = hardware_concurrency
+    int async_workers = 0;               // Async executor threads; 0 = hardware_concurrency
+    bool pin_threads = false;            // NUMA-aware thread pinning (see thread_placement.hpp)
+    std::string state_dir;               // StateStore WAL/snapshot dir; empty = in-memory only
+    std::string exec_log_dir;            // Execution log segment dir; empty = in-memory only
+    std::string audit_log_path;          // Audit JSONL sink file; empty = in-memory only
+    uint32_t metrics_interval_ms = 1000; // Background /proc sampler interval; 0 = sample on demand
+    int llm_concurrency = 8;             // Max in-flight LLM requests
+    int llm_cache_ttl_secs = 300;        // SYS_THINK response cache TTL; 0 disables
     std::string gemini_api_key;          // Gemini API key (or from env)
     std::string llm_model = "gemini-2.0-flash";
     // Tunnel configuration
@@ -13,6 +13,7 @@ class AgentMailboxRegistry;
 class PermissionsStore;
 class AsyncTaskManager;
 class LlmQueue;
+class FederationManager;
 
 } // namespace clove::kernel
 
@@ -54,6 +55,7 @@ struct KernelContext {
     PermissionsStore& permissions_store;
     AsyncTaskManager& async_tasks;
     LlmQueue& llm_queue;
+    FederationManager* federation = nullptr;  // null when clustering is off
 };
 
 } // namespace clove::kernel
@@ -1,80 +1,319 @@
 #include "kernel/event_bus.hpp"
 #include <spdlog/spdlog.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <bit>
 
 namespace clove::kernel {
 
-void EventBus::emit(KernelEventType type, const nlohmann::json& data, uint32_t source_agent_id) {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    KernelEvent event;
-    event.type = type;
-    event.data = data;
-    event.timestamp = std::chrono::steady_clock::now();
-    event.source_agent_id = source_agent_id;
-
-    for (const auto& [agent_id, subscriptions] : subscriptions_) {
-        if (subscriptions.count(type) > 0) {
-            queues_[agent_id].push(event);
-            spdlog::debug("Event {} queued for agent {}", kernel_event_type_to_string(type), agent_id);
+namespace {
+
+constexpr uint32_t mask_bit(KernelEventType type) {
+    return 1u << static_cast<uint32_t>(type);
+}
+
+// Events travel as a refcounted pre-serialized JSON object so fan-out
+// to N subscribers is one dump() plus N pointer bumps
+struct QueuedEvent {
+    KernelEventType type = KernelEventType::CUSTOM;
+    std::shared_ptr<const std::string> text;
+};
+
+} // namespace
+
+// One per subscribed agent: a Vyukov bounded MPMC ring. Producers (any
+// thread) push; the agent's connection thread is the draining consumer.
+// Producers also act as consumers for one slot when evicting under
+// DROP_OLDEST/COALESCE, which the MPMC queue permits.
+struct EventBus::Subscriber {
+    struct Cell {
+        std::atomic<size_t> seq;
+        QueuedEvent event;
+    };
+
+    std::atomic<uint32_t> type_mask{0};
+    std::vector<Cell> cells;
+    size_t pos_mask;
+    OverflowPolicy policy;
+    alignas(64) std::atomic<size_t> enqueue_pos{0};
+    alignas(64) std::atomic<size_t> dequeue_pos{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> coalesced{0};
+    int event_fd = -1;
+
+    Subscriber(size_t capacity, OverflowPolicy overflow_policy)
+        : cells(std::bit_ceil(capacity)),
+          pos_mask(cells.size() - 1),
+          policy(overflow_policy) {
+        for (size_t i = 0; i < cells.size(); ++i) {
+            cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+        event_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    }
+
+    ~Subscriber() {
+        if (event_fd >= 0) {
+            ::close(event_fd);
+        }
+    }
+
+    bool try_push(QueuedEvent&& event) {
+        Cell* cell;
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells[pos & pos_mask];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (dif == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1,
+                                                      std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (dif < 0) {
+                return false; // full
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->event = std::move(event);
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(QueuedEvent& out) {
+        Cell* cell;
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells[pos & pos_mask];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t dif = static_cast<intptr_t>(seq) -
+                           static_cast<intptr_t>(pos + 1);
+            if (dif == 0) {
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1,
+                                                      std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (dif < 0) {
+                return false; // empty
+            } else {
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        out = std::move(cell->event);
+        cell->event.text.reset();
+        cell->seq.store(pos + pos_mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    void push(QueuedEvent event) {
+        for (int attempt = 0; attempt < 4; ++attempt) {
+            if (try_push(std::move(event))) {
+                if (event_fd >= 0) {
+                    uint64_t one = 1;
+                    [[maybe_unused]] ssize_t n =
+                        ::write(event_fd, &one, sizeof(one));
+                }
+                return;
+            }
+            if (policy == OverflowPolicy::DROP_NEWEST) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            // Evict the oldest entry to make room
+            QueuedEvent evicted;
+            if (try_pop(evicted)) {
+                if (policy == OverflowPolicy::COALESCE &&
+                    evicted.type == event.type) {
+                    coalesced.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
         }
+        dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+EventBus::EventBus() = default;
+
+EventBus::~EventBus() = default;
+
+void EventBus::emit(KernelEventType type, const nlohmann::json& data, uint32_t source_agent_id) {
+    auto snapshot = by_type_[static_cast<size_t>(type)].load(std::memory_order_acquire);
+    if (!snapshot || snapshot->empty()) {
+        return;
+    }
+
+    auto duration = std::chrono::steady_clock::now().time_since_epoch();
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+
+    nlohmann::json event_json;
+    event_json["type"] = kernel_event_type_to_string(type);
+    event_json["data"] = data;
+    event_json["source_agent_id"] = source_agent_id;
+    event_json["timestamp"] = millis;
+
+    auto text = std::make_shared<const std::string>(event_json.dump());
+    for (const auto& subscriber : *snapshot) {
+        subscriber->push(QueuedEvent{type, text});
+    }
+}
+
+void EventBus::emit_to(uint32_t agent_id, KernelEventType type,
+                       const nlohmann::json& data, uint32_t source_agent_id) {
+    auto subscriber = find(agent_id);
+    if (!subscriber) {
+        return;
     }
+
+    auto duration = std::chrono::steady_clock::now().time_since_epoch();
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+
+    nlohmann::json event_json;
+    event_json["type"] = kernel_event_type_to_string(type);
+    event_json["data"] = data;
+    event_json["source_agent_id"] = source_agent_id;
+    event_json["timestamp"] = millis;
+
+    subscriber->push(QueuedEvent{
+        type, std::make_shared<const std::string>(event_json.dump())});
 }
 
-void EventBus::subscribe(uint32_t agent_id, const std::vector<KernelEventType>& types) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto& subs = subscriptions_[agent_id];
+void EventBus::subscribe(uint32_t agent_id, const std::vector<KernelEventType>& types,
+                         size_t queue_size, OverflowPolicy policy) {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+
+    auto& subscriber = subscribers_[agent_id];
+    if (!subscriber) {
+        size_t capacity = queue_size == 0 ? DEFAULT_QUEUE_SIZE
+                                          : std::clamp(queue_size, MIN_QUEUE_SIZE,
+                                                       MAX_QUEUE_SIZE);
+        subscriber = std::make_shared<Subscriber>(capacity, policy);
+    }
+
+    uint32_t bits = 0;
     for (auto type : types) {
-        subs.insert(type);
+        bits |= mask_bit(type);
     }
+    subscriber->type_mask.fetch_or(bits, std::memory_order_relaxed);
+
+    rebuild_snapshots();
 }
 
 void EventBus::unsubscribe(uint32_t agent_id, const std::vector<KernelEventType>& types, bool unsubscribe_all) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (unsubscribe_all) {
-        subscriptions_.erase(agent_id);
-        return;
-    }
+    std::lock_guard<std::mutex> lock(registry_mutex_);
 
-    auto it = subscriptions_.find(agent_id);
-    if (it == subscriptions_.end()) {
+    auto it = subscribers_.find(agent_id);
+    if (it == subscribers_.end()) {
         return;
     }
 
-    for (auto type : types) {
-        it->second.erase(type);
+    if (unsubscribe_all) {
+        it->second->type_mask.store(0, std::memory_order_relaxed);
+    } else {
+        uint32_t bits = 0;
+        for (auto type : types) {
+            bits |= mask_bit(type);
+        }
+        it->second->type_mask.fetch_and(~bits, std::memory_order_relaxed);
     }
+
+    rebuild_snapshots();
 }
 
-nlohmann::json EventBus::poll(uint32_t agent_id, int max_events) {
-    std::lock_guard<std::mutex> lock(mutex_);
+EventBus::PollBatch EventBus::poll(uint32_t agent_id, int max_events) {
+    PollBatch batch;
 
-    nlohmann::json events_array = nlohmann::json::array();
-    auto it = queues_.find(agent_id);
-    if (it == queues_.end()) {
-        return events_array;
+    auto subscriber = find(agent_id);
+    if (!subscriber) {
+        return batch;
     }
 
-    auto& queue = it->second;
-    int count = 0;
+    // Reset the readiness signal before draining so a concurrent emit
+    // re-arms it rather than getting lost
+    if (subscriber->event_fd >= 0) {
+        uint64_t count = 0;
+        [[maybe_unused]] ssize_t n =
+            ::read(subscriber->event_fd, &count, sizeof(count));
+    }
+
+    // Concatenate the pre-serialized events into one batch buffer
+    std::string out;
+    out.reserve(512);
+    out.push_back('[');
+
+    QueuedEvent event;
+    while (batch.count < max_events && subscriber->try_pop(event)) {
+        if (batch.count > 0) {
+            out.push_back(',');
+        }
+        out.append(*event.text);
+        batch.count++;
+    }
+    out.push_back(']');
+    batch.events = std::move(out);
 
-    while (!queue.empty() && count < max_events) {
-        const auto& event = queue.front();
+    batch.dropped = subscriber->dropped.exchange(0, std::memory_order_relaxed);
+    batch.coalesced = subscriber->coalesced.exchange(0, std::memory_order_relaxed);
+    return batch;
+}
 
-        nlohmann::json event_json;
-        event_json["type"] = kernel_event_type_to_string(event.type);
-        event_json["data"] = event.data;
-        event_json["source_agent_id"] = event.source_agent_id;
+int EventBus::notify_fd(uint32_t agent_id) const {
+    auto subscriber = find(agent_id);
+    return subscriber ? subscriber->event_fd : -1;
+}
 
-        auto duration = event.timestamp.time_since_epoch();
-        auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
-        event_json["timestamp"] = millis;
+nlohmann::json EventBus::export_subscriptions() const {
+    nlohmann::json subs = nlohmann::json::array();
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    for (const auto& [agent_id, subscriber] : subscribers_) {
+        uint32_t mask = subscriber->type_mask.load(std::memory_order_relaxed);
+        if (mask == 0) {
+            continue;  // fully unsubscribed, nothing to restore
+        }
+        subs.push_back({
+            {"agent_id", agent_id},
+            {"type_mask", mask},
+            {"queue_size", subscriber->cells.size()},
+            {"policy", static_cast<int>(subscriber->policy)},
+        });
+    }
+    return subs;
+}
 
-        events_array.push_back(event_json);
-        queue.pop();
-        count++;
+void EventBus::import_subscriptions(const nlohmann::json& subs) {
+    for (const auto& sub : subs) {
+        uint32_t mask = sub.value("type_mask", 0u);
+        std::vector<KernelEventType> types;
+        for (size_t i = 0; i < NUM_EVENT_TYPES; ++i) {
+            if (mask & (1u << i)) {
+                types.push_back(static_cast<KernelEventType>(i));
+            }
+        }
+        subscribe(sub.value("agent_id", 0u), types,
+                  sub.value("queue_size", static_cast<size_t>(0)),
+                  static_cast<OverflowPolicy>(sub.value("policy", 0)));
     }
+}
 
-    return events_array;
+std::shared_ptr<EventBus::Subscriber> EventBus::find(uint32_t agent_id) const {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    auto it = subscribers_.find(agent_id);
+    return it == subscribers_.end() ? nullptr : it->second;
+}
+
+void EventBus::rebuild_snapshots() {
+    for (size_t type = 0; type < NUM_EVENT_TYPES; ++type) {
+        const uint32_t bit = 1u << type;
+        auto snapshot = std::make_shared<Snapshot>();
+        for (const auto& [agent_id, subscriber] : subscribers_) {
+            if (subscriber->type_mask.load(std::memory_order_relaxed) & bit) {
+                snapshot->push_back(subscriber);
+            }
+        }
+        by_type_[type].store(std::move(snapshot), std::memory_order_release);
+    }
 }
 
 } // namespace clove::kernel
@@ -1,7 +1,8 @@
 #pragma once
+#include <array>
+#include <atomic>
 #include <cstdint>
-#include <queue>
-#include <set>
+#include <memory>
 #include <unordered_map>
 #include <mutex>
 #include <chrono>
@@ -26,14 +27,6 @@ enum class KernelEventType {
     CUSTOM              // User-defined event
 };
 
-// Kernel event
-struct KernelEvent {
-    KernelEventType type;
-    nlohmann::json data;
-    std::chrono::steady_clock::time_point timestamp;
-    uint32_t source_agent_id;  // 0 = kernel
-};
-
 // Convert KernelEventType to string
 inline std::string kernel_event_type_to_string(KernelEventType type) {
     switch (type) {
@@ -67,17 +60,84 @@ inline KernelEventType kernel_event_type_from_string(const std::string& str) {
     return KernelEventType::CUSTOM;
 }
 
+// Number of KernelEventType values (CUSTOM is last)
+inline constexpr size_t NUM_EVENT_TYPES = static_cast<size_t>(KernelEventType::CUSTOM) + 1;
+
+// What a full subscriber queue does with new events
+enum class OverflowPolicy {
+    DROP_NEWEST,    // incoming event is dropped (default)
+    DROP_OLDEST,    // oldest queued event is evicted to make room
+    COALESCE        // like DROP_OLDEST, but an evicted event of the same
+                    // type counts as merged into the incoming one
+};
+
+// Pub/sub bus with lock-free delivery and bounded per-subscriber queues.
+//
+// Each subscriber owns a fixed-capacity MPMC ring (Vyukov bounded
+// queue): any thread may emit, while poll() for a given agent always
+// runs on the thread owning that agent's connection. The ring bounds
+// memory per subscriber — a paused agent can no longer accumulate
+// events without limit; overflow behaviour is chosen at subscribe time.
+// emit() takes no lock: it serializes the event JSON once, then walks an
+// immutable per-event-type snapshot of exactly the interested
+// subscribers (swapped copy-on-write by subscribe/unsubscribe), pushing
+// a refcounted pointer to the shared text. poll() therefore returns a
+// ready-to-send batch assembled by concatenation, never re-serializing
+// events element-by-element. Each subscriber also has an eventfd that
+// is signalled on enqueue, so the SDK can epoll-wait on event arrival
+// instead of polling on an interval.
 class EventBus {
 public:
+    // Drained events, pre-serialized: `events` is a complete JSON array
+    struct PollBatch {
+        std::string events = "[]";
+        int count = 0;
+        uint64_t dropped = 0;    // evicted/refused since the last poll
+        uint64_t coalesced = 0;  // merged same-type events since the last poll
+    };
+
+    EventBus();
+    ~EventBus();
+
     void emit(KernelEventType type, const nlohmann::json& data, uint32_t source_agent_id);
-    void subscribe(uint32_t agent_id, const std::vector<KernelEventType>& types);
+    // Targeted delivery to one agent's queue (key-watch pushes), landing
+    // regardless of the agent's broadcast type subscriptions. No-op if
+    // the agent has no subscriber queue.
+    void emit_to(uint32_t agent_id, KernelEventType type, const nlohmann::json& data,
+                 uint32_t source_agent_id);
+    // queue_size/policy take effect when the subscriber is first created
+    void subscribe(uint32_t agent_id, const std::vector<KernelEventType>& types,
+                   size_t queue_size = 0,
+                   OverflowPolicy policy = OverflowPolicy::DROP_NEWEST);
     void unsubscribe(uint32_t agent_id, const std::vector<KernelEventType>& types, bool unsubscribe_all);
-    nlohmann::json poll(uint32_t agent_id, int max_events);
+    PollBatch poll(uint32_t agent_id, int max_events);
+
+    // eventfd signalled whenever an event lands on this agent's queue;
+    // -1 if the agent never subscribed. The bus keeps ownership — the
+    // caller dups or SCM_RIGHTS-transfers it but never closes it.
+    int notify_fd(uint32_t agent_id) const;
+
+    // Checkpoint support: subscription registrations only. Queued
+    // events are in-flight state and are not carried across a restart.
+    nlohmann::json export_subscriptions() const;
+    void import_subscriptions(const nlohmann::json& subs);
 
 private:
-    std::unordered_map<uint32_t, std::set<KernelEventType>> subscriptions_;
-    std::unordered_map<uint32_t, std::queue<KernelEvent>> queues_;
-    std::mutex mutex_;
+    struct Subscriber;
+    using Snapshot = std::vector<std::shared_ptr<Subscriber>>;
+
+    static constexpr size_t DEFAULT_QUEUE_SIZE = 4096;
+    static constexpr size_t MIN_QUEUE_SIZE = 64;
+    static constexpr size_t MAX_QUEUE_SIZE = 65536;
+
+    std::shared_ptr<Subscriber> find(uint32_t agent_id) const;
+    void rebuild_snapshots();               // callers hold registry_mutex_
+
+    mutable std::mutex registry_mutex_;
+    std::unordered_map<uint32_t, std::shared_ptr<Subscriber>> subscribers_;
+    // One immutable subscriber list per event type, rebuilt on any
+    // subscription change (rare) so emit (hot) walks only real takers
+    std::array<std::atomic<std::shared_ptr<const Snapshot>>, NUM_EVENT_TYPES> by_type_;
 };
 
 } // namespace clove::kernel
@@ -1,4 +1,5 @@
 #include "kernel/execution_log.hpp"
+#include "kernel/execution_segments.hpp"
 #include "ipc/protocol.hpp"
 #include <spdlog/spdlog.h>
 #include <iomanip>
@@ -82,6 +83,24 @@ ExecutionLogger::ExecutionLogger(const RecordingConfig& config) : config_(config
     spdlog::debug("ExecutionLogger initialized (max_entries={})", config_.max_entries);
 }
 
+ExecutionLogger::~ExecutionLogger() = default;
+
+bool ExecutionLogger::enable_disk_recording(const std::string& dir) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto segments = std::make_unique<ExecutionSegmentLog>(dir);
+    if (!segments->open()) {
+        return false;
+    }
+
+    // Resume the sequence after whatever the last run left on disk
+    next_sequence_id_ = segments->last_sequence() + 1;
+    segments_ = std::move(segments);
+    spdlog::info("Execution log persisting to {} ({} entries on disk)",
+                 dir, segments_->entry_count());
+    return true;
+}
+
 bool ExecutionLogger::start_recording() {
     std::lock_guard<std::mutex> lock(mutex_);
 
@@ -90,8 +109,9 @@ bool ExecutionLogger::start_recording() {
         return false;
     }
 
-    // Clear previous entries if starting fresh
-    if (recording_state_ == RecordingState::IDLE) {
+    // Clear previous entries if starting fresh. The disk backend keeps
+    // accumulating across sessions — that history is the point.
+    if (recording_state_ == RecordingState::IDLE && !segments_) {
         entries_.clear();
         next_sequence_id_ = 1;
     }
@@ -110,7 +130,13 @@ bool ExecutionLogger::stop_recording() {
     }
 
     recording_state_ = RecordingState::IDLE;
-    spdlog::info("Execution recording stopped ({} entries)", entries_.size());
+    if (segments_) {
+        segments_->flush();  // make the session durable before reporting done
+        spdlog::info("Execution recording stopped ({} entries on disk)",
+                     segments_->entry_count());
+    } else {
+        spdlog::info("Execution recording stopped ({} entries)", entries_.size());
+    }
     return true;
 }
 
@@ -179,14 +205,15 @@ void ExecutionLogger::log_syscall(uint32_t agent_id, uint8_t opcode,
                                   const std::string& payload,
                                   const std::string& response,
                                   uint64_t duration_us, bool success) {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    // Check if we're recording
-    if (recording_state_ != RecordingState::RECORDING) {
+    // Cheap rejections first, no lock: the common case on the syscall
+    // path is "not recording"
+    if (recording_state_.load(std::memory_order_relaxed) != RecordingState::RECORDING) {
         return;
     }
 
-    // Check if this syscall should be recorded
+    // Check if this syscall should be recorded. config_ is effectively
+    // read-only while a recording session runs (SYS_RECORD_START sets
+    // it before flipping the state).
     if (!should_record(opcode)) {
         return;
     }
@@ -206,7 +233,7 @@ void ExecutionLogger::log_syscall(uint32_t agent_id, uint8_t opcode,
     }
 
     ExecutionLogEntry entry;
-    entry.sequence_id = next_sequence_id_++;
+    entry.sequence_id = next_sequence_id_.fetch_add(1, std::memory_order_relaxed);
     entry.timestamp = std::chrono::system_clock::now();
     entry.agent_id = agent_id;
     entry.opcode = opcode;
@@ -215,19 +242,34 @@ void ExecutionLogger::log_syscall(uint32_t agent_id, uint8_t opcode,
     entry.duration_us = duration_us;
     entry.success = success;
 
-    entries_.push_back(entry);
-    trim_entries();
-
     spdlog::trace("Recorded syscall: seq={} agent={} opcode={}",
                   entry.sequence_id, agent_id, ipc::opcode_to_string(static_cast<ipc::SyscallOp>(opcode)));
+
+    if (segments_) {
+        // Disk backend: one enqueue, the flusher thread does the rest
+        segments_->append(std::move(entry));
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.push_back(std::move(entry));
+    trim_entries();
 }
 
 std::vector<ExecutionLogEntry> ExecutionLogger::get_entries(
     uint64_t start_sequence, size_t limit) const {
 
-    std::lock_guard<std::mutex> lock(mutex_);
     std::vector<ExecutionLogEntry> result;
 
+    if (segments_) {
+        segments_->scan_from(start_sequence, [&](const ExecutionLogEntry& entry) {
+            result.push_back(entry);
+            return result.size() < limit;
+        });
+        return result;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
     for (const auto& entry : entries_) {
         if (entry.sequence_id > start_sequence) {
             result.push_back(entry);
@@ -243,6 +285,10 @@ std::vector<ExecutionLogEntry> ExecutionLogger::get_entries(
 std::vector<ExecutionLogEntry> ExecutionLogger::get_entries_for_agent(
     uint32_t agent_id, size_t limit) const {
 
+    if (segments_) {
+        return segments_->agent_tail(agent_id, limit);
+    }
+
     std::lock_guard<std::mutex> lock(mutex_);
     std::vector<ExecutionLogEntry> result;
 
@@ -256,10 +302,46 @@ std::vector<ExecutionLogEntry> ExecutionLogger::get_entries_for_agent(
     return result;
 }
 
-std::string ExecutionLogger::export_recording() const {
+std::vector<ExecutionLogEntry> ExecutionLogger::get_entries_in_range(
+    int64_t from_wall_ms, int64_t to_wall_ms, size_t limit) const {
+
+    std::vector<ExecutionLogEntry> result;
+
+    if (segments_) {
+        segments_->scan_time_range(from_wall_ms, to_wall_ms,
+            [&](const ExecutionLogEntry& entry) {
+                result.push_back(entry);
+                return result.size() < limit;
+            });
+        return result;
+    }
+
     std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& entry : entries_) {
+        int64_t ts = std::chrono::duration_cast<std::chrono::milliseconds>(
+            entry.timestamp.time_since_epoch()).count();
+        if (ts >= from_wall_ms && ts <= to_wall_ms) {
+            result.push_back(entry);
+            if (result.size() >= limit) {
+                break;
+            }
+        }
+    }
+    return result;
+}
 
+std::string ExecutionLogger::export_recording() const {
     json arr = json::array();
+
+    if (segments_) {
+        segments_->scan([&](const ExecutionLogEntry& entry) {
+            arr.push_back(entry.to_json());
+            return true;
+        });
+        return arr.dump();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
     for (const auto& entry : entries_) {
         arr.push_back(entry.to_json());
     }
@@ -405,6 +487,11 @@ void ExecutionLogger::advance_replay(bool skipped) {
     }
 }
 
+std::vector<ExecutionLogEntry> ExecutionLogger::replay_entries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return replay_entries_;
+}
+
 void ExecutionLogger::set_config(const RecordingConfig& config) {
     std::lock_guard<std::mutex> lock(mutex_);
     config_ = config;
@@ -416,6 +503,9 @@ void ExecutionLogger::clear() {
     std::lock_guard<std::mutex> lock(mutex_);
     entries_.clear();
     replay_entries_.clear();
+    if (segments_) {
+        segments_->reset();
+    }
     next_sequence_id_ = 1;
     recording_state_ = RecordingState::IDLE;
     replay_state_ = ReplayState::IDLE;
@@ -423,13 +513,15 @@ void ExecutionLogger::clear() {
 }
 
 size_t ExecutionLogger::entry_count() const {
+    if (segments_) {
+        return segments_->entry_count();
+    }
     std::lock_guard<std::mutex> lock(mutex_);
     return entries_.size();
 }
 
 uint64_t ExecutionLogger::last_sequence_id() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return next_sequence_id_ - 1;
+    return next_sequence_id_.load(std::memory_order_relaxed) - 1;
 }
 
 void ExecutionLogger::trim_entries() {
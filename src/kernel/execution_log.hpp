@@ -5,9 +5,11 @@
  * Supports recording, checkpointing, and playback of agent activities.
  */
 #pragma once
+#include <atomic>
 #include <string>
 #include <vector>
 #include <deque>
+#include <memory>
 #include <mutex>
 #include <chrono>
 #include <cstdint>
@@ -15,6 +17,8 @@
 
 namespace clove::kernel {
 
+class ExecutionSegmentLog;
+
 // Execution log entry for recording syscalls
 struct ExecutionLogEntry {
     uint64_t sequence_id;                       // Monotonic sequence number
@@ -73,7 +77,14 @@ class ExecutionLogger {
 public:
     ExecutionLogger();
     explicit ExecutionLogger(const RecordingConfig& config);
-    ~ExecutionLogger() = default;
+    ~ExecutionLogger();
+
+    // Switch to the on-disk segment backend: entries go to mmap'd
+    // binary segments in `dir` via a background flusher instead of the
+    // capped in-memory deque, so recording is no longer bounded by
+    // max_entries and survives kernel crashes. log_syscall becomes a
+    // single queue push. Queries read back from the segments.
+    bool enable_disk_recording(const std::string& dir);
 
     // Recording control
     bool start_recording();
@@ -98,6 +109,15 @@ public:
         size_t limit = 100
     ) const;
 
+    // Entries whose timestamps fall within [from_wall_ms, to_wall_ms]
+    // (milliseconds since epoch); seeks via the segment index when the
+    // disk backend is active
+    std::vector<ExecutionLogEntry> get_entries_in_range(
+        int64_t from_wall_ms,
+        int64_t to_wall_ms,
+        size_t limit = 100
+    ) const;
+
     // Export recorded session
     std::string export_recording() const;   // Returns JSON array
 
@@ -117,6 +137,9 @@ public:
     // Mark current entry as replayed
     void advance_replay(bool skipped = false);
 
+    // Copy of the imported entries for the active replay
+    std::vector<ExecutionLogEntry> replay_entries() const;
+
     // Configuration
     void set_config(const RecordingConfig& config);
     const RecordingConfig& get_config() const { return config_; }
@@ -133,9 +156,13 @@ private:
     std::deque<ExecutionLogEntry> entries_;
     mutable std::mutex mutex_;
 
-    // Recording state
-    RecordingState recording_state_ = RecordingState::IDLE;
-    uint64_t next_sequence_id_ = 1;
+    // Disk backend (null = in-memory deque only)
+    std::unique_ptr<ExecutionSegmentLog> segments_;
+
+    // Recording state. Atomic so the hot path can check and sequence
+    // without touching mutex_ when the disk backend is active.
+    std::atomic<RecordingState> recording_state_{RecordingState::IDLE};
+    std::atomic<uint64_t> next_sequence_id_{1};
 
     // Replay state
     std::vector<ExecutionLogEntry> replay_entries_;  // Imported entries
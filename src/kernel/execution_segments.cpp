@@ -0,0 +1,600 @@
+#include "kernel/execution_segments.hpp"
+#include "kernel/thread_placement.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace clove::kernel {
+
+namespace {
+
+constexpr uint32_t SEGMENT_MAGIC = 0x4C584543;  // "CEXL"
+constexpr uint32_t SEGMENT_VERSION = 1;
+constexpr size_t HEADER_BYTES = 16;  // magic, version, committed
+
+// Fixed record fields after the u32 length prefix
+struct RecordHeader {
+    uint64_t sequence_id;
+    int64_t ts_wall_ms;
+    uint64_t duration_us;
+    uint32_t agent_id;
+    uint8_t opcode;
+    uint8_t success;
+    uint16_t reserved;
+    uint32_t payload_len;
+    uint32_t response_len;
+} __attribute__((packed));
+
+static_assert(sizeof(RecordHeader) == 40, "record header layout is on disk");
+
+int64_t to_wall_ms(std::chrono::system_clock::time_point tp) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        tp.time_since_epoch()).count();
+}
+
+std::string segment_name(uint64_t first_sequence) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "exec-%020llu.seg",
+             static_cast<unsigned long long>(first_sequence));
+    return buf;
+}
+
+uint64_t read_committed(const uint8_t* base, size_t size) {
+    if (size < HEADER_BYTES) {
+        return 0;
+    }
+    uint32_t magic, version;
+    uint64_t committed;
+    std::memcpy(&magic, base, sizeof(magic));
+    std::memcpy(&version, base + 4, sizeof(version));
+    std::memcpy(&committed, base + 8, sizeof(committed));
+    if (magic != SEGMENT_MAGIC || version != SEGMENT_VERSION) {
+        return 0;
+    }
+    return std::min<uint64_t>(committed, size - HEADER_BYTES);
+}
+
+// Read-only view of a segment file
+struct MappedSegment {
+    const uint8_t* base = nullptr;  // file start
+    size_t size = 0;
+
+    bool open(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(HEADER_BYTES)) {
+            ::close(fd);
+            return false;
+        }
+        size = static_cast<size_t>(st.st_size);
+        void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            return false;
+        }
+        base = static_cast<const uint8_t*>(mapped);
+        return true;
+    }
+
+    ~MappedSegment() {
+        if (base) {
+            munmap(const_cast<uint8_t*>(base), size);
+        }
+    }
+};
+
+// Decode one record at `offset` (relative to the record area); returns
+// false on a torn or corrupt tail. Advances next to the following record.
+bool decode_at(const uint8_t* base, uint64_t committed, uint64_t offset,
+               ExecutionLogEntry& out, uint64_t& next) {
+    if (offset + sizeof(uint32_t) + sizeof(RecordHeader) > committed) {
+        return false;
+    }
+    const uint8_t* rec = base + HEADER_BYTES + offset;
+
+    uint32_t record_len;
+    std::memcpy(&record_len, rec, sizeof(record_len));
+    if (record_len < sizeof(RecordHeader) ||
+        offset + sizeof(uint32_t) + record_len > committed) {
+        return false;
+    }
+
+    RecordHeader header;
+    std::memcpy(&header, rec + sizeof(uint32_t), sizeof(header));
+    if (sizeof(header) + header.payload_len + header.response_len != record_len) {
+        return false;
+    }
+
+    out.sequence_id = header.sequence_id;
+    out.timestamp = std::chrono::system_clock::time_point(
+        std::chrono::milliseconds(header.ts_wall_ms));
+    out.agent_id = header.agent_id;
+    out.opcode = header.opcode;
+    out.duration_us = header.duration_us;
+    out.success = header.success != 0;
+    const char* body = reinterpret_cast<const char*>(rec + sizeof(uint32_t) + sizeof(header));
+    out.payload.assign(body, header.payload_len);
+    out.response.assign(body + header.payload_len, header.response_len);
+
+    next = offset + sizeof(uint32_t) + record_len;
+    return true;
+}
+
+} // namespace
+
+ExecutionSegmentLog::ExecutionSegmentLog(std::string dir, size_t segment_bytes)
+    : dir_(std::move(dir)),
+      segment_bytes_(std::max<size_t>(segment_bytes, 1024 * 1024)) {}
+
+ExecutionSegmentLog::~ExecutionSegmentLog() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        stopping_ = true;
+    }
+    queue_cv_.notify_one();
+    if (flusher_.joinable()) {
+        flusher_.join();
+    }
+    finalize_segment();
+}
+
+bool ExecutionSegmentLog::open() {
+    if (mkdir(dir_.c_str(), 0755) != 0 && errno != EEXIST) {
+        spdlog::error("ExecutionSegmentLog: cannot create {}: {}", dir_, strerror(errno));
+        return false;
+    }
+
+    // Recover existing segments: rebuild the sparse index and posting
+    // lists and find the tail sequence so recording resumes where the
+    // last run stopped
+    DIR* dp = opendir(dir_.c_str());
+    if (dp) {
+        std::vector<std::string> names;
+        while (dirent* de = readdir(dp)) {
+            std::string name = de->d_name;
+            if (name.rfind("exec-", 0) == 0 && name.size() > 4 &&
+                name.compare(name.size() - 4, 4, ".seg") == 0) {
+                names.push_back(name);
+            }
+        }
+        closedir(dp);
+        std::sort(names.begin(), names.end());
+
+        for (const auto& name : names) {
+            std::string path = dir_ + "/" + name;
+            MappedSegment mapped;
+            if (!mapped.open(path)) {
+                continue;
+            }
+            uint64_t committed = read_committed(mapped.base, mapped.size);
+
+            uint32_t segment = static_cast<uint32_t>(metas_.size());
+            metas_.push_back(SegmentMeta{path});
+
+            ExecutionLogEntry entry;
+            uint64_t offset = 0, next = 0;
+            while (decode_at(mapped.base, committed, offset, entry, next)) {
+                index_record(segment, entry, offset);
+                entry_count_.fetch_add(1, std::memory_order_relaxed);
+                if (entry.sequence_id > last_sequence_) {
+                    last_sequence_ = entry.sequence_id;
+                }
+                offset = next;
+            }
+        }
+        if (entry_count_ > 0) {
+            spdlog::info("ExecutionSegmentLog: recovered {} entries in {} segments",
+                         entry_count_.load(), metas_.size());
+        }
+    }
+
+    flusher_ = std::thread([this] { flusher_loop(); });
+    return true;
+}
+
+void ExecutionSegmentLog::append(ExecutionLogEntry entry) {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        queue_.push_back(std::move(entry));
+        flusher_idle_ = false;
+    }
+    queue_cv_.notify_one();
+}
+
+void ExecutionSegmentLog::flush() {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    flushed_cv_.wait(lock, [this] { return queue_.empty() && flusher_idle_; });
+    std::lock_guard<std::mutex> seg_lock(segments_mutex_);
+    if (active_ && active_->base) {
+        msync(active_->base, HEADER_BYTES + active_->committed.load(), MS_SYNC);
+    }
+}
+
+void ExecutionSegmentLog::reset() {
+    flush();
+    std::lock_guard<std::mutex> lock(segments_mutex_);
+    if (active_) {
+        std::string path = active_->path;
+        if (active_->base) {
+            munmap(active_->base, active_->mapped);
+        }
+        if (active_->fd >= 0) {
+            ::close(active_->fd);
+        }
+        active_.reset();
+        ::unlink(path.c_str());
+        metas_.pop_back();
+    }
+    for (const auto& meta : metas_) {
+        ::unlink(meta.path.c_str());
+    }
+    metas_.clear();
+    agent_postings_.clear();
+    entry_count_ = 0;
+    last_sequence_ = 0;
+}
+
+void ExecutionSegmentLog::flusher_loop() {
+    placement::pin_current(placement::ThreadClass::BACKGROUND);
+
+    std::deque<ExecutionLogEntry> batch;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_cv_.wait(lock, [this] { return !queue_.empty() || stopping_; });
+            if (queue_.empty() && stopping_) {
+                return;
+            }
+            batch.swap(queue_);
+        }
+
+        write_batch(batch);
+        batch.clear();
+
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            if (queue_.empty()) {
+                flusher_idle_ = true;
+            }
+        }
+        flushed_cv_.notify_all();
+    }
+}
+
+void ExecutionSegmentLog::index_record(uint32_t segment,
+                                       const ExecutionLogEntry& entry,
+                                       uint64_t offset) {
+    // Caller holds segments_mutex_ (or is open() before the flusher starts)
+    SegmentMeta& meta = metas_[segment];
+    if (meta.record_count == 0) {
+        meta.first_sequence = entry.sequence_id;
+    }
+    if (meta.record_count % SPARSE_EVERY == 0) {
+        meta.sparse.push_back(SegmentMeta::SparseEntry{
+            entry.sequence_id, to_wall_ms(entry.timestamp), offset});
+    }
+    meta.record_count++;
+    agent_postings_[entry.agent_id].push_back(Posting{segment, offset});
+}
+
+void ExecutionSegmentLog::write_batch(std::deque<ExecutionLogEntry>& batch) {
+    for (auto& entry : batch) {
+        size_t record_bytes = sizeof(uint32_t) + sizeof(RecordHeader) +
+                              entry.payload.size() + entry.response.size();
+
+        if (record_bytes > segment_bytes_ - HEADER_BYTES) {
+            spdlog::warn("ExecutionSegmentLog: dropping oversized record (seq={}, {} bytes)",
+                         entry.sequence_id, record_bytes);
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(segments_mutex_);
+        if (active_ &&
+            HEADER_BYTES + active_->committed.load() + record_bytes > active_->mapped) {
+            finalize_segment();
+        }
+        if (!active_ && !open_segment(entry.sequence_id)) {
+            return;  // disk trouble; drop the batch rather than spin
+        }
+
+        uint64_t offset = active_->committed.load(std::memory_order_relaxed);
+        uint8_t* dst = active_->base + HEADER_BYTES + offset;
+
+        uint32_t record_len = static_cast<uint32_t>(record_bytes - sizeof(uint32_t));
+        RecordHeader header{};
+        header.sequence_id = entry.sequence_id;
+        header.ts_wall_ms = to_wall_ms(entry.timestamp);
+        header.duration_us = entry.duration_us;
+        header.agent_id = entry.agent_id;
+        header.opcode = entry.opcode;
+        header.success = entry.success ? 1 : 0;
+        header.payload_len = static_cast<uint32_t>(entry.payload.size());
+        header.response_len = static_cast<uint32_t>(entry.response.size());
+
+        std::memcpy(dst, &record_len, sizeof(record_len));
+        std::memcpy(dst + sizeof(record_len), &header, sizeof(header));
+        std::memcpy(dst + sizeof(record_len) + sizeof(header),
+                    entry.payload.data(), entry.payload.size());
+        std::memcpy(dst + sizeof(record_len) + sizeof(header) + entry.payload.size(),
+                    entry.response.data(), entry.response.size());
+
+        // Publish: data first, then the committed counter readers trust
+        uint64_t committed = offset + record_bytes;
+        active_->committed.store(committed, std::memory_order_release);
+        std::memcpy(active_->base + 8, &committed, sizeof(committed));
+
+        index_record(static_cast<uint32_t>(metas_.size() - 1), entry, offset);
+        entry_count_.fetch_add(1, std::memory_order_relaxed);
+        last_sequence_.store(entry.sequence_id, std::memory_order_relaxed);
+    }
+
+    // Background flush: let the kernel write pages out without
+    // stalling the flusher; a crash loses at most this batch
+    std::lock_guard<std::mutex> lock(segments_mutex_);
+    if (active_ && active_->base) {
+        msync(active_->base, HEADER_BYTES + active_->committed.load(), MS_ASYNC);
+    }
+}
+
+bool ExecutionSegmentLog::open_segment(uint64_t first_sequence) {
+    // Caller holds segments_mutex_
+    auto segment = std::make_unique<Segment>();
+    segment->path = dir_ + "/" + segment_name(first_sequence);
+
+    segment->fd = ::open(segment->path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (segment->fd < 0) {
+        spdlog::error("ExecutionSegmentLog: cannot open {}: {}",
+                      segment->path, strerror(errno));
+        return false;
+    }
+    if (ftruncate(segment->fd, static_cast<off_t>(segment_bytes_)) != 0) {
+        spdlog::error("ExecutionSegmentLog: cannot size {}: {}",
+                      segment->path, strerror(errno));
+        ::close(segment->fd);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, segment_bytes_, PROT_READ | PROT_WRITE,
+                        MAP_SHARED, segment->fd, 0);
+    if (mapped == MAP_FAILED) {
+        spdlog::error("ExecutionSegmentLog: mmap of {} failed: {}",
+                      segment->path, strerror(errno));
+        ::close(segment->fd);
+        return false;
+    }
+
+    segment->base = static_cast<uint8_t*>(mapped);
+    segment->mapped = segment_bytes_;
+    std::memcpy(segment->base, &SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC));
+    std::memcpy(segment->base + 4, &SEGMENT_VERSION, sizeof(SEGMENT_VERSION));
+    uint64_t zero = 0;
+    std::memcpy(segment->base + 8, &zero, sizeof(zero));
+
+    metas_.push_back(SegmentMeta{segment->path});
+    active_ = std::move(segment);
+    return true;
+}
+
+void ExecutionSegmentLog::finalize_segment() {
+    // Caller holds segments_mutex_ (or is the destructor after the
+    // flusher has stopped)
+    if (!active_) {
+        return;
+    }
+    uint64_t committed = active_->committed.load();
+    if (active_->base) {
+        msync(active_->base, HEADER_BYTES + committed, MS_SYNC);
+        munmap(active_->base, active_->mapped);
+    }
+    if (active_->fd >= 0) {
+        // Shrink the preallocated segment to its used size
+        if (ftruncate(active_->fd, static_cast<off_t>(HEADER_BYTES + committed)) != 0) {
+            spdlog::warn("ExecutionSegmentLog: ftruncate of {} failed: {}",
+                         active_->path, strerror(errno));
+        }
+        ::close(active_->fd);
+    }
+    active_.reset();
+}
+
+std::pair<std::string, uint64_t> ExecutionSegmentLog::segment_extent(size_t index) const {
+    std::lock_guard<std::mutex> lock(segments_mutex_);
+    if (index >= metas_.size()) {
+        return {"", 0};
+    }
+    if (active_ && index == metas_.size() - 1) {
+        return {active_->path, active_->committed.load(std::memory_order_acquire)};
+    }
+    // Finalized segment: trust its on-disk committed header
+    return {metas_[index].path, UINT64_MAX};
+}
+
+bool ExecutionSegmentLog::scan_segment(
+    size_t index, uint64_t offset, uint64_t limit_bytes,
+    const std::function<bool(const ExecutionLogEntry&, uint64_t)>& cb) const {
+
+    auto [path, extent] = segment_extent(index);
+    if (path.empty()) {
+        return true;
+    }
+
+    MappedSegment mapped;
+    if (!mapped.open(path)) {
+        return true;
+    }
+    uint64_t committed = std::min<uint64_t>(read_committed(mapped.base, mapped.size),
+                                            std::min(extent, limit_bytes));
+
+    ExecutionLogEntry entry;
+    uint64_t next = 0;
+    while (decode_at(mapped.base, committed, offset, entry, next)) {
+        if (!cb(entry, offset)) {
+            return false;
+        }
+        offset = next;
+    }
+    return true;
+}
+
+void ExecutionSegmentLog::scan(
+    const std::function<bool(const ExecutionLogEntry&)>& cb) const {
+    size_t count;
+    {
+        std::lock_guard<std::mutex> lock(segments_mutex_);
+        count = metas_.size();
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (!scan_segment(i, 0, UINT64_MAX,
+                          [&](const ExecutionLogEntry& e, uint64_t) { return cb(e); })) {
+            return;
+        }
+    }
+}
+
+void ExecutionSegmentLog::scan_from(
+    uint64_t start_sequence,
+    const std::function<bool(const ExecutionLogEntry&)>& cb) const {
+
+    size_t count, start_segment = 0;
+    uint64_t start_offset = 0;
+    {
+        std::lock_guard<std::mutex> lock(segments_mutex_);
+        count = metas_.size();
+        if (count == 0) {
+            return;
+        }
+
+        // Last segment whose first sequence is at or below the target
+        for (size_t i = count; i-- > 0;) {
+            if (metas_[i].record_count > 0 &&
+                metas_[i].first_sequence <= start_sequence + 1) {
+                start_segment = i;
+                break;
+            }
+        }
+
+        // Sparse seek within it: greatest indexed sequence <= target
+        const auto& sparse = metas_[start_segment].sparse;
+        auto it = std::upper_bound(sparse.begin(), sparse.end(), start_sequence,
+            [](uint64_t seq, const SegmentMeta::SparseEntry& e) {
+                return seq < e.sequence;
+            });
+        if (it != sparse.begin()) {
+            start_offset = std::prev(it)->offset;
+        }
+    }
+
+    for (size_t i = start_segment; i < count; ++i) {
+        bool keep_going = scan_segment(i, i == start_segment ? start_offset : 0,
+                                       UINT64_MAX,
+            [&](const ExecutionLogEntry& entry, uint64_t) {
+                if (entry.sequence_id <= start_sequence) {
+                    return true;  // records before the sparse checkpoint's gap
+                }
+                return cb(entry);
+            });
+        if (!keep_going) {
+            return;
+        }
+    }
+}
+
+void ExecutionSegmentLog::scan_time_range(
+    int64_t from_ms, int64_t to_ms,
+    const std::function<bool(const ExecutionLogEntry&)>& cb) const {
+
+    size_t count, start_segment = 0;
+    uint64_t start_offset = 0;
+    {
+        std::lock_guard<std::mutex> lock(segments_mutex_);
+        count = metas_.size();
+        if (count == 0) {
+            return;
+        }
+
+        for (size_t i = count; i-- > 0;) {
+            if (!metas_[i].sparse.empty() &&
+                metas_[i].sparse.front().ts_wall_ms <= from_ms) {
+                start_segment = i;
+                break;
+            }
+        }
+
+        const auto& sparse = metas_[start_segment].sparse;
+        auto it = std::upper_bound(sparse.begin(), sparse.end(), from_ms,
+            [](int64_t ts, const SegmentMeta::SparseEntry& e) {
+                return ts < e.ts_wall_ms;
+            });
+        if (it != sparse.begin()) {
+            start_offset = std::prev(it)->offset;
+        }
+    }
+
+    for (size_t i = start_segment; i < count; ++i) {
+        bool keep_going = scan_segment(i, i == start_segment ? start_offset : 0,
+                                       UINT64_MAX,
+            [&](const ExecutionLogEntry& entry, uint64_t) {
+                int64_t ts = to_wall_ms(entry.timestamp);
+                if (ts < from_ms) {
+                    return true;
+                }
+                if (ts > to_ms) {
+                    return false;  // timestamps are write-ordered; done
+                }
+                return cb(entry);
+            });
+        if (!keep_going) {
+            return;
+        }
+    }
+}
+
+std::vector<ExecutionLogEntry> ExecutionSegmentLog::agent_tail(
+    uint32_t agent_id, size_t limit) const {
+
+    std::vector<Posting> tail;
+    {
+        std::lock_guard<std::mutex> lock(segments_mutex_);
+        auto it = agent_postings_.find(agent_id);
+        if (it == agent_postings_.end() || it->second.empty()) {
+            return {};
+        }
+        const auto& postings = it->second;
+        size_t n = std::min(limit, postings.size());
+        tail.assign(postings.end() - n, postings.end());
+    }
+
+    // Postings are in write order, so each segment is visited once
+    std::vector<ExecutionLogEntry> result;
+    result.reserve(tail.size());
+    size_t i = 0;
+    while (i < tail.size()) {
+        uint32_t segment = tail[i].segment;
+        auto [path, extent] = segment_extent(segment);
+        MappedSegment mapped;
+        if (path.empty() || !mapped.open(path)) {
+            while (i < tail.size() && tail[i].segment == segment) i++;
+            continue;
+        }
+        uint64_t committed = std::min(read_committed(mapped.base, mapped.size), extent);
+
+        for (; i < tail.size() && tail[i].segment == segment; ++i) {
+            ExecutionLogEntry entry;
+            uint64_t next = 0;
+            if (decode_at(mapped.base, committed, tail[i].offset, entry, next)) {
+                result.push_back(std::move(entry));
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace clove::kernel
@@ -0,0 +1,150 @@
+/**
+ * Clove Execution Log Segments
+ *
+ * On-disk binary backend for the execution logger. Entries are
+ * enqueued on the syscall path (one queue push, no I/O) and a
+ * dedicated flusher thread appends them to mmap'd segment files:
+ * fixed record headers plus length-prefixed payload/response bytes.
+ * Segments rotate at a size cap and each carries a committed-bytes
+ * header, so a crash mid-write loses at most the last unflushed batch
+ * and everything before it replays cleanly post-mortem.
+ *
+ * Queries seek instead of scanning: each segment keeps a sparse
+ * in-memory index (sequence id and timestamp every SPARSE_EVERY
+ * records, mapped to byte offsets) and every record lands on its
+ * agent's posting list, so sequence, time-range and per-agent lookups
+ * touch only the records they return. The index is rebuilt from the
+ * segments on open, never persisted.
+ */
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "kernel/execution_log.hpp"
+
+namespace clove::kernel {
+
+class ExecutionSegmentLog {
+public:
+    static constexpr size_t DEFAULT_SEGMENT_BYTES = 64 * 1024 * 1024;
+
+    explicit ExecutionSegmentLog(std::string dir,
+                                 size_t segment_bytes = DEFAULT_SEGMENT_BYTES);
+    ~ExecutionSegmentLog();
+
+    ExecutionSegmentLog(const ExecutionSegmentLog&) = delete;
+    ExecutionSegmentLog& operator=(const ExecutionSegmentLog&) = delete;
+
+    // Scans existing segments (rebuilding the index and recovering the
+    // highest sequence id) and starts the flusher thread
+    bool open();
+
+    // Hot path: enqueue only; the flusher thread does the encoding,
+    // memcpy into the mapped segment, flushing and indexing
+    void append(ExecutionLogEntry entry);
+
+    // Blocks until everything enqueued so far is on disk (MS_SYNC)
+    void flush();
+
+    // Drops all segments and the index, starts fresh
+    void reset();
+
+    uint64_t entry_count() const { return entry_count_.load(std::memory_order_relaxed); }
+    uint64_t last_sequence() const { return last_sequence_.load(std::memory_order_relaxed); }
+
+    // Iterates committed records across all segments in write order;
+    // return false from the callback to stop early
+    void scan(const std::function<bool(const ExecutionLogEntry&)>& cb) const;
+
+    // Indexed variants: seek to the first record with sequence id
+    // greater than start_sequence / timestamp at or after from_wall_ms
+    // and iterate from there (time range additionally stops past
+    // to_wall_ms)
+    void scan_from(uint64_t start_sequence,
+                   const std::function<bool(const ExecutionLogEntry&)>& cb) const;
+    void scan_time_range(int64_t from_wall_ms, int64_t to_wall_ms,
+                         const std::function<bool(const ExecutionLogEntry&)>& cb) const;
+
+    // The agent's most recent `limit` records, oldest first, via its
+    // posting list — cost is proportional to the result, not the log
+    std::vector<ExecutionLogEntry> agent_tail(uint32_t agent_id, size_t limit) const;
+
+private:
+    static constexpr size_t SPARSE_EVERY = 256;
+
+    struct Segment {
+        std::string path;
+        int fd = -1;
+        uint8_t* base = nullptr;   // mmap of the whole segment
+        size_t mapped = 0;
+        std::atomic<uint64_t> committed{0};  // bytes of valid records after header
+    };
+
+    // One per segment, in write order; indexes into metas_ are stable
+    // (rotation appends, reset clears everything)
+    struct SegmentMeta {
+        std::string path;
+        uint64_t first_sequence = 0;
+        uint64_t record_count = 0;
+        struct SparseEntry {
+            uint64_t sequence;
+            int64_t ts_wall_ms;
+            uint64_t offset;  // byte offset after the segment header
+        };
+        std::vector<SparseEntry> sparse;
+    };
+
+    struct Posting {
+        uint32_t segment;  // index into metas_
+        uint64_t offset;
+    };
+
+    std::string dir_;
+    size_t segment_bytes_;
+
+    // Producer queue drained in batches by the flusher
+    std::mutex queue_mutex_;
+    std::condition_variable queue_cv_;
+    std::condition_variable flushed_cv_;
+    std::deque<ExecutionLogEntry> queue_;
+    bool stopping_ = false;
+    bool flusher_idle_ = true;
+
+    // Segment list and index. Guarded for mutation; the active
+    // segment's bytes are safe to read up to its committed counter
+    // while the flusher appends.
+    mutable std::mutex segments_mutex_;
+    std::vector<SegmentMeta> metas_;
+    std::unique_ptr<Segment> active_;  // corresponds to metas_.back() when set
+    std::unordered_map<uint32_t, std::vector<Posting>> agent_postings_;
+
+    std::atomic<uint64_t> entry_count_{0};
+    std::atomic<uint64_t> last_sequence_{0};
+
+    std::thread flusher_;
+
+    void flusher_loop();
+    void write_batch(std::deque<ExecutionLogEntry>& batch);
+    bool open_segment(uint64_t first_sequence);
+    void finalize_segment();
+    void index_record(uint32_t segment, const ExecutionLogEntry& entry, uint64_t offset);
+
+    // Iterate committed records of segment `index` starting at byte
+    // `offset`; limit_bytes caps the active segment to its committed
+    // counter. Callback also receives each record's offset.
+    bool scan_segment(size_t index, uint64_t offset, uint64_t limit_bytes,
+                      const std::function<bool(const ExecutionLogEntry&, uint64_t)>& cb) const;
+
+    // Snapshot (path or "", committed bytes) for a segment under the lock
+    std::pair<std::string, uint64_t> segment_extent(size_t index) const;
+};
+
+} // namespace clove::kernel
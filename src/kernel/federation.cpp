@@ -0,0 +1,690 @@
+#include "kernel/federation.hpp"
+#include "kernel/ipc_mailbox.hpp"
+#include "kernel/reactor.hpp"
+#include "kernel/state_store.hpp"
+#include "runtime/agent/manager.hpp"
+#include <spdlog/spdlog.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+using json = nlohmann::json;
+
+namespace clove::kernel {
+
+namespace {
+
+constexpr int ROUND_TRIP_TIMEOUT_MS = 1000;
+constexpr auto GOSSIP_INTERVAL = std::chrono::seconds(2);
+constexpr auto PEER_SILENCE_LIMIT = std::chrono::seconds(15);
+
+bool parse_addr(const std::string& addr, std::string& host, uint16_t& port) {
+    auto colon = addr.rfind(':');
+    if (colon == std::string::npos || colon == 0 || colon + 1 >= addr.size()) {
+        return false;
+    }
+    host = addr.substr(0, colon);
+    try {
+        port = static_cast<uint16_t>(std::stoul(addr.substr(colon + 1)));
+    } catch (...) {
+        return false;
+    }
+    return port != 0;
+}
+
+bool set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+} // namespace
+
+FederationManager::FederationManager(Reactor& reactor, AgentMailboxRegistry& mailboxes,
+                                     StateStore& state_store,
+                                     runtime::AgentManager& agent_manager,
+                                     std::string listen_addr,
+                                     std::vector<std::string> peer_addrs)
+    : reactor_(reactor),
+      mailboxes_(mailboxes),
+      state_store_(state_store),
+      agent_manager_(agent_manager),
+      listen_addr_(std::move(listen_addr)),
+      configured_peers_(std::move(peer_addrs)) {}
+
+FederationManager::~FederationManager() {
+    stop();
+}
+
+bool FederationManager::start() {
+    std::string host;
+    uint16_t port = 0;
+    if (!parse_addr(listen_addr_, host, port)) {
+        spdlog::error("Federation: invalid listen address '{}'", listen_addr_);
+        return false;
+    }
+
+    listen_fd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0) {
+        spdlog::error("Federation: socket failed: {}", strerror(errno));
+        return false;
+    }
+
+    int one = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in sa{};
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons(port);
+    if (inet_pton(AF_INET, host.c_str(), &sa.sin_addr) != 1) {
+        sa.sin_addr.s_addr = host == "0.0.0.0" ? INADDR_ANY : INADDR_LOOPBACK;
+    }
+
+    if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&sa), sizeof(sa)) < 0 ||
+        ::listen(listen_fd_, 16) < 0) {
+        spdlog::error("Federation: cannot listen on {}: {}", listen_addr_, strerror(errno));
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        return false;
+    }
+
+    set_nonblocking(listen_fd_);
+    reactor_.add(listen_fd_, static_cast<uint32_t>(EventType::READABLE),
+                 [this](int, uint32_t) { accept_peer(); });
+
+    for (const auto& addr : configured_peers_) {
+        dial_peer(addr);
+    }
+
+    spdlog::info("Federation: listening on {} ({} configured peers)",
+                 listen_addr_, configured_peers_.size());
+    return true;
+}
+
+void FederationManager::stop() {
+    if (listen_fd_ >= 0) {
+        reactor_.remove(listen_fd_);
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+    }
+    std::lock_guard<std::mutex> lock(peers_mutex_);
+    for (auto& [fd, peer] : peers_) {
+        reactor_.remove(fd);
+        ::close(fd);
+    }
+    peers_.clear();
+}
+
+size_t FederationManager::peer_count() const {
+    std::lock_guard<std::mutex> lock(peers_mutex_);
+    return peers_.size();
+}
+
+void FederationManager::accept_peer() {
+    for (;;) {
+        int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return;  // EAGAIN or transient error; reactor retries
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(peers_mutex_);
+            Peer peer;
+            peer.fd = fd;
+            peer.connected = true;
+            peer.last_seen = std::chrono::steady_clock::now();
+            peers_.emplace(fd, std::move(peer));
+        }
+
+        reactor_.add(fd,
+                     EventType::READABLE | EventType::HANGUP | EventType::ERROR,
+                     [this](int peer_fd, uint32_t events) {
+                         on_peer_readable(peer_fd, events);
+                     });
+    }
+}
+
+bool FederationManager::dial_peer(const std::string& addr) {
+    std::string host;
+    uint16_t port = 0;
+    if (!parse_addr(addr, host, port)) {
+        spdlog::warn("Federation: invalid peer address '{}'", addr);
+        return false;
+    }
+
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    sockaddr_in sa{};
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons(port);
+    if (inet_pton(AF_INET, host.c_str(), &sa.sin_addr) != 1) {
+        sa.sin_addr.s_addr = INADDR_LOOPBACK;
+    }
+
+    int rc = ::connect(fd, reinterpret_cast<sockaddr*>(&sa), sizeof(sa));
+    if (rc < 0 && errno != EINPROGRESS) {
+        ::close(fd);
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(peers_mutex_);
+        Peer peer;
+        peer.fd = fd;
+        peer.dial_addr = addr;
+        peer.last_seen = std::chrono::steady_clock::now();
+        peers_.emplace(fd, std::move(peer));
+    }
+
+    // Register for WRITABLE first: it fires once the non-blocking
+    // connect completes (or fails), then the link flips to read mode
+    reactor_.add(fd,
+                 EventType::WRITABLE | EventType::HANGUP | EventType::ERROR,
+                 [this](int peer_fd, uint32_t events) {
+                     if (events & (EventType::ERROR | EventType::HANGUP)) {
+                         drop_peer(peer_fd);
+                         return;
+                     }
+                     int err = 0;
+                     socklen_t len = sizeof(err);
+                     getsockopt(peer_fd, SOL_SOCKET, SO_ERROR, &err, &len);
+                     if (err != 0) {
+                         drop_peer(peer_fd);
+                         return;
+                     }
+                     // Connected: swap the fd over to the read callback
+                     // (modify alone would leave this lambda installed)
+                     reactor_.remove(peer_fd);
+                     reactor_.add(peer_fd,
+                                  EventType::READABLE | EventType::HANGUP | EventType::ERROR,
+                                  [this](int link_fd, uint32_t link_events) {
+                                      on_peer_readable(link_fd, link_events);
+                                  });
+                     {
+                         std::lock_guard<std::mutex> lock(peers_mutex_);
+                         auto it = peers_.find(peer_fd);
+                         if (it != peers_.end()) {
+                             it->second.connected = true;
+                         }
+                     }
+                     gossip();  // introduce ourselves immediately
+                 });
+    return true;
+}
+
+void FederationManager::drop_peer(int fd) {
+    reactor_.remove(fd);
+    ::close(fd);
+    std::lock_guard<std::mutex> lock(peers_mutex_);
+    auto it = peers_.find(fd);
+    if (it != peers_.end()) {
+        if (!it->second.dial_addr.empty() || !it->second.names.empty()) {
+            spdlog::info("Federation: peer {} disconnected",
+                         it->second.dial_addr.empty() ? it->second.advertised_addr
+                                                      : it->second.dial_addr);
+        }
+        peers_.erase(it);
+    }
+}
+
+void FederationManager::on_peer_readable(int fd, uint32_t events) {
+    if (events & (EventType::ERROR | EventType::HANGUP)) {
+        drop_peer(fd);
+        return;
+    }
+
+    // Drain the socket into the peer's reassembly buffer, collect
+    // complete frames, then dispatch them off the lock
+    std::vector<ipc::Message> frames;
+    {
+        std::lock_guard<std::mutex> lock(peers_mutex_);
+        auto it = peers_.find(fd);
+        if (it == peers_.end()) {
+            return;
+        }
+        Peer& peer = it->second;
+
+        uint8_t buf[16384];
+        for (;;) {
+            ssize_t n = ::read(fd, buf, sizeof(buf));
+            if (n > 0) {
+                peer.rx.insert(peer.rx.end(), buf, buf + n);
+            } else if (n == 0) {
+                break;  // peer closed; HANGUP follows
+            } else {
+                break;  // EAGAIN or error
+            }
+        }
+
+        size_t offset = 0;
+        while (auto size = ipc::Message::get_message_size(peer.rx.data() + offset,
+                                                          peer.rx.size() - offset)) {
+            if (peer.rx.size() - offset < *size) {
+                break;  // header seen, payload still in flight
+            }
+            auto msg = ipc::Message::deserialize(peer.rx.data() + offset, *size);
+            if (!msg) {
+                break;
+            }
+            frames.push_back(std::move(*msg));
+            offset += *size;
+        }
+        if (offset > 0) {
+            peer.rx.erase(peer.rx.begin(),
+                          peer.rx.begin() + static_cast<ptrdiff_t>(offset));
+        }
+        peer.last_seen = std::chrono::steady_clock::now();
+    }
+
+    for (auto& frame : frames) {
+        try {
+            handle_frame(fd, frame);
+        } catch (const std::exception& e) {
+            spdlog::warn("Federation: bad frame from peer: {}", e.what());
+        }
+    }
+}
+
+void FederationManager::handle_frame(int fd, const ipc::Message& msg) {
+    json j = json::parse(msg.payload_str());
+
+    switch (msg.opcode) {
+        case ipc::SyscallOp::SYS_HELLO: {
+            std::lock_guard<std::mutex> lock(peers_mutex_);
+            auto it = peers_.find(fd);
+            if (it == peers_.end()) {
+                return;
+            }
+            Peer& peer = it->second;
+            peer.advertised_addr = j.value("addr", "");
+            peer.load = j.value("load", static_cast<size_t>(0));
+            peer.names.clear();
+            for (const auto& name : j.value("names", json::array())) {
+                peer.names.insert(name.get<std::string>());
+            }
+            break;
+        }
+
+        case ipc::SyscallOp::SYS_SEND: {
+            auto target = mailboxes_.resolve_name(j.value("to_name", ""));
+            if (!target) {
+                spdlog::debug("Federation: forwarded send for unknown name '{}'",
+                              j.value("to_name", ""));
+                return;
+            }
+            IPCMessage ipc_msg;
+            ipc_msg.from_id = j.value("from_id", 0u);
+            ipc_msg.from_name = j.value("from_name", "");
+            ipc_msg.body = std::make_shared<const std::string>(
+                j.value("message", json::object()).dump());
+            ipc_msg.timestamp = std::chrono::steady_clock::now();
+            int priority = static_cast<int>(IPC_LANE_NORMAL);
+            if (j.contains("priority")) {
+                if (j["priority"].is_number_integer()) {
+                    priority = j["priority"].get<int>();
+                } else if (j["priority"] == "urgent") {
+                    priority = IPC_LANE_URGENT;
+                } else if (j["priority"] == "bulk") {
+                    priority = IPC_LANE_BULK;
+                }
+            }
+            ipc_msg.priority = static_cast<uint8_t>(
+                std::clamp(priority, 0, NUM_IPC_LANES - 1));
+            int ttl_ms = j.value("ttl_ms", 0);
+            if (ttl_ms > 0) {
+                ipc_msg.has_ttl = true;
+                ipc_msg.expires_at = ipc_msg.timestamp + std::chrono::milliseconds(ttl_ms);
+            }
+            mailboxes_.enqueue(*target, std::move(ipc_msg));
+            break;
+        }
+
+        case ipc::SyscallOp::SYS_BROADCAST: {
+            IPCMessage ipc_msg;
+            ipc_msg.from_id = j.value("from_id", 0u);
+            ipc_msg.from_name = j.value("from_name", "");
+            ipc_msg.body = std::make_shared<const std::string>(
+                j.value("message", json::object()).dump());
+            ipc_msg.timestamp = std::chrono::steady_clock::now();
+            // Sender IDs are per-kernel, so self-exclusion is meaningless
+            // here — deliver to every local mailbox, never re-forward
+            mailboxes_.broadcast(ipc_msg, true);
+            break;
+        }
+
+        case ipc::SyscallOp::SYS_FETCH: {
+            auto result = state_store_.fetch(j.value("agent_id", 0u), j.value("key", ""));
+            json reply;
+            reply["found"] = result.success && result.exists;
+            if (reply["found"].get<bool>()) {
+                reply["value"] = result.value;
+                reply["scope"] = result.scope;
+            }
+            std::lock_guard<std::mutex> lock(peers_mutex_);
+            auto it = peers_.find(fd);
+            if (it != peers_.end()) {
+                send_frame(it->second,
+                           ipc::Message(0, ipc::SyscallOp::SYS_FETCH, reply.dump()));
+            }
+            break;
+        }
+
+        case ipc::SyscallOp::SYS_SPAWN: {
+            auto config = runtime::AgentConfig::from_json(j.value("config", json::object()));
+            // The forwarding kernel's socket path is meaningless here
+            config.socket_path.clear();
+            json reply;
+            if (auto agent = agent_manager_.spawn_agent(config)) {
+                reply["success"] = true;
+                reply["agent_id"] = agent->id();
+                reply["agent_name"] = agent->name();
+            } else {
+                reply["success"] = false;
+                reply["error"] = "spawn failed on peer";
+            }
+            std::lock_guard<std::mutex> lock(peers_mutex_);
+            auto it = peers_.find(fd);
+            if (it != peers_.end()) {
+                send_frame(it->second,
+                           ipc::Message(0, ipc::SyscallOp::SYS_SPAWN, reply.dump()));
+            }
+            break;
+        }
+
+        default:
+            spdlog::debug("Federation: ignoring frame opcode {:#x}",
+                          static_cast<int>(msg.opcode));
+    }
+}
+
+void FederationManager::send_frame(Peer& peer, const ipc::Message& msg) {
+    // Gossip and forwards are small and infrequent; a link too congested
+    // to take a whole frame is treated as dead and redialed
+    auto buffer = msg.serialize();
+    ssize_t written = ::send(peer.fd, buffer.data(), buffer.size(), MSG_NOSIGNAL);
+    if (written != static_cast<ssize_t>(buffer.size())) {
+        spdlog::warn("Federation: short write to peer ({}), dropping link",
+                     written < 0 ? strerror(errno) : "partial frame");
+        ::shutdown(peer.fd, SHUT_RDWR);  // HANGUP cleans up via the reactor
+    }
+}
+
+void FederationManager::gossip() {
+    json hello;
+    hello["addr"] = listen_addr_;
+    hello["names"] = mailboxes_.registered_names();
+    hello["load"] = agent_manager_.list_agents().size();
+    ipc::Message frame(0, ipc::SyscallOp::SYS_HELLO, hello.dump());
+
+    std::lock_guard<std::mutex> lock(peers_mutex_);
+    for (auto& [fd, peer] : peers_) {
+        if (peer.connected) {  // dialed links still connecting can't take a frame
+            send_frame(peer, frame);
+        }
+    }
+    last_gossip_ = std::chrono::steady_clock::now();
+}
+
+void FederationManager::on_tick() {
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_gossip_ < GOSSIP_INTERVAL) {
+        return;
+    }
+
+    // Drop links that stopped gossiping, note which peers need redialing
+    std::vector<int> stale;
+    std::vector<std::string> to_dial = configured_peers_;
+    {
+        std::lock_guard<std::mutex> lock(peers_mutex_);
+        for (const auto& [fd, peer] : peers_) {
+            if (now - peer.last_seen > PEER_SILENCE_LIMIT) {
+                stale.push_back(fd);
+                continue;
+            }
+            std::erase(to_dial, peer.dial_addr);
+            std::erase(to_dial, peer.advertised_addr);
+        }
+    }
+    for (int fd : stale) {
+        drop_peer(fd);
+    }
+    for (const auto& addr : to_dial) {
+        dial_peer(addr);
+    }
+
+    gossip();
+}
+
+bool FederationManager::knows_name(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(peers_mutex_);
+    for (const auto& [fd, peer] : peers_) {
+        if (peer.names.count(name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::optional<std::string> FederationManager::forward_send(
+    const std::string& target_name, const json& request,
+    uint32_t from_id, const std::string& from_name) {
+    json payload;
+    payload["to_name"] = target_name;
+    payload["message"] = request.value("message", json::object());
+    if (request.contains("priority")) {
+        payload["priority"] = request["priority"];  // verbatim; receiver normalizes
+    }
+    if (request.contains("ttl_ms")) {
+        payload["ttl_ms"] = request["ttl_ms"];
+    }
+    payload["from_id"] = from_id;
+    payload["from_name"] = from_name;
+    ipc::Message frame(0, ipc::SyscallOp::SYS_SEND, payload.dump());
+
+    std::lock_guard<std::mutex> lock(peers_mutex_);
+    for (auto& [fd, peer] : peers_) {
+        if (peer.names.count(target_name)) {
+            send_frame(peer, frame);
+            return peer.advertised_addr.empty() ? peer.dial_addr : peer.advertised_addr;
+        }
+    }
+    return std::nullopt;
+}
+
+int FederationManager::forward_broadcast(const json& request,
+                                         uint32_t from_id, const std::string& from_name) {
+    json payload;
+    payload["message"] = request.value("message", json::object());
+    payload["from_id"] = from_id;
+    payload["from_name"] = from_name;
+    ipc::Message frame(0, ipc::SyscallOp::SYS_BROADCAST, payload.dump());
+
+    int forwarded = 0;
+    std::unordered_set<std::string> sent_to;
+    std::lock_guard<std::mutex> lock(peers_mutex_);
+    for (auto& [fd, peer] : peers_) {
+        // Only links that completed the hello — a half-open dial or an
+        // ephemeral request connection shouldn't get broadcasts. Mutual
+        // dialing leaves two links per peer pair; send on one of them
+        if (!peer.advertised_addr.empty() && sent_to.insert(peer.advertised_addr).second) {
+            send_frame(peer, frame);
+            forwarded++;
+        }
+    }
+    return forwarded;
+}
+
+std::optional<std::string> FederationManager::pick_spawn_target(size_t local_load) const {
+    std::lock_guard<std::mutex> lock(peers_mutex_);
+    const Peer* best = nullptr;
+    for (const auto& [fd, peer] : peers_) {
+        if (peer.advertised_addr.empty()) {
+            continue;
+        }
+        if (peer.load < local_load && (!best || peer.load < best->load)) {
+            best = &peer;
+        }
+    }
+    if (!best) {
+        return std::nullopt;
+    }
+    return best->advertised_addr;
+}
+
+std::optional<json> FederationManager::remote_fetch(uint32_t agent_id,
+                                                    const std::string& key) {
+    std::unordered_set<std::string> addrs;
+    {
+        std::lock_guard<std::mutex> lock(peers_mutex_);
+        for (const auto& [fd, peer] : peers_) {
+            if (!peer.advertised_addr.empty()) {
+                addrs.insert(peer.advertised_addr);
+            }
+        }
+    }
+
+    json request;
+    request["agent_id"] = agent_id;
+    request["key"] = key;
+    ipc::Message frame(0, ipc::SyscallOp::SYS_FETCH, request.dump());
+
+    for (const auto& addr : addrs) {
+        auto reply = round_trip(addr, frame, ROUND_TRIP_TIMEOUT_MS);
+        if (!reply) {
+            continue;
+        }
+        json j = json::parse(reply->payload_str(), nullptr, false);
+        if (!j.is_discarded() && j.value("found", false)) {
+            j["peer"] = addr;
+            return j;
+        }
+    }
+    return std::nullopt;
+}
+
+json FederationManager::remote_spawn(const std::string& addr, const json& config_json) {
+    json request;
+    request["config"] = config_json;
+    ipc::Message frame(0, ipc::SyscallOp::SYS_SPAWN, request.dump());
+
+    auto reply = round_trip(addr, frame, ROUND_TRIP_TIMEOUT_MS * 5);
+    if (!reply) {
+        return {{"success", false}, {"error", "peer " + addr + " unreachable"}};
+    }
+    json j = json::parse(reply->payload_str(), nullptr, false);
+    if (j.is_discarded()) {
+        return {{"success", false}, {"error", "malformed reply from peer"}};
+    }
+    j["peer"] = addr;
+    return j;
+}
+
+int FederationManager::connect_to(const std::string& addr, int timeout_ms) {
+    std::string host;
+    uint16_t port = 0;
+    if (!parse_addr(addr, host, port)) {
+        return -1;
+    }
+
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    set_nonblocking(fd);
+
+    sockaddr_in sa{};
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons(port);
+    if (inet_pton(AF_INET, host.c_str(), &sa.sin_addr) != 1) {
+        sa.sin_addr.s_addr = INADDR_LOOPBACK;
+    }
+
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&sa), sizeof(sa)) < 0) {
+        if (errno != EINPROGRESS) {
+            ::close(fd);
+            return -1;
+        }
+        pollfd pfd{fd, POLLOUT, 0};
+        if (::poll(&pfd, 1, timeout_ms) != 1) {
+            ::close(fd);
+            return -1;
+        }
+        int err = 0;
+        socklen_t len = sizeof(err);
+        getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len);
+        if (err != 0) {
+            ::close(fd);
+            return -1;
+        }
+    }
+
+    // Blocking with deadlines from here on
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags & ~O_NONBLOCK);
+    timeval tv{timeout_ms / 1000, (timeout_ms % 1000) * 1000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    return fd;
+}
+
+std::optional<ipc::Message> FederationManager::round_trip(const std::string& addr,
+                                                          const ipc::Message& request,
+                                                          int timeout_ms) {
+    int fd = connect_to(addr, timeout_ms);
+    if (fd < 0) {
+        return std::nullopt;
+    }
+
+    auto buffer = request.serialize();
+    size_t sent = 0;
+    while (sent < buffer.size()) {
+        ssize_t n = ::send(fd, buffer.data() + sent, buffer.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            ::close(fd);
+            return std::nullopt;
+        }
+        sent += static_cast<size_t>(n);
+    }
+
+    uint8_t header[ipc::HEADER_SIZE];
+    size_t have = 0;
+    while (have < sizeof(header)) {
+        ssize_t n = ::read(fd, header + have, sizeof(header) - have);
+        if (n <= 0) {
+            ::close(fd);
+            return std::nullopt;
+        }
+        have += static_cast<size_t>(n);
+    }
+
+    auto total = ipc::Message::get_message_size(header, sizeof(header));
+    if (!total) {
+        ::close(fd);
+        return std::nullopt;
+    }
+
+    std::vector<uint8_t> frame(header, header + sizeof(header));
+    frame.resize(*total);
+    while (have < *total) {
+        ssize_t n = ::read(fd, frame.data() + have, *total - have);
+        if (n <= 0) {
+            ::close(fd);
+            return std::nullopt;
+        }
+        have += static_cast<size_t>(n);
+    }
+    ::close(fd);
+
+    return ipc::Message::deserialize(frame.data(), frame.size());
+}
+
+} // namespace clove::kernel
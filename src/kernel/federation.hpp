@@ -0,0 +1,134 @@
+/**
+ * Multi-kernel federation
+ *
+ * Connects kernels over TCP using the same 17-byte framed protocol the
+ * Unix socket speaks. Peers gossip their registered mailbox names and
+ * agent count on every tick, so name resolution for SYS_SEND and
+ * broadcast fan-out extend across machines without the agents doing
+ * their own sharding.
+ *
+ * Two traffic classes:
+ *  - persistent links (one per configured peer, plus inbound): gossip,
+ *    forwarded SYS_SEND/SYS_BROADCAST — fire-and-forget, handled on the
+ *    reactor thread like any other connection;
+ *  - ephemeral round trips (remote SYS_FETCH, remote SYS_SPAWN): a
+ *    short-lived blocking connection with a deadline, made from the
+ *    async pool so the reactor never waits on a peer.
+ */
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "ipc/protocol.hpp"
+
+namespace clove::runtime {
+class AgentManager;
+}
+
+namespace clove::kernel {
+
+class Reactor;
+class AgentMailboxRegistry;
+class StateStore;
+
+class FederationManager {
+public:
+    FederationManager(Reactor& reactor, AgentMailboxRegistry& mailboxes,
+                      StateStore& state_store, runtime::AgentManager& agent_manager,
+                      std::string listen_addr, std::vector<std::string> peer_addrs);
+    ~FederationManager();
+
+    FederationManager(const FederationManager&) = delete;
+    FederationManager& operator=(const FederationManager&) = delete;
+
+    // Listen on the configured address and start dialing peers. Needs a
+    // live reactor, so it runs from Kernel::init(), not the constructor.
+    // Peers that are down are redialed from on_tick().
+    bool start();
+    void stop();
+
+    // Driven by the kernel main loop: redial lost peers, gossip names
+    // and load, drop links that went silent
+    void on_tick();
+
+    size_t peer_count() const;
+
+    // --- syscall fallbacks (reactor thread, non-blocking) ---
+
+    // True if some peer currently advertises this mailbox name
+    bool knows_name(const std::string& name) const;
+
+    // Forward a SYS_SEND whose target name lives on a peer. Returns the
+    // peer's address, or nullopt if no peer owns the name. Delivery is
+    // asynchronous — the frame is queued on the persistent link.
+    std::optional<std::string> forward_send(const std::string& target_name,
+                                            const nlohmann::json& request,
+                                            uint32_t from_id, const std::string& from_name);
+
+    // Re-broadcast to every connected peer; receivers deliver locally
+    // and never re-forward, so the fan-out can't loop. Returns the
+    // number of peers the frame was queued to.
+    int forward_broadcast(const nlohmann::json& request,
+                          uint32_t from_id, const std::string& from_name);
+
+    // Peer advertising fewer agents than local_load; nullopt when this
+    // kernel is already the least loaded
+    std::optional<std::string> pick_spawn_target(size_t local_load) const;
+
+    // --- blocking round trips (async pool only) ---
+
+    // Ask each peer for a key until one has it
+    std::optional<nlohmann::json> remote_fetch(uint32_t agent_id, const std::string& key);
+
+    // Spawn on a specific peer; config_json is AgentConfig::to_json()
+    nlohmann::json remote_spawn(const std::string& addr, const nlohmann::json& config_json);
+
+private:
+    struct Peer {
+        int fd = -1;
+        bool connected = false;       // false while a dialed connect is in flight
+        std::string dial_addr;        // configured address; "" for inbound links
+        std::string advertised_addr;  // peer's listen addr, from gossip
+        std::vector<uint8_t> rx;
+        std::unordered_set<std::string> names;
+        size_t load = 0;
+        std::chrono::steady_clock::time_point last_seen;
+    };
+
+    void accept_peer();
+    void on_peer_readable(int fd, uint32_t events);
+    void handle_frame(int fd, const ipc::Message& msg);
+    void drop_peer(int fd);
+    bool dial_peer(const std::string& addr);
+    void send_frame(Peer& peer, const ipc::Message& msg);
+    void gossip();
+
+    // One framed request, one framed reply, hard deadline; nullopt on
+    // any failure. Never call from the reactor thread.
+    static std::optional<ipc::Message> round_trip(const std::string& addr,
+                                                  const ipc::Message& request,
+                                                  int timeout_ms);
+    static int connect_to(const std::string& addr, int timeout_ms);
+
+    Reactor& reactor_;
+    AgentMailboxRegistry& mailboxes_;
+    StateStore& state_store_;
+    runtime::AgentManager& agent_manager_;
+
+    std::string listen_addr_;
+    int listen_fd_ = -1;
+    std::vector<std::string> configured_peers_;
+
+    mutable std::mutex peers_mutex_;
+    std::unordered_map<int, Peer> peers_;  // keyed by fd
+    std::chrono::steady_clock::time_point last_gossip_{};
+};
+
+} // namespace clove::kernel
@@ -1,4 +1,5 @@
 #include "kernel/ipc_mailbox.hpp"
+#include <algorithm>
 
 namespace clove::kernel {
 
@@ -32,7 +33,7 @@ void AgentMailboxRegistry::unregister(uint32_t agent_id) {
         }
     }
     {
-        std::lock_guard<std::mutex> lock(mailbox_mutex_);
+        std::lock_guard<std::mutex> lock(mailboxes_mutex_);
         mailboxes_.erase(agent_id);
     }
 }
@@ -46,6 +47,16 @@ std::optional<uint32_t> AgentMailboxRegistry::resolve_name(const std::string& na
     return it->second;
 }
 
+std::vector<std::string> AgentMailboxRegistry::registered_names() const {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    std::vector<std::string> names;
+    names.reserve(names_.size());
+    for (const auto& [name, agent_id] : names_) {
+        names.push_back(name);
+    }
+    return names;
+}
+
 std::string AgentMailboxRegistry::get_name(uint32_t agent_id) const {
     std::lock_guard<std::mutex> lock(registry_mutex_);
     auto it = ids_to_names_.find(agent_id);
@@ -55,45 +66,244 @@ std::string AgentMailboxRegistry::get_name(uint32_t agent_id) const {
     return it->second;
 }
 
+void AgentMailboxRegistry::enqueue(uint32_t target_id, IPCMessage&& message) {
+    auto mailbox = get_or_create_mailbox(target_id);
+
+    uint64_t wake_request_id = 0;
+    std::vector<IPCMessage> wake_messages;
+    {
+        std::lock_guard<std::mutex> lock(mailbox->mutex);
+        uint8_t lane = std::min<uint8_t>(message.priority, NUM_IPC_LANES - 1);
+        mailbox->lanes[lane].push(std::move(message));
+
+        // A parked recv completes the moment its first message lands
+        if (mailbox->waiter) {
+            wake_request_id = mailbox->waiter->request_id;
+            wake_messages = mailbox->drain_locked(mailbox->waiter->max_messages);
+            mailbox->waiter.reset();
+        }
+    }
+    if (wake_request_id != 0 && recv_wake_) {
+        recv_wake_(target_id, wake_request_id, std::move(wake_messages), false);
+    }
+}
+
 void AgentMailboxRegistry::enqueue(uint32_t target_id, const IPCMessage& message) {
-    std::lock_guard<std::mutex> lock(mailbox_mutex_);
-    mailboxes_[target_id].push(message);
+    enqueue(target_id, IPCMessage(message));
 }
 
 std::vector<IPCMessage> AgentMailboxRegistry::dequeue(uint32_t agent_id, int max_messages) {
-    std::vector<IPCMessage> messages;
     if (max_messages <= 0) {
-        return messages;
+        return {};
     }
 
-    std::lock_guard<std::mutex> lock(mailbox_mutex_);
+    auto mailbox = find_mailbox(agent_id);
+    if (!mailbox) {
+        return {};
+    }
+
+    std::lock_guard<std::mutex> lock(mailbox->mutex);
+    return mailbox->drain_locked(max_messages);
+}
+
+int AgentMailboxRegistry::broadcast(const IPCMessage& message, bool include_self) {
+    std::vector<uint32_t> targets;
+    {
+        std::lock_guard<std::mutex> reg_lock(registry_mutex_);
+        targets.reserve(ids_to_names_.size());
+        for (const auto& [agent_id, name] : ids_to_names_) {
+            if (agent_id == message.from_id && !include_self) {
+                continue;
+            }
+            targets.push_back(agent_id);
+        }
+    }
+
+    for (uint32_t agent_id : targets) {
+        enqueue(agent_id, IPCMessage(message));
+    }
+
+    return static_cast<int>(targets.size());
+}
+
+void AgentMailboxRegistry::set_recv_wake_handler(RecvWakeHandler handler) {
+    recv_wake_ = std::move(handler);
+}
+
+RecvParkResult AgentMailboxRegistry::dequeue_or_park(uint32_t agent_id,
+                                                     const RecvWaiter& waiter,
+                                                     std::vector<IPCMessage>& out) {
+    auto mailbox = get_or_create_mailbox(agent_id);
+    std::lock_guard<std::mutex> lock(mailbox->mutex);
+
+    out = mailbox->drain_locked(waiter.max_messages);
+    if (!out.empty()) {
+        return RecvParkResult::DELIVERED;
+    }
+
+    if (mailbox->waiter) {
+        return RecvParkResult::ALREADY_WAITING;
+    }
+
+    mailbox->waiter = waiter;
+    return RecvParkResult::PARKED;
+}
+
+void AgentMailboxRegistry::expire_recv_waiters() {
+    std::vector<std::pair<uint32_t, std::shared_ptr<Mailbox>>> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(mailboxes_mutex_);
+        snapshot.reserve(mailboxes_.size());
+        for (const auto& [agent_id, mailbox] : mailboxes_) {
+            snapshot.emplace_back(agent_id, mailbox);
+        }
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    std::vector<std::pair<uint32_t, uint64_t>> expired;
+    for (auto& [agent_id, mailbox] : snapshot) {
+        std::lock_guard<std::mutex> lock(mailbox->mutex);
+        if (mailbox->waiter && mailbox->waiter->has_deadline &&
+            mailbox->waiter->deadline <= now) {
+            expired.emplace_back(agent_id, mailbox->waiter->request_id);
+            mailbox->waiter.reset();
+        }
+    }
+
+    for (const auto& [agent_id, request_id] : expired) {
+        if (recv_wake_) {
+            recv_wake_(agent_id, request_id, {}, true);
+        }
+    }
+}
+
+std::shared_ptr<AgentMailboxRegistry::Mailbox>
+AgentMailboxRegistry::get_or_create_mailbox(uint32_t agent_id) {
+    std::lock_guard<std::mutex> lock(mailboxes_mutex_);
     auto& mailbox = mailboxes_[agent_id];
+    if (!mailbox) {
+        mailbox = std::make_shared<Mailbox>();
+    }
+    return mailbox;
+}
+
+std::shared_ptr<AgentMailboxRegistry::Mailbox>
+AgentMailboxRegistry::find_mailbox(uint32_t agent_id) const {
+    std::lock_guard<std::mutex> lock(mailboxes_mutex_);
+    auto it = mailboxes_.find(agent_id);
+    return it == mailboxes_.end() ? nullptr : it->second;
+}
+
+std::vector<IPCMessage> AgentMailboxRegistry::Mailbox::drain_locked(int max_messages) {
+    std::vector<IPCMessage> messages;
     int count = 0;
+    auto now = std::chrono::steady_clock::now();
 
-    while (!mailbox.empty() && count < max_messages) {
-        messages.push_back(mailbox.front());
-        mailbox.pop();
-        count++;
+    for (auto& lane : lanes) {
+        while (!lane.empty() && count < max_messages) {
+            IPCMessage& front = lane.front();
+            if (front.has_ttl && front.expires_at <= now) {
+                expired_dropped++;
+                lane.pop();
+                continue;
+            }
+            messages.push_back(std::move(front));
+            lane.pop();
+            count++;
+        }
+        if (count >= max_messages) {
+            break;
+        }
     }
 
     return messages;
 }
 
-int AgentMailboxRegistry::broadcast(const IPCMessage& message, bool include_self) {
-    std::lock_guard<std::mutex> reg_lock(registry_mutex_);
-    std::lock_guard<std::mutex> mail_lock(mailbox_mutex_);
+nlohmann::json AgentMailboxRegistry::export_state() const {
+    nlohmann::json state;
+
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        state["names"] = nlohmann::json::object();
+        for (const auto& [name, agent_id] : names_) {
+            state["names"][name] = agent_id;
+        }
+    }
+
+    // TTLs are steady_clock deadlines, meaningless across a process
+    // boundary; persist the remaining budget and re-arm it on import
+    auto now = std::chrono::steady_clock::now();
+    state["mailboxes"] = nlohmann::json::array();
+
+    std::lock_guard<std::mutex> lock(mailboxes_mutex_);
+    for (const auto& [agent_id, mailbox] : mailboxes_) {
+        std::lock_guard<std::mutex> box_lock(mailbox->mutex);
 
-    int delivered_count = 0;
-    for (const auto& [agent_id, name] : ids_to_names_) {
-        if (agent_id == message.from_id && !include_self) {
-            continue;
+        nlohmann::json messages = nlohmann::json::array();
+        for (uint8_t lane = 0; lane < NUM_IPC_LANES; ++lane) {
+            auto queue = mailbox->lanes[lane];  // copy: queues aren't iterable
+            while (!queue.empty()) {
+                const IPCMessage& msg = queue.front();
+                nlohmann::json entry = {
+                    {"from_id", msg.from_id},
+                    {"from_name", msg.from_name},
+                    {"body", *msg.body},
+                    {"priority", msg.priority},
+                };
+                if (msg.has_ttl) {
+                    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        msg.expires_at - now).count();
+                    if (remaining <= 0) {
+                        queue.pop();
+                        continue;  // already expired, don't carry it over
+                    }
+                    entry["ttl_ms"] = remaining;
+                }
+                messages.push_back(std::move(entry));
+                queue.pop();
+            }
         }
 
-        mailboxes_[agent_id].push(message);
-        delivered_count++;
+        if (!messages.empty()) {
+            state["mailboxes"].push_back({
+                {"agent_id", agent_id},
+                {"messages", std::move(messages)},
+            });
+        }
     }
 
-    return delivered_count;
+    return state;
+}
+
+void AgentMailboxRegistry::import_state(const nlohmann::json& state) {
+    if (state.contains("names")) {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        for (const auto& [name, agent_id] : state["names"].items()) {
+            names_[name] = agent_id.get<uint32_t>();
+            ids_to_names_[agent_id.get<uint32_t>()] = name;
+        }
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    for (const auto& box : state.value("mailboxes", nlohmann::json::array())) {
+        uint32_t agent_id = box.value("agent_id", 0u);
+        for (const auto& entry : box.value("messages", nlohmann::json::array())) {
+            IPCMessage msg;
+            msg.from_id = entry.value("from_id", 0u);
+            msg.from_name = entry.value("from_name", "");
+            msg.body = std::make_shared<const std::string>(entry.value("body", "{}"));
+            msg.timestamp = now;
+            msg.priority = entry.value("priority", static_cast<uint8_t>(IPC_LANE_NORMAL));
+            if (msg.priority >= NUM_IPC_LANES) {
+                msg.priority = IPC_LANE_NORMAL;
+            }
+            if (entry.contains("ttl_ms")) {
+                msg.has_ttl = true;
+                msg.expires_at = now + std::chrono::milliseconds(entry["ttl_ms"].get<int64_t>());
+            }
+            enqueue(agent_id, std::move(msg));
+        }
+    }
 }
 
 } // namespace clove::kernel
@@ -1,5 +1,8 @@
 #pragma once
+#include <array>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <queue>
 #include <unordered_map>
 #include <mutex>
@@ -11,12 +14,30 @@
 
 namespace clove::kernel {
 
-// IPC Message for agent-to-agent communication
+// Fixed priority lanes for inter-agent messages: urgent control traffic
+// is dequeued before normal traffic, which beats bulk telemetry. Three
+// FIFO lanes, not a per-message priority queue.
+enum IpcLane : uint8_t {
+    IPC_LANE_URGENT = 0,
+    IPC_LANE_NORMAL = 1,
+    IPC_LANE_BULK = 2,
+    NUM_IPC_LANES = 3
+};
+
+// IPC Message for agent-to-agent communication. The body is serialized
+// once at send time and shared immutably, so a broadcast to N agents is
+// one allocation plus N refcount bumps, and dequeue splices the text
+// straight into the reply without re-serializing.
 struct IPCMessage {
     uint32_t from_id;
     std::string from_name;
-    nlohmann::json message;
+    std::shared_ptr<const std::string> body; // pre-serialized JSON
     std::chrono::steady_clock::time_point timestamp;
+    uint8_t priority = IPC_LANE_NORMAL;
+    // Optional TTL: expired messages are dropped at dequeue time, so
+    // stale bulk data can't pile up in a slow consumer's mailbox
+    bool has_ttl = false;
+    std::chrono::steady_clock::time_point expires_at;
 };
 
 struct RegisterResult {
@@ -24,24 +45,84 @@ struct RegisterResult {
     std::string error;
 };
 
+// A SYS_RECV parked in the kernel until a message arrives (or the
+// optional deadline passes). One waiter per agent — an agent has one
+// connection, and a second blocking recv on it is a protocol error.
+struct RecvWaiter {
+    uint64_t request_id = 0;
+    int max_messages = 10;
+    bool has_deadline = false;
+    std::chrono::steady_clock::time_point deadline;
+};
+
+// Outcome of dequeue_or_park
+enum class RecvParkResult {
+    DELIVERED,       // mailbox had messages, returned inline
+    PARKED,          // empty: waiter parked, reply comes via the wake handler
+    ALREADY_WAITING  // a blocking recv is already pending for this agent
+};
+
 class AgentMailboxRegistry {
 public:
+    // Invoked (off the mailbox lock) when a parked recv completes —
+    // either messages arrived or the deadline expired (timed_out)
+    using RecvWakeHandler = std::function<void(uint32_t agent_id, uint64_t request_id,
+                                               std::vector<IPCMessage> messages,
+                                               bool timed_out)>;
+
     RegisterResult register_name(uint32_t agent_id, const std::string& name);
     void unregister(uint32_t agent_id);
     std::optional<uint32_t> resolve_name(const std::string& name) const;
     std::string get_name(uint32_t agent_id) const;
+    // Every registered name (federation gossip)
+    std::vector<std::string> registered_names() const;
 
+    // Messages are moved end-to-end; the const& overload copies once at
+    // the boundary for callers that must keep theirs
+    void enqueue(uint32_t target_id, IPCMessage&& message);
     void enqueue(uint32_t target_id, const IPCMessage& message);
     std::vector<IPCMessage> dequeue(uint32_t agent_id, int max_messages);
     int broadcast(const IPCMessage& message, bool include_self);
 
+    // Blocking-recv support: atomically drain-or-park under the mailbox
+    // lock so no message can slip between the emptiness check and the park
+    void set_recv_wake_handler(RecvWakeHandler handler);
+    RecvParkResult dequeue_or_park(uint32_t agent_id, const RecvWaiter& waiter,
+                                   std::vector<IPCMessage>& out);
+    // Fires timed-out waiters; called from the kernel tick
+    void expire_recv_waiters();
+
+    // Checkpoint support: name registrations plus every queued message
+    // (parked recv waiters are connection state and are not included —
+    // the SDK re-issues the recv after reconnecting)
+    nlohmann::json export_state() const;
+    void import_state(const nlohmann::json& state);
+
 private:
+    // One lock per mailbox: an agent pair's IPC traffic never contends
+    // with unrelated agents'. The registry map itself is touched only on
+    // create/unregister, behind its own short-lived lock.
+    struct Mailbox {
+        std::mutex mutex;
+        std::array<std::queue<IPCMessage>, NUM_IPC_LANES> lanes;
+        std::optional<RecvWaiter> waiter;
+        uint64_t expired_dropped = 0;
+
+        // Caller holds mutex; drains urgent before normal before bulk,
+        // discarding expired messages as it goes
+        std::vector<IPCMessage> drain_locked(int max_messages);
+    };
+
+    std::shared_ptr<Mailbox> get_or_create_mailbox(uint32_t agent_id);
+    std::shared_ptr<Mailbox> find_mailbox(uint32_t agent_id) const;
+
     mutable std::mutex registry_mutex_;
     std::unordered_map<std::string, uint32_t> names_;
     std::unordered_map<uint32_t, std::string> ids_to_names_;
 
-    mutable std::mutex mailbox_mutex_;
-    std::unordered_map<uint32_t, std::queue<IPCMessage>> mailboxes_;
+    mutable std::mutex mailboxes_mutex_;
+    std::unordered_map<uint32_t, std::shared_ptr<Mailbox>> mailboxes_;
+    RecvWakeHandler recv_wake_;
 };
 
 } // namespace clove::kernel
@@ -4,23 +4,36 @@
 #include "kernel/syscall_handlers.hpp"
 #include "kernel/async_task_manager.hpp"
 #include "kernel/audit_log.hpp"
+#include "kernel/checkpoint.hpp"
 #include "kernel/event_bus.hpp"
+#include "kernel/federation.hpp"
 #include "kernel/execution_log.hpp"
 #include "kernel/ipc_mailbox.hpp"
 #include "kernel/llm_queue.hpp"
+#include "kernel/opcode_table.hpp"
 #include "kernel/permissions_store.hpp"
+#include "kernel/pressure_monitor.hpp"
 #include "kernel/reactor.hpp"
 #include "kernel/state_store.hpp"
+#include "kernel/thread_placement.hpp"
+#include "kernel/trace_ring.hpp"
 #include "ipc/transport/socket_server.hpp"
+#include "ipc/transport/uring_transport.hpp"
 #include "metrics/metrics.hpp"
 #include "runtime/agent/manager.hpp"
+#include "core/config.hpp"
 #include "services/llm/client.hpp"
 #include "services/tunnel/client.hpp"
 #include "worlds/world_engine.hpp"
 #include <spdlog/spdlog.h>
 #include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
 #include <sys/wait.h>
+#include <unistd.h>
+#include <cerrno>
 #include <csignal>
+#include <cstring>
 #include <fstream>
 #include <thread>
 #include <nlohmann/json.hpp>
@@ -39,6 +52,14 @@ static void signal_handler(int signum) {
     }
 }
 
+// SIGHUP just raises a flag; the reload itself (file IO, allocation)
+// runs on the main loop where it's safe
+static volatile std::sig_atomic_t g_reload_requested = 0;
+
+static void reload_handler(int) {
+    g_reload_requested = 1;
+}
+
 Kernel::Kernel()
     : Kernel(Config{}) {}
 
@@ -48,6 +69,10 @@ Kernel::Kernel(const Config& config)
 Kernel::Kernel(const Config& config, Dependencies deps)
     : config_(config)
 {
+    // Arm thread pinning before any worker pool spins up below — the
+    // pools pin their threads as they start
+    placement::configure(config.pin_threads);
+
     reactor_ = std::move(deps.reactor);
     socket_server_ = std::move(deps.socket_server);
     agent_manager_ = std::move(deps.agent_manager);
@@ -86,23 +111,52 @@ Kernel::Kernel(const Config& config, Dependencies deps)
         llm_client_ = std::make_unique<services::llm::LLMClient>(llm_config);
     }
     if (!llm_queue_) {
-        llm_queue_ = std::make_unique<LlmQueue>(*llm_client_);
+        llm_queue_ = std::make_unique<LlmQueue>(*llm_client_,
+            config.llm_concurrency > 0 ? static_cast<size_t>(config.llm_concurrency) : 8,
+            config.llm_cache_ttl_secs);
     }
     if (!metrics_collector_) {
         metrics_collector_ = std::make_unique<clove::metrics::MetricsCollector>();
     }
+    if (config.metrics_interval_ms > 0) {
+        metrics_collector_->start_sampler(std::chrono::milliseconds(config.metrics_interval_ms));
+    }
     if (!audit_logger_) {
         audit_logger_ = std::make_unique<AuditLogger>();
     }
+    if (!config.audit_log_path.empty()) {
+        if (!audit_logger_->enable_file_sink(config.audit_log_path)) {
+            spdlog::warn("Audit file sink disabled: cannot open {}", config.audit_log_path);
+        }
+    }
     if (!execution_logger_) {
         execution_logger_ = std::make_unique<ExecutionLogger>();
     }
+    if (!config.exec_log_dir.empty()) {
+        if (!execution_logger_->enable_disk_recording(config.exec_log_dir)) {
+            spdlog::warn("Execution log persistence disabled: cannot open {}",
+                         config.exec_log_dir);
+        }
+    }
     if (!state_store_) {
         state_store_ = std::make_unique<StateStore>();
     }
+    if (!config.state_dir.empty()) {
+        if (!state_store_->enable_persistence(config.state_dir)) {
+            spdlog::warn("State persistence disabled: cannot open {}", config.state_dir);
+        }
+    }
     if (!event_bus_) {
         event_bus_ = std::make_unique<EventBus>();
     }
+
+    // SYS_WATCH pushes ride the event bus: a targeted STATE_CHANGED
+    // event lands on the watcher's queue the moment the key mutates
+    state_store_->set_watch_publisher(
+        [this](uint32_t watcher_id, const nlohmann::json& event) {
+            event_bus_->emit_to(watcher_id, KernelEventType::STATE_CHANGED, event,
+                                event.value("agent_id", 0u));
+        });
     if (!mailbox_registry_) {
         mailbox_registry_ = std::make_unique<AgentMailboxRegistry>();
     }
@@ -110,7 +164,29 @@ Kernel::Kernel(const Config& config, Dependencies deps)
         permissions_store_ = std::make_unique<PermissionsStore>();
     }
     if (!async_tasks_) {
-        async_tasks_ = std::make_unique<AsyncTaskManager>();
+        async_tasks_ = std::make_unique<AsyncTaskManager>(
+            config.async_workers > 0 ? static_cast<size_t>(config.async_workers) : 0);
+    }
+
+    // Federation is opt-in: a listen address turns it on, peers are
+    // dialed (and redialed) from the main loop tick
+    std::string fed_listen = core::config::get_env_or("CLOVE_FED_LISTEN", "");
+    if (!fed_listen.empty()) {
+        std::vector<std::string> peers;
+        std::string peer_list = core::config::get_env_or("CLOVE_FED_PEERS", "");
+        for (size_t pos = 0; pos < peer_list.size();) {
+            size_t comma = peer_list.find(',', pos);
+            if (comma == std::string::npos) {
+                comma = peer_list.size();
+            }
+            if (comma > pos) {
+                peers.push_back(peer_list.substr(pos, comma - pos));
+            }
+            pos = comma + 1;
+        }
+        federation_ = std::make_unique<FederationManager>(
+            *reactor_, *mailbox_registry_, *state_store_, *agent_manager_,
+            fed_listen, std::move(peers));
     }
 
     context_ = std::make_unique<KernelContext>(KernelContext{
@@ -128,10 +204,23 @@ Kernel::Kernel(const Config& config, Dependencies deps)
         *mailbox_registry_,
         *permissions_store_,
         *async_tasks_,
-        *llm_queue_
+        *llm_queue_,
+        federation_.get()
     });
 
     syscall_router_ = std::make_unique<SyscallRouter>();
+
+    // Per-syscall audit feed, category per opcode from OPCODE_TABLE.
+    // The is_enabled check keeps disabled categories (log_syscalls is
+    // off by default) to a table load and a bool test per dispatch.
+    syscall_router_->set_observer(
+        [this](ipc::SyscallOp op, uint32_t agent_id, bool failed) {
+            const auto& info = opcode_info(op);
+            if (audit_logger_->get_config().is_enabled(info.audit)) {
+                audit_logger_->log(info.audit, info.name, agent_id, "", {}, !failed);
+            }
+        });
+
     modules_.push_back(std::make_unique<AgentSyscalls>(*context_));
     modules_.push_back(std::make_unique<AsyncSyscalls>(*context_));
     modules_.push_back(std::make_unique<AuditSyscalls>(*context_));
@@ -140,10 +229,14 @@ Kernel::Kernel(const Config& config, Dependencies deps)
     modules_.push_back(std::make_unique<FileSyscalls>(*context_));
     modules_.push_back(std::make_unique<IpcSyscalls>(*context_));
     modules_.push_back(std::make_unique<LlmSyscalls>(*context_));
-    modules_.push_back(std::make_unique<MetricsSyscalls>(*context_));
+    modules_.push_back(std::make_unique<MetricsSyscalls>(*context_,
+        [this](uint32_t agent_id, ipc::Message msg) {
+            return push_to_agent(agent_id, std::move(msg));
+        }));
     modules_.push_back(std::make_unique<NetworkSyscalls>(*context_));
     modules_.push_back(std::make_unique<PermissionSyscalls>(*context_));
-    modules_.push_back(std::make_unique<ReplaySyscalls>(*context_));
+    modules_.push_back(std::make_unique<ReplaySyscalls>(*context_,
+        [this](const ipc::Message& msg) { return syscall_router_->handle(msg); }));
     modules_.push_back(std::make_unique<StateSyscalls>(*context_));
     modules_.push_back(std::make_unique<TunnelSyscalls>(*context_,
         [this](const ipc::Message& msg) { return syscall_router_->handle(msg); }));
@@ -154,6 +247,60 @@ Kernel::Kernel(const Config& config, Dependencies deps)
             return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_NOOP, msg.payload);
         });
 
+    syscall_router_->register_handler(ipc::SyscallOp::SYS_TRACE,
+        [](const ipc::Message& msg) {
+            size_t limit = 256;
+            auto j = nlohmann::json::parse(msg.payload_str(), nullptr, false);
+            if (j.is_object() && j.contains("limit")) {
+                limit = std::min<size_t>(j["limit"].get<size_t>(), 4096);
+            }
+            json response;
+            response["success"] = true;
+            response["records"] = TraceRing::snapshot(limit);
+            return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_TRACE, response.dump());
+        });
+
+    // SYS_BATCH: payload is a sequence of serialized sub-messages, each
+    // dispatched in order with the responses coalesced into one frame.
+    // Saves a socket round trip per sub-syscall for bursty agents.
+    syscall_router_->register_handler(ipc::SyscallOp::SYS_BATCH,
+        [this](const ipc::Message& msg) {
+            std::vector<uint8_t> coalesced;
+            size_t offset = 0;
+
+            while (offset < msg.payload.size()) {
+                auto sub_size = ipc::Message::get_message_size(
+                    msg.payload.data() + offset, msg.payload.size() - offset);
+                if (!sub_size || offset + *sub_size > msg.payload.size()) {
+                    spdlog::warn("Agent {} sent malformed batch at offset {}",
+                        msg.agent_id, offset);
+                    break;
+                }
+
+                auto sub = ipc::Message::deserialize(
+                    msg.payload.data() + offset, *sub_size);
+                offset += *sub_size;
+                if (!sub) {
+                    continue;
+                }
+
+                // Sub-messages run as the batching agent; no nested batches
+                sub->agent_id = msg.agent_id;
+                if (sub->opcode == ipc::SyscallOp::SYS_BATCH) {
+                    spdlog::warn("Agent {} attempted nested SYS_BATCH", msg.agent_id);
+                    continue;
+                }
+
+                ipc::Message sub_response = syscall_router_->handle(*sub);
+                sub_response.agent_id = msg.agent_id;
+
+                auto serialized = sub_response.serialize();
+                coalesced.insert(coalesced.end(), serialized.begin(), serialized.end());
+            }
+
+            return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_BATCH, coalesced);
+        });
+
     syscall_router_->register_handler(ipc::SyscallOp::SYS_EXIT,
         [](const ipc::Message& msg) {
             spdlog::info("Agent {} requested exit", msg.agent_id);
@@ -205,16 +352,98 @@ bool Kernel::init() {
         return false;
     }
 
-    // Add server socket to reactor
-    int server_fd = socket_server_->get_server_fd();
-    reactor_->add(server_fd, EPOLLIN, [this](int fd, uint32_t events) {
-        on_server_event(fd, events);
-    });
+    // io_uring transport if requested, else server socket goes to the reactor
+    if (config_.use_io_uring) {
+        uring_transport_ = std::make_unique<ipc::UringTransport>(*socket_server_);
+        uring_transport_->set_on_disconnect([this](uint32_t agent_id) {
+            context_->mailbox_registry.unregister(agent_id);
+            async_tasks_->purge_agent(agent_id);
+            state_store_->unwatch(agent_id, 0);
+        });
+        if (!uring_transport_->init()) {
+            spdlog::warn("Falling back to epoll transport");
+            uring_transport_.reset();
+        }
+    }
+
+    // Federation sockets live on the main reactor, so this has to wait
+    // until the transport choice is settled: the uring transport
+    // bypasses the main reactor's poll entirely, and a federation
+    // started under it would register fds nobody ever polls and
+    // silently go deaf — better off than half-on.
+    if (federation_ && uring_transport_) {
+        spdlog::warn("Federation disabled: CLOVE_FED_LISTEN requires the epoll "
+                     "transport (unset CLOVE_IO_URING to use federation)");
+        federation_.reset();
+        context_->federation = nullptr;
+    }
+    if (federation_ && !federation_->start()) {
+        federation_.reset();
+        context_->federation = nullptr;
+    }
+
+    if (!uring_transport_) {
+        int server_fd = socket_server_->get_server_fd();
+        reactor_->add(server_fd, EPOLLIN, [this](int fd, uint32_t events) {
+            on_server_event(fd, events);
+        });
+
+        // Shard reactors for client fds; each polls on its own thread so
+        // one saturated connection no longer starves the rest
+        size_t shards = config_.reactor_shards > 0
+            ? static_cast<size_t>(config_.reactor_shards)
+            : std::max(1u, std::thread::hardware_concurrency());
+        if (shards > 1) {
+            for (size_t i = 0; i < shards; i++) {
+                auto shard = std::make_unique<Reactor>();
+                if (!shard->init()) {
+                    spdlog::error("Failed to initialize shard reactor {}", i);
+                    return false;
+                }
+                shard_reactors_.push_back(std::move(shard));
+            }
+            spdlog::info("Reactor sharding enabled ({} client shards)", shards);
+        }
+
+        // Push-completion queues: one per reactor, woken by eventfd
+        for (size_t i = 0; i < 1 + shard_reactors_.size(); i++) {
+            auto queue = std::make_unique<PushQueue>();
+            queue->event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (queue->event_fd < 0) {
+                spdlog::error("Failed to create push eventfd: {}", strerror(errno));
+                return false;
+            }
+            reactor_at(i).add(queue->event_fd, EPOLLIN,
+                [this, i](int, uint32_t) { drain_push_queue(i); });
+            push_queues_.push_back(std::move(queue));
+        }
+
+        async_tasks_->set_completion_handler(
+            [this](uint32_t agent_id, const AsyncTaskManager::AsyncResult& result) {
+                json entry;
+                entry["request_id"] = result.request_id;
+                entry["opcode"] = static_cast<uint8_t>(result.opcode);
+                entry["opcode_name"] = ipc::opcode_to_string(result.opcode);
+                entry["payload"] = result.payload;
+
+                json payload;
+                payload["success"] = true;
+                payload["push"] = true;
+                payload["results"] = json::array({entry});
+                payload["count"] = 1;
+
+                // false -> disconnected, park for SYS_ASYNC_POLL
+                return push_to_agent(agent_id,
+                    ipc::Message(agent_id, ipc::SyscallOp::SYS_ASYNC_POLL,
+                                 payload.dump()));
+            });
+    }
 
     // Set up signal handlers
     g_kernel = this;
     signal(SIGINT, signal_handler);
     signal(SIGTERM, signal_handler);
+    signal(SIGHUP, reload_handler);
 
     // Set up restart event callback for auto-recovery notifications
     agent_manager_->set_restart_event_callback(
@@ -232,6 +461,28 @@ bool Kernel::init() {
             }
         });
 
+    // Watch each spawned agent's pidfd so exits arrive as reactor events
+    // instead of waiting for the periodic sweep, and arm PSI triggers on
+    // its cgroup so RESOURCE_WARNING fires the moment it starts stalling.
+    // The uring transport bypasses the main reactor's poll, so it keeps
+    // the sweep-only path and skips pressure monitoring.
+    if (!uring_transport_) {
+        pressure_monitor_ = std::make_unique<PressureMonitor>(*reactor_, *event_bus_);
+        pressure_monitor_->set_rebalance_cpu(
+            core::config::get_env_or("CLOVE_PSI_REBALANCE", "0") == "1");
+
+        agent_manager_->set_spawn_observer(
+            [this](const std::string& agent_name, pid_t pid) {
+                watch_agent_pidfd(agent_name, pid);
+
+                auto agent = agent_manager_->get_agent(agent_name);
+                if (agent && agent->get_isolation_status().cgroups_available) {
+                    pressure_monitor_->watch_agent(agent->id(), agent_name,
+                        "/sys/fs/cgroup/clove/" + agent_name + "_" + std::to_string(agent->id()));
+                }
+            });
+    }
+
     // Initialize tunnel client
     if (tunnel_client_->init()) {
         spdlog::info("Tunnel client initialized");
@@ -255,6 +506,11 @@ bool Kernel::init() {
         }
     }
 
+    // Adopt a checkpoint from the previous kernel, if one was left: the
+    // socket is already listening, so respawned agents reconnect to a
+    // kernel that remembers them
+    load_checkpoint();
+
     spdlog::info("Kernel initialized successfully");
     spdlog::info("Sandboxing: {}", config_.enable_sandboxing ? "enabled" : "disabled");
     spdlog::info("LLM: {} ({})",
@@ -270,8 +526,19 @@ void Kernel::run() {
     spdlog::info("Listening on: {}", config_.socket_path);
     spdlog::info("Press Ctrl+C to exit");
 
+    for (auto& shard : shard_reactors_) {
+        shard_threads_.emplace_back([&shard] {
+            placement::pin_current(placement::ThreadClass::REACTOR);
+            shard->run();
+        });
+    }
+
+    // The accept/dispatch loop below counts as a reactor thread too
+    placement::pin_current(placement::ThreadClass::REACTOR);
+
     while (running_) {
-        int n = reactor_->poll(100);
+        int n = uring_transport_ ? uring_transport_->poll(100)
+                                 : reactor_->poll(100);
         if (n < 0) {
             spdlog::error("Reactor error, exiting");
             break;
@@ -282,20 +549,175 @@ void Kernel::run() {
             module->on_tick();
         }
 
-        // Reap dead agents and queue restarts if needed
-        agent_manager_->reap_and_restart_agents();
+        // Federation housekeeping: gossip names/load, redial lost peers
+        if (federation_) {
+            federation_->on_tick();
+        }
+
+        // SIGHUP: rebuild the config snapshot and push the knobs that
+        // can change live into their subsystems
+        if (g_reload_requested) {
+            g_reload_requested = 0;
+            apply_config_reload();
+        }
+
+        // Reap dead agents and queue restarts if needed. With pidfd
+        // reaping active, exits already arrive as reactor events and the
+        // full scan drops to a slow safety net.
+        auto now = std::chrono::steady_clock::now();
+        if (!pidfd_reaping_ || now - last_reap_sweep_ >= std::chrono::seconds(5)) {
+            agent_manager_->reap_and_restart_agents();
+            last_reap_sweep_ = now;
+        }
 
         // Process any pending restarts (with backoff)
         agent_manager_->process_pending_restarts();
     }
 
     spdlog::info("Kernel shutting down...");
+
+    // Registries are still fully populated here — capture them before
+    // anything is torn down
+    save_checkpoint();
+
+    for (auto& shard : shard_reactors_) {
+        shard->stop();
+    }
+    for (auto& thread : shard_threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    if (uring_transport_) {
+        uring_transport_->stop();
+    }
     tunnel_client_->shutdown();
     agent_manager_->stop_all();
     socket_server_->stop();
     spdlog::info("Kernel stopped");
 }
 
+std::string Kernel::checkpoint_path() const {
+    return config_.state_dir + "/kernel.ckpt";
+}
+
+void Kernel::save_checkpoint() {
+    if (config_.state_dir.empty()) {
+        return;  // nowhere to persist — same gating as the StateStore WAL
+    }
+
+    json image;
+
+    // Agents to respawn, plus the highest ID seen anywhere so the next
+    // boot can fence its ID counter past everything in the image
+    uint32_t max_id = 0;
+    json agents = json::array();
+    for (const auto& agent : agent_manager_->list_agents()) {
+        agents.push_back({
+            {"id", agent->id()},
+            {"config", agent->config().to_json()},
+        });
+        max_id = std::max(max_id, agent->id());
+    }
+    image["agents"] = std::move(agents);
+
+    image["mailboxes"] = mailbox_registry_->export_state();
+    for (const auto& [name, id] : image["mailboxes"]["names"].items()) {
+        max_id = std::max(max_id, id.get<uint32_t>());
+    }
+    image["event_subscriptions"] = event_bus_->export_subscriptions();
+    image["permissions"] = permissions_store_->export_state();
+    image["max_agent_id"] = max_id;
+
+    checkpoint::write_image(checkpoint_path(), image);
+}
+
+void Kernel::load_checkpoint() {
+    if (config_.state_dir.empty()) {
+        return;
+    }
+
+    auto image = checkpoint::read_image(checkpoint_path());
+    if (!image) {
+        return;
+    }
+    // Consume the image immediately: if this boot dies, the next one
+    // must not adopt agents the intervening run may have killed
+    ::unlink(checkpoint_path().c_str());
+
+    // Fence the ID counter first so restored registrations can never
+    // collide with freshly issued IDs
+    runtime::AgentProcess::reserve_ids_through(image->value("max_agent_id", 0u));
+
+    mailbox_registry_->import_state(image->value("mailboxes", json::object()));
+    event_bus_->import_subscriptions(image->value("event_subscriptions", json::array()));
+    permissions_store_->import_state(image->value("permissions", json::object()));
+
+    int respawned = 0;
+    for (const auto& entry : image->value("agents", json::array())) {
+        auto config = runtime::AgentConfig::from_json(entry.value("config", json::object()));
+        uint32_t preserved_id = entry.value("id", 0u);
+        if (agent_manager_->spawn_agent(config, preserved_id)) {
+            respawned++;
+        } else {
+            spdlog::warn("Checkpoint: failed to respawn agent {} (id={})",
+                         config.name, preserved_id);
+        }
+    }
+
+    spdlog::info("Checkpoint adopted: {} agents respawned under preserved IDs",
+                 respawned);
+}
+
+void Kernel::apply_config_reload() {
+    uint64_t version = core::config::reload();
+    auto snap = core::config::snapshot();
+    spdlog::info("Reloading configuration (snapshot v{})", version);
+
+    // LLM concurrency window resizes live; the queue parks or spawns
+    // workers as needed without dropping in-flight calls
+    int llm_concurrency = snap->get_int_or("CLOVE_LLM_CONCURRENCY", config_.llm_concurrency);
+    if (llm_concurrency > 0 && llm_concurrency != config_.llm_concurrency) {
+        spdlog::info("LLM concurrency: {} -> {}", config_.llm_concurrency, llm_concurrency);
+        llm_queue_->set_max_concurrent(static_cast<size_t>(llm_concurrency));
+        config_.llm_concurrency = llm_concurrency;
+    }
+
+    // PSI rebalance policy is a plain toggle
+    if (pressure_monitor_) {
+        pressure_monitor_->set_rebalance_cpu(
+            snap->get_or("CLOVE_PSI_REBALANCE", "0") == "1");
+    }
+
+    // Audit knobs: override only the fields the file actually sets so
+    // settings applied via SYS_AUDIT_CONFIGURE survive unrelated reloads
+    AuditConfig audit = audit_logger_->get_config();
+    bool audit_changed = false;
+    if (auto v = snap->get_or("CLOVE_AUDIT_MAX_ENTRIES", ""); !v.empty()) {
+        audit.max_entries = static_cast<size_t>(std::max(snap->get_int_or("CLOVE_AUDIT_MAX_ENTRIES", 0), 1));
+        audit_changed = true;
+    }
+    if (auto v = snap->get_or("CLOVE_AUDIT_SYSCALLS", ""); !v.empty()) {
+        audit.log_syscalls = v == "1";
+        audit_changed = true;
+    }
+    if (auto v = snap->get_or("CLOVE_AUDIT_SAMPLE_SYSCALLS", ""); !v.empty()) {
+        try { audit.sample_syscalls = std::stod(v); } catch (...) {}
+        audit_changed = true;
+    }
+    if (audit_changed) {
+        audit_logger_->set_config(audit);
+    }
+
+    // Worker-pool sizes (async executor, reactor shards) are fixed at
+    // construction; a changed CLOVE_ASYNC_WORKERS or
+    // CLOVE_REACTOR_SHARDS still needs a restart
+    if (snap->get_int_or("CLOVE_ASYNC_WORKERS", config_.async_workers) != config_.async_workers ||
+        snap->get_int_or("CLOVE_REACTOR_SHARDS", config_.reactor_shards) != config_.reactor_shards) {
+        spdlog::warn("Worker/shard counts changed in config; these apply on next restart");
+    }
+}
+
 void Kernel::shutdown() {
     running_ = false;
 }
@@ -304,6 +726,17 @@ runtime::AgentManager& Kernel::agents() {
     return *agent_manager_;
 }
 
+size_t Kernel::pick_client_queue() {
+    if (shard_reactors_.empty()) {
+        return 0;
+    }
+    return 1 + next_shard_.fetch_add(1) % shard_reactors_.size();
+}
+
+Reactor& Kernel::reactor_at(size_t queue_idx) {
+    return queue_idx == 0 ? *reactor_ : *shard_reactors_[queue_idx - 1];
+}
+
 void Kernel::on_server_event(int fd, uint32_t events) {
     if (events & EPOLLIN) {
         // Accept new connections
@@ -313,34 +746,130 @@ void Kernel::on_server_event(int fd, uint32_t events) {
                 break;
             }
 
-            // Add client to reactor
-            reactor_->add(client_fd, EPOLLIN | EPOLLHUP | EPOLLERR,
-                [this](int cfd, uint32_t ev) {
-                    on_client_event(cfd, ev);
+            // Assign the client to a shard; all of its syscall dispatch
+            // happens on that shard's thread from here on.
+            // Edge-triggered: handle_client/flush_client drain until EAGAIN,
+            // so we only need the transition wakeups
+            size_t queue_idx = pick_client_queue();
+            Reactor& owner = reactor_at(queue_idx);
+            owner.add(client_fd, EPOLLIN | EPOLLHUP | EPOLLERR | EPOLLET,
+                [this, &owner](int cfd, uint32_t ev) {
+                    on_client_event(owner, cfd, ev);
                 });
+
+            // Route for pushed async completions
+            uint32_t agent_id = socket_server_->agent_id_for_fd(client_fd);
+            if (agent_id > 0) {
+                std::lock_guard<std::mutex> lock(routes_mutex_);
+                agent_routes_[agent_id] = {client_fd, queue_idx};
+            }
         }
     }
 }
 
-void Kernel::on_client_event(int fd, uint32_t events) {
+void Kernel::watch_agent_pidfd(const std::string& agent_name, pid_t pid) {
+    int pidfd = static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+    if (pidfd < 0) {
+        // Older kernel without pidfd_open - the periodic sweep still covers us
+        spdlog::debug("pidfd_open failed for agent {} (pid={}): {}",
+            agent_name, pid, strerror(errno));
+        return;
+    }
+
+    // A pidfd becomes readable when the process exits; the handler drops
+    // the fd and runs the same reap + restart path as the periodic sweep
+    bool added = reactor_->add(pidfd, static_cast<uint32_t>(EventType::READABLE),
+        [this, agent_name](int fd, uint32_t) {
+            reactor_->remove(fd);
+            close(fd);
+            spdlog::debug("Agent {} exit delivered via pidfd", agent_name);
+            agent_manager_->reap_and_restart_agents();
+            agent_manager_->process_pending_restarts();
+        });
+
+    if (!added) {
+        close(pidfd);
+        return;
+    }
+
+    pidfd_reaping_ = true;
+}
+
+void Kernel::drop_client(Reactor& owner, int fd) {
+    owner.remove(fd);
+    uint32_t agent_id = socket_server_->remove_client(fd);
+    if (agent_id > 0) {
+        context_->mailbox_registry.unregister(agent_id);
+        async_tasks_->purge_agent(agent_id);
+        state_store_->unwatch(agent_id, 0);
+        std::lock_guard<std::mutex> lock(routes_mutex_);
+        agent_routes_.erase(agent_id);
+    }
+}
+
+bool Kernel::push_to_agent(uint32_t agent_id, ipc::Message msg) {
+    if (push_queues_.empty()) {
+        return false;  // io_uring transport: no push plumbing
+    }
+
+    std::pair<int, size_t> route;
+    {
+        std::lock_guard<std::mutex> lock(routes_mutex_);
+        auto it = agent_routes_.find(agent_id);
+        if (it == agent_routes_.end()) {
+            return false;
+        }
+        route = it->second;
+    }
+
+    auto& queue = *push_queues_[route.second];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.items.emplace_back(route.first, std::move(msg));
+    }
+    uint64_t one = 1;
+    if (write(queue.event_fd, &one, sizeof(one)) < 0) {
+        spdlog::warn("Push eventfd write failed: {}", strerror(errno));
+    }
+    return true;
+}
+
+void Kernel::drain_push_queue(size_t queue_idx) {
+    auto& queue = *push_queues_[queue_idx];
+
+    uint64_t val;
+    while (read(queue.event_fd, &val, sizeof(val)) > 0) {
+    }
+
+    std::vector<std::pair<int, ipc::Message>> items;
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        items.swap(queue.items);
+    }
+
+    for (auto& [fd, msg] : items) {
+        socket_server_->push_message(fd, msg);
+        if (!socket_server_->flush_client(fd)) {
+            drop_client(reactor_at(queue_idx), fd);
+            continue;
+        }
+        update_client_events(reactor_at(queue_idx), fd);
+    }
+}
+
+void Kernel::on_client_event(Reactor& owner, int fd, uint32_t events) {
     // Handle errors and hangups
     if (events & (EPOLLHUP | EPOLLERR)) {
-        reactor_->remove(fd);
-        uint32_t agent_id = socket_server_->remove_client(fd);
-        if (agent_id > 0) {
-            context_->mailbox_registry.unregister(agent_id);
-        }
+        drop_client(owner, fd);
         return;
     }
 
-    // Handle readable
+    // Handle readable (flush eagerly after: with edge-triggered EPOLLOUT
+    // we'd otherwise wait a poll cycle for the write edge)
     if (events & EPOLLIN) {
-        if (!socket_server_->handle_client(fd)) {
-            reactor_->remove(fd);
-            uint32_t agent_id = socket_server_->remove_client(fd);
-            if (agent_id > 0) {
-                context_->mailbox_registry.unregister(agent_id);
-            }
+        if (!socket_server_->handle_client(fd) ||
+            !socket_server_->flush_client(fd)) {
+            drop_client(owner, fd);
             return;
         }
     }
@@ -348,25 +877,21 @@ void Kernel::on_client_event(int fd, uint32_t events) {
     // Handle writable
     if (events & EPOLLOUT) {
         if (!socket_server_->flush_client(fd)) {
-            reactor_->remove(fd);
-            uint32_t agent_id = socket_server_->remove_client(fd);
-            if (agent_id > 0) {
-                context_->mailbox_registry.unregister(agent_id);
-            }
+            drop_client(owner, fd);
             return;
         }
     }
 
     // Update events based on write buffer
-    update_client_events(fd);
+    update_client_events(owner, fd);
 }
 
-void Kernel::update_client_events(int fd) {
-    uint32_t events = EPOLLIN | EPOLLHUP | EPOLLERR;
+void Kernel::update_client_events(Reactor& owner, int fd) {
+    uint32_t events = EPOLLIN | EPOLLHUP | EPOLLERR | EPOLLET;
     if (socket_server_->client_wants_write(fd)) {
         events |= EPOLLOUT;
     }
-    reactor_->modify(fd, events);
+    owner.modify(fd, events);
 }
 
 ipc::Message Kernel::handle_message(const ipc::Message& msg) {
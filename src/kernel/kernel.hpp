@@ -9,8 +9,13 @@
  */
 #pragma once
 #include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include "kernel/config.hpp"
 #include "ipc/protocol.hpp"
@@ -18,6 +23,7 @@
 
 namespace clove::ipc {
 class SocketServer;
+class UringTransport;
 } // namespace clove::ipc
 
 namespace clove::runtime {
@@ -45,7 +51,9 @@ class ExecutionLogger;
 class EventBus;
 class KernelContext;
 class KernelModule;
+class FederationManager;
 class PermissionsStore;
+class PressureMonitor;
 class Reactor;
 class StateStore;
 class SyscallRouter;
@@ -102,11 +110,42 @@ public:
     const Config& get_config() const { return config_; }
 
 private:
+    // Rebuild the config snapshot (SIGHUP) and apply the live-tunable
+    // knobs to their subsystems
+    void apply_config_reload();
+
+    // Kernel-wide checkpoint image (requires state_dir): written on
+    // clean shutdown, adopted and consumed by the next boot
+    std::string checkpoint_path() const;
+    void save_checkpoint();
+    void load_checkpoint();
+
     Config config_;
     std::atomic<bool> running_{false};
 
     std::unique_ptr<Reactor> reactor_;
     std::unique_ptr<ipc::SocketServer> socket_server_;
+    std::unique_ptr<ipc::UringTransport> uring_transport_;
+
+    // Client fds are spread over N shard reactors (assigned round-robin at
+    // accept), each polled on its own thread; the main reactor keeps the
+    // listening socket and periodic work. Empty when sharding is off.
+    std::vector<std::unique_ptr<Reactor>> shard_reactors_;
+    std::vector<std::thread> shard_threads_;
+    std::atomic<size_t> next_shard_{0};
+
+    // Push-completion plumbing: async workers enqueue finished results on
+    // the owning reactor's queue and wake it via eventfd; the reactor
+    // thread writes them into the connection it owns. Queue 0 belongs to
+    // the main reactor, 1..N to the shards.
+    struct PushQueue {
+        int event_fd = -1;
+        std::mutex mutex;
+        std::vector<std::pair<int, ipc::Message>> items;
+    };
+    std::vector<std::unique_ptr<PushQueue>> push_queues_;
+    std::mutex routes_mutex_;
+    std::unordered_map<uint32_t, std::pair<int, size_t>> agent_routes_; // agent -> (fd, queue)
     std::unique_ptr<runtime::AgentManager> agent_manager_;
     std::unique_ptr<worlds::WorldEngine> world_engine_;
     std::unique_ptr<services::tunnel::TunnelClient> tunnel_client_;
@@ -126,13 +165,39 @@ private:
 
     // Event handlers
     void on_server_event(int fd, uint32_t events);
-    void on_client_event(int fd, uint32_t events);
+    void on_client_event(Reactor& owner, int fd, uint32_t events);
 
     // Message handler
     ipc::Message handle_message(const ipc::Message& msg);
 
     // Update client in reactor (for write events)
-    void update_client_events(int fd);
+    void update_client_events(Reactor& owner, int fd);
+
+    // Queue index (0 = main reactor, 1..N = shards) for the next client
+    size_t pick_client_queue();
+    Reactor& reactor_at(size_t queue_idx);
+
+    // Tear down a client connection and its bookkeeping
+    void drop_client(Reactor& owner, int fd);
+
+    // Register an agent's pidfd on the main reactor so its exit wakes the
+    // loop immediately instead of waiting for the periodic reap sweep
+    void watch_agent_pidfd(const std::string& agent_name, pid_t pid);
+    bool pidfd_reaping_ = false;
+    std::chrono::steady_clock::time_point last_reap_sweep_{};
+
+    // PSI triggers on agent cgroups, polled via the main reactor
+    std::unique_ptr<PressureMonitor> pressure_monitor_;
+
+    // Kernel-to-kernel clustering; null unless CLOVE_FED_LISTEN is set
+    std::unique_ptr<FederationManager> federation_;
+
+    // Deliver queued push completions on the owning reactor's thread
+    void drain_push_queue(size_t queue_idx);
+
+    // Queue an unsolicited message for an agent's connection; false if
+    // the agent is not connected (or push delivery is unavailable)
+    bool push_to_agent(uint32_t agent_id, ipc::Message msg);
 };
 
 } // namespace clove::kernel
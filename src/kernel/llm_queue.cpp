@@ -1,10 +1,20 @@
 #include "kernel/llm_queue.hpp"
+#include "kernel/thread_placement.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
 
 namespace clove::kernel {
 
-LlmQueue::LlmQueue(services::llm::LLMClient& client)
-    : client_(client) {
-    worker_ = std::thread(&LlmQueue::worker_loop, this);
+LlmQueue::LlmQueue(services::llm::LLMClient& client, size_t max_concurrent,
+                   int cache_ttl_secs)
+    : client_(client),
+      max_concurrent_(std::max<size_t>(max_concurrent, 1)),
+      per_agent_limit_(std::max<size_t>(max_concurrent_ / 4, 1)),
+      cache_ttl_secs_(cache_ttl_secs) {
+    workers_.reserve(max_concurrent_);
+    for (size_t i = 0; i < max_concurrent_; ++i) {
+        workers_.emplace_back(&LlmQueue::worker_loop, this);
+    }
 }
 
 LlmQueue::~LlmQueue() {
@@ -13,8 +23,10 @@ LlmQueue::~LlmQueue() {
         stopping_ = true;
     }
     cv_.notify_all();
-    if (worker_.joinable()) {
-        worker_.join();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
     }
 }
 
@@ -22,46 +34,217 @@ std::future<services::llm::LLMResponse> LlmQueue::submit(uint32_t agent_id, cons
     Request req{agent_id, payload, std::promise<services::llm::LLMResponse>()};
     auto future = req.promise.get_future();
 
+    services::llm::LLMResponse cached;
+    if (cache_get(payload, cached)) {
+        req.promise.set_value(std::move(cached));
+        return future;
+    }
+
     {
         std::lock_guard<std::mutex> lock(mutex_);
-        auto& q = queues_[agent_id];
-        bool was_empty = q.empty();
-        q.push_back(std::move(req));
-        if (was_empty) {
-            round_robin_.push_back(agent_id);
+        if (pending_payloads_.count(payload)) {
+            // Identical request already queued or in flight: ride along
+            joiners_[payload].push_back(std::move(req.promise));
+            return future;
         }
+        pending_payloads_.insert(payload);
+        req.enqueued_at = std::chrono::steady_clock::now();
+        queues_[agent_id].push_back(std::move(req));
+        reschedule_locked(agent_id);
     }
     cv_.notify_one();
     return future;
 }
 
+void LlmQueue::submit_stream(uint32_t agent_id, const std::string& payload,
+                             std::function<void(const std::string&)> on_delta,
+                             std::function<void(services::llm::LLMResponse)> on_done) {
+    Request req;
+    req.agent_id = agent_id;
+    req.payload = payload;
+    req.on_delta = std::move(on_delta);
+    req.on_done = std::move(on_done);
+
+    req.enqueued_at = std::chrono::steady_clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queues_[agent_id].push_back(std::move(req));
+        reschedule_locked(agent_id);
+    }
+    cv_.notify_one();
+}
+
+void LlmQueue::set_max_concurrent(size_t n) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_concurrent_ = std::max<size_t>(n, 1);
+    per_agent_limit_ = std::max<size_t>(max_concurrent_ / 4, 1);
+    // Threads only ever grow; shrinking is handled by the dispatch gate
+    // in worker_loop, so no calls are interrupted mid-flight
+    while (workers_.size() < max_concurrent_) {
+        workers_.emplace_back(&LlmQueue::worker_loop, this);
+    }
+    cv_.notify_all();
+}
+
+void LlmQueue::reschedule_locked(uint32_t agent_id) {
+    if (in_rotation_.count(agent_id)) {
+        return;
+    }
+    auto queue_it = queues_.find(agent_id);
+    if (queue_it == queues_.end() || queue_it->second.empty()) {
+        return;
+    }
+    if (in_flight_[agent_id] >= per_agent_limit_) {
+        return;  // re-entered when one of its calls completes
+    }
+    round_robin_.push_back(agent_id);
+    in_rotation_.insert(agent_id);
+}
+
 void LlmQueue::worker_loop() {
+    // LLM calls block on the network; keep these threads off the
+    // reactor/async CPUs rather than giving them their own
+    placement::pin_current(placement::ThreadClass::BACKGROUND);
+
     while (true) {
         Request req;
         {
             std::unique_lock<std::mutex> lock(mutex_);
-            cv_.wait(lock, [this]() { return stopping_ || !round_robin_.empty(); });
+            // The dispatching_ gate lets max_concurrent_ shrink below
+            // the thread count at runtime: surplus workers just park here
+            cv_.wait(lock, [this]() {
+                return stopping_ ||
+                       (!round_robin_.empty() && dispatching_ < max_concurrent_);
+            });
             if (stopping_) {
                 break;
             }
 
             uint32_t agent_id = round_robin_.front();
             round_robin_.pop_front();
+            in_rotation_.erase(agent_id);
 
             auto& q = queues_[agent_id];
             req = std::move(q.front());
             q.pop_front();
+            in_flight_[agent_id]++;
+            dispatching_++;
 
-            if (!q.empty()) {
-                round_robin_.push_back(agent_id);
-            } else {
+            if (q.empty()) {
                 queues_.erase(agent_id);
+            } else {
+                reschedule_locked(agent_id);
+            }
+        }
+
+        queue_wait_hist_.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - req.enqueued_at).count()));
+
+        // A throw here would escape the worker thread and terminate the
+        // kernel; whatever the client trips over becomes an error response
+        auto guarded = [&](auto&& call) -> services::llm::LLMResponse {
+            try {
+                return call();
+            } catch (const std::exception& e) {
+                spdlog::warn("LLM request failed: {}", e.what());
+                return {false, "", 0, std::string("llm request failed: ") + e.what()};
+            }
+        };
+
+        if (req.on_delta) {
+            auto result = guarded([&] {
+                return client_.complete_streaming(req.payload, req.on_delta);
+            });
+            if (req.on_done) {
+                req.on_done(std::move(result));
+            }
+        } else {
+            auto result = guarded([&] {
+                return client_.complete_with_options(req.payload);
+            });
+            if (result.success) {
+                cache_put(req.payload, result);
+            }
+
+            std::vector<std::promise<services::llm::LLMResponse>> joined;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                pending_payloads_.erase(req.payload);
+                auto it = joiners_.find(req.payload);
+                if (it != joiners_.end()) {
+                    joined = std::move(it->second);
+                    joiners_.erase(it);
+                }
             }
+            for (auto& promise : joined) {
+                promise.set_value(result);
+            }
+            req.promise.set_value(std::move(result));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            dispatching_--;
+            auto it = in_flight_.find(req.agent_id);
+            if (it != in_flight_.end() && --it->second == 0) {
+                in_flight_.erase(it);
+            }
+            // The completed slot may unblock this agent's next request
+            reschedule_locked(req.agent_id);
         }
+        cv_.notify_one();
+    }
+}
+
+bool LlmQueue::cache_get(const std::string& payload, services::llm::LLMResponse& out) {
+    if (cache_ttl_secs_ <= 0) {
+        return false;
+    }
 
-        auto result = client_.complete_with_options(req.payload);
-        req.promise.set_value(result);
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    auto it = cache_.find(payload);
+    if (it == cache_.end()) {
+        return false;
+    }
+    if (std::chrono::steady_clock::now() > it->second.expires_at) {
+        cache_lru_.erase(it->second.lru_it);
+        cache_.erase(it);
+        return false;
     }
+
+    cache_lru_.splice(cache_lru_.begin(), cache_lru_, it->second.lru_it);
+    out = it->second.response;
+    return true;
+}
+
+void LlmQueue::cache_put(const std::string& payload, const services::llm::LLMResponse& response) {
+    if (cache_ttl_secs_ <= 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    auto it = cache_.find(payload);
+    if (it != cache_.end()) {
+        cache_lru_.splice(cache_lru_.begin(), cache_lru_, it->second.lru_it);
+        it->second.response = response;
+        it->second.expires_at = std::chrono::steady_clock::now() +
+                                std::chrono::seconds(cache_ttl_secs_);
+        return;
+    }
+
+    while (cache_.size() >= CACHE_MAX_ENTRIES) {
+        cache_.erase(cache_lru_.back());
+        cache_lru_.pop_back();
+    }
+
+    cache_lru_.push_front(payload);
+    cache_[payload] = CacheEntry{
+        response,
+        std::chrono::steady_clock::now() + std::chrono::seconds(cache_ttl_secs_),
+        cache_lru_.begin()
+    };
 }
 
 } // namespace clove::kernel
@@ -1,19 +1,29 @@
 #pragma once
+#include <chrono>
 #include <condition_variable>
 #include <cstdint>
 #include <deque>
+#include <list>
 #include <mutex>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <future>
+#include "metrics/histogram.hpp"
 #include "services/llm/client.hpp"
 
 namespace clove::kernel {
 
+// Fair dispatcher for SYS_THINK. Requests queue per agent and agents
+// take turns round-robin, but up to max_concurrent requests run in
+// flight at once (the provider handles parallel calls happily; a single
+// worker made queue wait dominate end-to-end latency). A per-agent
+// in-flight cap keeps one chatty agent from filling the whole window.
 class LlmQueue {
 public:
-    explicit LlmQueue(services::llm::LLMClient& client);
+    explicit LlmQueue(services::llm::LLMClient& client, size_t max_concurrent = 8,
+                      int cache_ttl_secs = 300);
     ~LlmQueue();
 
     LlmQueue(const LlmQueue&) = delete;
@@ -21,22 +31,78 @@ public:
 
     std::future<services::llm::LLMResponse> submit(uint32_t agent_id, const std::string& payload);
 
+    // Streaming submit: deltas are forwarded through on_delta as the
+    // provider produces them and on_done fires with the final response.
+    // Same queue, same fairness; streamed responses bypass the cache.
+    void submit_stream(uint32_t agent_id, const std::string& payload,
+                       std::function<void(const std::string&)> on_delta,
+                       std::function<void(services::llm::LLMResponse)> on_done);
+
+    // Resize the in-flight window at runtime (config reload). Raising
+    // it spawns extra workers; lowering it leaves surplus workers parked
+    // on the condition variable so in-flight calls finish undisturbed.
+    void set_max_concurrent(size_t n);
+
 private:
     struct Request {
         uint32_t agent_id;
         std::string payload;
         std::promise<services::llm::LLMResponse> promise;
+        std::function<void(const std::string&)> on_delta;     // set => streaming
+        std::function<void(services::llm::LLMResponse)> on_done;
+        std::chrono::steady_clock::time_point enqueued_at;
     };
 
     services::llm::LLMClient& client_;
+    size_t max_concurrent_;
+    size_t per_agent_limit_;
+
     std::mutex mutex_;
     std::condition_variable cv_;
     std::unordered_map<uint32_t, std::deque<Request>> queues_;
-    std::deque<uint32_t> round_robin_;
-    std::thread worker_;
+    std::deque<uint32_t> round_robin_;        // agents eligible to dispatch
+    std::unordered_set<uint32_t> in_rotation_; // membership guard for round_robin_
+    std::unordered_map<uint32_t, size_t> in_flight_;
+    size_t dispatching_ = 0;               // workers holding a request right now
+    std::vector<std::thread> workers_;
     bool stopping_ = false;
 
     void worker_loop();
+    // Caller holds mutex_: put agent back in rotation if it has pending
+    // work and headroom under its in-flight cap
+    void reschedule_locked(uint32_t agent_id);
+
+    // Coalescing: when a payload identical to one already queued or in
+    // flight is submitted, the new promise joins the existing call
+    // instead of spawning another — burst sets of duplicate prompts
+    // (one per document chunk, parallel pipelines) collapse into a
+    // single provider round trip whose result fans out to every waiter.
+    std::unordered_set<std::string> pending_payloads_;  // queued or in flight
+    std::unordered_map<std::string, std::vector<std::promise<services::llm::LLMResponse>>> joiners_;
+
+    // Response cache keyed by the exact request payload (which includes
+    // the model): agents re-issue identical classification and routing
+    // prompts constantly, and a duplicate within the TTL costs nothing.
+    // Exact-string keys rather than a digest — no collision can ever
+    // hand an agent someone else's completion. LRU-capped.
+    static constexpr size_t CACHE_MAX_ENTRIES = 1024;
+
+    struct CacheEntry {
+        services::llm::LLMResponse response;
+        std::chrono::steady_clock::time_point expires_at;
+        std::list<std::string>::iterator lru_it;
+    };
+
+    bool cache_get(const std::string& payload, services::llm::LLMResponse& out);
+    void cache_put(const std::string& payload, const services::llm::LLMResponse& response);
+
+    // Time from submit to a worker picking the request up
+    metrics::LatencyHistogram queue_wait_hist_{"llm_queue_wait_us"};
+
+    int cache_ttl_secs_;
+    std::mutex cache_mutex_;
+    std::unordered_map<std::string, CacheEntry> cache_;
+    std::list<std::string> cache_lru_;  // front = most recent
 };
 
 } // namespace clove::kernel
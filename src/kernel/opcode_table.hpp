@@ -0,0 +1,154 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "ipc/protocol.hpp"
+#include "kernel/audit_log.hpp"
+#include "kernel/permissions.hpp"
+
+namespace clove::kernel {
+
+// Capability an opcode needs before its handler may run, mapped onto
+// the AgentPermissions bools by capability_allowed() below
+enum class Capability : uint8_t {
+    NONE,   // no blanket gate (handler may still check finer-grained rules)
+    EXEC,
+    READ,
+    WRITE,
+    THINK,
+    SPAWN,
+    HTTP,
+};
+
+// How a syscall routes by default when the request doesn't say
+// {"async": ...} explicitly
+enum class AsyncMode : uint8_t {
+    SYNC,     // always on the dispatch thread
+    OPT_IN,   // sync unless the request asks for async
+    ASYNC,    // offloaded to the executor unless the request opts out
+};
+
+// Per-opcode metadata, one row per SyscallOp. Everything that used to
+// be re-derived per call — display name, audit category, capability,
+// async default, timeout default — is a single indexed load from a
+// table built at compile time. Adding an opcode is one row here plus
+// its handler registration.
+struct OpcodeInfo {
+    const char* name = "UNKNOWN";
+    Capability capability = Capability::NONE;
+    AuditCategory audit = AuditCategory::SYSCALL;
+    AsyncMode async_mode = AsyncMode::SYNC;
+    uint16_t default_timeout_sec = 0;
+};
+
+namespace detail {
+
+constexpr std::array<OpcodeInfo, 256> build_opcode_table() {
+    std::array<OpcodeInfo, 256> table{};
+    using Op = ipc::SyscallOp;
+
+    // Every row gets its wire name (opcode_to_string stays the single
+    // source for those); rows below override the defaults
+    for (size_t i = 0; i < table.size(); ++i) {
+        table[i].name = ipc::opcode_to_string(static_cast<Op>(i));
+    }
+
+    auto set = [&](Op op, Capability cap, AuditCategory audit,
+                   AsyncMode mode = AsyncMode::SYNC, uint16_t timeout_sec = 0) {
+        auto& row = table[static_cast<uint8_t>(op)];
+        row.capability = cap;
+        row.audit = audit;
+        row.async_mode = mode;
+        row.default_timeout_sec = timeout_sec;
+    };
+
+    set(Op::SYS_THINK, Capability::THINK, AuditCategory::SYSCALL, AsyncMode::ASYNC);
+    set(Op::SYS_EXEC,  Capability::EXEC,  AuditCategory::SECURITY, AsyncMode::ASYNC, 30);
+    set(Op::SYS_READ,  Capability::READ,  AuditCategory::SYSCALL, AsyncMode::OPT_IN);
+    set(Op::SYS_WRITE, Capability::WRITE, AuditCategory::SYSCALL, AsyncMode::OPT_IN);
+
+    set(Op::SYS_SPAWN,       Capability::SPAWN, AuditCategory::AGENT_LIFECYCLE);
+    set(Op::SYS_SPAWN_BATCH, Capability::SPAWN, AuditCategory::AGENT_LIFECYCLE);
+    set(Op::SYS_KILL,   Capability::NONE, AuditCategory::AGENT_LIFECYCLE);
+    set(Op::SYS_PAUSE,  Capability::NONE, AuditCategory::AGENT_LIFECYCLE);
+    set(Op::SYS_RESUME, Capability::NONE, AuditCategory::AGENT_LIFECYCLE);
+
+    set(Op::SYS_SEND,      Capability::NONE, AuditCategory::IPC);
+    set(Op::SYS_RECV,      Capability::NONE, AuditCategory::IPC);
+    set(Op::SYS_BROADCAST, Capability::NONE, AuditCategory::IPC);
+    set(Op::SYS_REGISTER,  Capability::NONE, AuditCategory::IPC);
+
+    set(Op::SYS_STORE,  Capability::NONE, AuditCategory::STATE_STORE);
+    set(Op::SYS_FETCH,  Capability::NONE, AuditCategory::STATE_STORE);
+    set(Op::SYS_DELETE, Capability::NONE, AuditCategory::STATE_STORE);
+    set(Op::SYS_KEYS,   Capability::NONE, AuditCategory::STATE_STORE);
+    set(Op::SYS_INCR,   Capability::NONE, AuditCategory::STATE_STORE);
+    set(Op::SYS_CAS,    Capability::NONE, AuditCategory::STATE_STORE);
+    set(Op::SYS_APPEND, Capability::NONE, AuditCategory::STATE_STORE);
+    set(Op::SYS_WATCH,  Capability::NONE, AuditCategory::STATE_STORE);
+    set(Op::SYS_UNWATCH, Capability::NONE, AuditCategory::STATE_STORE);
+
+    set(Op::SYS_GET_PERMS, Capability::NONE, AuditCategory::SECURITY);
+    set(Op::SYS_SET_PERMS, Capability::NONE, AuditCategory::SECURITY);
+
+    set(Op::SYS_HTTP, Capability::HTTP, AuditCategory::NETWORK, AsyncMode::ASYNC, 30);
+
+    set(Op::SYS_SUBSCRIBE,   Capability::NONE, AuditCategory::IPC);
+    set(Op::SYS_UNSUBSCRIBE, Capability::NONE, AuditCategory::IPC);
+    set(Op::SYS_POLL_EVENTS, Capability::NONE, AuditCategory::IPC);
+    set(Op::SYS_EMIT,        Capability::NONE, AuditCategory::IPC);
+
+    set(Op::SYS_WORLD_CREATE,   Capability::NONE, AuditCategory::WORLD);
+    set(Op::SYS_WORLD_DESTROY,  Capability::NONE, AuditCategory::WORLD);
+    set(Op::SYS_WORLD_LIST,     Capability::NONE, AuditCategory::WORLD);
+    set(Op::SYS_WORLD_JOIN,     Capability::NONE, AuditCategory::WORLD);
+    set(Op::SYS_WORLD_LEAVE,    Capability::NONE, AuditCategory::WORLD);
+    set(Op::SYS_WORLD_EVENT,    Capability::NONE, AuditCategory::WORLD);
+    set(Op::SYS_WORLD_STATE,    Capability::NONE, AuditCategory::WORLD);
+    set(Op::SYS_WORLD_SNAPSHOT, Capability::NONE, AuditCategory::WORLD);
+    set(Op::SYS_WORLD_RESTORE,  Capability::NONE, AuditCategory::WORLD);
+
+    set(Op::SYS_TUNNEL_CONNECT,      Capability::NONE, AuditCategory::NETWORK);
+    set(Op::SYS_TUNNEL_DISCONNECT,   Capability::NONE, AuditCategory::NETWORK);
+    set(Op::SYS_TUNNEL_STATUS,       Capability::NONE, AuditCategory::NETWORK);
+    set(Op::SYS_TUNNEL_LIST_REMOTES, Capability::NONE, AuditCategory::NETWORK);
+    set(Op::SYS_TUNNEL_CONFIG,       Capability::NONE, AuditCategory::NETWORK);
+
+    set(Op::SYS_METRICS_SYSTEM,      Capability::NONE, AuditCategory::RESOURCE);
+    set(Op::SYS_METRICS_AGENT,       Capability::NONE, AuditCategory::RESOURCE);
+    set(Op::SYS_METRICS_ALL_AGENTS,  Capability::NONE, AuditCategory::RESOURCE);
+    set(Op::SYS_METRICS_CGROUP,      Capability::NONE, AuditCategory::RESOURCE);
+    set(Op::SYS_METRICS_SUBSCRIBE,   Capability::NONE, AuditCategory::RESOURCE);
+    set(Op::SYS_METRICS_UNSUBSCRIBE, Capability::NONE, AuditCategory::RESOURCE);
+    set(Op::SYS_LLM_REPORT,          Capability::NONE, AuditCategory::RESOURCE);
+
+    set(Op::SYS_GET_AUDIT_LOG,    Capability::NONE, AuditCategory::SECURITY);
+    set(Op::SYS_SET_AUDIT_CONFIG, Capability::NONE, AuditCategory::SECURITY);
+
+    return table;
+}
+
+} // namespace detail
+
+inline constexpr std::array<OpcodeInfo, 256> OPCODE_TABLE = detail::build_opcode_table();
+
+constexpr const OpcodeInfo& opcode_info(ipc::SyscallOp op) {
+    return OPCODE_TABLE[static_cast<uint8_t>(op)];
+}
+
+// Map an opcode's required capability onto the agent's permission bits.
+// NONE always passes — the handler's finer-grained checks (path globs,
+// command lists, domain whitelist) still apply after this gate.
+inline bool capability_allowed(const AgentPermissions& perms, Capability cap) {
+    switch (cap) {
+        case Capability::NONE:  return true;
+        case Capability::EXEC:  return perms.can_exec;
+        case Capability::READ:  return perms.can_read;
+        case Capability::WRITE: return perms.can_write;
+        case Capability::THINK: return perms.can_think;
+        case Capability::SPAWN: return perms.can_spawn;
+        case Capability::HTTP:  return perms.can_http;
+    }
+    return false;
+}
+
+} // namespace clove::kernel
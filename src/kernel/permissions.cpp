@@ -2,7 +2,7 @@
 #include <spdlog/spdlog.h>
 #include <fnmatch.h>
 #include <algorithm>
-#include <regex>
+#include <string_view>
 #include <filesystem>
 #include <strings.h>
 
@@ -10,6 +10,114 @@ namespace fs = std::filesystem;
 
 namespace clove::kernel {
 
+namespace {
+
+// Expand a leading ~ to $HOME, same as PermissionChecker::path_matches
+std::string expand_home(const std::string& pattern) {
+    if (!pattern.empty() && pattern[0] == '~') {
+        const char* home = std::getenv("HOME");
+        if (home) {
+            return std::string(home) + pattern.substr(1);
+        }
+    }
+    return pattern;
+}
+
+// Iterative glob match with FNM_PATHNAME semantics: '*' and '?' match
+// anything except '/'. Single backtrack point per star is enough because
+// stars further right reset it.
+bool glob_match(std::string_view pattern, std::string_view str) {
+    size_t p = 0;
+    size_t s = 0;
+    size_t star = std::string_view::npos;
+    size_t mark = 0;
+
+    while (s < str.size()) {
+        if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            mark = s;
+        } else if (p < pattern.size() &&
+                   (pattern[p] == str[s] || (pattern[p] == '?' && str[s] != '/'))) {
+            p++;
+            s++;
+        } else if (star != std::string_view::npos && str[mark] != '/') {
+            // Grow the last star by one byte and retry (never across '/')
+            p = star + 1;
+            s = ++mark;
+        } else {
+            return false;
+        }
+    }
+
+    while (p < pattern.size() && pattern[p] == '*') {
+        p++;
+    }
+    return p == pattern.size();
+}
+
+} // namespace
+
+// ============================================================================
+// CompiledPathSet Implementation
+// ============================================================================
+
+CompiledPathSet::CompiledPathSet(const std::vector<std::string>& patterns) {
+    for (const auto& raw : patterns) {
+        std::string pattern = expand_home(raw);
+        if (contains_parent_ref(pattern)) {
+            // path_matches refuses patterns with ".." components, so
+            // these could never match anything
+            continue;
+        }
+
+        if (pattern.find('[') != std::string::npos) {
+            fallback_.push_back(std::move(pattern));
+            continue;
+        }
+
+        size_t meta = pattern.find_first_of("*?");
+        if (meta == std::string::npos) {
+            literals_.insert(std::move(pattern));
+        } else {
+            globs_.push_back({pattern.substr(0, meta), std::move(pattern)});
+        }
+    }
+}
+
+bool CompiledPathSet::matches(const std::string& path) const {
+    if (literals_.count(path) > 0) {
+        return true;
+    }
+
+    for (const auto& glob : globs_) {
+        if (path.compare(0, glob.prefix.size(), glob.prefix) == 0 &&
+            glob_match(glob.pattern, path)) {
+            return true;
+        }
+    }
+
+    for (const auto& pattern : fallback_) {
+        if (fnmatch(pattern.c_str(), path.c_str(), FNM_PATHNAME | FNM_NOESCAPE) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool CompiledPathSet::contains_parent_ref(const std::string& path) {
+    size_t pos = path.find("..");
+    while (pos != std::string::npos) {
+        bool starts = pos == 0 || path[pos - 1] == '/';
+        bool ends = pos + 2 == path.size() || path[pos + 2] == '/';
+        if (starts && ends) {
+            return true;
+        }
+        pos = path.find("..", pos + 1);
+    }
+    return false;
+}
+
 // ============================================================================
 // AgentPermissions Implementation
 // ============================================================================
@@ -87,6 +195,7 @@ AgentPermissions AgentPermissions::from_json(const nlohmann::json& j) {
         perms.max_exec_time_ms = j["max_exec_time_ms"].get<uint64_t>();
     }
 
+    perms.compile_path_matchers();
     return perms;
 }
 
@@ -181,9 +290,24 @@ AgentPermissions AgentPermissions::from_level(PermissionLevel level) {
             break;
     }
 
+    perms.compile_path_matchers();
     return perms;
 }
 
+void AgentPermissions::compile_path_matchers() {
+    read_matcher = CompiledPathSet(allowed_read_paths);
+    write_matcher = CompiledPathSet(allowed_write_paths);
+    blocked_matcher = CompiledPathSet(blocked_paths);
+
+    capability_mask = 0;
+    if (can_exec)  capability_mask |= CAP_EXEC;
+    if (can_read)  capability_mask |= CAP_READ;
+    if (can_write) capability_mask |= CAP_WRITE;
+    if (can_think) capability_mask |= CAP_THINK;
+    if (can_spawn) capability_mask |= CAP_SPAWN;
+    if (can_http)  capability_mask |= CAP_HTTP;
+}
+
 bool AgentPermissions::can_read_path(const std::string& path) const {
     if (!can_read) return false;
 
@@ -197,12 +321,16 @@ bool AgentPermissions::can_read_path(const std::string& path) const {
         // Use original path if canonicalization fails
     }
 
+    // A ".." component defeats pattern matching entirely, so only the
+    // allow-all default (empty allowed list) can pass
+    if (CompiledPathSet::contains_parent_ref(normalized)) {
+        return allowed_read_paths.empty();
+    }
+
     // Check blocked paths first
-    for (const auto& blocked : blocked_paths) {
-        if (PermissionChecker::path_matches(normalized, blocked)) {
-            spdlog::debug("Path blocked: {} matches {}", path, blocked);
-            return false;
-        }
+    if (blocked_matcher.matches(normalized)) {
+        spdlog::debug("Path blocked: {}", path);
+        return false;
     }
 
     // If no allowed paths specified, allow all (except blocked)
@@ -210,14 +338,7 @@ bool AgentPermissions::can_read_path(const std::string& path) const {
         return true;
     }
 
-    // Check if path matches any allowed pattern
-    for (const auto& allowed : allowed_read_paths) {
-        if (PermissionChecker::path_matches(normalized, allowed)) {
-            return true;
-        }
-    }
-
-    return false;
+    return read_matcher.matches(normalized);
 }
 
 bool AgentPermissions::can_write_path(const std::string& path) const {
@@ -234,12 +355,16 @@ bool AgentPermissions::can_write_path(const std::string& path) const {
         // Use original path if canonicalization fails
     }
 
+    // A ".." component defeats pattern matching entirely, so only the
+    // allow-all default (empty allowed list) can pass
+    if (CompiledPathSet::contains_parent_ref(normalized)) {
+        return allowed_write_paths.empty();
+    }
+
     // Check blocked paths first
-    for (const auto& blocked : blocked_paths) {
-        if (PermissionChecker::path_matches(normalized, blocked)) {
-            spdlog::debug("Path blocked for write: {} matches {}", path, blocked);
-            return false;
-        }
+    if (blocked_matcher.matches(normalized)) {
+        spdlog::debug("Path blocked for write: {}", path);
+        return false;
     }
 
     // If no allowed paths specified, allow all (except blocked)
@@ -247,14 +372,7 @@ bool AgentPermissions::can_write_path(const std::string& path) const {
         return true;
     }
 
-    // Check if path matches any allowed pattern
-    for (const auto& allowed : allowed_write_paths) {
-        if (PermissionChecker::path_matches(normalized, allowed)) {
-            return true;
-        }
-    }
-
-    return false;
+    return write_matcher.matches(normalized);
 }
 
 bool AgentPermissions::can_execute_command(const std::string& command) const {
@@ -349,25 +467,11 @@ void AgentPermissions::record_llm_usage(uint32_t tokens) {
 // ============================================================================
 
 bool PermissionChecker::path_matches(const std::string& path, const std::string& pattern) {
-    // Expand ~ to home directory
-    std::string expanded_pattern = pattern;
-    if (!pattern.empty() && pattern[0] == '~') {
-        const char* home = std::getenv("HOME");
-        if (home) {
-            expanded_pattern = std::string(home) + pattern.substr(1);
-        }
-    }
-
-    auto has_parent_ref = [](const std::string& value) {
-        for (const auto& part : fs::path(value)) {
-            if (part == "..") {
-                return true;
-            }
-        }
-        return false;
-    };
+    // One-off check; the per-syscall paths go through CompiledPathSet
+    std::string expanded_pattern = expand_home(pattern);
 
-    if (has_parent_ref(path) || has_parent_ref(expanded_pattern)) {
+    if (CompiledPathSet::contains_parent_ref(path) ||
+        CompiledPathSet::contains_parent_ref(expanded_pattern)) {
         return false;
     }
 
@@ -8,11 +8,47 @@
 #include <string>
 #include <vector>
 #include <unordered_set>
-#include <regex>
 #include <nlohmann/json.hpp>
 
 namespace clove::kernel {
 
+// A pattern list compiled once into a form that is cheap to match.
+//
+// can_read_path/can_write_path run on every SYS_READ/SYS_WRITE, and the
+// naive loop re-parsed every glob (plus ~-expansion and ".." screening)
+// per call. Compiling splits the list into three tiers: exact literals
+// (hash lookup), wildcard patterns with a literal prefix (memcmp reject,
+// then an iterative glob matcher), and the rare bracket-expression
+// patterns (left to fnmatch). Matching semantics are identical to
+// fnmatch(FNM_PATHNAME | FNM_NOESCAPE): '*' and '?' never cross '/'.
+class CompiledPathSet {
+public:
+    CompiledPathSet() = default;
+    explicit CompiledPathSet(const std::vector<std::string>& patterns);
+
+    // True if path matches any compiled pattern. Callers screen the
+    // path for ".." components first (see contains_parent_ref).
+    bool matches(const std::string& path) const;
+
+    bool empty() const {
+        return literals_.empty() && globs_.empty() && fallback_.empty();
+    }
+
+    // Cheap scan for a ".." path component (patterns containing one are
+    // dropped at compile time — they can never match)
+    static bool contains_parent_ref(const std::string& path);
+
+private:
+    struct Glob {
+        std::string prefix;   // literal bytes before the first metachar
+        std::string pattern;  // full expanded pattern
+    };
+
+    std::unordered_set<std::string> literals_;  // no metachars: exact match
+    std::vector<Glob> globs_;                   // '*'/'?' only
+    std::vector<std::string> fallback_;         // '[...]': matched via fnmatch
+};
+
 // Permission levels (presets)
 enum class PermissionLevel {
     UNRESTRICTED,   // Everything allowed (dev mode)
@@ -81,6 +117,31 @@ struct AgentPermissions {
 
     // Record LLM usage
     void record_llm_usage(uint32_t tokens);
+
+    // Capability bits, one per can_* boolean. capability_mask packs the
+    // current values so a single byte answers "what may this agent do"
+    // without touching the rest of the struct.
+    static constexpr uint8_t CAP_EXEC  = 1 << 0;
+    static constexpr uint8_t CAP_READ  = 1 << 1;
+    static constexpr uint8_t CAP_WRITE = 1 << 2;
+    static constexpr uint8_t CAP_THINK = 1 << 3;
+    static constexpr uint8_t CAP_SPAWN = 1 << 4;
+    static constexpr uint8_t CAP_HTTP  = 1 << 5;
+
+    // Rebuild the compiled matchers and capability mask below from the
+    // fields above. from_json/from_level call this; anything else that
+    // edits the path lists or can_* flags must call it again or the
+    // compiled state goes stale.
+    void compile_path_matchers();
+
+    // Compiled forms of allowed_read_paths / allowed_write_paths /
+    // blocked_paths (see CompiledPathSet)
+    CompiledPathSet read_matcher;
+    CompiledPathSet write_matcher;
+    CompiledPathSet blocked_matcher;
+
+    // Packed CAP_* snapshot of the can_* booleans
+    uint8_t capability_mask = 0;
 };
 
 // Permission checker utility
@@ -14,11 +14,86 @@ AgentPermissions& PermissionsStore::get_or_create(uint32_t agent_id) {
 void PermissionsStore::set_permissions(uint32_t agent_id, const AgentPermissions& perms) {
     std::lock_guard<std::mutex> lock(mutex_);
     permissions_[agent_id] = perms;
+    path_cache_.erase(agent_id);
 }
 
 void PermissionsStore::set_level(uint32_t agent_id, PermissionLevel level) {
     std::lock_guard<std::mutex> lock(mutex_);
     permissions_[agent_id] = AgentPermissions::from_level(level);
+    path_cache_.erase(agent_id);
+}
+
+bool PermissionsStore::check_path(uint32_t agent_id, const std::string& path, PathAccess access) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto cache_it = path_cache_.find(agent_id);
+        if (cache_it != path_cache_.end()) {
+            auto& cache = cache_it->second;
+            auto it = cache.verdicts.find(path);
+            if (it != cache.verdicts.end()) {
+                int8_t verdict = access == PathAccess::READ ? it->second.read
+                                                            : it->second.write;
+                if (verdict >= 0) {
+                    cache.lru.splice(cache.lru.begin(), cache.lru, it->second.lru_it);
+                    return verdict == 1;
+                }
+            }
+        }
+    }
+
+    // Miss: evaluate outside the lock — can_*_path canonicalizes against
+    // the filesystem. The AgentPermissions reference stays valid because
+    // entries are only ever assigned in place, never erased.
+    AgentPermissions& perms = get_or_create(agent_id);
+    bool allowed = access == PathAccess::READ ? perms.can_read_path(path)
+                                              : perms.can_write_path(path);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& cache = path_cache_[agent_id];
+    auto it = cache.verdicts.find(path);
+    if (it == cache.verdicts.end()) {
+        if (cache.verdicts.size() >= PATH_CACHE_ENTRIES) {
+            cache.verdicts.erase(cache.lru.back());
+            cache.lru.pop_back();
+        }
+        cache.lru.push_front(path);
+        it = cache.verdicts.emplace(path, CachedVerdict{}).first;
+        it->second.lru_it = cache.lru.begin();
+    }
+    if (access == PathAccess::READ) {
+        it->second.read = allowed ? 1 : 0;
+    } else {
+        it->second.write = allowed ? 1 : 0;
+    }
+    return allowed;
+}
+
+uint8_t PermissionsStore::capabilities(uint32_t agent_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = permissions_.find(agent_id);
+    if (it == permissions_.end()) {
+        permissions_[agent_id] = AgentPermissions::from_level(PermissionLevel::STANDARD);
+        it = permissions_.find(agent_id);
+    }
+    return it->second.capability_mask;
+}
+
+nlohmann::json PermissionsStore::export_state() {
+    nlohmann::json state = nlohmann::json::object();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& [agent_id, perms] : permissions_) {
+        state[std::to_string(agent_id)] = perms.to_json();
+    }
+    return state;
+}
+
+void PermissionsStore::import_state(const nlohmann::json& state) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& [key, perms] : state.items()) {
+        // from_json recompiles the path matchers and capability mask
+        permissions_[static_cast<uint32_t>(std::stoul(key))] =
+            AgentPermissions::from_json(perms);
+    }
 }
 
 } // namespace clove::kernel
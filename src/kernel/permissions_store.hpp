@@ -1,19 +1,58 @@
 #pragma once
 #include <cstdint>
+#include <list>
+#include <string>
 #include <unordered_map>
 #include <mutex>
 #include "kernel/permissions.hpp"
 
 namespace clove::kernel {
 
+enum class PathAccess : uint8_t { READ, WRITE };
+
 class PermissionsStore {
 public:
     AgentPermissions& get_or_create(uint32_t agent_id);
     void set_permissions(uint32_t agent_id, const AgentPermissions& perms);
     void set_level(uint32_t agent_id, PermissionLevel level);
 
+    // Cached path-permission check for the SYS_READ/SYS_WRITE hot path.
+    // Agents hammer a small working set of paths, so a hit is one hash
+    // probe; a miss runs the full can_read_path/can_write_path (which
+    // canonicalizes against the filesystem) and caches the verdict.
+    // set_permissions/set_level drop the agent's cache, so a cached
+    // verdict can only go stale if the filesystem under an already
+    // checked path changes (e.g. a symlink appears) — same exposure the
+    // uncached check has between its canonicalize and the actual I/O.
+    bool check_path(uint32_t agent_id, const std::string& path, PathAccess access);
+
+    // Packed CAP_* mask for one agent: a single locked probe, no
+    // AgentPermissions copy
+    uint8_t capabilities(uint32_t agent_id);
+
+    // Checkpoint support: every agent's grants, keyed by agent ID. Path
+    // caches are rebuilt lazily after import.
+    nlohmann::json export_state();
+    void import_state(const nlohmann::json& state);
+
 private:
+    // Per-agent path→verdict cache, LRU-bounded. read/write verdicts
+    // are tracked separately per path: -1 unknown, 0 deny, 1 allow.
+    static constexpr size_t PATH_CACHE_ENTRIES = 256;
+
+    struct CachedVerdict {
+        int8_t read = -1;
+        int8_t write = -1;
+        std::list<std::string>::iterator lru_it;
+    };
+
+    struct AgentPathCache {
+        std::unordered_map<std::string, CachedVerdict> verdicts;
+        std::list<std::string> lru;  // front = most recently used
+    };
+
     std::unordered_map<uint32_t, AgentPermissions> permissions_;
+    std::unordered_map<uint32_t, AgentPathCache> path_cache_;
     std::mutex mutex_;
 };
 
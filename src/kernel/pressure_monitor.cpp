@@ -0,0 +1,189 @@
+#include "kernel/pressure_monitor.hpp"
+#include "kernel/event_bus.hpp"
+#include "kernel/reactor.hpp"
+#include <spdlog/spdlog.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace clove::kernel {
+
+// Stall thresholds for the PSI triggers: fire when tasks in the cgroup
+// were stalled for more than this many usecs within a 1s window. The
+// kernel rearms a trigger at most once per window, which also bounds
+// how often one agent can emit RESOURCE_WARNING.
+constexpr const char* MEMORY_TRIGGER = "some 100000 1000000";
+constexpr const char* CPU_TRIGGER = "some 150000 1000000";
+
+// cpu.weight values used by the rebalancer (cgroup default is 100)
+constexpr int CPU_WEIGHT_DEFAULT = 100;
+constexpr int CPU_WEIGHT_BOOSTED = 300;
+
+// Parse "some avg10=0.12 avg60=0.05 avg300=0.01 total=123456" lines
+// from a pressure file into {"some": {...}, "full": {...}}
+static json read_pressure_stats(const std::string& pressure_file) {
+    json stats;
+    std::ifstream ifs(pressure_file);
+    std::string line;
+    while (std::getline(ifs, line)) {
+        char kind[8];
+        double avg10 = 0, avg60 = 0, avg300 = 0;
+        unsigned long long total = 0;
+        if (sscanf(line.c_str(), "%7s avg10=%lf avg60=%lf avg300=%lf total=%llu",
+                   kind, &avg10, &avg60, &avg300, &total) == 5) {
+            stats[kind]["avg10"] = avg10;
+            stats[kind]["avg60"] = avg60;
+            stats[kind]["avg300"] = avg300;
+            stats[kind]["total_us"] = total;
+        }
+    }
+    return stats;
+}
+
+PressureMonitor::PressureMonitor(Reactor& reactor, EventBus& event_bus)
+    : reactor_(reactor), event_bus_(event_bus) {}
+
+PressureMonitor::~PressureMonitor() {
+    std::vector<int> fds;
+    fds.reserve(watches_.size());
+    for (const auto& [fd, _] : watches_) {
+        fds.push_back(fd);
+    }
+    for (int fd : fds) {
+        drop_watch(fd);
+    }
+}
+
+int PressureMonitor::arm_trigger(const std::string& pressure_file,
+                                 const std::string& trigger) {
+    int fd = open(pressure_file.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+
+    if (write(fd, trigger.c_str(), trigger.size()) < 0) {
+        // PSI triggers need CONFIG_PSI and a 5.2+ kernel
+        spdlog::debug("Cannot arm PSI trigger on {}: {}", pressure_file, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+void PressureMonitor::watch_agent(uint32_t agent_id, const std::string& agent_name,
+                                  const std::string& cgroup_path) {
+    struct { const char* resource; const char* trigger; } resources[] = {
+        {"memory", MEMORY_TRIGGER},
+        {"cpu", CPU_TRIGGER},
+    };
+
+    for (const auto& res : resources) {
+        std::string pressure_file = cgroup_path + "/" + res.resource + ".pressure";
+        int fd = arm_trigger(pressure_file, res.trigger);
+        if (fd < 0) {
+            continue;
+        }
+
+        // PSI triggers surface as EPOLLPRI, not EPOLLIN
+        bool added = reactor_.add(fd,
+            EventType::PRIORITY | EventType::ERROR,
+            [this](int event_fd, uint32_t events) { on_pressure(event_fd, events); });
+
+        if (!added) {
+            close(fd);
+            continue;
+        }
+
+        Watch watch;
+        watch.agent_id = agent_id;
+        watch.agent_name = agent_name;
+        watch.cgroup_path = cgroup_path;
+        watch.resource = res.resource;
+        watches_[fd] = std::move(watch);
+
+        spdlog::debug("PSI watch armed: agent {} {} ({})",
+            agent_name, res.resource, pressure_file);
+    }
+}
+
+void PressureMonitor::unwatch_agent(uint32_t agent_id) {
+    std::vector<int> fds;
+    for (const auto& [fd, watch] : watches_) {
+        if (watch.agent_id == agent_id) {
+            fds.push_back(fd);
+        }
+    }
+    for (int fd : fds) {
+        drop_watch(fd);
+    }
+}
+
+void PressureMonitor::on_pressure(int fd, uint32_t events) {
+    auto it = watches_.find(fd);
+    if (it == watches_.end()) {
+        return;
+    }
+
+    // EPOLLERR means the cgroup went away (agent exited)
+    if (events & static_cast<uint32_t>(EventType::ERROR)) {
+        drop_watch(fd);
+        return;
+    }
+
+    Watch watch = it->second;
+    std::string pressure_file = watch.cgroup_path + "/" + watch.resource + ".pressure";
+    json psi = read_pressure_stats(pressure_file);
+
+    spdlog::warn("Agent {} under {} pressure (avg10={})",
+        watch.agent_name, watch.resource,
+        psi.contains("some") ? psi["some"].value("avg10", 0.0) : 0.0);
+
+    json event_data;
+    event_data["agent_id"] = watch.agent_id;
+    event_data["name"] = watch.agent_name;
+    event_data["resource"] = watch.resource;
+    event_data["psi"] = psi;
+    event_bus_.emit(KernelEventType::RESOURCE_WARNING, event_data, 0);
+
+    if (rebalance_cpu_ && watch.resource == "cpu") {
+        rebalance_cpu_weights(watch.cgroup_path);
+    }
+}
+
+void PressureMonitor::drop_watch(int fd) {
+    reactor_.remove(fd);
+    close(fd);
+    watches_.erase(fd);
+}
+
+void PressureMonitor::rebalance_cpu_weights(const std::string& stalled_cgroup) {
+    // Simple contention policy: the stalled agent gets a boosted
+    // cpu.weight, every other watched agent drops back to the default.
+    // If several agents stall in turn, the most recent one wins.
+    for (const auto& [_, watch] : watches_) {
+        if (watch.resource != "cpu") {
+            continue;
+        }
+
+        int weight = (watch.cgroup_path == stalled_cgroup)
+            ? CPU_WEIGHT_BOOSTED : CPU_WEIGHT_DEFAULT;
+
+        std::ofstream ofs(watch.cgroup_path + "/cpu.weight");
+        if (ofs.is_open()) {
+            ofs << weight;
+            if (ofs.good() && watch.cgroup_path == stalled_cgroup) {
+                spdlog::info("Boosted cpu.weight to {} for agent {}",
+                    weight, watch.agent_name);
+            }
+        }
+    }
+}
+
+} // namespace clove::kernel
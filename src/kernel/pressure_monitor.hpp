@@ -0,0 +1,69 @@
+/**
+ * PSI-driven resource pressure monitoring.
+ *
+ * cgroup v2 exposes pressure stall information per cgroup
+ * (memory.pressure / cpu.pressure). Writing a trigger to those files
+ * makes the fd poll-ready (EPOLLPRI) whenever the stall threshold is
+ * crossed, so the kernel learns an agent is thrashing the moment it
+ * happens instead of when the OOM killer fires inside the sandbox.
+ *
+ * Each watched agent contributes one fd per resource to the main
+ * reactor. On a trigger the monitor emits RESOURCE_WARNING with the
+ * current stall averages; with CPU rebalancing enabled it also bumps
+ * the stalled agent's cpu.weight while resetting the other watched
+ * agents to the default weight.
+ */
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace clove::kernel {
+
+class Reactor;
+class EventBus;
+
+class PressureMonitor {
+public:
+    PressureMonitor(Reactor& reactor, EventBus& event_bus);
+    ~PressureMonitor();
+
+    // Non-copyable
+    PressureMonitor(const PressureMonitor&) = delete;
+    PressureMonitor& operator=(const PressureMonitor&) = delete;
+
+    // Arm memory.pressure and cpu.pressure triggers for the agent's
+    // cgroup. No-op when the cgroup or PSI support is missing; watches
+    // tear themselves down when the cgroup is removed (fd reports error)
+    void watch_agent(uint32_t agent_id, const std::string& agent_name,
+                     const std::string& cgroup_path);
+    void unwatch_agent(uint32_t agent_id);
+
+    // Shift cpu.weight toward agents reporting CPU stalls
+    void set_rebalance_cpu(bool enable) { rebalance_cpu_ = enable; }
+
+    size_t watch_count() const { return watches_.size(); }
+
+private:
+    struct Watch {
+        uint32_t agent_id = 0;
+        std::string agent_name;
+        std::string cgroup_path;
+        std::string resource;  // "memory" or "cpu"
+    };
+
+    // Opens the pressure file and writes the trigger; -1 on failure
+    int arm_trigger(const std::string& pressure_file, const std::string& trigger);
+
+    void on_pressure(int fd, uint32_t events);
+    void drop_watch(int fd);
+    void rebalance_cpu_weights(const std::string& stalled_cgroup);
+
+    Reactor& reactor_;
+    EventBus& event_bus_;
+    std::unordered_map<int, Watch> watches_;  // keyed by trigger fd
+    bool rebalance_cpu_ = false;
+};
+
+} // namespace clove::kernel
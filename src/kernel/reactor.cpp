@@ -35,8 +35,11 @@ bool Reactor::add(int fd, uint32_t events, EventCallback callback) {
         return false;
     }
 
-    callbacks_[fd] = std::move(callback);
-    spdlog::debug("Added fd {} to reactor (events=0x{:x})", fd, events);
+    {
+        std::lock_guard<std::mutex> lock(callbacks_mutex_);
+        callbacks_[fd] = std::move(callback);
+    }
+    SPDLOG_DEBUG("Added fd {} to reactor (events=0x{:x})", fd, events);
     return true;
 }
 
@@ -50,7 +53,7 @@ bool Reactor::modify(int fd, uint32_t events) {
         return false;
     }
 
-    spdlog::debug("Modified fd {} in reactor (events=0x{:x})", fd, events);
+    SPDLOG_DEBUG("Modified fd {} in reactor (events=0x{:x})", fd, events);
     return true;
 }
 
@@ -63,8 +66,11 @@ bool Reactor::remove(int fd) {
         }
     }
 
-    callbacks_.erase(fd);
-    spdlog::debug("Removed fd {} from reactor", fd);
+    {
+        std::lock_guard<std::mutex> lock(callbacks_mutex_);
+        callbacks_.erase(fd);
+    }
+    SPDLOG_DEBUG("Removed fd {} from reactor", fd);
     return true;
 }
 
@@ -81,14 +87,21 @@ int Reactor::poll(int timeout_ms) {
         return -1;
     }
 
-    // Process events
+    // Process events (copy the callback so handlers can remove fds)
     for (int i = 0; i < n; i++) {
         int fd = events[i].data.fd;
         uint32_t ev = events[i].events;
 
-        auto it = callbacks_.find(fd);
-        if (it != callbacks_.end()) {
-            it->second(fd, ev);
+        EventCallback callback;
+        {
+            std::lock_guard<std::mutex> lock(callbacks_mutex_);
+            auto it = callbacks_.find(fd);
+            if (it != callbacks_.end()) {
+                callback = it->second;
+            }
+        }
+        if (callback) {
+            callback(fd, ev);
         }
     }
 
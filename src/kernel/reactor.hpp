@@ -1,5 +1,6 @@
 #pragma once
 #include <functional>
+#include <mutex>
 #include <unordered_map>
 #include <cstdint>
 
@@ -8,6 +9,7 @@ namespace clove::kernel {
 // Event types
 enum class EventType : uint32_t {
     READABLE  = 0x001,
+    PRIORITY  = 0x002,  // EPOLLPRI (e.g. cgroup PSI triggers)
     WRITABLE  = 0x004,
     ERROR     = 0x008,
     HANGUP    = 0x010
@@ -53,6 +55,9 @@ public:
 private:
     int epoll_fd_ = -1;
     bool running_ = false;
+    // Guards callbacks_: with sharded reactors the accept path registers
+    // fds from the main thread while the shard thread is polling
+    mutable std::mutex callbacks_mutex_;
     std::unordered_map<int, EventCallback> callbacks_;
 };
 
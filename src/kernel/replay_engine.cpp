@@ -0,0 +1,230 @@
+#include "kernel/replay_engine.hpp"
+#include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+using json = nlohmann::json;
+
+namespace clove::kernel {
+
+namespace {
+
+// Shared resources an entry touches. Agent-scoped state keys resolve
+// to per-agent storage and can't conflict across agents, so they need
+// no edge — the agent's own stream already orders them.
+std::vector<std::string> extract_resources(const ExecutionLogEntry& entry) {
+    auto op = static_cast<ipc::SyscallOp>(entry.opcode);
+
+    json j = json::parse(entry.payload, nullptr, false);
+    if (!j.is_object()) {
+        j = json::object();
+    }
+
+    switch (op) {
+        case ipc::SyscallOp::SYS_STORE:
+        case ipc::SyscallOp::SYS_FETCH:
+        case ipc::SyscallOp::SYS_DELETE:
+        case ipc::SyscallOp::SYS_INCR:
+        case ipc::SyscallOp::SYS_CAS:
+        case ipc::SyscallOp::SYS_APPEND: {
+            std::string scope = j.value("scope", "global");
+            if (scope == "agent") {
+                return {};
+            }
+            std::string key = j.value("key", "");
+            if (key.empty()) {
+                return {};
+            }
+            return {"state:" + key};
+        }
+
+        case ipc::SyscallOp::SYS_SEND: {
+            uint32_t to = j.value("to", 0u);
+            std::string to_name = j.value("to_name", "");
+            if (to != 0) {
+                return {"mailbox:" + std::to_string(to)};
+            }
+            if (!to_name.empty()) {
+                return {"mailbox-name:" + to_name};
+            }
+            return {};
+        }
+
+        case ipc::SyscallOp::SYS_EMIT:
+            // Event fan-out order is observable to every subscriber;
+            // serialize emits against each other
+            return {"event-bus"};
+
+        default:
+            return {};
+    }
+}
+
+// Non-deterministic calls are not re-executed: replaying them would
+// talk to the outside world and diverge from the recording
+bool skip_on_replay(uint8_t opcode) {
+    auto op = static_cast<ipc::SyscallOp>(opcode);
+    return op == ipc::SyscallOp::SYS_THINK ||
+           op == ipc::SyscallOp::SYS_HTTP ||
+           op == ipc::SyscallOp::SYS_EXEC;
+}
+
+} // namespace
+
+ReplayEngine::ReplayEngine(ExecutionLogger& logger, DispatchFn dispatch)
+    : logger_(logger), dispatch_(std::move(dispatch)) {}
+
+ReplayEngine::~ReplayEngine() {
+    if (driver_.joinable()) {
+        driver_.join();
+    }
+}
+
+bool ReplayEngine::start(std::vector<ExecutionLogEntry> entries) {
+    bool expected = false;
+    if (!running_.compare_exchange_strong(expected, true)) {
+        return false;
+    }
+    if (driver_.joinable()) {
+        driver_.join();  // reap the previous, already-finished run
+    }
+    driver_ = std::thread(&ReplayEngine::run, this, std::move(entries));
+    return true;
+}
+
+void ReplayEngine::run(std::vector<ExecutionLogEntry> entries) {
+    const size_t n = entries.size();
+    auto started = std::chrono::steady_clock::now();
+
+    // Per-agent streams and per-resource orders, both in recording
+    // order. An entry is runnable once it heads its agent's stream and
+    // is next in line on every resource it touches. Prerequisites
+    // always have smaller indices, so the oldest unexecuted entry is
+    // always runnable and progress is guaranteed.
+    std::unordered_map<uint32_t, std::vector<size_t>> agent_stream;
+    std::unordered_map<uint32_t, size_t> agent_pos;
+    std::vector<std::vector<std::string>> resources(n);
+    std::unordered_map<std::string, std::vector<size_t>> res_order;
+    std::unordered_map<std::string, size_t> res_pos;
+    std::unordered_map<size_t, std::vector<size_t>> ranks;  // idx -> position in each resource order
+
+    for (size_t i = 0; i < n; ++i) {
+        agent_stream[entries[i].agent_id].push_back(i);
+        resources[i] = extract_resources(entries[i]);
+        for (const auto& r : resources[i]) {
+            ranks[i].push_back(res_order[r].size());
+            res_order[r].push_back(i);
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<size_t> ready;
+    size_t remaining = n;
+
+    auto is_ready = [&](size_t idx) {
+        const auto& stream = agent_stream[entries[idx].agent_id];
+        size_t pos = agent_pos[entries[idx].agent_id];
+        if (pos >= stream.size() || stream[pos] != idx) {
+            return false;
+        }
+        const auto& rs = resources[idx];
+        for (size_t k = 0; k < rs.size(); ++k) {
+            if (res_pos[rs[k]] != ranks[idx][k]) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    for (auto& [agent_id, stream] : agent_stream) {
+        if (!stream.empty() && is_ready(stream.front())) {
+            ready.push_back(stream.front());
+        }
+    }
+
+    size_t worker_count = std::min<size_t>(
+        std::max(2u, std::thread::hardware_concurrency()), 8);
+
+    auto worker = [&]() {
+        for (;;) {
+            size_t idx;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [&] { return !ready.empty() || remaining == 0; });
+                if (ready.empty()) {
+                    return;
+                }
+                idx = ready.front();
+                ready.pop_front();
+            }
+
+            const auto& entry = entries[idx];
+            bool cancelled =
+                logger_.get_replay_progress().state != ReplayState::RUNNING;
+
+            if (cancelled || skip_on_replay(entry.opcode)) {
+                logger_.advance_replay(true);
+            } else {
+                try {
+                    ipc::Message msg(entry.agent_id,
+                                     static_cast<ipc::SyscallOp>(entry.opcode),
+                                     entry.payload);
+                    auto response = dispatch_(msg);
+                    (void)response;
+                    logger_.advance_replay(false);
+                } catch (const std::exception& e) {
+                    spdlog::warn("Replay: entry seq={} failed: {}",
+                                 entry.sequence_id, e.what());
+                    logger_.advance_replay(true);
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                remaining--;
+
+                // Retire this entry from its agent stream and resource
+                // orders, then see what that unblocked
+                agent_pos[entry.agent_id]++;
+                for (const auto& r : resources[idx]) {
+                    res_pos[r]++;
+                }
+
+                const auto& stream = agent_stream[entry.agent_id];
+                size_t pos = agent_pos[entry.agent_id];
+                if (pos < stream.size() && is_ready(stream[pos])) {
+                    ready.push_back(stream[pos]);
+                }
+                for (const auto& r : resources[idx]) {
+                    const auto& order = res_order[r];
+                    size_t rpos = res_pos[r];
+                    if (rpos < order.size() && is_ready(order[rpos])) {
+                        ready.push_back(order[rpos]);
+                    }
+                }
+            }
+            cv.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers.emplace_back(worker);
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - started);
+    spdlog::info("Replay engine finished {} entries across {} agents in {}ms",
+                 n, agent_stream.size(), elapsed.count());
+    running_ = false;
+}
+
+} // namespace clove::kernel
@@ -0,0 +1,48 @@
+/**
+ * Clove Replay Engine
+ *
+ * Executes an imported recording with per-agent dependency ordering.
+ * Entries from the same agent replay in their original order; entries
+ * from different agents run concurrently unless they touch the same
+ * shared resource (a state key, a mailbox, the event bus), in which
+ * case the original sequence order is enforced at that edge only. The
+ * oldest unexecuted entry is always runnable, so the schedule cannot
+ * deadlock.
+ */
+#pragma once
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "ipc/protocol.hpp"
+#include "kernel/execution_log.hpp"
+
+namespace clove::kernel {
+
+class ReplayEngine {
+public:
+    using DispatchFn = std::function<ipc::Message(const ipc::Message&)>;
+
+    ReplayEngine(ExecutionLogger& logger, DispatchFn dispatch);
+    ~ReplayEngine();
+
+    ReplayEngine(const ReplayEngine&) = delete;
+    ReplayEngine& operator=(const ReplayEngine&) = delete;
+
+    // Kicks off replay of `entries` on a worker team; returns false if
+    // a replay is already running. Progress and completion are reported
+    // through the logger's replay state machine.
+    bool start(std::vector<ExecutionLogEntry> entries);
+
+    bool running() const { return running_.load(); }
+
+private:
+    void run(std::vector<ExecutionLogEntry> entries);
+
+    ExecutionLogger& logger_;
+    DispatchFn dispatch_;
+    std::atomic<bool> running_{false};
+    std::thread driver_;
+};
+
+} // namespace clove::kernel
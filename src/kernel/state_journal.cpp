@@ -0,0 +1,280 @@
+#include "kernel/state_journal.hpp"
+#include "kernel/thread_placement.hpp"
+#include <spdlog/spdlog.h>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace clove::kernel {
+
+namespace {
+
+void put_u32(std::string& out, uint32_t v) {
+    out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+void put_i64(std::string& out, int64_t v) {
+    out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+void put_str(std::string& out, const std::string& s) {
+    put_u32(out, static_cast<uint32_t>(s.size()));
+    out.append(s);
+}
+
+// Bounds-checked cursor over a mapped file; any short read marks the
+// stream bad and replay stops at the last complete record (a torn tail
+// after a crash is expected, not fatal)
+struct Cursor {
+    const char* data;
+    size_t size;
+    size_t pos = 0;
+    bool ok = true;
+
+    bool read(void* out, size_t n) {
+        if (pos + n > size) {
+            ok = false;
+            return false;
+        }
+        std::memcpy(out, data + pos, n);
+        pos += n;
+        return true;
+    }
+
+    bool read_str(std::string& out) {
+        uint32_t len = 0;
+        if (!read(&len, sizeof(len)) || pos + len > size) {
+            ok = false;
+            return false;
+        }
+        out.assign(data + pos, len);
+        pos += len;
+        return true;
+    }
+};
+
+} // namespace
+
+StateJournal::StateJournal(std::string dir)
+    : dir_(std::move(dir)),
+      wal_path_(dir_ + "/state.wal"),
+      snapshot_path_(dir_ + "/state.snapshot") {}
+
+StateJournal::~StateJournal() {
+    close();
+}
+
+bool StateJournal::open(const std::function<void(const JournalRecord&)>& replay,
+                        SnapshotProvider snapshot_provider) {
+    if (mkdir(dir_.c_str(), 0755) != 0 && errno != EEXIST) {
+        spdlog::error("StateJournal: cannot create {}: {}", dir_, strerror(errno));
+        return false;
+    }
+
+    // Snapshot first, then the WAL written since it was taken
+    replay_file(snapshot_path_, replay);
+    replay_file(wal_path_, replay);
+
+    wal_fd_ = ::open(wal_path_.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (wal_fd_ < 0) {
+        spdlog::error("StateJournal: cannot open {}: {}", wal_path_, strerror(errno));
+        return false;
+    }
+
+    struct stat st{};
+    if (fstat(wal_fd_, &st) == 0) {
+        wal_bytes_ = static_cast<uint64_t>(st.st_size);
+    }
+
+    snapshot_provider_ = std::move(snapshot_provider);
+    writer_ = std::thread([this] { writer_loop(); });
+    return true;
+}
+
+void StateJournal::append(JournalRecord record) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.push_back(std::move(record));
+    }
+    cv_.notify_one();
+}
+
+void StateJournal::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            return;
+        }
+        stopping_ = true;
+    }
+    cv_.notify_one();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+    if (wal_fd_ >= 0) {
+        ::close(wal_fd_);
+        wal_fd_ = -1;
+    }
+}
+
+void StateJournal::writer_loop() {
+    placement::pin_current(placement::ThreadClass::BACKGROUND);
+
+    std::vector<JournalRecord> batch;
+    std::string buffer;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return !pending_.empty() || stopping_; });
+            if (pending_.empty() && stopping_) {
+                return;
+            }
+            batch.swap(pending_);
+        }
+
+        // Group commit: everything queued since the last wakeup goes out
+        // in one write and one fdatasync
+        buffer.clear();
+        for (const auto& record : batch) {
+            encode(record, buffer);
+        }
+        batch.clear();
+
+        size_t written = 0;
+        while (written < buffer.size()) {
+            ssize_t n = ::write(wal_fd_, buffer.data() + written, buffer.size() - written);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                spdlog::error("StateJournal: WAL write failed: {}", strerror(errno));
+                break;
+            }
+            written += static_cast<size_t>(n);
+        }
+        fdatasync(wal_fd_);
+        wal_bytes_ += written;
+
+        if (wal_bytes_ >= SNAPSHOT_THRESHOLD_BYTES && snapshot_provider_) {
+            compact();
+        }
+    }
+}
+
+void StateJournal::compact() {
+    std::vector<JournalRecord> live = snapshot_provider_();
+
+    std::string tmp_path = snapshot_path_ + ".tmp";
+    int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        spdlog::error("StateJournal: cannot open {}: {}", tmp_path, strerror(errno));
+        return;
+    }
+
+    std::string buffer;
+    buffer.reserve(1024 * 1024);
+    for (const auto& record : live) {
+        encode(record, buffer);
+        if (buffer.size() >= 1024 * 1024) {
+            if (::write(fd, buffer.data(), buffer.size()) < 0) {
+                spdlog::error("StateJournal: snapshot write failed: {}", strerror(errno));
+                ::close(fd);
+                ::unlink(tmp_path.c_str());
+                return;
+            }
+            buffer.clear();
+        }
+    }
+    if (!buffer.empty() && ::write(fd, buffer.data(), buffer.size()) < 0) {
+        spdlog::error("StateJournal: snapshot write failed: {}", strerror(errno));
+        ::close(fd);
+        ::unlink(tmp_path.c_str());
+        return;
+    }
+
+    fsync(fd);
+    ::close(fd);
+
+    // Atomic cutover: publish the snapshot, then the WAL only needs to
+    // cover mutations after this point
+    if (rename(tmp_path.c_str(), snapshot_path_.c_str()) != 0) {
+        spdlog::error("StateJournal: snapshot rename failed: {}", strerror(errno));
+        ::unlink(tmp_path.c_str());
+        return;
+    }
+    if (ftruncate(wal_fd_, 0) == 0) {
+        wal_bytes_ = 0;
+    }
+
+    spdlog::info("StateJournal: compacted {} entries into snapshot", live.size());
+}
+
+bool StateJournal::replay_file(const std::string& path,
+                               const std::function<void(const JournalRecord&)>& replay) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;  // no file yet: first run
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return st.st_size == 0;
+    }
+
+    void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        spdlog::error("StateJournal: mmap of {} failed: {}", path, strerror(errno));
+        return false;
+    }
+
+    Cursor cursor{static_cast<const char*>(mapped), static_cast<size_t>(st.st_size)};
+    size_t count = 0;
+    while (cursor.ok && cursor.pos < cursor.size) {
+        uint32_t record_len = 0;
+        if (!cursor.read(&record_len, sizeof(record_len))) break;
+        size_t record_end = cursor.pos + record_len;
+        if (record_end > cursor.size) break;  // torn tail
+
+        JournalRecord record;
+        if (!cursor.read(&record.op, sizeof(record.op))) break;
+        if (!cursor.read_str(record.key)) break;
+        if (record.op == JournalRecord::STORE) {
+            if (!cursor.read_str(record.scope)) break;
+            if (!cursor.read(&record.owner_agent_id, sizeof(record.owner_agent_id))) break;
+            if (!cursor.read(&record.expires_wall_ms, sizeof(record.expires_wall_ms))) break;
+            if (!cursor.read_str(record.value_json)) break;
+        }
+        cursor.pos = record_end;
+
+        replay(record);
+        count++;
+    }
+
+    munmap(mapped, static_cast<size_t>(st.st_size));
+    if (count > 0) {
+        spdlog::info("StateJournal: replayed {} records from {}", count, path);
+    }
+    return true;
+}
+
+void StateJournal::encode(const JournalRecord& record, std::string& out) {
+    size_t len_pos = out.size();
+    put_u32(out, 0);  // patched below
+
+    out.push_back(static_cast<char>(record.op));
+    put_str(out, record.key);
+    if (record.op == JournalRecord::STORE) {
+        put_str(out, record.scope);
+        put_u32(out, record.owner_agent_id);
+        put_i64(out, record.expires_wall_ms);
+        put_str(out, record.value_json);
+    }
+
+    uint32_t record_len = static_cast<uint32_t>(out.size() - len_pos - sizeof(uint32_t));
+    std::memcpy(out.data() + len_pos, &record_len, sizeof(record_len));
+}
+
+} // namespace clove::kernel
@@ -0,0 +1,80 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace clove::kernel {
+
+// One mutation as it appears on disk. TTLs are persisted as wall-clock
+// deadlines (steady_clock does not survive a restart); replay converts
+// whatever remains back into a steady deadline and skips dead entries.
+struct JournalRecord {
+    enum Op : uint8_t { STORE = 1, ERASE = 2 };
+
+    uint8_t op = STORE;
+    std::string key;              // fully-qualified (agent:N:... for agent scope)
+    std::string value_json;       // serialized value, empty for ERASE
+    uint32_t owner_agent_id = 0;
+    std::string scope;
+    int64_t expires_wall_ms = 0;  // unix epoch ms, 0 = no TTL
+};
+
+// Durability for the state store: an append-only binary WAL written by a
+// single background thread (append() only queues and wakes it, so the
+// syscall path never touches disk), compacted into a snapshot file once
+// the WAL passes a size threshold. Recovery maps the snapshot and WAL
+// and replays both record streams in order.
+class StateJournal {
+public:
+    // Called during compaction to get the full live state; must be safe
+    // to invoke from the journal thread
+    using SnapshotProvider = std::function<std::vector<JournalRecord>()>;
+
+    explicit StateJournal(std::string dir);
+    ~StateJournal();
+
+    StateJournal(const StateJournal&) = delete;
+    StateJournal& operator=(const StateJournal&) = delete;
+
+    // Replays snapshot + WAL through the callback, then opens the WAL for
+    // appending and starts the writer thread. Returns false if the
+    // directory can't be created or the files can't be opened.
+    bool open(const std::function<void(const JournalRecord&)>& replay,
+              SnapshotProvider snapshot_provider);
+
+    // Queue a record for the next group commit. Cheap: one lock, one
+    // vector push, one notify.
+    void append(JournalRecord record);
+
+    // Flush pending records and stop the writer thread
+    void close();
+
+private:
+    static constexpr uint64_t SNAPSHOT_THRESHOLD_BYTES = 16ull * 1024 * 1024;
+
+    void writer_loop();
+    bool replay_file(const std::string& path,
+                     const std::function<void(const JournalRecord&)>& replay);
+    void compact();
+
+    static void encode(const JournalRecord& record, std::string& out);
+
+    std::string dir_;
+    std::string wal_path_;
+    std::string snapshot_path_;
+    int wal_fd_ = -1;
+    uint64_t wal_bytes_ = 0;
+    SnapshotProvider snapshot_provider_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<JournalRecord> pending_;
+    bool stopping_ = false;
+    std::thread writer_;
+};
+
+} // namespace clove::kernel
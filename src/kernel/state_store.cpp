@@ -1,7 +1,134 @@
 #include "kernel/state_store.hpp"
+#include <algorithm>
 
 namespace clove::kernel {
 
+namespace {
+
+int64_t wall_now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+bool scope_allows(uint32_t agent_id, uint32_t owner_agent_id, const std::string& scope) {
+    if (scope == "global") return true;
+    if (scope == "agent" && owner_agent_id == agent_id) return true;
+    if (scope == "session") return true;
+    return false;
+}
+
+} // namespace
+
+StateStore::Shard& StateStore::shard_for(const std::string& key) {
+    return shards_[std::hash<std::string>{}(key) & (NUM_SHARDS - 1)];
+}
+
+void StateStore::index_put(const std::string& key, const StoredValue& entry) {
+    std::unique_lock<std::shared_mutex> lock(index_mutex_);
+    key_index_[key] = KeyMeta{entry.owner_agent_id, entry.scope, entry.expires_at};
+}
+
+void StateStore::index_erase(const std::string& key) {
+    std::unique_lock<std::shared_mutex> lock(index_mutex_);
+    key_index_.erase(key);
+}
+
+bool StateStore::enable_persistence(const std::string& dir) {
+    journal_ = std::make_unique<StateJournal>(dir);
+    bool ok = journal_->open(
+        [this](const JournalRecord& record) { apply_record(record); },
+        [this] { return snapshot_records(); });
+    if (!ok) {
+        journal_.reset();
+    }
+    return ok;
+}
+
+void StateStore::apply_record(const JournalRecord& record) {
+    Shard& shard = shard_for(record.key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+    if (record.op == JournalRecord::ERASE) {
+        shard.map.erase(record.key);
+        index_erase(record.key);
+        return;
+    }
+
+    StoredValue entry;
+    entry.value = nlohmann::json::parse(record.value_json, nullptr, false);
+    entry.owner_agent_id = record.owner_agent_id;
+    entry.scope = record.scope;
+    if (record.expires_wall_ms != 0) {
+        int64_t remaining_ms = record.expires_wall_ms - wall_now_ms();
+        if (remaining_ms <= 0) {
+            shard.map.erase(record.key);  // died while the kernel was down
+            index_erase(record.key);
+            return;
+        }
+        entry.expires_at = std::chrono::steady_clock::now() +
+                           std::chrono::milliseconds(remaining_ms);
+        schedule_expiry(record.key, entry.expires_at);
+    }
+    index_put(record.key, entry);
+    shard.map[record.key] = std::move(entry);
+}
+
+std::vector<JournalRecord> StateStore::snapshot_records() {
+    std::vector<JournalRecord> records;
+    int64_t now_wall = wall_now_ms();
+    auto now_steady = std::chrono::steady_clock::now();
+
+    for (Shard& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        for (const auto& [key, entry] : shard.map) {
+            if (entry.is_expired()) {
+                continue;
+            }
+            JournalRecord record;
+            record.op = JournalRecord::STORE;
+            record.key = key;
+            record.value_json = entry.value.dump();
+            record.owner_agent_id = entry.owner_agent_id;
+            record.scope = entry.scope;
+            if (entry.expires_at != std::chrono::steady_clock::time_point{}) {
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    entry.expires_at - now_steady).count();
+                record.expires_wall_ms = now_wall + remaining;
+            }
+            records.push_back(std::move(record));
+        }
+    }
+    return records;
+}
+
+void StateStore::journal_store(const std::string& store_key, const StoredValue& entry) {
+    if (!journal_) {
+        return;
+    }
+    JournalRecord record;
+    record.op = JournalRecord::STORE;
+    record.key = store_key;
+    record.value_json = entry.value.dump();
+    record.owner_agent_id = entry.owner_agent_id;
+    record.scope = entry.scope;
+    if (entry.expires_at != std::chrono::steady_clock::time_point{}) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            entry.expires_at - std::chrono::steady_clock::now()).count();
+        record.expires_wall_ms = wall_now_ms() + remaining;
+    }
+    journal_->append(std::move(record));
+}
+
+void StateStore::journal_erase(const std::string& store_key) {
+    if (!journal_) {
+        return;
+    }
+    JournalRecord record;
+    record.op = JournalRecord::ERASE;
+    record.key = store_key;
+    journal_->append(std::move(record));
+}
+
 StoreResult StateStore::store(uint32_t agent_id, const std::string& key,
                               const nlohmann::json& value, const std::string& scope,
                               std::optional<int> ttl_secs) {
@@ -29,9 +156,19 @@ StoreResult StateStore::store(uint32_t agent_id, const std::string& key,
     }
 
     std::string final_scope = entry.scope;
+    journal_store(store_key, entry);
+    index_put(store_key, entry);
+    if (entry.expires_at != std::chrono::steady_clock::time_point{}) {
+        schedule_expiry(store_key, entry.expires_at);
+    }
     {
-        std::lock_guard<std::mutex> lock(mutex_);
-        store_[store_key] = std::move(entry);
+        Shard& shard = shard_for(store_key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.map[store_key] = std::move(entry);
+    }
+
+    if (final_scope != "agent") {
+        notify_watchers(agent_id, key, "store", value);
     }
 
     result.success = true;
@@ -51,16 +188,18 @@ FetchResult StateStore::fetch(uint32_t agent_id, const std::string& key) {
         make_agent_key(agent_id, key)
     };
 
-    std::lock_guard<std::mutex> lock(mutex_);
-
     for (const auto& try_key : keys_to_try) {
-        auto it = store_.find(try_key);
-        if (it == store_.end()) {
+        Shard& shard = shard_for(try_key);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+        auto it = shard.map.find(try_key);
+        if (it == shard.map.end()) {
             continue;
         }
 
+        // Expired entries read as missing under the shared lock; the
+        // write paths (store/erase/keys) reclaim them
         if (it->second.is_expired()) {
-            store_.erase(it);
             continue;
         }
 
@@ -85,25 +224,32 @@ DeleteResult StateStore::erase(uint32_t agent_id, const std::string& key) {
     DeleteResult result;
     if (key.empty()) {
         return result;
-    }  
+    }
 
     std::vector<std::string> keys_to_try = {
         key,
         make_agent_key(agent_id, key)
     };
 
-    std::lock_guard<std::mutex> lock(mutex_);
-
     for (const auto& try_key : keys_to_try) {
-        auto it = store_.find(try_key);
-        if (it == store_.end()) {
+        Shard& shard = shard_for(try_key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+        auto it = shard.map.find(try_key);
+        if (it == shard.map.end()) {
             continue;
         }
 
         if (it->second.owner_agent_id == agent_id || it->second.scope == "global") {
-            store_.erase(it);
+            shard.map.erase(it);
+            journal_erase(try_key);
+            index_erase(try_key);
             result.success = true;
             result.deleted = true;
+            if (try_key == key) {  // agent-scoped keys are never watchable
+                lock.unlock();
+                notify_watchers(agent_id, key, "delete", nullptr);
+            }
             return result;
         }
     }
@@ -114,45 +260,322 @@ DeleteResult StateStore::erase(uint32_t agent_id, const std::string& key) {
 }
 
 std::vector<std::string> StateStore::keys(uint32_t agent_id, const std::string& prefix) {
-    std::lock_guard<std::mutex> lock(mutex_);
-
     std::vector<std::string> keys;
-    for (auto it = store_.begin(); it != store_.end(); ) {
-        if (it->second.is_expired()) {
-            it = store_.erase(it);
-            continue;
+    auto now = std::chrono::steady_clock::now();
+
+    // The index is sorted, so a prefix names a contiguous range: seek to
+    // its start with lower_bound and walk until keys stop matching. Only
+    // matching entries are ever touched, and the hash shards stay
+    // untouched entirely.
+    std::shared_lock<std::shared_mutex> lock(index_mutex_);
+    for (auto it = key_index_.lower_bound(prefix); it != key_index_.end(); ++it) {
+        const std::string& key = it->first;
+        if (!prefix.empty() && key.compare(0, prefix.size(), prefix) != 0) {
+            break;
         }
 
-        if (!can_access_key(agent_id, it->second)) {
-            ++it;
+        const KeyMeta& meta = it->second;
+        if (meta.expires_at != std::chrono::steady_clock::time_point{} &&
+            now > meta.expires_at) {
+            continue;
+        }
+        if (!scope_allows(agent_id, meta.owner_agent_id, meta.scope)) {
             continue;
         }
 
-        const std::string& key = it->first;
-        if (prefix.empty() || key.find(prefix) == 0) {
-            if (key.find("agent:") == 0) {
-                size_t second_colon = key.find(':', 6);
-                if (second_colon != std::string::npos) {
-                    keys.push_back(key.substr(second_colon + 1));
-                } else {
-                    keys.push_back(key);
-                }
+        if (key.find("agent:") == 0) {
+            size_t second_colon = key.find(':', 6);
+            if (second_colon != std::string::npos) {
+                keys.push_back(key.substr(second_colon + 1));
             } else {
                 keys.push_back(key);
             }
+        } else {
+            keys.push_back(key);
         }
-
-        ++it;
     }
 
     return keys;
 }
 
+void StateStore::schedule_expiry(const std::string& store_key,
+                                 std::chrono::steady_clock::time_point expires_at) {
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(
+        expires_at - wheel_epoch_).count() + 1;  // round up: never file early
+
+    std::lock_guard<std::mutex> lock(wheel_mutex_);
+    int64_t slot_s = std::max(seconds, last_swept_s_ + 1);
+    slot_s = std::min(slot_s, last_swept_s_ + static_cast<int64_t>(WHEEL_SLOTS));
+    wheel_[slot_s % WHEEL_SLOTS].push_back(store_key);
+}
+
+void StateStore::evict_if_expired(const std::string& store_key) {
+    std::chrono::steady_clock::time_point still_pending{};
+    {
+        Shard& shard = shard_for(store_key);
+        std::unique_lock<std::shared_mutex> shard_lock(shard.mutex);
+        auto it = shard.map.find(store_key);
+        if (it == shard.map.end()) {
+            return;  // already gone (deleted or overwritten without TTL)
+        }
+        if (it->second.is_expired()) {
+            shard.map.erase(it);
+            journal_erase(store_key);
+            index_erase(store_key);
+            return;
+        }
+        // Overwritten with a later TTL, or clamped past the wheel
+        // horizon: re-file under the real deadline
+        still_pending = it->second.expires_at;
+    }
+    if (still_pending != std::chrono::steady_clock::time_point{}) {
+        schedule_expiry(store_key, still_pending);
+    }
+}
+
+void StateStore::sweep_expired() {
+    std::vector<std::string> due;
+    {
+        std::lock_guard<std::mutex> lock(wheel_mutex_);
+        int64_t now_s = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now() - wheel_epoch_).count();
+        int64_t end_s = std::min(now_s, last_swept_s_ + static_cast<int64_t>(WHEEL_SLOTS));
+        for (int64_t s = last_swept_s_ + 1; s <= end_s; ++s) {
+            auto& slot = wheel_[s % WHEEL_SLOTS];
+            due.insert(due.end(), std::make_move_iterator(slot.begin()),
+                       std::make_move_iterator(slot.end()));
+            slot.clear();
+        }
+        last_swept_s_ = std::max(last_swept_s_, end_s);
+    }
+
+    for (const auto& store_key : due) {
+        evict_if_expired(store_key);
+    }
+}
+
+std::string StateStore::resolve_store_key(uint32_t agent_id, const std::string& key,
+                                          const std::string& scope, std::string& scope_out) {
+    scope_out = scope.empty() ? "global" : scope;
+    if (scope_out != "global" && scope_out != "agent" && scope_out != "session") {
+        scope_out = "global";
+    }
+    return scope_out == "agent" ? make_agent_key(agent_id, key) : key;
+}
+
+MutateResult StateStore::incr(uint32_t agent_id, const std::string& key, int64_t delta,
+                              const std::string& scope) {
+    MutateResult result;
+    if (key.empty()) {
+        result.error = "key is required";
+        return result;
+    }
+
+    std::string final_scope;
+    std::string store_key = resolve_store_key(agent_id, key, scope, final_scope);
+    Shard& shard = shard_for(store_key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+    auto it = shard.map.find(store_key);
+    if (it == shard.map.end() || it->second.is_expired()) {
+        // Missing counters start from zero
+        StoredValue entry;
+        entry.value = delta;
+        entry.owner_agent_id = agent_id;
+        entry.scope = final_scope;
+        it = shard.map.insert_or_assign(store_key, std::move(entry)).first;
+    } else {
+        if (!can_access_key(agent_id, it->second)) {
+            result.error = "access denied";
+            return result;
+        }
+        if (!it->second.value.is_number_integer()) {
+            result.error = "value is not an integer";
+            return result;
+        }
+        it->second.value = it->second.value.get<int64_t>() + delta;
+    }
+
+    journal_store(store_key, it->second);
+    index_put(store_key, it->second);
+    result.success = true;
+    result.value = it->second.value;
+    if (final_scope != "agent") {
+        lock.unlock();
+        notify_watchers(agent_id, key, "incr", result.value);
+    }
+    return result;
+}
+
+MutateResult StateStore::cas(uint32_t agent_id, const std::string& key,
+                             const nlohmann::json& expected, const nlohmann::json& desired,
+                             const std::string& scope) {
+    MutateResult result;
+    if (key.empty()) {
+        result.error = "key is required";
+        return result;
+    }
+
+    std::string final_scope;
+    std::string store_key = resolve_store_key(agent_id, key, scope, final_scope);
+    Shard& shard = shard_for(store_key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+    auto it = shard.map.find(store_key);
+    bool exists = it != shard.map.end() && !it->second.is_expired();
+
+    if (exists && !can_access_key(agent_id, it->second)) {
+        result.error = "access denied";
+        return result;
+    }
+
+    // expected == null matches a missing key, so CAS doubles as
+    // create-if-absent (the lock-acquisition idiom)
+    nlohmann::json current = exists ? it->second.value : nlohmann::json(nullptr);
+    if (current != expected) {
+        result.success = true;
+        result.swapped = false;
+        result.value = current;
+        return result;
+    }
+
+    if (exists) {
+        it->second.value = desired;
+    } else {
+        StoredValue entry;
+        entry.value = desired;
+        entry.owner_agent_id = agent_id;
+        entry.scope = final_scope;
+        it = shard.map.insert_or_assign(store_key, std::move(entry)).first;
+    }
+
+    journal_store(store_key, it->second);
+    index_put(store_key, it->second);
+    result.success = true;
+    result.swapped = true;
+    result.value = it->second.value;
+    if (final_scope != "agent") {
+        lock.unlock();
+        notify_watchers(agent_id, key, "cas", result.value);
+    }
+    return result;
+}
+
+MutateResult StateStore::append(uint32_t agent_id, const std::string& key,
+                                const nlohmann::json& value, const std::string& scope) {
+    MutateResult result;
+    if (key.empty()) {
+        result.error = "key is required";
+        return result;
+    }
+
+    std::string final_scope;
+    std::string store_key = resolve_store_key(agent_id, key, scope, final_scope);
+    Shard& shard = shard_for(store_key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+    auto it = shard.map.find(store_key);
+    if (it == shard.map.end() || it->second.is_expired()) {
+        StoredValue entry;
+        entry.value = nlohmann::json::array({value});
+        entry.owner_agent_id = agent_id;
+        entry.scope = final_scope;
+        it = shard.map.insert_or_assign(store_key, std::move(entry)).first;
+    } else {
+        if (!can_access_key(agent_id, it->second)) {
+            result.error = "access denied";
+            return result;
+        }
+        if (!it->second.value.is_array()) {
+            result.error = "value is not a list";
+            return result;
+        }
+        it->second.value.push_back(value);
+    }
+
+    journal_store(store_key, it->second);
+    index_put(store_key, it->second);
+    result.success = true;
+    result.value = it->second.value;
+    if (final_scope != "agent") {
+        lock.unlock();
+        notify_watchers(agent_id, key, "append", result.value);
+    }
+    return result;
+}
+
+void StateStore::set_watch_publisher(WatchPublisher publisher) {
+    watch_publisher_ = std::move(publisher);
+}
+
+uint64_t StateStore::watch(uint32_t agent_id, const std::string& pattern, bool prefix) {
+    uint64_t id = next_watch_id_.fetch_add(1, std::memory_order_relaxed);
+    std::unique_lock<std::shared_mutex> lock(watch_mutex_);
+    if (prefix) {
+        prefix_watches_.push_back(Watch{id, agent_id, pattern});
+    } else {
+        exact_watches_[pattern].push_back(Watch{id, agent_id, pattern});
+    }
+    watch_count_.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+size_t StateStore::unwatch(uint32_t agent_id, uint64_t watch_id) {
+    auto matches = [&](const Watch& w) {
+        return w.agent_id == agent_id && (watch_id == 0 || w.id == watch_id);
+    };
+
+    std::unique_lock<std::shared_mutex> lock(watch_mutex_);
+    size_t removed = std::erase_if(prefix_watches_, matches);
+    for (auto it = exact_watches_.begin(); it != exact_watches_.end();) {
+        removed += std::erase_if(it->second, matches);
+        it = it->second.empty() ? exact_watches_.erase(it) : std::next(it);
+    }
+    watch_count_.fetch_sub(removed, std::memory_order_relaxed);
+    return removed;
+}
+
+void StateStore::notify_watchers(uint32_t mutator_agent_id, const std::string& key,
+                                 const char* action, const nlohmann::json& value) {
+    if (watch_count_.load(std::memory_order_relaxed) == 0 || !watch_publisher_) {
+        return;
+    }
+
+    std::vector<uint32_t> targets;
+    {
+        std::shared_lock<std::shared_mutex> lock(watch_mutex_);
+        auto it = exact_watches_.find(key);
+        if (it != exact_watches_.end()) {
+            for (const Watch& w : it->second) {
+                targets.push_back(w.agent_id);
+            }
+        }
+        for (const Watch& w : prefix_watches_) {
+            if (key.compare(0, w.pattern.size(), w.pattern) == 0) {
+                targets.push_back(w.agent_id);
+            }
+        }
+    }
+    if (targets.empty()) {
+        return;
+    }
+
+    // An agent watching both the key and a covering prefix gets one event
+    std::sort(targets.begin(), targets.end());
+    targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+
+    nlohmann::json event;
+    event["key"] = key;
+    event["action"] = action;
+    event["value"] = value;
+    event["agent_id"] = mutator_agent_id;
+    for (uint32_t target : targets) {
+        watch_publisher_(target, event);
+    }
+}
+
 bool StateStore::can_access_key(uint32_t agent_id, const StoredValue& value) const {
-    if (value.scope == "global") return true;
-    if (value.scope == "agent" && value.owner_agent_id == agent_id) return true;
-    if (value.scope == "session") return true;
-    return false;
+    return scope_allows(agent_id, value.owner_agent_id, value.scope);
 }
 
 std::string StateStore::make_agent_key(uint32_t agent_id, const std::string& key) {
@@ -1,11 +1,18 @@
 #pragma once
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 #include <nlohmann/json.hpp>
+#include "kernel/state_journal.hpp"
 
 namespace clove::kernel {
 
@@ -40,6 +47,18 @@ struct DeleteResult {
     bool deleted = false;
 };
 
+// Result of an atomic read-modify-write (incr/cas/append). `value` is
+// the value after the operation — or the current value when a CAS loses.
+struct MutateResult {
+    bool success = false;
+    bool swapped = false;  // CAS only
+    nlohmann::json value;
+    std::string error;
+};
+
+// The map is sharded by key hash with one reader-writer lock per shard:
+// the workload is read-heavy, so concurrent fetches of unrelated keys
+// never serialize, and a store only stalls readers of its own shard.
 class StateStore {
 public:
     StoreResult store(uint32_t agent_id, const std::string& key,
@@ -50,9 +69,115 @@ public:
     DeleteResult erase(uint32_t agent_id, const std::string& key);
     std::vector<std::string> keys(uint32_t agent_id, const std::string& prefix);
 
+    // Atomic read-modify-write under the shard lock: what used to be a
+    // racy SYS_FETCH + SYS_STORE pair becomes one syscall. Missing keys
+    // are created (incr from 0, append to an empty list, cas against
+    // expected == null).
+    MutateResult incr(uint32_t agent_id, const std::string& key, int64_t delta,
+                      const std::string& scope);
+    MutateResult cas(uint32_t agent_id, const std::string& key,
+                     const nlohmann::json& expected, const nlohmann::json& desired,
+                     const std::string& scope);
+    MutateResult append(uint32_t agent_id, const std::string& key,
+                        const nlohmann::json& value, const std::string& scope);
+
+    // Opens (or creates) the journal under dir, replays any snapshot and
+    // WAL into the shards, and starts journaling mutations. Call once at
+    // startup before agents connect.
+    bool enable_persistence(const std::string& dir);
+
+    // Evicts entries whose TTL has passed; driven by the kernel tick.
+    // Without this, keys written with a TTL but never fetched again
+    // would sit in the shards forever.
+    void sweep_expired();
+
+    // Key-watch registry (SYS_WATCH). Agents register interest in an
+    // exact key or a prefix; every successful mutation of a globally
+    // visible key publishes {key, action, value} to each matching
+    // watcher through the publisher callback — the kernel points it at
+    // the event bus push path, so watchers see changes at push latency
+    // instead of fetch-polling on an interval.
+    using WatchPublisher = std::function<void(uint32_t watcher_agent_id,
+                                              const nlohmann::json& event)>;
+    void set_watch_publisher(WatchPublisher publisher);
+
+    // Returns the watch id, used to remove this watch selectively
+    uint64_t watch(uint32_t agent_id, const std::string& pattern, bool prefix);
+
+    // watch_id == 0 removes all of the agent's watches (also called on
+    // disconnect); returns how many were removed
+    size_t unwatch(uint32_t agent_id, uint64_t watch_id);
+
 private:
-    std::unordered_map<std::string, StoredValue> store_;
-    std::mutex mutex_;
+    static constexpr size_t NUM_SHARDS = 16;  // power of two
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string, StoredValue> map;
+    };
+
+    // Enumeration metadata kept in a sorted index beside the hash
+    // shards: SYS_KEYS with a prefix becomes a lower_bound + range scan
+    // over matching keys instead of a full walk of every shard
+    struct KeyMeta {
+        uint32_t owner_agent_id;
+        std::string scope;
+        std::chrono::steady_clock::time_point expires_at;
+    };
+
+    Shard& shard_for(const std::string& key);
+    void index_put(const std::string& key, const StoredValue& entry);
+    void index_erase(const std::string& key);
+
+    void apply_record(const JournalRecord& record);
+    std::vector<JournalRecord> snapshot_records();
+    void journal_store(const std::string& store_key, const StoredValue& entry);
+    void journal_erase(const std::string& store_key);
+    static std::string resolve_store_key(uint32_t agent_id, const std::string& key,
+                                         const std::string& scope, std::string& scope_out);
+
+    std::array<Shard, NUM_SHARDS> shards_;
+    std::unique_ptr<StateJournal> journal_;
+
+    mutable std::shared_mutex index_mutex_;
+    std::map<std::string, KeyMeta> key_index_;
+
+    // Timer wheel for proactive TTL eviction: one slot per second, keys
+    // filed under their deadline's slot. The sweeper only touches slots
+    // whose second has passed, so a sweep is proportional to what's due,
+    // not to the store size. Deadlines past the horizon are clamped to
+    // the last slot and re-filed when the wheel reaches them; a slot
+    // entry is a hint, not truth — the shard entry decides at sweep time.
+    static constexpr size_t WHEEL_SLOTS = 4096;
+
+    void schedule_expiry(const std::string& store_key,
+                         std::chrono::steady_clock::time_point expires_at);
+    void evict_if_expired(const std::string& store_key);
+
+    std::mutex wheel_mutex_;
+    std::array<std::vector<std::string>, WHEEL_SLOTS> wheel_;
+    std::chrono::steady_clock::time_point wheel_epoch_ = std::chrono::steady_clock::now();
+    int64_t last_swept_s_ = 0;
+
+    // Watch sets are expected to stay small (a handful of well-known
+    // coordination keys), so exact watches are one hash lookup and
+    // prefix watches a linear scan; the relaxed counter keeps the
+    // no-watcher mutation path at a single load.
+    struct Watch {
+        uint64_t id;
+        uint32_t agent_id;
+        std::string pattern;
+    };
+
+    void notify_watchers(uint32_t mutator_agent_id, const std::string& key,
+                         const char* action, const nlohmann::json& value);
+
+    WatchPublisher watch_publisher_;
+    mutable std::shared_mutex watch_mutex_;
+    std::unordered_map<std::string, std::vector<Watch>> exact_watches_;
+    std::vector<Watch> prefix_watches_;
+    std::atomic<size_t> watch_count_{0};
+    std::atomic<uint64_t> next_watch_id_{1};
 
     bool can_access_key(uint32_t agent_id, const StoredValue& value) const;
     static std::string make_agent_key(uint32_t agent_id, const std::string& key);
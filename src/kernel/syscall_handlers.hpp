@@ -1,6 +1,10 @@
 #pragma once
+#include <chrono>
 #include <cstdint>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <nlohmann/json.hpp>
@@ -24,6 +28,7 @@ public:
     void register_syscalls(SyscallRouter& router) override;
 private:
     ipc::Message handle_spawn(const ipc::Message& msg);
+    ipc::Message handle_spawn_batch(const ipc::Message& msg);
     ipc::Message handle_kill(const ipc::Message& msg);
     ipc::Message handle_list(const ipc::Message& msg);
     ipc::Message handle_pause(const ipc::Message& msg);
@@ -35,6 +40,7 @@ class AsyncSyscalls final : public KernelModule {
 public:
     explicit AsyncSyscalls(KernelContext& context) : context_(context) {}
     void register_syscalls(SyscallRouter& router) override;
+    void on_tick() override;  // posts timeout results for overdue tasks
 private:
     ipc::Message handle_async_poll(const ipc::Message& msg);
     KernelContext& context_;
@@ -78,6 +84,8 @@ public:
     explicit FileSyscalls(KernelContext& context) : context_(context) {}
     void register_syscalls(SyscallRouter& router) override;
 private:
+    static ipc::Message read_sync(KernelContext& context, const ipc::Message& msg, const nlohmann::json& j);
+    static ipc::Message write_sync(KernelContext& context, const ipc::Message& msg, const nlohmann::json& j);
     ipc::Message handle_read(const ipc::Message& msg);
     ipc::Message handle_write(const ipc::Message& msg);
     ipc::Message handle_read_virtual(const ipc::Message& msg, clove::worlds::World* world);
@@ -89,6 +97,7 @@ class IpcSyscalls final : public KernelModule {
 public:
     explicit IpcSyscalls(KernelContext& context) : context_(context) {}
     void register_syscalls(SyscallRouter& router) override;
+    void on_tick() override;  // fires timed-out blocking recvs
 private:
     ipc::Message handle_register(const ipc::Message& msg);
     ipc::Message handle_send(const ipc::Message& msg);
@@ -104,20 +113,39 @@ public:
 private:
     static ipc::Message think_sync(KernelContext& context, const ipc::Message& msg);
     ipc::Message handle_think(const ipc::Message& msg);
+    ipc::Message handle_think_stream(const ipc::Message& msg);
     ipc::Message handle_report(const ipc::Message& msg);
     KernelContext& context_;
 };
 
 class MetricsSyscalls final : public KernelModule {
 public:
-    explicit MetricsSyscalls(KernelContext& context) : context_(context) {}
+    // push delivers an unsolicited message to a connected agent;
+    // returns false when the agent has no live connection
+    MetricsSyscalls(KernelContext& context,
+                    std::function<bool(uint32_t, ipc::Message)> push)
+        : context_(context), push_(std::move(push)) {}
     void register_syscalls(SyscallRouter& router) override;
+    void on_tick() override;  // pushes due subscription frames
 private:
+    // One agent's metrics feed: binary frames at a fixed cadence
+    struct Subscription {
+        std::chrono::milliseconds interval{1000};
+        std::chrono::steady_clock::time_point next_due;
+        bool include_agents = false;  // also push per-agent process frames
+    };
+
     ipc::Message handle_metrics_system(const ipc::Message& msg);
     ipc::Message handle_metrics_agent(const ipc::Message& msg);
     ipc::Message handle_metrics_all_agents(const ipc::Message& msg);
     ipc::Message handle_metrics_cgroup(const ipc::Message& msg);
+    ipc::Message handle_metrics_subscribe(const ipc::Message& msg);
+    ipc::Message handle_metrics_unsubscribe(const ipc::Message& msg);
     KernelContext& context_;
+    std::function<bool(uint32_t, ipc::Message)> push_;
+    SyscallRouter* router_ = nullptr;  // set in register_syscalls; per-agent accounting
+    std::unordered_map<uint32_t, Subscription> subscriptions_;
+    std::mutex subscriptions_mutex_;
 };
 
 class NetworkSyscalls final : public KernelModule {
@@ -142,9 +170,13 @@ private:
     KernelContext& context_;
 };
 
+class ReplayEngine;
+
 class ReplaySyscalls final : public KernelModule {
 public:
-    explicit ReplaySyscalls(KernelContext& context) : context_(context) {}
+    ReplaySyscalls(KernelContext& context,
+                   std::function<ipc::Message(const ipc::Message&)> dispatch);
+    ~ReplaySyscalls() override;
     void register_syscalls(SyscallRouter& router) override;
 private:
     ipc::Message handle_record_start(const ipc::Message& msg);
@@ -153,17 +185,24 @@ private:
     ipc::Message handle_replay_start(const ipc::Message& msg);
     ipc::Message handle_replay_status(const ipc::Message& msg);
     KernelContext& context_;
+    std::unique_ptr<ReplayEngine> engine_;
 };
 
 class StateSyscalls final : public KernelModule {
 public:
     explicit StateSyscalls(KernelContext& context) : context_(context) {}
     void register_syscalls(SyscallRouter& router) override;
+    void on_tick() override;  // sweeps expired TTL entries
 private:
     ipc::Message handle_store(const ipc::Message& msg);
     ipc::Message handle_fetch(const ipc::Message& msg);
     ipc::Message handle_delete(const ipc::Message& msg);
     ipc::Message handle_keys(const ipc::Message& msg);
+    ipc::Message handle_incr(const ipc::Message& msg);
+    ipc::Message handle_cas(const ipc::Message& msg);
+    ipc::Message handle_append(const ipc::Message& msg);
+    ipc::Message handle_watch(const ipc::Message& msg);
+    ipc::Message handle_unwatch(const ipc::Message& msg);
     KernelContext& context_;
 };
 
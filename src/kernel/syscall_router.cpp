@@ -1,20 +1,105 @@
 #include "kernel/syscall_router.hpp"
+#include "kernel/opcode_table.hpp"
+#include "kernel/trace_ring.hpp"
 #include <spdlog/spdlog.h>
+#include <bit>
+#include <chrono>
+#include <cstring>
 
 namespace clove::kernel {
 
-ipc::Message SyscallRouter::handle(const ipc::Message& msg) const {
-    auto it = handlers_.find(msg.opcode);
-    if (it != handlers_.end()) {
-        return it->second(msg);
+namespace {
+// Cheap failure sniff for the trace record: handlers report errors as
+// {"success":false,...} by convention
+bool response_failed(const ipc::Message& response) {
+    static constexpr char kPrefix[] = "{\"success\":false";
+    return response.payload.size() >= sizeof(kPrefix) - 1 &&
+           std::memcmp(response.payload.data(), kPrefix, sizeof(kPrefix) - 1) == 0;
+}
+} // namespace
+
+ipc::Message SyscallRouter::handle(const ipc::Message& msg) {
+    uint8_t op = static_cast<uint8_t>(msg.opcode);
+    const Handler& handler = handlers_[op];
+
+    if (!handler) {
+        spdlog::warn("Unknown opcode: 0x{:02x}", op);
+        return ipc::Message(msg.agent_id, msg.opcode, msg.payload);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    ipc::Message response = handler(msg);
+    auto elapsed_us = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count());
+
+    auto& stats = stats_[op];
+    stats.calls.fetch_add(1, std::memory_order_relaxed);
+    stats.total_us.fetch_add(elapsed_us, std::memory_order_relaxed);
+
+    size_t bucket = elapsed_us == 0
+        ? 0
+        : std::min<size_t>(std::bit_width(elapsed_us) - 1, LATENCY_BUCKETS - 1);
+    stats.histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    latency_hist_.record(elapsed_us);
+
+    bool failed = response_failed(response);
+    auto& agent = agent_stats_[msg.agent_id % AGENT_SLOTS];
+    agent.calls.fetch_add(1, std::memory_order_relaxed);
+    agent.bytes_in.fetch_add(msg.payload.size(), std::memory_order_relaxed);
+    agent.bytes_out.fetch_add(response.payload.size(), std::memory_order_relaxed);
+    if (failed) {
+        agent.errors.fetch_add(1, std::memory_order_relaxed);
     }
 
-    spdlog::warn("Unknown opcode: 0x{:02x}", static_cast<uint8_t>(msg.opcode));
-    return ipc::Message(msg.agent_id, msg.opcode, msg.payload);
+    if (observer_) {
+        observer_(msg.opcode, msg.agent_id, failed);
+    }
+
+    TraceRing::local().record({
+        .timestamp_us = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count()),
+        .agent_id = msg.agent_id,
+        .duration_us = static_cast<uint32_t>(elapsed_us),
+        .payload_size = static_cast<uint32_t>(msg.payload.size()),
+        .opcode = op,
+        .status = static_cast<uint8_t>(failed ? 1 : 0)
+    });
+
+    return response;
 }
 
 void SyscallRouter::register_handler(ipc::SyscallOp op, Handler handler) {
-    handlers_[op] = std::move(handler);
+    handlers_[static_cast<uint8_t>(op)] = std::move(handler);
+}
+
+nlohmann::json SyscallRouter::stats_json() const {
+    nlohmann::json out = nlohmann::json::object();
+
+    for (size_t op = 0; op < stats_.size(); op++) {
+        const auto& stats = stats_[op];
+        uint64_t calls = stats.calls.load(std::memory_order_relaxed);
+        if (calls == 0) {
+            continue;
+        }
+
+        nlohmann::json buckets = nlohmann::json::array();
+        for (const auto& bucket : stats.histogram) {
+            buckets.push_back(bucket.load(std::memory_order_relaxed));
+        }
+
+        uint64_t total_us = stats.total_us.load(std::memory_order_relaxed);
+        out[opcode_info(static_cast<ipc::SyscallOp>(op)).name] = {
+            {"calls", calls},
+            {"total_us", total_us},
+            {"mean_us", total_us / calls},
+            {"latency_log2_us", buckets}
+        };
+    }
+
+    return out;
 }
 
 } // namespace clove::kernel
@@ -1,22 +1,71 @@
 #pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <functional>
-#include <unordered_map>
+#include <nlohmann/json.hpp>
 #include "ipc/protocol.hpp"
+#include "metrics/histogram.hpp"
 
 namespace clove::kernel {
 
 // Centralized syscall dispatch table.
+//
+// SyscallOp is a dense uint8_t, so handlers live in a flat 256-entry
+// array (no hash lookup on the hot path). Dispatch also records a
+// per-opcode call counter and a log2-bucketed latency histogram;
+// counters are atomic since shard reactors dispatch concurrently.
 class SyscallRouter {
 public:
     using Handler = std::function<ipc::Message(const ipc::Message&)>;
 
+    // Power-of-two microsecond buckets: bucket i covers [2^i, 2^(i+1)) us
+    static constexpr size_t LATENCY_BUCKETS = 32;
+
+    struct OpcodeStats {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> total_us{0};
+        std::array<std::atomic<uint64_t>, LATENCY_BUCKETS> histogram{};
+    };
+
     SyscallRouter() = default;
 
-    ipc::Message handle(const ipc::Message& msg) const;
+    // Per-agent accounting updated on every dispatch. Slots are indexed
+    // agent_id % AGENT_SLOTS, so two agents more than 1024 ids apart
+    // share (and merge) a slot — fine for rate accounting, and it keeps
+    // the hot path at four relaxed increments with no lookup.
+    static constexpr size_t AGENT_SLOTS = 1024;
+
+    struct AgentStats {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> errors{0};
+        std::atomic<uint64_t> bytes_in{0};   // request payload bytes
+        std::atomic<uint64_t> bytes_out{0};  // response payload bytes
+    };
+
+    // Post-dispatch hook, called once per handled syscall with the
+    // opcode, calling agent and success sniff. The kernel points this
+    // at the audit logger (category per opcode via OPCODE_TABLE); it
+    // must be cheap when its category is disabled.
+    using Observer = std::function<void(ipc::SyscallOp, uint32_t agent_id, bool failed)>;
+
+    ipc::Message handle(const ipc::Message& msg);
     void register_handler(ipc::SyscallOp op, Handler handler);
+    void set_observer(Observer observer) { observer_ = std::move(observer); }
+
+    // Per-opcode latency stats for opcodes that have been called
+    nlohmann::json stats_json() const;
+
+    const AgentStats& agent_stats(uint32_t agent_id) const {
+        return agent_stats_[agent_id % AGENT_SLOTS];
+    }
 
 private:
-    std::unordered_map<ipc::SyscallOp, Handler> handlers_;
+    std::array<Handler, 256> handlers_{};
+    Observer observer_;
+    std::array<OpcodeStats, 256> stats_{};
+    std::array<AgentStats, AGENT_SLOTS> agent_stats_{};
+    metrics::LatencyHistogram latency_hist_{"syscall_handle_us"};
 };
 
 } // namespace clove::kernel
@@ -1,6 +1,8 @@
 #include "kernel/syscall_handlers.hpp"
 #include "kernel/syscall_router.hpp"
+#include "kernel/async_helpers.hpp"
 #include "kernel/audit_log.hpp"
+#include "kernel/federation.hpp"
 #include "runtime/agent/manager.hpp"
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
@@ -11,44 +13,71 @@ namespace clove::kernel {
 
 void AgentSyscalls::register_syscalls(SyscallRouter& router) {
     router.register_handler(ipc::SyscallOp::SYS_SPAWN, [this](const ipc::Message& msg) { return handle_spawn(msg); });
+    router.register_handler(ipc::SyscallOp::SYS_SPAWN_BATCH, [this](const ipc::Message& msg) { return handle_spawn_batch(msg); });
     router.register_handler(ipc::SyscallOp::SYS_KILL, [this](const ipc::Message& msg) { return handle_kill(msg); });
     router.register_handler(ipc::SyscallOp::SYS_LIST, [this](const ipc::Message& msg) { return handle_list(msg); });
     router.register_handler(ipc::SyscallOp::SYS_PAUSE, [this](const ipc::Message& msg) { return handle_pause(msg); });
     router.register_handler(ipc::SyscallOp::SYS_RESUME, [this](const ipc::Message& msg) { return handle_resume(msg); });
 }
 
+// Shared by SYS_SPAWN and SYS_SPAWN_BATCH
+static runtime::AgentConfig parse_agent_config(const json& j, bool sandboxing_enabled) {
+    runtime::AgentConfig config;
+    // Use ternary to avoid eager evaluation of generate_id() when name is provided
+    config.name = j.contains("name") ? j["name"].get<std::string>()
+        : "agent_" + std::to_string(runtime::AgentProcess::generate_id());
+    config.script_path = j.value("script", "");
+    config.python_path = j.value("python", "python3");
+    config.sandboxed = sandboxing_enabled && j.value("sandboxed", true);
+    config.enable_network = j.value("network", false);
+    config.image = j.value("image", "");
+
+    if (j.contains("limits")) {
+        auto& lim = j["limits"];
+        config.limits.memory_limit_bytes = lim.value("memory", 256 * 1024 * 1024);
+        config.limits.max_pids = lim.value("max_pids", 64);
+        config.limits.cpu_quota_us = lim.value("cpu_quota", 100000);
+        config.limits.cpu_period_us = lim.value("cpu_period", 100000);
+        config.limits.cpu_shares = lim.value("cpu_shares", 1024);
+    }
+
+    config.restart.policy = runtime::restart_policy_from_string(
+        j.value("restart_policy", "never"));
+    config.restart.max_restarts = j.value("max_restarts", 5);
+    config.restart.restart_window_sec = j.value("restart_window", 300);
+
+    return config;
+}
+
 ipc::Message AgentSyscalls::handle_spawn(const ipc::Message& msg) {
     try {
         json j = json::parse(msg.payload_str());
 
-        runtime::AgentConfig config;
-        // Use ternary to avoid eager evaluation of generate_id() when name is provided
-        config.name = j.contains("name") ? j["name"].get<std::string>()
-            : "agent_" + std::to_string(runtime::AgentProcess::generate_id());
-        config.script_path = j.value("script", "");
-        config.python_path = j.value("python", "python3");
-        config.sandboxed = context_.config.enable_sandboxing && j.value("sandboxed", true);
-        config.enable_network = j.value("network", false);
-
-        if (j.contains("limits")) {
-            auto& lim = j["limits"];
-            config.limits.memory_limit_bytes = lim.value("memory", 256 * 1024 * 1024);
-            config.limits.max_pids = lim.value("max_pids", 64);
-            config.limits.cpu_quota_us = lim.value("cpu_quota", 100000);
-            config.limits.cpu_period_us = lim.value("cpu_period", 100000);
-            config.limits.cpu_shares = lim.value("cpu_shares", 1024);
-        }
-
-        config.restart.policy = runtime::restart_policy_from_string(
-            j.value("restart_policy", "never"));
-        config.restart.max_restarts = j.value("max_restarts", 5);
-        config.restart.restart_window_sec = j.value("restart_window", 300);
+        runtime::AgentConfig config = parse_agent_config(j, context_.config.enable_sandboxing);
 
         if (config.script_path.empty()) {
             return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_SPAWN,
                 R"({"error": "script path required"})");
         }
 
+        // placement "least_loaded": hand the spawn to the peer kernel
+        // with the fewest agents when one is less loaded than us. The
+        // round trip runs on the async pool.
+        if (context_.federation && j.value("placement", "local") == "least_loaded") {
+            auto target = context_.federation->pick_spawn_target(
+                context_.agent_manager.list_agents().size());
+            if (target) {
+                return async_helpers::submit_async(context_, msg, j,
+                    [config, addr = *target](KernelContext& context,
+                                             const ipc::Message& task_msg, const json&) {
+                        json reply = context.federation->remote_spawn(addr, config.to_json());
+                        return ipc::Message(task_msg.agent_id, ipc::SyscallOp::SYS_SPAWN,
+                                            reply.dump());
+                    });
+            }
+            // No peer beats local load — fall through and spawn here
+        }
+
         spdlog::info("Spawning agent: {} (script={})", config.name, config.script_path);
 
         auto agent = context_.agent_manager.spawn_agent(config);
@@ -107,6 +136,86 @@ ipc::Message AgentSyscalls::handle_spawn(const ipc::Message& msg) {
     }
 }
 
+ipc::Message AgentSyscalls::handle_spawn_batch(const ipc::Message& msg) {
+    try {
+        json j = json::parse(msg.payload_str());
+
+        if (!j.contains("agents") || !j["agents"].is_array() || j["agents"].empty()) {
+            return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_SPAWN_BATCH,
+                R"({"error": "agents array required"})");
+        }
+
+        // Pre-validate each spec so one bad entry doesn't sink the batch
+        json results = json::array();
+        std::vector<runtime::AgentConfig> valid;
+        std::vector<size_t> result_idx;
+        for (const auto& spec : j["agents"]) {
+            runtime::AgentConfig config =
+                parse_agent_config(spec, context_.config.enable_sandboxing);
+
+            json entry;
+            entry["name"] = config.name;
+            if (config.script_path.empty()) {
+                entry["success"] = false;
+                entry["error"] = "script path required";
+            } else {
+                result_idx.push_back(results.size());
+                valid.push_back(std::move(config));
+            }
+            results.push_back(entry);
+        }
+
+        spdlog::info("Spawning agent batch: {} agents", valid.size());
+
+        auto agents = context_.agent_manager.spawn_agents(valid);
+
+        size_t spawned = 0;
+        for (size_t i = 0; i < agents.size(); ++i) {
+            json& entry = results[result_idx[i]];
+            auto& agent = agents[i];
+
+            if (!agent) {
+                entry["success"] = false;
+                entry["error"] = "failed to spawn agent";
+                continue;
+            }
+
+            agent->set_parent_id(msg.agent_id);
+            if (msg.agent_id > 0) {
+                auto parent = context_.agent_manager.get_agent(msg.agent_id);
+                if (parent) {
+                    parent->add_child(agent->id());
+                }
+            }
+
+            entry["success"] = true;
+            entry["id"] = agent->id();
+            entry["pid"] = agent->pid();
+            spawned++;
+
+            json event_data;
+            event_data["agent_id"] = agent->id();
+            event_data["name"] = agent->name();
+            event_data["pid"] = agent->pid();
+            event_data["parent_id"] = msg.agent_id;
+            context_.event_bus.emit(KernelEventType::AGENT_SPAWNED, event_data, 0);
+
+            context_.audit_logger.log_lifecycle("AGENT_SPAWNED", agent->id(), agent->name(), event_data);
+        }
+
+        json response;
+        response["success"] = (spawned == results.size());
+        response["count"] = spawned;
+        response["agents"] = results;
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_SPAWN_BATCH, response.dump());
+
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to parse spawn batch request: {}", e.what());
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_SPAWN_BATCH,
+            R"({"error": "invalid JSON"})");
+    }
+}
+
 ipc::Message AgentSyscalls::handle_kill(const ipc::Message& msg) {
     try {
         json j = json::parse(msg.payload_str());
@@ -128,6 +237,10 @@ ipc::Message AgentSyscalls::handle_kill(const ipc::Message& msg) {
         }
 
         if (killed && target_id > 0) {
+            // Reclaim the dead agent's async work: queued tasks are
+            // dropped, running ones get their cancel flag
+            context_.async_tasks.purge_agent(target_id);
+
             json event_data;
             event_data["agent_id"] = target_id;
             event_data["name"] = target_name;
@@ -12,6 +12,10 @@ void AsyncSyscalls::register_syscalls(SyscallRouter& router) {
         [this](const ipc::Message& msg) { return handle_async_poll(msg); });
 }
 
+void AsyncSyscalls::on_tick() {
+    context_.async_tasks.expire_deadlines();
+}
+
 ipc::Message AsyncSyscalls::handle_async_poll(const ipc::Message& msg) {
     json request;
     try {
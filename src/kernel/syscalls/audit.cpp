@@ -96,6 +96,18 @@ ipc::Message AuditSyscalls::handle_set_audit_config(const ipc::Message& msg) {
     if (request.contains("log_world")) {
         config.log_world = request["log_world"].get<bool>();
     }
+    if (request.contains("sample_syscalls")) {
+        config.sample_syscalls = request["sample_syscalls"].get<double>();
+    }
+    if (request.contains("sample_ipc")) {
+        config.sample_ipc = request["sample_ipc"].get<double>();
+    }
+    if (request.contains("sample_state")) {
+        config.sample_state = request["sample_state"].get<double>();
+    }
+    if (request.contains("sample_network")) {
+        config.sample_network = request["sample_network"].get<double>();
+    }
 
     context_.audit_logger.set_config(config);
 
@@ -115,6 +127,10 @@ ipc::Message AuditSyscalls::handle_set_audit_config(const ipc::Message& msg) {
     response["config"]["log_resource"] = config.log_resource;
     response["config"]["log_network"] = config.log_network;
     response["config"]["log_world"] = config.log_world;
+    response["config"]["sample_syscalls"] = config.sample_syscalls;
+    response["config"]["sample_ipc"] = config.sample_ipc;
+    response["config"]["sample_state"] = config.sample_state;
+    response["config"]["sample_network"] = config.sample_network;
 
     return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_SET_AUDIT_CONFIG, response.dump());
 }
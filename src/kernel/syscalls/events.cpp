@@ -1,5 +1,6 @@
 #include "kernel/syscall_handlers.hpp"
 #include "kernel/syscall_router.hpp"
+#include "ipc/transport/socket_server.hpp"
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
 
@@ -51,13 +52,36 @@ ipc::Message EventSyscalls::handle_subscribe(const ipc::Message& msg) {
         for (const auto& event_str : event_types) {
             types.push_back(kernel_event_type_from_string(event_str));
         }
-        context_.event_bus.subscribe(msg.agent_id, types);
+        // Queue bound and overflow policy apply when the subscriber is
+        // first created
+        size_t queue_size = j.value("queue_size", 0u);
+        OverflowPolicy policy = OverflowPolicy::DROP_NEWEST;
+        std::string overflow = j.value("overflow", "drop_newest");
+        if (overflow == "drop_oldest") {
+            policy = OverflowPolicy::DROP_OLDEST;
+        } else if (overflow == "coalesce") {
+            policy = OverflowPolicy::COALESCE;
+        }
+
+        context_.event_bus.subscribe(msg.agent_id, types, queue_size, policy);
 
         spdlog::debug("Agent {} subscribed to {} event type(s)", msg.agent_id, event_types.size());
 
         json response;
         response["success"] = true;
         response["subscribed"] = event_types;
+
+        // Opt-in: hand the agent its notification eventfd (SCM_RIGHTS on
+        // this response) so the SDK can epoll-wait for events instead of
+        // polling SYS_POLL_EVENTS on a timer
+        if (j.value("notify_fd", false)) {
+            int notify_fd = context_.event_bus.notify_fd(msg.agent_id);
+            if (notify_fd >= 0 &&
+                context_.socket_server.attach_fd(msg.agent_id, notify_fd)) {
+                response["notify_fd"] = true;
+            }
+        }
+
         return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_SUBSCRIBE, response.dump());
 
     } catch (const std::exception& e) {
@@ -123,13 +147,21 @@ ipc::Message EventSyscalls::handle_poll_events(const ipc::Message& msg) {
         }
 
         int max_events = j.value("max", 100);
-        json events_array = context_.event_bus.poll(msg.agent_id, max_events);
-
-        json response;
-        response["success"] = true;
-        response["events"] = events_array;
-        response["count"] = events_array.size();
-        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_POLL_EVENTS, response.dump());
+        auto batch = context_.event_bus.poll(msg.agent_id, max_events);
+
+        // Events come back pre-serialized; assemble the response by
+        // concatenation instead of re-parsing them into a json tree
+        std::string payload = "{\"success\":true,\"count\":" +
+                              std::to_string(batch.count) +
+                              ",\"events\":" + batch.events;
+        if (batch.dropped > 0) {
+            payload += ",\"dropped\":" + std::to_string(batch.dropped);
+        }
+        if (batch.coalesced > 0) {
+            payload += ",\"coalesced\":" + std::to_string(batch.coalesced);
+        }
+        payload += "}";
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_POLL_EVENTS, payload);
 
     } catch (const std::exception& e) {
         json response;
@@ -2,16 +2,47 @@
 #include "kernel/syscall_router.hpp"
 #include "kernel/async_task_manager.hpp"
 #include "kernel/async_helpers.hpp"
+#include "kernel/opcode_table.hpp"
 #include "kernel/permissions_store.hpp"
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
-#include <cstdio>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
 #include <sys/wait.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+
+extern char** environ;
 
 using json = nlohmann::json;
 
 namespace clove::kernel {
 
+namespace {
+
+// A command without shell metacharacters can be spawned directly; only
+// pipelines, redirections, expansions etc. need /bin/sh
+bool needs_shell(const std::string& command) {
+    return command.find_first_of("|&;<>()$`\\\"'*?[]#~{}\n") != std::string::npos;
+}
+
+std::vector<std::string> split_argv(const std::string& command) {
+    std::vector<std::string> args;
+    std::istringstream stream(command);
+    std::string token;
+    while (stream >> token) {
+        args.push_back(std::move(token));
+    }
+    return args;
+}
+
+} // namespace
+
 void ExecSyscalls::register_syscalls(SyscallRouter& router) {
     router.register_handler(ipc::SyscallOp::SYS_EXEC,
         [this](const ipc::Message& msg) { return handle_exec(msg); });
@@ -21,8 +52,8 @@ ipc::Message ExecSyscalls::exec_sync(KernelContext& context, const ipc::Message&
     auto& perms = context.permissions_store.get_or_create(msg.agent_id);
     std::string command = j.value("command", "");
     std::string cwd = j.value("cwd", "");
-    int timeout_sec = j.value("timeout", 30);
-    (void)timeout_sec;
+    int timeout_sec = j.value("timeout",
+        static_cast<int>(opcode_info(ipc::SyscallOp::SYS_EXEC).default_timeout_sec));
 
     if (command.empty()) {
         json response;
@@ -47,37 +78,166 @@ ipc::Message ExecSyscalls::exec_sync(KernelContext& context, const ipc::Message&
 
     spdlog::debug("Agent {} executing: {}", msg.agent_id, command);
 
-    std::string full_command = command;
+    // Cap how much output we buffer so a chatty command can't balloon
+    // kernel memory; the agent sees a truncation flag instead
+    size_t max_output = j.value("max_output", 4u * 1024 * 1024);
+
+    json response;
+    response["stdout"] = "";
+    response["stderr"] = "";
+    response["exit_code"] = -1;
+
+    // Build argv: direct spawn for plain commands, /bin/sh -c only when
+    // the command actually uses shell syntax
+    std::vector<std::string> args;
+    if (needs_shell(command)) {
+        args = {"/bin/sh", "-c", command};
+    } else {
+        args = split_argv(command);
+    }
+    if (args.empty()) {
+        response["success"] = false;
+        response["error"] = "command required";
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_EXEC, response.dump());
+    }
+    std::vector<char*> argv;
+    argv.reserve(args.size() + 1);
+    for (auto& arg : args) {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+
+    int out_pipe[2];
+    int err_pipe[2];
+    if (::pipe2(out_pipe, O_CLOEXEC) < 0) {
+        response["success"] = false;
+        response["error"] = "failed to create pipes";
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_EXEC, response.dump());
+    }
+    if (::pipe2(err_pipe, O_CLOEXEC) < 0) {
+        // pipe2 fails under fd pressure (EMFILE/ENFILE); leaking out_pipe
+        // here would deepen the very exhaustion that caused the failure
+        ::close(out_pipe[0]);
+        ::close(out_pipe[1]);
+        response["success"] = false;
+        response["error"] = "failed to create pipes";
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_EXEC, response.dump());
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
     if (!cwd.empty()) {
-        full_command = "cd " + cwd + " && " + command;
+        posix_spawn_file_actions_addchdir_np(&actions, cwd.c_str());
     }
-    full_command += " 2>&1";
+    posix_spawn_file_actions_adddup2(&actions, out_pipe[1], STDOUT_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, err_pipe[1], STDERR_FILENO);
 
-    FILE* pipe = popen(full_command.c_str(), "r");
-    if (!pipe) {
-        json response;
+    pid_t pid = -1;
+    int spawn_rc = ::posix_spawnp(&pid, argv[0], &actions, nullptr,
+                                  argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    ::close(out_pipe[1]);
+    ::close(err_pipe[1]);
+
+    if (spawn_rc != 0) {
+        ::close(out_pipe[0]);
+        ::close(err_pipe[0]);
         response["success"] = false;
-        response["error"] = "failed to execute command";
-        response["stdout"] = "";
-        response["stderr"] = "";
-        response["exit_code"] = -1;
+        response["error"] = std::string("failed to spawn: ") + strerror(spawn_rc);
         return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_EXEC, response.dump());
     }
 
-    std::string output;
-    char buffer[4096];
-    while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
-        output += buffer;
+    // Drain both pipes as output arrives instead of buffering the whole
+    // stream behind a blocking read; this also enforces the timeout,
+    // which the popen path silently ignored
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::seconds(timeout_sec);
+    std::string out_data;
+    std::string err_data;
+    bool truncated = false;
+    bool timed_out = false;
+    bool cancelled = false;
+
+    pollfd fds[2] = {{out_pipe[0], POLLIN, 0}, {err_pipe[0], POLLIN, 0}};
+    int open_fds = 2;
+    char buffer[16384];
+
+    while (open_fds > 0) {
+        // Cooperative cancellation: when the executor cancelled this
+        // task (agent killed, deadline_ms elapsed), stop draining and
+        // reap the child instead of running it to completion
+        if (AsyncTaskManager::current_cancelled()) {
+            cancelled = true;
+            break;
+        }
+
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        if (left <= 0) {
+            timed_out = true;
+            break;
+        }
+
+        // Cap the wait so cancellation is noticed within ~half a second
+        int rc = ::poll(fds, 2, static_cast<int>(std::min<long long>(left, 500)));
+        if (rc < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (rc == 0) {
+            continue;  // timeout and cancellation re-checked at loop top
+        }
+
+        for (int i = 0; i < 2; ++i) {
+            if (fds[i].fd < 0 || !(fds[i].revents & (POLLIN | POLLHUP))) {
+                continue;
+            }
+            ssize_t n = ::read(fds[i].fd, buffer, sizeof(buffer));
+            if (n > 0) {
+                std::string& sink = (i == 0) ? out_data : err_data;
+                if (sink.size() < max_output) {
+                    sink.append(buffer, std::min(static_cast<size_t>(n),
+                                                 max_output - sink.size()));
+                    if (sink.size() >= max_output) {
+                        truncated = true;
+                    }
+                }
+            } else {
+                ::close(fds[i].fd);
+                fds[i].fd = -1;
+                --open_fds;
+            }
+        }
     }
 
-    int status = pclose(pipe);
-    int exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    if (fds[0].fd >= 0) ::close(fds[0].fd);
+    if (fds[1].fd >= 0) ::close(fds[1].fd);
 
-    json response;
-    response["success"] = (exit_code == 0);
-    response["stdout"] = output;
-    response["stderr"] = "";
+    int exit_code = -1;
+    if (timed_out || cancelled) {
+        ::kill(pid, SIGKILL);
+    }
+    int status = 0;
+    if (::waitpid(pid, &status, 0) == pid && WIFEXITED(status)) {
+        exit_code = WEXITSTATUS(status);
+    }
+
+    response["success"] = (!timed_out && !cancelled && exit_code == 0);
+    response["stdout"] = out_data;
+    response["stderr"] = err_data;
     response["exit_code"] = exit_code;
+    if (timed_out) {
+        response["error"] = "command timed out after " +
+                            std::to_string(timeout_sec) + "s";
+        response["timed_out"] = true;
+    }
+    if (cancelled) {
+        response["error"] = "cancelled";
+        response["cancelled"] = true;
+    }
+    if (truncated) {
+        response["truncated"] = true;
+    }
 
     spdlog::debug("Command exit code: {}", exit_code);
     return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_EXEC, response.dump());
@@ -98,7 +258,7 @@ ipc::Message ExecSyscalls::handle_exec(const ipc::Message& msg) {
         return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_EXEC, response.dump());
     }
 
-    bool async = async_helpers::should_async(j, true);
+    bool async = async_helpers::should_async(j, msg.opcode);
     if (async) {
         std::string command = j.value("command", "");
         if (command.empty()) {
@@ -1,10 +1,18 @@
 #include "kernel/syscall_handlers.hpp"
 #include "kernel/syscall_router.hpp"
+#include "kernel/async_helpers.hpp"
 #include "kernel/permissions_store.hpp"
+#include "kernel/uring_file.hpp"
+#include "ipc/transport/socket_server.hpp"
 #include "worlds/world_engine.hpp"
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
-#include <fstream>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <limits>
 #include <thread>
 
 using json = nlohmann::json;
@@ -22,13 +30,13 @@ ipc::Message FileSyscalls::handle_read(const ipc::Message& msg) {
     if (context_.world_engine.is_agent_in_world(msg.agent_id)) {
         auto world_id = context_.world_engine.get_agent_world(msg.agent_id);
         if (world_id) {
-            auto* world = context_.world_engine.get_world(*world_id);
+            auto world = context_.world_engine.get_world(*world_id);
             if (world && world->vfs().is_enabled()) {
                 try {
                     json j = json::parse(msg.payload_str());
                     std::string path = j.value("path", "");
                     if (world->vfs().should_intercept(path)) {
-                        return handle_read_virtual(msg, world);
+                        return handle_read_virtual(msg, world.get());
                     }
                 } catch (...) {
                 }
@@ -36,80 +44,125 @@ ipc::Message FileSyscalls::handle_read(const ipc::Message& msg) {
         }
     }
 
-    auto& perms = context_.permissions_store.get_or_create(msg.agent_id);
-
     try {
         json j = json::parse(msg.payload_str());
-        std::string path = j.value("path", "");
 
-        if (path.empty()) {
+        // Opt-in async: offloads the disk wait to the executor instead
+        // of blocking the dispatch thread. Raw mode stays synchronous —
+        // its file region must be queued on the thread owning the fd.
+        if (!j.value("raw", false) && async_helpers::should_async(j, msg.opcode)) {
+            return async_helpers::submit_async(context_, msg, j, read_sync);
+        }
+        return read_sync(context_, msg, j);
+
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to parse read request: {}", e.what());
+        json response;
+        response["success"] = false;
+        response["error"] = std::string("invalid request: ") + e.what();
+        response["content"] = "";
+        response["size"] = 0;
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_READ, response.dump());
+    }
+}
+
+ipc::Message FileSyscalls::read_sync(KernelContext& context, const ipc::Message& msg, const json& j) {
+    std::string path = j.value("path", "");
+
+    if (path.empty()) {
+        json response;
+        response["success"] = false;
+        response["error"] = "path required";
+        response["content"] = "";
+        response["size"] = 0;
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_READ, response.dump());
+    }
+
+    if (!context.permissions_store.check_path(msg.agent_id, path, PathAccess::READ)) {
+        spdlog::warn("Agent {} denied read access to: {}", msg.agent_id, path);
+        json response;
+        response["success"] = false;
+        response["error"] = "Permission denied: path not allowed for reading";
+        response["content"] = "";
+        response["size"] = 0;
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_READ, response.dump());
+    }
+
+    spdlog::debug("Agent {} reading file: {}", msg.agent_id, path);
+
+    // Raw mode: the reply frame announces the size and the file bytes
+    // follow it on the wire, pumped kernel-to-socket via sendfile — no
+    // userspace copy and no JSON escaping of the content
+    if (j.value("raw", false)) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
             json response;
             response["success"] = false;
-            response["error"] = "path required";
+            response["error"] = std::string("cannot open file: ") + strerror(errno);
             response["content"] = "";
             response["size"] = 0;
             return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_READ, response.dump());
         }
 
-        if (!perms.can_read_path(path)) {
-            spdlog::warn("Agent {} denied read access to: {}", msg.agent_id, path);
+        struct stat st{};
+        if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+            ::close(fd);
             json response;
             response["success"] = false;
-            response["error"] = "Permission denied: path not allowed for reading";
+            response["error"] = "raw mode requires a regular file";
             response["content"] = "";
             response["size"] = 0;
             return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_READ, response.dump());
         }
 
-        spdlog::debug("Agent {} reading file: {}", msg.agent_id, path);
-
-        std::ifstream file(path, std::ios::binary);
-        if (!file.is_open()) {
+        size_t size = static_cast<size_t>(st.st_size);
+        if (!context.socket_server.stream_file(msg.agent_id, fd, size)) {
+            ::close(fd);
             json response;
             response["success"] = false;
-            response["error"] = "failed to open file";
+            response["error"] = "connection cannot stream raw responses";
             response["content"] = "";
             response["size"] = 0;
             return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_READ, response.dump());
         }
 
-        file.seekg(0, std::ios::end);
-        size_t size = file.tellg();
-        file.seekg(0, std::ios::beg);
-
-        std::string content(size, '\0');
-        file.read(&content[0], size);
-        file.close();
-
         json response;
         response["success"] = true;
-        response["content"] = content;
+        response["raw"] = true;
         response["size"] = size;
-
         return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_READ, response.dump());
+    }
 
-    } catch (const std::exception& e) {
-        spdlog::error("Failed to parse read request: {}", e.what());
+    std::string content;
+    std::string error;
+    if (!uring_file::read_file(path, content, error)) {
         json response;
         response["success"] = false;
-        response["error"] = std::string("invalid request: ") + e.what();
+        response["error"] = error;
         response["content"] = "";
         response["size"] = 0;
         return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_READ, response.dump());
     }
+
+    json response;
+    response["success"] = true;
+    response["content"] = content;
+    response["size"] = content.size();
+
+    return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_READ, response.dump());
 }
 
 ipc::Message FileSyscalls::handle_write(const ipc::Message& msg) {
     if (context_.world_engine.is_agent_in_world(msg.agent_id)) {
         auto world_id = context_.world_engine.get_agent_world(msg.agent_id);
         if (world_id) {
-            auto* world = context_.world_engine.get_world(*world_id);
+            auto world = context_.world_engine.get_world(*world_id);
             if (world && world->vfs().is_enabled()) {
                 try {
                     json j = json::parse(msg.payload_str());
                     std::string path = j.value("path", "");
                     if (world->vfs().should_intercept(path)) {
-                        return handle_write_virtual(msg, world);
+                        return handle_write_virtual(msg, world.get());
                     }
                 } catch (...) {
                 }
@@ -117,66 +170,62 @@ ipc::Message FileSyscalls::handle_write(const ipc::Message& msg) {
         }
     }
 
-    auto& perms = context_.permissions_store.get_or_create(msg.agent_id);
-
     try {
         json j = json::parse(msg.payload_str());
-        std::string path = j.value("path", "");
-        std::string content = j.value("content", "");
-        std::string mode = j.value("mode", "write");
 
-        if (path.empty()) {
-            json response;
-            response["success"] = false;
-            response["error"] = "path required";
-            response["bytes_written"] = 0;
-            return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_WRITE, response.dump());
-        }
-
-        if (!perms.can_write_path(path)) {
-            spdlog::warn("Agent {} denied write access to: {}", msg.agent_id, path);
-            json response;
-            response["success"] = false;
-            response["error"] = "Permission denied: path not allowed for writing";
-            response["bytes_written"] = 0;
-            return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_WRITE, response.dump());
+        if (async_helpers::should_async(j, msg.opcode)) {
+            return async_helpers::submit_async(context_, msg, j, write_sync);
         }
+        return write_sync(context_, msg, j);
 
-        spdlog::debug("Agent {} writing file: {} (mode={})", msg.agent_id, path, mode);
-
-        std::ios_base::openmode file_mode = std::ios::binary;
-        if (mode == "append") {
-            file_mode |= std::ios::app;
-        } else {
-            file_mode |= std::ios::trunc;
-        }
-
-        std::ofstream file(path, file_mode);
-        if (!file.is_open()) {
-            json response;
-            response["success"] = false;
-            response["error"] = "failed to open file for writing";
-            response["bytes_written"] = 0;
-            return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_WRITE, response.dump());
-        }
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to parse write request: {}", e.what());
+        json response;
+        response["success"] = false;
+        response["error"] = std::string("invalid request: ") + e.what();
+        response["bytes_written"] = 0;
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_WRITE, response.dump());
+    }
+}
 
-        file.write(content.data(), content.size());
-        file.close();
+ipc::Message FileSyscalls::write_sync(KernelContext& context, const ipc::Message& msg, const json& j) {
+    std::string path = j.value("path", "");
+    std::string content = j.value("content", "");
+    std::string mode = j.value("mode", "write");
 
+    if (path.empty()) {
         json response;
-        response["success"] = true;
-        response["bytes_written"] = content.size();
+        response["success"] = false;
+        response["error"] = "path required";
+        response["bytes_written"] = 0;
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_WRITE, response.dump());
+    }
 
+    if (!context.permissions_store.check_path(msg.agent_id, path, PathAccess::WRITE)) {
+        spdlog::warn("Agent {} denied write access to: {}", msg.agent_id, path);
+        json response;
+        response["success"] = false;
+        response["error"] = "Permission denied: path not allowed for writing";
+        response["bytes_written"] = 0;
         return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_WRITE, response.dump());
+    }
 
-    } catch (const std::exception& e) {
-        spdlog::error("Failed to parse write request: {}", e.what());
+    spdlog::debug("Agent {} writing file: {} (mode={})", msg.agent_id, path, mode);
+
+    std::string error;
+    if (!uring_file::write_file(path, content, mode == "append", error)) {
         json response;
         response["success"] = false;
-        response["error"] = std::string("invalid request: ") + e.what();
+        response["error"] = error;
         response["bytes_written"] = 0;
         return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_WRITE, response.dump());
     }
+
+    json response;
+    response["success"] = true;
+    response["bytes_written"] = content.size();
+
+    return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_WRITE, response.dump());
 }
 
 // ============================================================================
@@ -201,7 +250,15 @@ ipc::Message FileSyscalls::handle_read_virtual(const ipc::Message& msg, clove::w
             return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_READ, response.dump());
         }
 
-        auto content_opt = world->vfs().read(path);
+        // Ranged reads copy only the requested slice of the rope
+        std::optional<std::string> content_opt;
+        if (j.contains("offset") || j.contains("length")) {
+            content_opt = world->vfs().read_range(
+                path, j.value("offset", 0ull),
+                j.value("length", std::numeric_limits<uint64_t>::max()));
+        } else {
+            content_opt = world->vfs().read(path);
+        }
         if (!content_opt.has_value()) {
             json response;
             response["success"] = false;
@@ -1,13 +1,82 @@
 #include "kernel/syscall_handlers.hpp"
 #include "kernel/syscall_router.hpp"
+#include "kernel/async_task_manager.hpp"
+#include "kernel/federation.hpp"
 #include "kernel/ipc_mailbox.hpp"
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
+#include <algorithm>
 
 using json = nlohmann::json;
 
 namespace clove::kernel {
 
+namespace {
+
+// Bodies are stored pre-serialized, so the messages array is assembled
+// by concatenation — no json tree is rebuilt on the dequeue path
+std::string serialize_messages(const std::vector<IPCMessage>& messages) {
+    std::string out = "[";
+    auto now = std::chrono::steady_clock::now();
+
+    bool first = true;
+    for (const auto& ipc_msg : messages) {
+        auto age_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            now - ipc_msg.timestamp).count();
+
+        if (!first) {
+            out.push_back(',');
+        }
+        first = false;
+        out += "{\"from\":" + std::to_string(ipc_msg.from_id);
+        out += ",\"from_name\":" + json(ipc_msg.from_name).dump();
+        out += ",\"message\":" + (ipc_msg.body ? *ipc_msg.body : std::string("null"));
+        out += ",\"age_ms\":" + std::to_string(age_ms) + "}";
+    }
+
+    out.push_back(']');
+    return out;
+}
+
+uint8_t parse_priority(const json& j) {
+    if (!j.contains("priority")) {
+        return IPC_LANE_NORMAL;
+    }
+    const auto& priority = j["priority"];
+    if (priority.is_number_integer()) {
+        return static_cast<uint8_t>(
+            std::clamp(priority.get<int>(), 0, NUM_IPC_LANES - 1));
+    }
+    if (priority.is_string()) {
+        std::string name = priority.get<std::string>();
+        if (name == "urgent") return IPC_LANE_URGENT;
+        if (name == "bulk") return IPC_LANE_BULK;
+    }
+    return IPC_LANE_NORMAL;
+}
+
+void apply_ttl(IPCMessage& ipc_msg, const json& j) {
+    int ttl_ms = j.value("ttl_ms", 0);
+    if (ttl_ms > 0) {
+        ipc_msg.has_ttl = true;
+        ipc_msg.expires_at = std::chrono::steady_clock::now() +
+                             std::chrono::milliseconds(ttl_ms);
+    }
+}
+
+std::string recv_payload(const std::vector<IPCMessage>& messages, bool timed_out) {
+    std::string payload = "{\"success\":true,\"count\":" +
+                          std::to_string(messages.size()) +
+                          ",\"messages\":" + serialize_messages(messages);
+    if (timed_out) {
+        payload += ",\"timed_out\":true";
+    }
+    payload += "}";
+    return payload;
+}
+
+} // namespace
+
 void IpcSyscalls::register_syscalls(SyscallRouter& router) {
     router.register_handler(ipc::SyscallOp::SYS_REGISTER,
         [this](const ipc::Message& msg) { return handle_register(msg); });
@@ -17,6 +86,21 @@ void IpcSyscalls::register_syscalls(SyscallRouter& router) {
         [this](const ipc::Message& msg) { return handle_recv(msg); });
     router.register_handler(ipc::SyscallOp::SYS_BROADCAST,
         [this](const ipc::Message& msg) { return handle_broadcast(msg); });
+
+    // Completion path for blocking recvs: the reply rides the same
+    // push/park machinery as async task results, so the waiting agent is
+    // woken the moment a message is enqueued for it
+    context_.mailbox_registry.set_recv_wake_handler(
+        [this](uint32_t agent_id, uint64_t request_id,
+               std::vector<IPCMessage> messages, bool timed_out) {
+            context_.async_tasks.complete(agent_id,
+                AsyncTaskManager::AsyncResult{request_id, ipc::SyscallOp::SYS_RECV,
+                                              recv_payload(messages, timed_out)});
+        });
+}
+
+void IpcSyscalls::on_tick() {
+    context_.mailbox_registry.expire_recv_waiters();
 }
 
 ipc::Message IpcSyscalls::handle_register(const ipc::Message& msg) {
@@ -67,6 +151,20 @@ ipc::Message IpcSyscalls::handle_send(const ipc::Message& msg) {
         if (target_id == 0 && !target_name.empty()) {
             auto resolved = context_.mailbox_registry.resolve_name(target_name);
             if (!resolved.has_value()) {
+                // Not local — a federated peer may own the name
+                if (context_.federation) {
+                    auto peer = context_.federation->forward_send(
+                        target_name, j, msg.agent_id,
+                        context_.mailbox_registry.get_name(msg.agent_id));
+                    if (peer) {
+                        json response;
+                        response["success"] = true;
+                        response["forwarded"] = true;
+                        response["peer"] = *peer;
+                        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_SEND,
+                                            response.dump());
+                    }
+                }
                 json response;
                 response["success"] = false;
                 response["error"] = "target agent not found: " + target_name;
@@ -87,10 +185,12 @@ ipc::Message IpcSyscalls::handle_send(const ipc::Message& msg) {
         IPCMessage ipc_msg;
         ipc_msg.from_id = msg.agent_id;
         ipc_msg.from_name = sender_name;
-        ipc_msg.message = message_content;
+        ipc_msg.body = std::make_shared<const std::string>(message_content.dump());
         ipc_msg.timestamp = std::chrono::steady_clock::now();
+        ipc_msg.priority = parse_priority(j);
+        apply_ttl(ipc_msg, j);
 
-        context_.mailbox_registry.enqueue(target_id, ipc_msg);
+        context_.mailbox_registry.enqueue(target_id, std::move(ipc_msg));
 
         spdlog::debug("Agent {} sent message to agent {}", msg.agent_id, target_id);
 
@@ -113,29 +213,48 @@ ipc::Message IpcSyscalls::handle_recv(const ipc::Message& msg) {
         json j = json::parse(msg.payload_str());
         int max_messages = j.value("max", 10);
         bool wait = j.value("wait", false);
-        (void)wait;
 
-        auto messages = context_.mailbox_registry.dequeue(msg.agent_id, max_messages);
-        json messages_array = json::array();
-
-        for (const auto& ipc_msg : messages) {
-            auto now = std::chrono::steady_clock::now();
-            auto age_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                now - ipc_msg.timestamp).count();
-
-            json msg_json;
-            msg_json["from"] = ipc_msg.from_id;
-            msg_json["from_name"] = ipc_msg.from_name;
-            msg_json["message"] = ipc_msg.message;
-            msg_json["age_ms"] = age_ms;
-            messages_array.push_back(msg_json);
+        if (wait) {
+            RecvWaiter waiter;
+            waiter.request_id = j.value("request_id", 0ULL);
+            if (waiter.request_id == 0) {
+                waiter.request_id = context_.async_tasks.next_request_id();
+            }
+            waiter.max_messages = max_messages;
+            int timeout_ms = j.value("timeout_ms", 0);
+            if (timeout_ms > 0) {
+                waiter.has_deadline = true;
+                waiter.deadline = std::chrono::steady_clock::now() +
+                                  std::chrono::milliseconds(timeout_ms);
+            }
+
+            std::vector<IPCMessage> messages;
+            auto result = context_.mailbox_registry.dequeue_or_park(
+                msg.agent_id, waiter, messages);
+
+            if (result == RecvParkResult::ALREADY_WAITING) {
+                json response;
+                response["success"] = false;
+                response["error"] = "a blocking recv is already pending";
+                return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_RECV, response.dump());
+            }
+
+            if (result == RecvParkResult::PARKED) {
+                json response;
+                response["success"] = true;
+                response["async"] = true;
+                response["request_id"] = waiter.request_id;
+                response["status"] = "waiting";
+                return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_RECV, response.dump());
+            }
+
+            return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_RECV,
+                                recv_payload(messages, false));
         }
 
-        json response;
-        response["success"] = true;
-        response["messages"] = messages_array;
-        response["count"] = messages_array.size();
-        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_RECV, response.dump());
+        auto messages = context_.mailbox_registry.dequeue(msg.agent_id, max_messages);
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_RECV,
+                            recv_payload(messages, false));
 
     } catch (const std::exception& e) {
         spdlog::error("Failed to parse recv request: {}", e.what());
@@ -159,16 +278,29 @@ ipc::Message IpcSyscalls::handle_broadcast(const ipc::Message& msg) {
         IPCMessage ipc_msg;
         ipc_msg.from_id = msg.agent_id;
         ipc_msg.from_name = sender_name;
-        ipc_msg.message = message_content;
+        ipc_msg.body = std::make_shared<const std::string>(message_content.dump());
         ipc_msg.timestamp = std::chrono::steady_clock::now();
+        ipc_msg.priority = parse_priority(j);
+        apply_ttl(ipc_msg, j);
 
         int delivered_count = context_.mailbox_registry.broadcast(ipc_msg, include_self);
 
+        // Fan the broadcast out to peer kernels too; their delivery is
+        // asynchronous so only the peer count is reported
+        int remote_peers = 0;
+        if (context_.federation) {
+            remote_peers = context_.federation->forward_broadcast(
+                j, msg.agent_id, sender_name);
+        }
+
         spdlog::debug("Agent {} broadcast message to {} agents", msg.agent_id, delivered_count);
 
         json response;
         response["success"] = true;
         response["delivered_count"] = delivered_count;
+        if (remote_peers > 0) {
+            response["remote_peers"] = remote_peers;
+        }
         return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_BROADCAST, response.dump());
 
     } catch (const std::exception& e) {
@@ -76,7 +76,11 @@ ipc::Message LlmSyscalls::handle_think(const ipc::Message& msg) {
         return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_THINK, response.dump());
     }
 
-    bool async = async_helpers::should_async(j, true);
+    if (j.value("stream", false)) {
+        return handle_think_stream(msg);
+    }
+
+    bool async = async_helpers::should_async(j, msg.opcode);
     if (async) {
         return async_helpers::submit_async(context_, msg, j,
             [](KernelContext& context, const ipc::Message& task_msg, const json&) {
@@ -87,6 +91,68 @@ ipc::Message LlmSyscalls::handle_think(const ipc::Message& msg) {
     return think_sync(context_, msg);
 }
 
+// Streaming think: the agent gets an immediate stream handle, then the
+// kernel pushes a completion per token chunk as the provider produces
+// them — same push/park machinery as other async results, all chunks
+// carrying the same request_id, the last one marked done. Time-to-first
+// -token stops being time-to-last-token.
+ipc::Message LlmSyscalls::handle_think_stream(const ipc::Message& msg) {
+    auto& perms = context_.permissions_store.get_or_create(msg.agent_id);
+    if (!perms.can_use_llm()) {
+        spdlog::warn("Agent {} denied LLM access (quota exceeded or permission denied)", msg.agent_id);
+        json response;
+        response["success"] = false;
+        response["error"] = "Permission denied: LLM quota exceeded or not allowed";
+        response["content"] = "";
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_THINK, response.dump());
+    }
+
+    uint64_t request_id = context_.async_tasks.next_request_id();
+    uint32_t agent_id = msg.agent_id;
+
+    context_.llm_queue.submit_stream(agent_id, msg.payload_str(),
+        [&context = context_, agent_id, request_id](const std::string& delta) {
+            json chunk;
+            chunk["success"] = true;
+            chunk["stream"] = true;
+            chunk["done"] = false;
+            chunk["delta"] = delta;
+            context.async_tasks.complete(agent_id,
+                AsyncTaskManager::AsyncResult{request_id, ipc::SyscallOp::SYS_THINK,
+                                              chunk.dump()});
+        },
+        [&context = context_, agent_id, request_id](services::llm::LLMResponse result) {
+            if (result.success && result.tokens_used > 0) {
+                auto agent = context.agent_manager.get_agent(agent_id);
+                if (agent) {
+                    agent->record_llm_call(result.tokens_used);
+                }
+                context.permissions_store.get_or_create(agent_id)
+                    .record_llm_usage(result.tokens_used);
+            }
+            json final_chunk;
+            final_chunk["success"] = result.success;
+            final_chunk["stream"] = true;
+            final_chunk["done"] = true;
+            if (result.success) {
+                final_chunk["tokens"] = result.tokens_used;
+            } else {
+                final_chunk["error"] = result.error;
+            }
+            context.async_tasks.complete(agent_id,
+                AsyncTaskManager::AsyncResult{request_id, ipc::SyscallOp::SYS_THINK,
+                                              final_chunk.dump()});
+        });
+
+    json response;
+    response["success"] = true;
+    response["async"] = true;
+    response["stream"] = true;
+    response["request_id"] = request_id;
+    response["status"] = "streaming";
+    return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_THINK, response.dump());
+}
+
 ipc::Message LlmSyscalls::handle_report(const ipc::Message& msg) {
     json j;
     try {
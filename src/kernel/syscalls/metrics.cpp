@@ -1,6 +1,7 @@
 #include "kernel/syscall_handlers.hpp"
 #include "kernel/syscall_router.hpp"
 #include "metrics/metrics.hpp"
+#include "metrics/wire.hpp"
 #include "runtime/agent/manager.hpp"
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
@@ -9,7 +10,12 @@ using json = nlohmann::json;
 
 namespace clove::kernel {
 
+namespace {
+constexpr uint32_t MIN_SUBSCRIPTION_INTERVAL_MS = 100;
+} // namespace
+
 void MetricsSyscalls::register_syscalls(SyscallRouter& router) {
+    router_ = &router;
     router.register_handler(ipc::SyscallOp::SYS_METRICS_SYSTEM,
         [this](const ipc::Message& msg) { return handle_metrics_system(msg); });
     router.register_handler(ipc::SyscallOp::SYS_METRICS_AGENT,
@@ -18,6 +24,110 @@ void MetricsSyscalls::register_syscalls(SyscallRouter& router) {
         [this](const ipc::Message& msg) { return handle_metrics_all_agents(msg); });
     router.register_handler(ipc::SyscallOp::SYS_METRICS_CGROUP,
         [this](const ipc::Message& msg) { return handle_metrics_cgroup(msg); });
+    router.register_handler(ipc::SyscallOp::SYS_METRICS_SUBSCRIBE,
+        [this](const ipc::Message& msg) { return handle_metrics_subscribe(msg); });
+    router.register_handler(ipc::SyscallOp::SYS_METRICS_UNSUBSCRIBE,
+        [this](const ipc::Message& msg) { return handle_metrics_unsubscribe(msg); });
+}
+
+void MetricsSyscalls::on_tick() {
+    auto now = std::chrono::steady_clock::now();
+
+    // Collect due subscribers without holding the lock across /proc
+    // reads or pushes
+    std::vector<std::pair<uint32_t, bool>> due;
+    {
+        std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+        for (auto& [agent_id, sub] : subscriptions_) {
+            if (now >= sub.next_due) {
+                due.emplace_back(agent_id, sub.include_agents);
+                sub.next_due = now + sub.interval;
+            }
+        }
+    }
+    if (due.empty()) {
+        return;
+    }
+
+    auto system = context_.metrics.collect_system();
+    auto system_frame = metrics::encode_system_frame(system);
+
+    std::vector<uint32_t> dead;
+    for (auto& [agent_id, include_agents] : due) {
+        bool delivered = push_(agent_id,
+            ipc::Message(agent_id, ipc::SyscallOp::SYS_METRICS_PUSH, system_frame));
+
+        if (delivered && include_agents) {
+            for (const auto& agent : context_.agent_manager.list_agents()) {
+                auto proc = context_.metrics.collect_process(agent->pid());
+                if (!proc) {
+                    continue;
+                }
+                delivered = push_(agent_id,
+                    ipc::Message(agent_id, ipc::SyscallOp::SYS_METRICS_PUSH,
+                                 metrics::encode_process_frame(agent->id(), *proc)));
+                if (!delivered) {
+                    break;
+                }
+            }
+        }
+
+        if (!delivered) {
+            dead.push_back(agent_id);
+        }
+    }
+
+    if (!dead.empty()) {
+        std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+        for (uint32_t agent_id : dead) {
+            subscriptions_.erase(agent_id);
+        }
+    }
+}
+
+ipc::Message MetricsSyscalls::handle_metrics_subscribe(const ipc::Message& msg) {
+    json request;
+    try {
+        request = json::parse(msg.payload_str());
+    } catch (...) {
+        request = json::object();
+    }
+
+    uint32_t interval_ms = request.value("interval_ms", 1000u);
+    if (interval_ms < MIN_SUBSCRIPTION_INTERVAL_MS) {
+        interval_ms = MIN_SUBSCRIPTION_INTERVAL_MS;
+    }
+
+    Subscription sub;
+    sub.interval = std::chrono::milliseconds(interval_ms);
+    sub.next_due = std::chrono::steady_clock::now();
+    sub.include_agents = request.value("include_agents", false);
+
+    {
+        std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+        subscriptions_[msg.agent_id] = sub;
+    }
+
+    json response;
+    response["success"] = true;
+    response["interval_ms"] = interval_ms;
+    response["include_agents"] = sub.include_agents;
+
+    return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_METRICS_SUBSCRIBE, response.dump());
+}
+
+ipc::Message MetricsSyscalls::handle_metrics_unsubscribe(const ipc::Message& msg) {
+    bool removed;
+    {
+        std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+        removed = subscriptions_.erase(msg.agent_id) > 0;
+    }
+
+    json response;
+    response["success"] = true;
+    response["was_subscribed"] = removed;
+
+    return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_METRICS_UNSUBSCRIBE, response.dump());
 }
 
 ipc::Message MetricsSyscalls::handle_metrics_system(const ipc::Message& msg) {
@@ -26,6 +136,7 @@ ipc::Message MetricsSyscalls::handle_metrics_system(const ipc::Message& msg) {
     json response;
     response["success"] = true;
     response["metrics"] = metrics.to_json();
+    response["latency_histograms"] = metrics::histograms_json();
 
     return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_METRICS_SYSTEM, response.dump());
 }
@@ -68,9 +179,18 @@ ipc::Message MetricsSyscalls::handle_metrics_agent(const ipc::Message& msg) {
         agent_metrics.uptime_seconds * 1000
     );
 
+    // Kernel-side accounting: the router counts every dispatch, so no
+    // /proc scraping is needed for these
+    const auto& stats = router_->agent_stats(target_agent->id());
+    metrics.syscall_count = stats.calls.load(std::memory_order_relaxed);
+    metrics.bytes_read = stats.bytes_in.load(std::memory_order_relaxed);
+    metrics.bytes_written = stats.bytes_out.load(std::memory_order_relaxed);
+
     json response;
     response["success"] = true;
     response["metrics"] = metrics.to_json();
+    response["metrics"]["kernel_stats"]["syscall_errors"] =
+        stats.errors.load(std::memory_order_relaxed);
 
     return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_METRICS_AGENT, response.dump());
 }
@@ -97,7 +217,15 @@ ipc::Message MetricsSyscalls::handle_metrics_all_agents(const ipc::Message& msg)
             agent_info.uptime_seconds * 1000
         );
 
-        agent_metrics_list.push_back(metrics.to_json());
+        const auto& stats = router_->agent_stats(agent->id());
+        metrics.syscall_count = stats.calls.load(std::memory_order_relaxed);
+        metrics.bytes_read = stats.bytes_in.load(std::memory_order_relaxed);
+        metrics.bytes_written = stats.bytes_out.load(std::memory_order_relaxed);
+
+        auto entry = metrics.to_json();
+        entry["kernel_stats"]["syscall_errors"] =
+            stats.errors.load(std::memory_order_relaxed);
+        agent_metrics_list.push_back(std::move(entry));
     }
 
     json response;
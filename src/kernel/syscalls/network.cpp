@@ -2,8 +2,10 @@
 #include "kernel/syscall_router.hpp"
 #include "kernel/async_task_manager.hpp"
 #include "kernel/async_helpers.hpp"
+#include "kernel/opcode_table.hpp"
 #include "kernel/permissions_store.hpp"
 #include "worlds/world_engine.hpp"
+#include "services/http/client.hpp"
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
 #include <thread>
@@ -21,7 +23,8 @@ ipc::Message NetworkSyscalls::http_sync(KernelContext& context, const ipc::Messa
     auto& perms = context.permissions_store.get_or_create(msg.agent_id);
     std::string method = j.value("method", "GET");
     std::string url = j.value("url", "");
-    int timeout = j.value("timeout", 30);
+    int timeout = j.value("timeout",
+        static_cast<int>(opcode_info(ipc::SyscallOp::SYS_HTTP).default_timeout_sec));
 
     if (url.empty()) {
         json response;
@@ -30,7 +33,7 @@ ipc::Message NetworkSyscalls::http_sync(KernelContext& context, const ipc::Messa
         return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_HTTP, response.dump());
     }
 
-    if (!perms.can_http) {
+    if (!capability_allowed(perms, opcode_info(ipc::SyscallOp::SYS_HTTP).capability)) {
         spdlog::warn("Agent {} denied HTTP access (permission denied)", msg.agent_id);
         json response;
         response["success"] = false;
@@ -56,43 +59,44 @@ ipc::Message NetworkSyscalls::http_sync(KernelContext& context, const ipc::Messa
 
     spdlog::debug("Agent {} making {} request to {}", msg.agent_id, method, url);
 
-    std::string curl_cmd = "curl -s -X " + method;
-    curl_cmd += " --max-time " + std::to_string(timeout);
+    services::http::HttpRequest http_req;
+    http_req.method = method;
+    http_req.url = url;
+    http_req.timeout_secs = timeout;
 
     if (j.contains("headers") && j["headers"].is_object()) {
         for (auto& [key, val] : j["headers"].items()) {
-            curl_cmd += " -H '" + key + ": " + val.get<std::string>() + "'";
+            http_req.headers[key] = val.get<std::string>();
         }
     }
 
     if (j.contains("body") && (method == "POST" || method == "PUT" || method == "PATCH")) {
-        std::string body = j["body"].get<std::string>();
-        curl_cmd += " -d '" + body + "'";
+        http_req.body = j["body"].get<std::string>();
     }
 
-    curl_cmd += " '" + url + "' 2>&1";
-
-    FILE* pipe = popen(curl_cmd.c_str(), "r");
-    if (!pipe) {
+    // Last cancellation check before the client blocks: a task that sat
+    // queued past its deadline (or whose agent was killed) never opens
+    // the connection. A cancel landing mid-request takes effect when the
+    // client returns — the late result is dropped by the executor.
+    if (AsyncTaskManager::current_cancelled()) {
         json response;
         response["success"] = false;
-        response["error"] = "Failed to execute HTTP request";
+        response["error"] = "cancelled";
+        response["cancelled"] = true;
         return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_HTTP, response.dump());
     }
 
-    std::string output;
-    char buffer[4096];
-    while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
-        output += buffer;
-    }
-
-    int status = pclose(pipe);
-    bool success = (WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    auto http_resp = services::http::HttpClient::instance().request(http_req);
 
     json response;
-    response["success"] = success;
-    response["body"] = output;
-    response["status_code"] = success ? 200 : 0;
+    response["success"] = http_resp.success;
+    response["body"] = http_resp.body;
+    response["status_code"] = http_resp.status_code;
+    if (!http_resp.success) {
+        response["error"] = http_resp.error;
+    } else {
+        response["headers"] = http_resp.headers;
+    }
 
     return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_HTTP, response.dump());
 }
@@ -101,13 +105,13 @@ ipc::Message NetworkSyscalls::handle_http(const ipc::Message& msg) {
     if (context_.world_engine.is_agent_in_world(msg.agent_id)) {
         auto world_id = context_.world_engine.get_agent_world(msg.agent_id);
         if (world_id) {
-            auto* world = context_.world_engine.get_world(*world_id);
+            auto world = context_.world_engine.get_world(*world_id);
             if (world && world->network().is_enabled()) {
                 try {
                     json j = json::parse(msg.payload_str());
                     std::string url = j.value("url", "");
                     if (world->network().should_intercept(url)) {
-                        return handle_http_virtual(msg, world);
+                        return handle_http_virtual(msg, world.get());
                     }
                 } catch (...) {
                 }
@@ -126,7 +130,7 @@ ipc::Message NetworkSyscalls::handle_http(const ipc::Message& msg) {
         return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_HTTP, response.dump());
     }
 
-    bool async = async_helpers::should_async(j, true);
+    bool async = async_helpers::should_async(j, msg.opcode);
     if (async) {
         std::string url = j.value("url", "");
         if (url.empty()) {
@@ -137,7 +141,7 @@ ipc::Message NetworkSyscalls::handle_http(const ipc::Message& msg) {
         }
 
         auto& perms = context_.permissions_store.get_or_create(msg.agent_id);
-        if (!perms.can_http) {
+        if (!capability_allowed(perms, opcode_info(ipc::SyscallOp::SYS_HTTP).capability)) {
             json response;
             response["success"] = false;
             response["error"] = "Permission denied: HTTP not allowed";
@@ -196,9 +200,14 @@ ipc::Message NetworkSyscalls::handle_http_virtual(const ipc::Message& msg, clove
             return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_HTTP, response.dump());
         }
 
+        // Simulated latency is virtual time; the world clock decides how
+        // much wall time (if any) realizes it
         uint32_t total_latency = mock_response->latency_ms + world->chaos().get_latency();
         if (total_latency > 0) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(total_latency));
+            auto wall = world->clock().wall_delay(total_latency);
+            if (wall.count() > 0) {
+                std::this_thread::sleep_for(wall);
+            }
         }
 
         spdlog::debug("Agent {} got mock HTTP response for {} in world '{}': status={}",
@@ -2,6 +2,8 @@
 #include "kernel/syscall_router.hpp"
 #include "kernel/audit_log.hpp"
 #include "kernel/execution_log.hpp"
+#include "kernel/replay_engine.hpp"
+#include <limits>
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
 
@@ -9,6 +11,13 @@ using json = nlohmann::json;
 
 namespace clove::kernel {
 
+ReplaySyscalls::ReplaySyscalls(KernelContext& context,
+                               std::function<ipc::Message(const ipc::Message&)> dispatch)
+    : context_(context),
+      engine_(std::make_unique<ReplayEngine>(context.execution_logger, std::move(dispatch))) {}
+
+ReplaySyscalls::~ReplaySyscalls() = default;
+
 void ReplaySyscalls::register_syscalls(SyscallRouter& router) {
     router.register_handler(ipc::SyscallOp::SYS_RECORD_START,
         [this](const ipc::Message& msg) { return handle_record_start(msg); });
@@ -107,8 +116,18 @@ ipc::Message ReplaySyscalls::handle_record_status(const ipc::Message& msg) {
 
     if (request.contains("get_entries")) {
         size_t limit = request.value("limit", 100);
-        uint64_t since = request.value("since_id", 0);
-        auto entries = context_.execution_logger.get_entries(since, limit);
+        std::vector<ExecutionLogEntry> entries;
+        if (request.contains("agent_id")) {
+            entries = context_.execution_logger.get_entries_for_agent(
+                request["agent_id"].get<uint32_t>(), limit);
+        } else if (request.contains("from_ts") || request.contains("to_ts")) {
+            int64_t from_ts = request.value("from_ts", int64_t{0});
+            int64_t to_ts = request.value("to_ts", std::numeric_limits<int64_t>::max());
+            entries = context_.execution_logger.get_entries_in_range(from_ts, to_ts, limit);
+        } else {
+            uint64_t since = request.value("since_id", 0);
+            entries = context_.execution_logger.get_entries(since, limit);
+        }
 
         response["entries"] = json::array();
         for (const auto& entry : entries) {
@@ -144,6 +163,9 @@ ipc::Message ReplaySyscalls::handle_replay_start(const ipc::Message& msg) {
     }
 
     bool success = context_.execution_logger.start_replay();
+    if (success) {
+        engine_->start(context_.execution_logger.replay_entries());
+    }
 
     json response;
     response["success"] = success;
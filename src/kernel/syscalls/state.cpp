@@ -1,5 +1,8 @@
 #include "kernel/syscall_handlers.hpp"
 #include "kernel/syscall_router.hpp"
+#include "kernel/async_helpers.hpp"
+#include "kernel/event_bus.hpp"
+#include "kernel/federation.hpp"
 #include "kernel/state_store.hpp"
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
@@ -17,6 +20,20 @@ void StateSyscalls::register_syscalls(SyscallRouter& router) {
         [this](const ipc::Message& msg) { return handle_delete(msg); });
     router.register_handler(ipc::SyscallOp::SYS_KEYS,
         [this](const ipc::Message& msg) { return handle_keys(msg); });
+    router.register_handler(ipc::SyscallOp::SYS_INCR,
+        [this](const ipc::Message& msg) { return handle_incr(msg); });
+    router.register_handler(ipc::SyscallOp::SYS_CAS,
+        [this](const ipc::Message& msg) { return handle_cas(msg); });
+    router.register_handler(ipc::SyscallOp::SYS_APPEND,
+        [this](const ipc::Message& msg) { return handle_append(msg); });
+    router.register_handler(ipc::SyscallOp::SYS_WATCH,
+        [this](const ipc::Message& msg) { return handle_watch(msg); });
+    router.register_handler(ipc::SyscallOp::SYS_UNWATCH,
+        [this](const ipc::Message& msg) { return handle_unwatch(msg); });
+}
+
+void StateSyscalls::on_tick() {
+    context_.state_store.sweep_expired();
 }
 
 ipc::Message StateSyscalls::handle_store(const ipc::Message& msg) {
@@ -90,6 +107,30 @@ ipc::Message StateSyscalls::handle_fetch(const ipc::Message& msg) {
             return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_FETCH, response.dump());
         }
 
+        // Local miss with federation up: the key may live on a peer
+        // kernel. The lookup is a network round trip, so it runs on the
+        // async pool and completes like any other async syscall.
+        if (!result.exists && context_.federation &&
+            context_.federation->peer_count() > 0 && j.value("federated", true)) {
+            return async_helpers::submit_async(context_, msg, j,
+                [key](KernelContext& context, const ipc::Message& task_msg, const json&) {
+                    json response;
+                    response["success"] = true;
+                    auto remote = context.federation->remote_fetch(task_msg.agent_id, key);
+                    if (remote) {
+                        response["exists"] = true;
+                        response["value"] = (*remote)["value"];
+                        response["scope"] = remote->value("scope", "global");
+                        response["peer"] = remote->value("peer", "");
+                    } else {
+                        response["exists"] = false;
+                        response["value"] = nullptr;
+                    }
+                    return ipc::Message(task_msg.agent_id, ipc::SyscallOp::SYS_FETCH,
+                                        response.dump());
+                });
+        }
+
         json response;
         response["success"] = true;
         response["exists"] = result.exists;
@@ -161,4 +202,165 @@ ipc::Message StateSyscalls::handle_keys(const ipc::Message& msg) {
     }
 }
 
+ipc::Message StateSyscalls::handle_incr(const ipc::Message& msg) {
+    try {
+        json j = json::parse(msg.payload_str());
+
+        std::string key = j.value("key", "");
+        if (key.empty()) {
+            json response;
+            response["success"] = false;
+            response["error"] = "key is required";
+            return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_INCR, response.dump());
+        }
+
+        int64_t delta = j.value("delta", static_cast<int64_t>(1));
+        std::string scope = j.value("scope", "global");
+
+        auto result = context_.state_store.incr(msg.agent_id, key, delta, scope);
+
+        json response;
+        response["success"] = result.success;
+        if (result.success) {
+            response["value"] = result.value;
+        } else {
+            response["error"] = result.error;
+        }
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_INCR, response.dump());
+
+    } catch (const std::exception& e) {
+        json response;
+        response["success"] = false;
+        response["error"] = std::string("invalid request: ") + e.what();
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_INCR, response.dump());
+    }
+}
+
+ipc::Message StateSyscalls::handle_cas(const ipc::Message& msg) {
+    try {
+        json j = json::parse(msg.payload_str());
+
+        std::string key = j.value("key", "");
+        if (key.empty() || !j.contains("desired")) {
+            json response;
+            response["success"] = false;
+            response["error"] = "key and desired are required";
+            return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_CAS, response.dump());
+        }
+
+        json expected = j.value("expected", json{});
+        std::string scope = j.value("scope", "global");
+
+        auto result = context_.state_store.cas(msg.agent_id, key, expected, j["desired"], scope);
+
+        json response;
+        response["success"] = result.success;
+        if (result.success) {
+            response["swapped"] = result.swapped;
+            response["value"] = result.value;
+        } else {
+            response["error"] = result.error;
+        }
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_CAS, response.dump());
+
+    } catch (const std::exception& e) {
+        json response;
+        response["success"] = false;
+        response["error"] = std::string("invalid request: ") + e.what();
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_CAS, response.dump());
+    }
+}
+
+ipc::Message StateSyscalls::handle_append(const ipc::Message& msg) {
+    try {
+        json j = json::parse(msg.payload_str());
+
+        std::string key = j.value("key", "");
+        if (key.empty() || !j.contains("value")) {
+            json response;
+            response["success"] = false;
+            response["error"] = "key and value are required";
+            return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_APPEND, response.dump());
+        }
+
+        std::string scope = j.value("scope", "global");
+
+        auto result = context_.state_store.append(msg.agent_id, key, j["value"], scope);
+
+        json response;
+        response["success"] = result.success;
+        if (result.success) {
+            response["length"] = result.value.size();
+        } else {
+            response["error"] = result.error;
+        }
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_APPEND, response.dump());
+
+    } catch (const std::exception& e) {
+        json response;
+        response["success"] = false;
+        response["error"] = std::string("invalid request: ") + e.what();
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_APPEND, response.dump());
+    }
+}
+
+ipc::Message StateSyscalls::handle_watch(const ipc::Message& msg) {
+    try {
+        json j = json::parse(msg.payload_str());
+
+        bool prefix = j.contains("prefix");
+        std::string pattern = prefix ? j.value("prefix", "") : j.value("key", "");
+        if (pattern.empty()) {
+            json response;
+            response["success"] = false;
+            response["error"] = "key or prefix is required";
+            return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_WATCH, response.dump());
+        }
+
+        // Make sure the agent has an event queue to receive pushes on;
+        // an empty type list creates the queue (and its eventfd) without
+        // opting the agent into any broadcast event types
+        context_.event_bus.subscribe(msg.agent_id, {});
+
+        uint64_t watch_id = context_.state_store.watch(msg.agent_id, pattern, prefix);
+        spdlog::debug("Agent {} watching {} '{}'", msg.agent_id,
+                      prefix ? "prefix" : "key", pattern);
+
+        json response;
+        response["success"] = true;
+        response["watch_id"] = watch_id;
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_WATCH, response.dump());
+
+    } catch (const std::exception& e) {
+        json response;
+        response["success"] = false;
+        response["error"] = std::string("invalid request: ") + e.what();
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_WATCH, response.dump());
+    }
+}
+
+ipc::Message StateSyscalls::handle_unwatch(const ipc::Message& msg) {
+    try {
+        json j;
+        if (!msg.payload.empty()) {
+            j = json::parse(msg.payload_str());
+        }
+
+        // No watch_id (or 0) removes everything the agent watches
+        uint64_t watch_id = j.value("watch_id", 0ULL);
+        size_t removed = context_.state_store.unwatch(msg.agent_id, watch_id);
+
+        json response;
+        response["success"] = true;
+        response["removed"] = removed;
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_UNWATCH, response.dump());
+
+    } catch (const std::exception& e) {
+        json response;
+        response["success"] = false;
+        response["error"] = std::string("invalid request: ") + e.what();
+        return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_UNWATCH, response.dump());
+    }
+}
+
 } // namespace clove::kernel
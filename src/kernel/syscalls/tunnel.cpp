@@ -85,6 +85,11 @@ ipc::Message TunnelSyscalls::handle_tunnel_status(const ipc::Message& msg) {
     response["relay_url"] = status.relay_url;
     response["machine_id"] = status.machine_id;
     response["remote_agent_count"] = status.remote_agent_count;
+    response["compression"] = status.compression;
+    response["tx_payload_bytes"] = status.tx_payload_bytes;
+    response["tx_wire_bytes"] = status.tx_wire_bytes;
+    response["rx_payload_bytes"] = status.rx_payload_bytes;
+    response["rx_wire_bytes"] = status.rx_wire_bytes;
 
     return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_TUNNEL_STATUS, response.dump());
 }
@@ -249,6 +249,15 @@ ipc::Message WorldSyscalls::handle_world_snapshot(const ipc::Message& msg) {
     try {
         json j = json::parse(msg.payload_str());
 
+        // Dropping a retained snapshot needs no world_id
+        if (j.contains("drop_snapshot_id")) {
+            std::string snapshot_id = j["drop_snapshot_id"].get<std::string>();
+            json response;
+            response["success"] = true;
+            response["dropped"] = context_.world_engine.drop_snapshot(snapshot_id);
+            return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_WORLD_SNAPSHOT, response.dump());
+        }
+
         std::string world_id = j.value("world_id", "");
 
         if (world_id.empty()) {
@@ -258,9 +267,47 @@ ipc::Message WorldSyscalls::handle_world_snapshot(const ipc::Message& msg) {
             return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_WORLD_SNAPSHOT, response.dump());
         }
 
-        auto snapshot = context_.world_engine.snapshot_world(world_id);
+        // Persist to a binary CWS1 file on disk (delta against the
+        // previous persist of this world where possible)
+        if (j.contains("persist_path")) {
+            std::string persist_path = j["persist_path"].get<std::string>();
+            std::string error;
+            json response;
+            if (context_.world_engine.persist_world(world_id, persist_path, error)) {
+                spdlog::info("Agent {} persisted world '{}' to {}",
+                             msg.agent_id, world_id, persist_path);
+                response["success"] = true;
+                response["path"] = persist_path;
+            } else {
+                response["success"] = false;
+                response["error"] = error;
+            }
+            return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_WORLD_SNAPSHOT, response.dump());
+        }
+
+        // Inline mode serializes the whole world into the response —
+        // only viable for small worlds (payload is capped at 1MB)
+        if (j.value("inline", false)) {
+            auto snapshot = context_.world_engine.snapshot_world(world_id);
+
+            if (!snapshot) {
+                json response;
+                response["success"] = false;
+                response["error"] = "World not found";
+                return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_WORLD_SNAPSHOT, response.dump());
+            }
 
-        if (!snapshot) {
+            json response;
+            response["success"] = true;
+            response["snapshot"] = *snapshot;
+            return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_WORLD_SNAPSHOT, response.dump());
+        }
+
+        // Default: copy-on-write snapshot retained kernel-side; cost is
+        // independent of world content size
+        auto snapshot_id = context_.world_engine.snapshot_world_cow(world_id);
+
+        if (!snapshot_id) {
             json response;
             response["success"] = false;
             response["error"] = "World not found";
@@ -271,7 +318,7 @@ ipc::Message WorldSyscalls::handle_world_snapshot(const ipc::Message& msg) {
 
         json response;
         response["success"] = true;
-        response["snapshot"] = *snapshot;
+        response["snapshot_id"] = *snapshot_id;
         return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_WORLD_SNAPSHOT, response.dump());
 
     } catch (const std::exception& e) {
@@ -287,16 +334,25 @@ ipc::Message WorldSyscalls::handle_world_restore(const ipc::Message& msg) {
         json j = json::parse(msg.payload_str());
 
         json snapshot = j.value("snapshot", json{});
+        std::string snapshot_id = j.value("snapshot_id", "");
+        std::string snapshot_path = j.value("snapshot_path", "");
         std::string new_world_id = j.value("new_world_id", "");
 
-        if (snapshot.empty()) {
+        if (snapshot.empty() && snapshot_id.empty() && snapshot_path.empty()) {
             json response;
             response["success"] = false;
-            response["error"] = "snapshot required";
+            response["error"] = "snapshot, snapshot_id or snapshot_path required";
             return ipc::Message(msg.agent_id, ipc::SyscallOp::SYS_WORLD_RESTORE, response.dump());
         }
 
-        auto world_id = context_.world_engine.restore_world(snapshot, new_world_id);
+        std::optional<worlds::WorldId> world_id;
+        if (!snapshot_path.empty()) {
+            world_id = context_.world_engine.restore_world_from_file(snapshot_path, new_world_id);
+        } else if (!snapshot_id.empty()) {
+            world_id = context_.world_engine.restore_world_cow(snapshot_id, new_world_id);
+        } else {
+            world_id = context_.world_engine.restore_world(snapshot, new_world_id);
+        }
 
         if (!world_id) {
             json response;
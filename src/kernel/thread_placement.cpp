@@ -0,0 +1,169 @@
+#include "kernel/thread_placement.hpp"
+#include <spdlog/spdlog.h>
+#include <pthread.h>
+#include <sched.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace clove::kernel::placement {
+
+namespace {
+
+struct Topology {
+    bool enabled = false;
+    // CPU ids per NUMA node; a single node covering every online CPU
+    // when the host has no NUMA sysfs
+    std::vector<std::vector<int>> nodes;
+};
+
+Topology g_topology;
+std::once_flag g_configure_once;
+
+// Next pin slot per thread class (REACTOR counts CPUs, the others nodes)
+std::atomic<size_t> g_next_reactor_cpu{0};
+std::atomic<size_t> g_next_async_node{0};
+
+// Parse a sysfs cpulist ("0-3,8-11") into CPU ids
+std::vector<int> parse_cpulist(const std::string& list) {
+    std::vector<int> cpus;
+    std::stringstream ss(list);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        auto dash = range.find('-');
+        try {
+            if (dash == std::string::npos) {
+                cpus.push_back(std::stoi(range));
+            } else {
+                int lo = std::stoi(range.substr(0, dash));
+                int hi = std::stoi(range.substr(dash + 1));
+                for (int cpu = lo; cpu <= hi; ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            }
+        } catch (...) {
+            // Malformed entry: skip it rather than mis-pin
+        }
+    }
+    return cpus;
+}
+
+std::vector<std::vector<int>> detect_nodes() {
+    std::vector<std::vector<int>> nodes;
+    for (int node = 0;; ++node) {
+        std::ifstream file("/sys/devices/system/node/node" +
+                           std::to_string(node) + "/cpulist");
+        if (!file.is_open()) {
+            break;
+        }
+        std::string list;
+        std::getline(file, list);
+        auto cpus = parse_cpulist(list);
+        if (!cpus.empty()) {
+            nodes.push_back(std::move(cpus));
+        }
+    }
+
+    if (nodes.empty()) {
+        // No NUMA sysfs: one pseudo-node over the CPUs we may run on
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        std::vector<int> cpus;
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &set)) {
+                    cpus.push_back(cpu);
+                }
+            }
+        }
+        if (cpus.empty()) {
+            for (unsigned cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()); ++cpu) {
+                cpus.push_back(static_cast<int>(cpu));
+            }
+        }
+        nodes.push_back(std::move(cpus));
+    }
+    return nodes;
+}
+
+void apply_cpuset(const cpu_set_t& set) {
+    int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (rc != 0) {
+        spdlog::warn("Thread pinning failed: {}", strerror(rc));
+    }
+}
+
+} // namespace
+
+void configure(bool enabled) {
+    std::call_once(g_configure_once, [enabled]() {
+        if (!enabled) {
+            return;
+        }
+        g_topology.nodes = detect_nodes();
+        g_topology.enabled = true;
+
+        size_t total_cpus = 0;
+        for (const auto& node : g_topology.nodes) {
+            total_cpus += node.size();
+        }
+        spdlog::info("Thread pinning enabled ({} NUMA node(s), {} CPUs)",
+                     g_topology.nodes.size(), total_cpus);
+    });
+}
+
+bool enabled() {
+    return g_topology.enabled;
+}
+
+size_t node_count() {
+    return g_topology.nodes.size();
+}
+
+void pin_current(ThreadClass cls) {
+    if (!g_topology.enabled) {
+        return;
+    }
+
+    const auto& nodes = g_topology.nodes;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    switch (cls) {
+        case ThreadClass::REACTOR: {
+            // One CPU per shard, striped across nodes so shards spread
+            // evenly; the slot index walks node-major (node 0 cpu 0,
+            // node 1 cpu 0, ..., node 0 cpu 1, ...)
+            size_t slot = g_next_reactor_cpu.fetch_add(1, std::memory_order_relaxed);
+            const auto& node = nodes[slot % nodes.size()];
+            CPU_SET(node[(slot / nodes.size()) % node.size()], &set);
+            break;
+        }
+        case ThreadClass::ASYNC_WORKER: {
+            // Whole-node cpuset: free to migrate within the node, never
+            // across it. Round-robin partitions the pool evenly.
+            size_t slot = g_next_async_node.fetch_add(1, std::memory_order_relaxed);
+            for (int cpu : nodes[slot % nodes.size()]) {
+                CPU_SET(cpu, &set);
+            }
+            break;
+        }
+        case ThreadClass::BACKGROUND: {
+            for (int cpu : nodes[0]) {
+                CPU_SET(cpu, &set);
+            }
+            break;
+        }
+    }
+
+    apply_cpuset(set);
+}
+
+} // namespace clove::kernel::placement
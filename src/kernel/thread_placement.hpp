@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+
+namespace clove::kernel::placement {
+
+// NUMA/CPU-aware placement for the kernel's long-lived threads. On
+// multi-socket hosts the scheduler migrates threads between nodes and
+// drags their working sets (connection buffers, worker deques) across
+// the interconnect with them; pinning removes that run-to-run variance.
+//
+// Policy per thread class:
+//   REACTOR       one CPU each, round-robin across nodes — a shard's
+//                 connection buffers are first-touched by its own loop,
+//                 so a stable pin keeps them node-local
+//   ASYNC_WORKER  whole-node cpuset, round-robin across nodes — workers
+//                 may migrate within their node (work stealing stays
+//                 cheap) but never across the interconnect
+//   BACKGROUND    node 0 cpuset (log flushers, journal writers)
+//
+// Topology comes from /sys/devices/system/node; a host without NUMA
+// sysfs (or with one node) degrades to spreading over all online CPUs.
+// Disabled by default (CLOVE_PIN_THREADS=1) — on shared hosts a pinned
+// kernel competes badly with whatever else owns those cores.
+enum class ThreadClass { REACTOR, ASYNC_WORKER, BACKGROUND };
+
+// Detect topology and arm pin_current(); no-op when enabled is false.
+// Called once from Kernel::init() before any worker threads start.
+void configure(bool enabled);
+
+bool enabled();
+size_t node_count();
+
+// Pin the calling thread per the policy above. Safe to call from any
+// thread at any time; does nothing until configure(true) has run.
+void pin_current(ThreadClass cls);
+
+} // namespace clove::kernel::placement
@@ -0,0 +1,69 @@
+#include "kernel/trace_ring.hpp"
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace clove::kernel {
+
+namespace {
+// Registry of per-thread rings, only locked on thread creation and
+// snapshot; the record path never touches it
+std::mutex g_registry_mutex;
+std::vector<TraceRing*> g_rings;
+} // namespace
+
+TraceRing::TraceRing() {
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    g_rings.push_back(this);
+}
+
+// Dispatching threads are not all kernel-lifetime (replay workers come
+// and go), so a ring must leave the registry with its thread or a later
+// snapshot would walk freed memory
+TraceRing::~TraceRing() {
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    std::erase(g_rings, this);
+}
+
+TraceRing& TraceRing::local() {
+    thread_local TraceRing ring;
+    return ring;
+}
+
+nlohmann::json TraceRing::snapshot(size_t limit) {
+    std::vector<TraceRecord> merged;
+
+    {
+        std::lock_guard<std::mutex> lock(g_registry_mutex);
+        for (TraceRing* ring : g_rings) {
+            uint64_t head = ring->head_.load(std::memory_order_acquire);
+            uint64_t count = std::min<uint64_t>(head, CAPACITY);
+            for (uint64_t i = head - count; i < head; i++) {
+                merged.push_back(ring->records_[i % CAPACITY]);
+            }
+        }
+    }
+
+    std::sort(merged.begin(), merged.end(),
+        [](const TraceRecord& a, const TraceRecord& b) {
+            return a.timestamp_us > b.timestamp_us;
+        });
+    if (merged.size() > limit) {
+        merged.resize(limit);
+    }
+
+    nlohmann::json records = nlohmann::json::array();
+    for (const auto& rec : merged) {
+        records.push_back({
+            {"timestamp_us", rec.timestamp_us},
+            {"agent_id", rec.agent_id},
+            {"opcode", ipc::opcode_to_string(static_cast<ipc::SyscallOp>(rec.opcode))},
+            {"duration_us", rec.duration_us},
+            {"payload_size", rec.payload_size},
+            {"status", rec.status}
+        });
+    }
+    return records;
+}
+
+} // namespace clove::kernel
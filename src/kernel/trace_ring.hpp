@@ -0,0 +1,57 @@
+/**
+ * Always-on syscall flight recorder.
+ *
+ * Each dispatching thread owns a fixed-size ring of small binary records
+ * written with plain stores (single writer per ring, no locks), so the
+ * per-syscall cost is nanoseconds — unlike ExecutionLogger, which copies
+ * full payloads under a mutex and is too heavy to leave on in
+ * production. SYS_TRACE snapshots the rings; readers race the writers
+ * by design, which is acceptable for a trace.
+ */
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include "ipc/protocol.hpp"
+
+namespace clove::kernel {
+
+struct TraceRecord {
+    uint64_t timestamp_us;   // wall clock, microseconds since epoch
+    uint32_t agent_id;
+    uint32_t duration_us;
+    uint32_t payload_size;   // request payload bytes
+    uint8_t opcode;
+    uint8_t status;          // 0 = ok, 1 = handler reported failure
+    uint16_t _pad = 0;
+};
+
+static_assert(sizeof(TraceRecord) == 24, "Trace record size mismatch");
+
+class TraceRing {
+public:
+    static constexpr size_t CAPACITY = 4096; // records per thread
+
+    // The calling thread's ring (created and registered on first use)
+    static TraceRing& local();
+
+    void record(const TraceRecord& rec) {
+        uint64_t idx = head_.load(std::memory_order_relaxed);
+        records_[idx % CAPACITY] = rec;
+        head_.store(idx + 1, std::memory_order_release);
+    }
+
+    // Most recent records across all thread rings, newest first,
+    // at most `limit` entries
+    static nlohmann::json snapshot(size_t limit);
+
+private:
+    TraceRing();
+    ~TraceRing();  // unregisters the ring when its thread exits
+
+    std::array<TraceRecord, CAPACITY> records_{};
+    std::atomic<uint64_t> head_{0};
+};
+
+} // namespace clove::kernel
@@ -0,0 +1,246 @@
+#include "kernel/uring_file.hpp"
+#include <spdlog/spdlog.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+#ifdef HAS_IO_URING
+#include <liburing.h>
+#endif
+
+namespace clove::kernel::uring_file {
+
+namespace {
+
+constexpr size_t CHUNK_SIZE = 1024 * 1024; // registered buffer / chunk size
+
+std::string errno_string(const char* what) {
+    return std::string(what) + ": " + strerror(errno);
+}
+
+// Plain pread/pwrite-style implementations. These are the whole story
+// when built without liburing, and the runtime fallback when ring setup
+// fails on this thread (locked-memory limits, old kernel, seccomp).
+bool read_file_sync(const std::string& path, std::string& out, std::string& error) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        error = errno_string("failed to open file");
+        return false;
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+        out.reserve(static_cast<size_t>(st.st_size));
+    }
+
+    char buffer[65536];
+    while (true) {
+        ssize_t n = ::read(fd, buffer, sizeof(buffer));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            error = errno_string("read failed");
+            ::close(fd);
+            return false;
+        }
+        if (n == 0) {
+            break;
+        }
+        out.append(buffer, static_cast<size_t>(n));
+    }
+
+    ::close(fd);
+    return true;
+}
+
+bool write_file_sync(const std::string& path, const std::string& data, bool append,
+                     std::string& error) {
+    int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC);
+    int fd = ::open(path.c_str(), flags, 0644);
+    if (fd < 0) {
+        error = errno_string("failed to open file for writing");
+        return false;
+    }
+
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            error = errno_string("write failed");
+            ::close(fd);
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+
+    ::close(fd);
+    return true;
+}
+
+} // namespace
+
+#ifdef HAS_IO_URING
+
+namespace {
+
+// One ring per async worker thread: no cross-thread submission locking,
+// and each thread's fixed buffer stays registered for its lifetime
+struct ThreadRing {
+    io_uring ring{};
+    std::vector<uint8_t> buffer;
+    bool ok = false;
+
+    ThreadRing() {
+        if (io_uring_queue_init(8, &ring, 0) != 0) {
+            spdlog::warn("uring_file: io_uring unavailable, using pread/pwrite");
+            return;
+        }
+        buffer.resize(CHUNK_SIZE);
+        iovec iov{buffer.data(), buffer.size()};
+        if (io_uring_register_buffers(&ring, &iov, 1) != 0) {
+            spdlog::warn("uring_file: buffer registration failed, using pread/pwrite");
+            io_uring_queue_exit(&ring);
+            return;
+        }
+        ok = true;
+    }
+
+    ~ThreadRing() {
+        if (ok) {
+            io_uring_queue_exit(&ring);
+        }
+    }
+
+    // Submits one fixed-buffer read/write at `offset` and waits for its
+    // completion; returns the op result (bytes or -errno)
+    int do_io(bool write, int fd, size_t len, off_t offset) {
+        io_uring_sqe* sqe = io_uring_get_sqe(&ring);
+        if (!sqe) {
+            return -EAGAIN;
+        }
+        if (write) {
+            io_uring_prep_write_fixed(sqe, fd, buffer.data(), len, offset, 0);
+        } else {
+            io_uring_prep_read_fixed(sqe, fd, buffer.data(), len, offset, 0);
+        }
+        if (io_uring_submit(&ring) < 0) {
+            return -EIO;
+        }
+        io_uring_cqe* cqe = nullptr;
+        if (io_uring_wait_cqe(&ring, &cqe) < 0) {
+            return -EIO;
+        }
+        int res = cqe->res;
+        io_uring_cqe_seen(&ring, cqe);
+        return res;
+    }
+};
+
+ThreadRing& local_ring() {
+    thread_local ThreadRing ring;
+    return ring;
+}
+
+} // namespace
+
+bool available() {
+    return local_ring().ok;
+}
+
+bool read_file(const std::string& path, std::string& out, std::string& error) {
+    auto& ring = local_ring();
+    if (!ring.ok) {
+        return read_file_sync(path, out, error);
+    }
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        error = errno_string("failed to open file");
+        return false;
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+        out.reserve(static_cast<size_t>(st.st_size));
+    }
+
+    off_t offset = 0;
+    while (true) {
+        int res = ring.do_io(false, fd, CHUNK_SIZE, offset);
+        if (res < 0) {
+            ::close(fd);
+            error = std::string("read failed: ") + strerror(-res);
+            return false;
+        }
+        if (res == 0) {
+            break;
+        }
+        out.append(reinterpret_cast<const char*>(ring.buffer.data()),
+                   static_cast<size_t>(res));
+        offset += res;
+    }
+
+    ::close(fd);
+    return true;
+}
+
+bool write_file(const std::string& path, const std::string& data, bool append,
+                std::string& error) {
+    auto& ring = local_ring();
+    if (!ring.ok) {
+        return write_file_sync(path, data, append, error);
+    }
+
+    int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (append ? 0 : O_TRUNC);
+    int fd = ::open(path.c_str(), flags, 0644);
+    if (fd < 0) {
+        error = errno_string("failed to open file for writing");
+        return false;
+    }
+
+    off_t offset = 0;
+    if (append) {
+        struct stat st{};
+        if (::fstat(fd, &st) == 0) {
+            offset = st.st_size;
+        }
+    }
+
+    size_t written = 0;
+    while (written < data.size()) {
+        size_t len = std::min(CHUNK_SIZE, data.size() - written);
+        std::memcpy(ring.buffer.data(), data.data() + written, len);
+        int res = ring.do_io(true, fd, len, offset);
+        if (res <= 0) {
+            ::close(fd);
+            error = std::string("write failed: ") + strerror(res < 0 ? -res : EIO);
+            return false;
+        }
+        written += static_cast<size_t>(res);
+        offset += res;
+    }
+
+    ::close(fd);
+    return true;
+}
+
+#else // !HAS_IO_URING
+
+bool available() {
+    return false;
+}
+
+bool read_file(const std::string& path, std::string& out, std::string& error) {
+    return read_file_sync(path, out, error);
+}
+
+bool write_file(const std::string& path, const std::string& data, bool append,
+                std::string& error) {
+    return write_file_sync(path, data, append, error);
+}
+
+#endif // HAS_IO_URING
+
+} // namespace clove::kernel::uring_file
@@ -0,0 +1,28 @@
+/**
+ * File I/O backend for FileSyscalls.
+ *
+ * When liburing is available (HAS_IO_URING), reads and writes go through
+ * a per-thread io_uring with one registered fixed buffer, so the kernel
+ * skips per-op buffer mapping and async pool threads issue genuinely
+ * parallel disk I/O. Without liburing this falls back to plain
+ * pread/pwrite loops — still cheaper than the old iostream whole-file
+ * path, with no stream machinery or extra copies.
+ */
+#pragma once
+#include <string>
+
+namespace clove::kernel::uring_file {
+
+// True when the io_uring backend is compiled in and usable
+bool available();
+
+// Read the whole file at `path` into `out`. Returns false with `error`
+// set on failure; `out` may hold a partial read in that case.
+bool read_file(const std::string& path, std::string& out, std::string& error);
+
+// Write `data` to `path`, truncating or appending. Returns false with
+// `error` set on failure.
+bool write_file(const std::string& path, const std::string& data, bool append,
+                std::string& error);
+
+} // namespace clove::kernel::uring_file
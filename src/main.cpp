@@ -1,5 +1,6 @@
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
+#include "core/config.hpp"
 #include "core/logger.hpp"
 #include "kernel/kernel.hpp"
 #include <iostream>
@@ -110,11 +111,24 @@ int main(int argc, char** argv) {
     // Print banner first
     print_banner();
 
+    // Load .env and publish the initial config snapshot (SIGHUP reloads it)
+    clove::core::config::load_dotenv();
+
     // Parse command line args
     clove::kernel::Kernel::Config config;
     if (argc > 1) {
         config.socket_path = argv[1];
     }
+    config.use_io_uring = clove::core::config::get_env_or("CLOVE_IO_URING", "0") == "1";
+    config.reactor_shards = std::stoi(clove::core::config::get_env_or("CLOVE_REACTOR_SHARDS", "0"));
+    config.async_workers = std::stoi(clove::core::config::get_env_or("CLOVE_ASYNC_WORKERS", "0"));
+    config.pin_threads = clove::core::config::get_env_or("CLOVE_PIN_THREADS", "0") == "1";
+    config.state_dir = clove::core::config::get_env_or("CLOVE_STATE_DIR", "");
+    config.exec_log_dir = clove::core::config::get_env_or("CLOVE_EXEC_LOG_DIR", "");
+    config.audit_log_path = clove::core::config::get_env_or("CLOVE_AUDIT_LOG", "");
+    config.metrics_interval_ms = std::stoi(clove::core::config::get_env_or("CLOVE_METRICS_INTERVAL_MS", "1000"));
+    config.llm_concurrency = std::stoi(clove::core::config::get_env_or("CLOVE_LLM_CONCURRENCY", "8"));
+    config.llm_cache_ttl_secs = std::stoi(clove::core::config::get_env_or("CLOVE_LLM_CACHE_TTL", "300"));
 
     // Show startup animation
     print_startup_sequence();
@@ -122,28 +136,34 @@ int main(int argc, char** argv) {
     // Setup logging after animation
     setup_logging();
 
-    // Create kernel
-    clove::kernel::Kernel kernel(config);
+    // Scoped so the kernel (and every subsystem that logs from its
+    // destructor) is torn down before the async logger shuts down
+    {
+        clove::kernel::Kernel kernel(config);
 
-    // Initialize
-    if (!kernel.init()) {
-        std::cout << "\n    " << term::BOLD << "\033[31m✗" << term::RESET
-                  << "  Failed to initialize clove\n\n";
-        return 1;
-    }
+        // Initialize
+        if (!kernel.init()) {
+            std::cout << "\n    " << term::BOLD << "\033[31m✗" << term::RESET
+                      << "  Failed to initialize clove\n\n";
+            return 1;
+        }
 
-    // Print status box
-    print_status_box(config.socket_path, config.enable_sandboxing);
+        // Print status box
+        print_status_box(config.socket_path, config.enable_sandboxing);
 
-    // Ready message
-    print_ready_message(config.socket_path);
+        // Ready message
+        print_ready_message(config.socket_path);
 
-    // Run (blocks until Ctrl+C)
-    kernel.run();
+        // Run (blocks until Ctrl+C)
+        kernel.run();
+
+        // Shutdown message
+        std::cout << "\n    " << term::YELLOW << "⟳" << term::RESET
+                  << "  Shutting down gracefully...\n\n";
+    }
 
-    // Shutdown message
-    std::cout << "\n    " << term::YELLOW << "⟳" << term::RESET
-              << "  Shutting down gracefully...\n\n";
+    // Drain the async log ring before exit
+    clove::core::shutdown_logger();
 
     return 0;
 }
@@ -0,0 +1,123 @@
+#include "metrics/histogram.hpp"
+#include <algorithm>
+#include <bit>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace clove::metrics {
+
+namespace {
+
+// Process-wide registry of live histograms
+std::mutex g_registry_mutex;
+std::vector<LatencyHistogram*> g_registry;
+
+size_t shard_index() {
+    thread_local size_t idx =
+        std::hash<std::thread::id>{}(std::this_thread::get_id()) %
+        LatencyHistogram::SHARDS;
+    return idx;
+}
+
+size_t bucket_for(uint64_t value_us) {
+    if (value_us == 0) {
+        return 0;
+    }
+    return std::min<size_t>(std::bit_width(value_us) - 1,
+                            LatencyHistogram::BUCKETS - 1);
+}
+
+// Value estimate for the p'th percentile given merged buckets: walk the
+// cumulative counts to the containing bucket, interpolate inside it
+double percentile(const std::array<uint64_t, LatencyHistogram::BUCKETS>& buckets,
+                  uint64_t count, uint64_t max_us, double p) {
+    if (count == 0) {
+        return 0.0;
+    }
+    double rank = p * static_cast<double>(count);
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < buckets.size(); i++) {
+        if (buckets[i] == 0) {
+            continue;
+        }
+        if (cumulative + buckets[i] >= rank) {
+            double lower = i == 0 ? 0.0 : static_cast<double>(1ULL << i);
+            double upper = static_cast<double>(1ULL << (i + 1));
+            double fraction = (rank - cumulative) / static_cast<double>(buckets[i]);
+            double estimate = lower + fraction * (upper - lower);
+            return std::min(estimate, static_cast<double>(max_us));
+        }
+        cumulative += buckets[i];
+    }
+    return static_cast<double>(max_us);
+}
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram(std::string name) : name_(std::move(name)) {
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    g_registry.push_back(this);
+}
+
+LatencyHistogram::~LatencyHistogram() {
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    g_registry.erase(std::remove(g_registry.begin(), g_registry.end(), this),
+                     g_registry.end());
+}
+
+void LatencyHistogram::record(uint64_t value_us) {
+    Shard& shard = shards_[shard_index()];
+    shard.buckets[bucket_for(value_us)].fetch_add(1, std::memory_order_relaxed);
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    shard.sum_us.fetch_add(value_us, std::memory_order_relaxed);
+
+    uint64_t seen = shard.max_us.load(std::memory_order_relaxed);
+    while (value_us > seen &&
+           !shard.max_us.compare_exchange_weak(seen, value_us,
+                                               std::memory_order_relaxed)) {
+    }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot snap;
+    for (const Shard& shard : shards_) {
+        for (size_t i = 0; i < BUCKETS; i++) {
+            snap.buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+        }
+        snap.count += shard.count.load(std::memory_order_relaxed);
+        snap.sum_us += shard.sum_us.load(std::memory_order_relaxed);
+        snap.max_us = std::max(snap.max_us,
+                               shard.max_us.load(std::memory_order_relaxed));
+    }
+
+    snap.p50_us = percentile(snap.buckets, snap.count, snap.max_us, 0.50);
+    snap.p95_us = percentile(snap.buckets, snap.count, snap.max_us, 0.95);
+    snap.p99_us = percentile(snap.buckets, snap.count, snap.max_us, 0.99);
+    return snap;
+}
+
+nlohmann::json LatencyHistogram::to_json() const {
+    Snapshot snap = snapshot();
+    return nlohmann::json{
+        {"count", snap.count},
+        {"sum_us", snap.sum_us},
+        {"mean_us", snap.count > 0 ? snap.sum_us / snap.count : 0},
+        {"max_us", snap.max_us},
+        {"p50_us", snap.p50_us},
+        {"p95_us", snap.p95_us},
+        {"p99_us", snap.p99_us},
+        {"log2_buckets", snap.buckets}
+    };
+}
+
+nlohmann::json histograms_json() {
+    nlohmann::json out = nlohmann::json::object();
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    for (const LatencyHistogram* hist : g_registry) {
+        out[hist->name()] = hist->to_json();
+    }
+    return out;
+}
+
+} // namespace clove::metrics
@@ -0,0 +1,69 @@
+/**
+ * Clove Latency Histograms
+ *
+ * Log2-bucketed latency histogram with lock-free recording: writers
+ * increment relaxed atomics in one of a small set of cache-line-sized
+ * shards (picked per thread), readers merge the shards on demand.
+ * Bucket i covers [2^i, 2^(i+1)) microseconds, matching the
+ * SyscallRouter per-opcode histograms.
+ *
+ * Histograms register themselves by name in a process-wide registry so
+ * SYS_METRICS_SYSTEM can report every feed (p50/p95/p99/max) without
+ * threading each one through KernelContext.
+ */
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <nlohmann/json.hpp>
+
+namespace clove::metrics {
+
+class LatencyHistogram {
+public:
+    static constexpr size_t BUCKETS = 32;
+    static constexpr size_t SHARDS = 16;
+
+    explicit LatencyHistogram(std::string name);
+    ~LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    // Lock-free; safe from any thread
+    void record(uint64_t value_us);
+
+    struct Snapshot {
+        uint64_t count = 0;
+        uint64_t sum_us = 0;
+        uint64_t max_us = 0;
+        double p50_us = 0.0;
+        double p95_us = 0.0;
+        double p99_us = 0.0;
+        std::array<uint64_t, BUCKETS> buckets{};
+    };
+
+    // Merges all shards; percentiles interpolate linearly inside the
+    // containing bucket
+    Snapshot snapshot() const;
+    nlohmann::json to_json() const;
+
+    const std::string& name() const { return name_; }
+
+private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<uint64_t>, BUCKETS> buckets{};
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sum_us{0};
+        std::atomic<uint64_t> max_us{0};
+    };
+
+    std::string name_;
+    std::array<Shard, SHARDS> shards_;
+};
+
+// Snapshots of every live histogram, keyed by name
+nlohmann::json histograms_json();
+
+} // namespace clove::metrics
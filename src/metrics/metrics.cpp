@@ -11,9 +11,25 @@
 #include <algorithm>
 #include <cstring>
 #include <dirent.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <sys/sysinfo.h>
 
+namespace {
+
+// Stable /proc files worth keeping an fd open for; pread at offset 0
+// re-reads fresh contents without the open/close churn
+bool is_cacheable_proc_file(const std::string& path) {
+    return path == "/proc/stat" ||
+           path == "/proc/meminfo" ||
+           path == "/proc/loadavg" ||
+           path == "/proc/diskstats" ||
+           path == "/proc/net/dev" ||
+           path == "/sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq";
+}
+
+} // namespace
+
 namespace fs = std::filesystem;
 
 namespace clove::metrics {
@@ -180,9 +196,37 @@ MetricsCollector::MetricsCollector() {
     prev_cpu_per_core_idle_ = dummy_idle;
 }
 
-MetricsCollector::~MetricsCollector() = default;
+MetricsCollector::~MetricsCollector() {
+    stop_sampler();
+    for (auto& [path, fd] : fd_cache_) {
+        ::close(fd);
+    }
+}
 
 std::string MetricsCollector::read_file(const std::string& path) {
+    if (is_cacheable_proc_file(path)) {
+        std::lock_guard<std::mutex> lock(fd_cache_mutex_);
+        auto it = fd_cache_.find(path);
+        if (it == fd_cache_.end()) {
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd >= 0) {
+                it = fd_cache_.emplace(path, fd).first;
+            }
+        }
+        if (it != fd_cache_.end()) {
+            std::string content;
+            char buf[4096];
+            off_t off = 0;
+            for (;;) {
+                ssize_t n = ::pread(it->second, buf, sizeof(buf), off);
+                if (n <= 0) break;
+                content.append(buf, static_cast<size_t>(n));
+                off += n;
+            }
+            return content;
+        }
+    }
+
     std::ifstream file(path);
     if (!file) return "";
     std::stringstream buffer;
@@ -192,10 +236,10 @@ std::string MetricsCollector::read_file(const std::string& path) {
 
 std::vector<std::string> MetricsCollector::read_file_lines(const std::string& path) {
     std::vector<std::string> lines;
-    std::ifstream file(path);
-    if (!file) return lines;
+    std::string content = read_file(path);
+    std::istringstream stream(content);
     std::string line;
-    while (std::getline(file, line)) {
+    while (std::getline(stream, line)) {
         lines.push_back(line);
     }
     return lines;
@@ -359,6 +403,144 @@ int MetricsCollector::count_fds(pid_t pid) {
 }
 
 SystemMetrics MetricsCollector::collect_system() {
+    if (auto snap = current_snapshot()) {
+        return snap->system;
+    }
+    return collect_system_direct();
+}
+
+std::optional<ProcessMetrics> MetricsCollector::collect_process(pid_t pid) {
+    if (auto snap = current_snapshot()) {
+        auto it = snap->processes.find(pid);
+        if (it != snap->processes.end()) {
+            return it->second;
+        }
+        // First query for this pid: answer directly and have the
+        // sampler pick it up from the next scan on
+        std::lock_guard<std::mutex> lock(watch_mutex_);
+        watched_pids_.insert(pid);
+    }
+    return collect_process_direct(pid);
+}
+
+CgroupMetrics MetricsCollector::collect_cgroup(const std::string& cgroup_path) {
+    if (auto snap = current_snapshot()) {
+        auto it = snap->cgroups.find(cgroup_path);
+        if (it != snap->cgroups.end()) {
+            return it->second;
+        }
+        std::lock_guard<std::mutex> lock(watch_mutex_);
+        watched_cgroups_.insert(cgroup_path);
+    }
+    return collect_cgroup_direct(cgroup_path);
+}
+
+void MetricsCollector::start_sampler(std::chrono::milliseconds interval) {
+    if (sampler_running_.exchange(true)) {
+        return;
+    }
+    sampler_interval_ = interval;
+    {
+        std::lock_guard<std::mutex> lock(sampler_mutex_);
+        sampler_stop_ = false;
+    }
+    sampler_thread_ = std::thread(&MetricsCollector::sampler_loop, this, interval);
+}
+
+void MetricsCollector::stop_sampler() {
+    {
+        std::lock_guard<std::mutex> lock(sampler_mutex_);
+        sampler_stop_ = true;
+    }
+    sampler_cv_.notify_all();
+    if (sampler_thread_.joinable()) {
+        sampler_thread_.join();
+    }
+    sampler_running_ = false;
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    snapshot_.reset();
+}
+
+std::shared_ptr<const MetricsCollector::Snapshot> MetricsCollector::current_snapshot() const {
+    if (!sampler_running_.load(std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    if (!snapshot_) {
+        return nullptr;
+    }
+    // A stale snapshot (sampler wedged or just started) is worse than
+    // a direct read
+    auto age = std::chrono::steady_clock::now() - snapshot_->taken;
+    if (age > 2 * sampler_interval_) {
+        return nullptr;
+    }
+    return snapshot_;
+}
+
+void MetricsCollector::sampler_loop(std::chrono::milliseconds interval) {
+    for (;;) {
+        auto snap = std::make_shared<Snapshot>();
+        snap->system = collect_system_direct();
+
+        std::unordered_set<pid_t> pids;
+        std::unordered_set<std::string> cgroups;
+        {
+            std::lock_guard<std::mutex> lock(watch_mutex_);
+            pids = watched_pids_;
+            cgroups = watched_cgroups_;
+        }
+
+        std::vector<pid_t> dead_pids;
+        for (pid_t pid : pids) {
+            auto metrics = collect_process_direct(pid);
+            if (metrics) {
+                snap->processes.emplace(pid, std::move(*metrics));
+            } else {
+                dead_pids.push_back(pid);
+            }
+        }
+
+        std::vector<std::string> dead_cgroups;
+        for (const auto& path : cgroups) {
+            auto metrics = collect_cgroup_direct(path);
+            if (metrics.valid) {
+                snap->cgroups.emplace(path, std::move(metrics));
+            } else {
+                dead_cgroups.push_back(path);
+            }
+        }
+
+        if (!dead_pids.empty() || !dead_cgroups.empty()) {
+            std::lock_guard<std::mutex> lock(watch_mutex_);
+            for (pid_t pid : dead_pids) {
+                watched_pids_.erase(pid);
+            }
+            for (const auto& path : dead_cgroups) {
+                watched_cgroups_.erase(path);
+            }
+        }
+        if (!dead_pids.empty()) {
+            std::lock_guard<std::mutex> lock(process_cpu_mutex_);
+            for (pid_t pid : dead_pids) {
+                process_cpu_state_.erase(pid);
+            }
+        }
+
+        snap->taken = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(snapshot_mutex_);
+            snapshot_ = std::move(snap);
+        }
+
+        std::unique_lock<std::mutex> lock(sampler_mutex_);
+        if (sampler_cv_.wait_for(lock, interval, [this] { return sampler_stop_; })) {
+            return;
+        }
+    }
+}
+
+SystemMetrics MetricsCollector::collect_system_direct() {
     SystemMetrics metrics;
     metrics.timestamp = std::chrono::system_clock::now();
 
@@ -415,7 +597,7 @@ SystemMetrics MetricsCollector::collect_system() {
     return metrics;
 }
 
-std::optional<ProcessMetrics> MetricsCollector::collect_process(pid_t pid) {
+std::optional<ProcessMetrics> MetricsCollector::collect_process_direct(pid_t pid) {
     std::string proc_path = "/proc/" + std::to_string(pid);
 
     // Check if process exists
@@ -468,23 +650,26 @@ std::optional<ProcessMetrics> MetricsCollector::collect_process(pid_t pid) {
     // Calculate CPU percent
     auto now = std::chrono::steady_clock::now();
     uint64_t total_time = utime + stime;
-    auto& cpu_state = process_cpu_state_[pid];
-
-    if (cpu_state.prev_time.time_since_epoch().count() > 0) {
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - cpu_state.prev_time).count();
-        if (elapsed > 0) {
-            uint64_t time_diff = total_time - (cpu_state.prev_utime + cpu_state.prev_stime);
-            // Convert from clock ticks to milliseconds
-            long ticks_per_sec = sysconf(_SC_CLK_TCK);
-            double time_diff_ms = (time_diff * 1000.0) / ticks_per_sec;
-            metrics.cpu_percent = 100.0 * time_diff_ms / elapsed;
+    {
+        std::lock_guard<std::mutex> lock(process_cpu_mutex_);
+        auto& cpu_state = process_cpu_state_[pid];
+
+        if (cpu_state.prev_time.time_since_epoch().count() > 0) {
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                now - cpu_state.prev_time).count();
+            if (elapsed > 0) {
+                uint64_t time_diff = total_time - (cpu_state.prev_utime + cpu_state.prev_stime);
+                // Convert from clock ticks to milliseconds
+                long ticks_per_sec = sysconf(_SC_CLK_TCK);
+                double time_diff_ms = (time_diff * 1000.0) / ticks_per_sec;
+                metrics.cpu_percent = 100.0 * time_diff_ms / elapsed;
+            }
         }
-    }
 
-    cpu_state.prev_utime = utime;
-    cpu_state.prev_stime = stime;
-    cpu_state.prev_time = now;
+        cpu_state.prev_utime = utime;
+        cpu_state.prev_stime = stime;
+        cpu_state.prev_time = now;
+    }
 
     // Convert clock ticks to milliseconds
     long ticks_per_sec = sysconf(_SC_CLK_TCK);
@@ -534,7 +719,7 @@ std::optional<ProcessMetrics> MetricsCollector::collect_process(pid_t pid) {
     return metrics;
 }
 
-CgroupMetrics MetricsCollector::collect_cgroup(const std::string& cgroup_path) {
+CgroupMetrics MetricsCollector::collect_cgroup_direct(const std::string& cgroup_path) {
     CgroupMetrics metrics;
     metrics.timestamp = std::chrono::system_clock::now();
     metrics.cgroup_path = cgroup_path;
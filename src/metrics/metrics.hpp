@@ -6,12 +6,18 @@
  */
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <chrono>
 #include <optional>
 #include <unordered_map>
+#include <unordered_set>
 #include <sys/types.h>
 #include <nlohmann/json.hpp>
 
@@ -241,7 +247,51 @@ public:
      */
     int get_cpu_count() const { return cpu_count_; }
 
+    /**
+     * Start the background sampler. /proc is scanned once per interval
+     * into a snapshot and the collect_* methods answer from it; pids
+     * and cgroups are tracked from the first time they are asked for.
+     * Without the sampler every collect_* call parses /proc directly.
+     */
+    void start_sampler(std::chrono::milliseconds interval);
+    void stop_sampler();
+    bool sampler_running() const { return sampler_running_.load(); }
+
 private:
+    // One full /proc scan, swapped in atomically by the sampler
+    struct Snapshot {
+        std::chrono::steady_clock::time_point taken;
+        SystemMetrics system;
+        std::unordered_map<pid_t, ProcessMetrics> processes;
+        std::unordered_map<std::string, CgroupMetrics> cgroups;
+    };
+
+    // Uncached collectors (what collect_* did before the sampler)
+    SystemMetrics collect_system_direct();
+    std::optional<ProcessMetrics> collect_process_direct(pid_t pid);
+    CgroupMetrics collect_cgroup_direct(const std::string& cgroup_path);
+
+    void sampler_loop(std::chrono::milliseconds interval);
+    std::shared_ptr<const Snapshot> current_snapshot() const;
+
+    std::shared_ptr<const Snapshot> snapshot_;
+    mutable std::mutex snapshot_mutex_;
+    std::thread sampler_thread_;
+    std::atomic<bool> sampler_running_{false};
+    bool sampler_stop_ = false;
+    std::mutex sampler_mutex_;
+    std::condition_variable sampler_cv_;
+    std::chrono::milliseconds sampler_interval_{1000};
+
+    // Pids/cgroups the sampler scans; populated on first query
+    std::unordered_set<pid_t> watched_pids_;
+    std::unordered_set<std::string> watched_cgroups_;
+    std::mutex watch_mutex_;
+
+    // Kept-open fds for stable /proc files, read with pread(0)
+    std::unordered_map<std::string, int> fd_cache_;
+    std::mutex fd_cache_mutex_;
+
     // CPU calculation state
     int cpu_count_;
     uint64_t prev_cpu_total_ = 0;
@@ -257,6 +307,7 @@ private:
         std::chrono::steady_clock::time_point prev_time;
     };
     std::unordered_map<pid_t, ProcessCpuState> process_cpu_state_;
+    std::mutex process_cpu_mutex_;
 
     // Helper methods
     void read_cpu_stats(uint64_t& total, uint64_t& idle,
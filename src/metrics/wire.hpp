@@ -0,0 +1,166 @@
+/**
+ * Clove Metrics Wire Format
+ *
+ * Fixed-layout binary frames pushed to SYS_METRICS_SUBSCRIBE
+ * subscribers. All fields are little-endian scalars so the TUI and
+ * external bridges can decode with a single struct read — no JSON at
+ * either end.
+ *
+ * Frame layout: MetricsFrameHeader, then one SystemFrameBody (with
+ * header.count trailing doubles for per-core CPU) or one
+ * ProcessFrameBody depending on header.type.
+ */
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "metrics/metrics.hpp"
+
+namespace clove::metrics {
+
+constexpr uint32_t METRICS_FRAME_MAGIC = 0x434D4631;  // "CMF1"
+constexpr uint8_t METRICS_FRAME_VERSION = 1;
+
+enum class FrameType : uint8_t {
+    SYSTEM = 1,
+    PROCESS = 2,
+};
+
+struct __attribute__((packed)) MetricsFrameHeader {
+    uint32_t magic;       // METRICS_FRAME_MAGIC
+    uint8_t version;      // METRICS_FRAME_VERSION
+    uint8_t type;         // FrameType
+    uint16_t count;       // SYSTEM: per-core doubles after the body; else 0
+    int64_t ts_ms;        // wall-clock sample time, ms since epoch
+};
+static_assert(sizeof(MetricsFrameHeader) == 16, "header layout drifted");
+
+struct __attribute__((packed)) SystemFrameBody {
+    double cpu_percent;
+    double cpu_freq_mhz;
+    double load_avg_1m;
+    double load_avg_5m;
+    double load_avg_15m;
+    int32_t cpu_count;
+    uint32_t reserved;
+    uint64_t mem_total;
+    uint64_t mem_available;
+    uint64_t mem_used;
+    uint64_t mem_buffers;
+    uint64_t mem_cached;
+    uint64_t swap_total;
+    uint64_t swap_used;
+    uint64_t disk_read_bytes;
+    uint64_t disk_write_bytes;
+    uint64_t disk_read_ops;
+    uint64_t disk_write_ops;
+    uint64_t net_bytes_sent;
+    uint64_t net_bytes_recv;
+    uint64_t net_packets_sent;
+    uint64_t net_packets_recv;
+    uint64_t net_errors_in;
+    uint64_t net_errors_out;
+};
+static_assert(sizeof(SystemFrameBody) == 184, "body layout drifted");
+
+struct __attribute__((packed)) ProcessFrameBody {
+    uint32_t agent_id;
+    int32_t pid;
+    int32_t ppid;
+    char state;           // R/S/D/Z/T, '?' if unknown
+    uint8_t reserved[3];
+    double cpu_percent;
+    double mem_percent;
+    uint64_t cpu_time_user_ms;
+    uint64_t cpu_time_system_ms;
+    uint64_t mem_rss;
+    uint64_t mem_vms;
+    uint64_t mem_shared;
+    uint64_t io_read_bytes;
+    uint64_t io_write_bytes;
+    int32_t num_threads;
+    int32_t num_fds;
+};
+static_assert(sizeof(ProcessFrameBody) == 96, "body layout drifted");
+
+inline int64_t frame_ts_ms(std::chrono::system_clock::time_point tp) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        tp.time_since_epoch()).count();
+}
+
+inline std::vector<uint8_t> encode_system_frame(const SystemMetrics& m) {
+    uint16_t cores = static_cast<uint16_t>(m.cpu_per_core.size());
+
+    MetricsFrameHeader header{};
+    header.magic = METRICS_FRAME_MAGIC;
+    header.version = METRICS_FRAME_VERSION;
+    header.type = static_cast<uint8_t>(FrameType::SYSTEM);
+    header.count = cores;
+    header.ts_ms = frame_ts_ms(m.timestamp);
+
+    SystemFrameBody body{};
+    body.cpu_percent = m.cpu_percent;
+    body.cpu_freq_mhz = m.cpu_freq_mhz;
+    body.load_avg_1m = m.load_avg_1m;
+    body.load_avg_5m = m.load_avg_5m;
+    body.load_avg_15m = m.load_avg_15m;
+    body.cpu_count = m.cpu_count;
+    body.mem_total = m.mem_total;
+    body.mem_available = m.mem_available;
+    body.mem_used = m.mem_used;
+    body.mem_buffers = m.mem_buffers;
+    body.mem_cached = m.mem_cached;
+    body.swap_total = m.swap_total;
+    body.swap_used = m.swap_used;
+    body.disk_read_bytes = m.disk_read_bytes;
+    body.disk_write_bytes = m.disk_write_bytes;
+    body.disk_read_ops = m.disk_read_ops;
+    body.disk_write_ops = m.disk_write_ops;
+    body.net_bytes_sent = m.net_bytes_sent;
+    body.net_bytes_recv = m.net_bytes_recv;
+    body.net_packets_sent = m.net_packets_sent;
+    body.net_packets_recv = m.net_packets_recv;
+    body.net_errors_in = m.net_errors_in;
+    body.net_errors_out = m.net_errors_out;
+
+    std::vector<uint8_t> frame(sizeof(header) + sizeof(body) + cores * sizeof(double));
+    std::memcpy(frame.data(), &header, sizeof(header));
+    std::memcpy(frame.data() + sizeof(header), &body, sizeof(body));
+    std::memcpy(frame.data() + sizeof(header) + sizeof(body),
+                m.cpu_per_core.data(), cores * sizeof(double));
+    return frame;
+}
+
+inline std::vector<uint8_t> encode_process_frame(uint32_t agent_id,
+                                                 const ProcessMetrics& m) {
+    MetricsFrameHeader header{};
+    header.magic = METRICS_FRAME_MAGIC;
+    header.version = METRICS_FRAME_VERSION;
+    header.type = static_cast<uint8_t>(FrameType::PROCESS);
+    header.count = 0;
+    header.ts_ms = frame_ts_ms(m.timestamp);
+
+    ProcessFrameBody body{};
+    body.agent_id = agent_id;
+    body.pid = m.pid;
+    body.ppid = m.ppid;
+    body.state = m.state.empty() ? '?' : m.state[0];
+    body.cpu_percent = m.cpu_percent;
+    body.mem_percent = m.mem_percent;
+    body.cpu_time_user_ms = m.cpu_time_user_ms;
+    body.cpu_time_system_ms = m.cpu_time_system_ms;
+    body.mem_rss = m.mem_rss;
+    body.mem_vms = m.mem_vms;
+    body.mem_shared = m.mem_shared;
+    body.io_read_bytes = m.io_read_bytes;
+    body.io_write_bytes = m.io_write_bytes;
+    body.num_threads = m.num_threads;
+    body.num_fds = m.num_fds;
+
+    std::vector<uint8_t> frame(sizeof(header) + sizeof(body));
+    std::memcpy(frame.data(), &header, sizeof(header));
+    std::memcpy(frame.data() + sizeof(header), &body, sizeof(body));
+    return frame;
+}
+
+} // namespace clove::metrics
@@ -1,10 +1,20 @@
 #include "runtime/agent/manager.hpp"
+#include "core/config.hpp"
 #include <spdlog/spdlog.h>
+#include <thread>
+#include <unordered_set>
 
 namespace clove::runtime {
 
 AgentManager::AgentManager(const std::string& kernel_socket)
     : kernel_socket_(kernel_socket) {
+    // Zygote pool profile matches the AgentConfig defaults (sandboxed,
+    // no network); agents with other profiles take the cold path
+    size_t pool_size = std::stoul(core::config::get_env_or("CLOVE_ZYGOTE_POOL", "0"));
+    if (pool_size > 0) {
+        zygote_pool_ = std::make_unique<ZygotePool>(pool_size, true, false);
+    }
+
     spdlog::debug("AgentManager initialized (socket={})", kernel_socket);
 }
 
@@ -13,6 +23,17 @@ AgentManager::~AgentManager() {
 }
 
 std::shared_ptr<AgentProcess> AgentManager::spawn_agent(const AgentConfig& config) {
+    return spawn_agent_internal(config, std::nullopt);
+}
+
+std::shared_ptr<AgentProcess> AgentManager::spawn_agent(const AgentConfig& config,
+                                                        uint32_t preserved_id) {
+    AgentProcess::reserve_ids_through(preserved_id);
+    return spawn_agent_internal(config, preserved_id);
+}
+
+std::shared_ptr<AgentProcess> AgentManager::spawn_agent_internal(
+    const AgentConfig& config, std::optional<uint32_t> preserved_id) {
     if (agents_by_name_.count(config.name)) {
         spdlog::error("Agent {} already exists", config.name);
         return nullptr;
@@ -24,7 +45,10 @@ std::shared_ptr<AgentProcess> AgentManager::spawn_agent(const AgentConfig& confi
         final_config.socket_path = kernel_socket_;
     }
 
-    auto agent = std::make_shared<AgentProcess>(final_config);
+    auto agent = preserved_id
+        ? std::make_shared<AgentProcess>(final_config, *preserved_id)
+        : std::make_shared<AgentProcess>(final_config);
+    agent->set_zygote_pool(zygote_pool_.get());
 
     if (!agent->start()) {
         return nullptr;
@@ -33,6 +57,10 @@ std::shared_ptr<AgentProcess> AgentManager::spawn_agent(const AgentConfig& confi
     agents_by_name_[config.name] = agent;
     agents_by_id_[agent->id()] = agent;
 
+    if (spawn_observer_) {
+        spawn_observer_(config.name, agent->pid());
+    }
+
     // Save config for potential restart if policy != NEVER
     if (config.restart.policy != RestartPolicy::NEVER) {
         saved_configs_[config.name] = final_config;
@@ -48,6 +76,77 @@ std::shared_ptr<AgentProcess> AgentManager::spawn_agent(const AgentConfig& confi
     return agent;
 }
 
+std::vector<std::shared_ptr<AgentProcess>> AgentManager::spawn_agents(
+    const std::vector<AgentConfig>& configs) {
+    std::vector<AgentConfig> final_configs(configs);
+    std::vector<std::shared_ptr<AgentProcess>> agents(configs.size());
+
+    // Reject duplicate names (against live agents and within the batch)
+    // before paying for any sandbox setup
+    std::unordered_set<std::string> batch_names;
+    for (size_t i = 0; i < final_configs.size(); ++i) {
+        AgentConfig& config = final_configs[i];
+        if (config.socket_path.empty()) {
+            config.socket_path = kernel_socket_;
+        }
+
+        if (agents_by_name_.count(config.name) || !batch_names.insert(config.name).second) {
+            spdlog::error("Agent {} already exists", config.name);
+            continue;
+        }
+
+        agents[i] = std::make_shared<AgentProcess>(config);
+        agents[i]->set_zygote_pool(zygote_pool_.get());
+    }
+
+    // Sandbox setup and process start only touch the agent's own state,
+    // so the expensive part of the batch runs on one thread per agent;
+    // manager bookkeeping stays on the calling thread
+    std::vector<char> started(agents.size(), 0);
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < agents.size(); ++i) {
+        if (!agents[i]) {
+            continue;
+        }
+        workers.emplace_back([&agents, &started, i] {
+            started[i] = agents[i]->start() ? 1 : 0;
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    for (size_t i = 0; i < agents.size(); ++i) {
+        if (!agents[i]) {
+            continue;
+        }
+        if (!started[i]) {
+            agents[i].reset();
+            continue;
+        }
+
+        const AgentConfig& config = final_configs[i];
+        agents_by_name_[config.name] = agents[i];
+        agents_by_id_[agents[i]->id()] = agents[i];
+
+        if (spawn_observer_) {
+            spawn_observer_(config.name, agents[i]->pid());
+        }
+
+        if (config.restart.policy != RestartPolicy::NEVER) {
+            saved_configs_[config.name] = config;
+
+            if (restart_states_.find(config.name) == restart_states_.end()) {
+                RestartState state;
+                state.window_start = std::chrono::steady_clock::now();
+                restart_states_[config.name] = state;
+            }
+        }
+    }
+
+    return agents;
+}
+
 std::shared_ptr<AgentProcess> AgentManager::get_agent(const std::string& name) {
     auto it = agents_by_name_.find(name);
     return (it != agents_by_name_.end()) ? it->second : nullptr;
@@ -147,6 +246,10 @@ void AgentManager::set_restart_event_callback(RestartEventCallback callback) {
     restart_event_callback_ = std::move(callback);
 }
 
+void AgentManager::set_spawn_observer(SpawnObserver observer) {
+    spawn_observer_ = std::move(observer);
+}
+
 uint32_t AgentManager::calculate_backoff_delay(const RestartConfig& config, uint32_t consecutive_failures) {
     if (consecutive_failures == 0) {
         return config.backoff_initial_ms;
@@ -284,6 +387,7 @@ void AgentManager::process_pending_restarts() {
             spdlog::info("Restarting agent: {} (scheduled restart)", pending.agent_name);
 
             auto agent = std::make_shared<AgentProcess>(pending.config);
+            agent->set_zygote_pool(zygote_pool_.get());
 
             if (agent->start()) {
                 agents_by_name_[pending.agent_name] = agent;
@@ -292,6 +396,10 @@ void AgentManager::process_pending_restarts() {
                 spdlog::info("Agent {} restarted successfully (new id={}, pid={})",
                     pending.agent_name, agent->id(), agent->pid());
 
+                if (spawn_observer_) {
+                    spawn_observer_(pending.agent_name, agent->pid());
+                }
+
                 // Reset consecutive failures on successful start
                 auto state_it = restart_states_.find(pending.agent_name);
                 if (state_it != restart_states_.end()) {
@@ -1,11 +1,13 @@
 #pragma once
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
 #include <functional>
 #include <chrono>
 #include "runtime/agent/process.hpp"
+#include "runtime/sandbox/zygote.hpp"
 
 namespace clove::runtime {
 
@@ -18,6 +20,16 @@ public:
     // Create and start an agent
     std::shared_ptr<AgentProcess> spawn_agent(const AgentConfig& config);
 
+    // Create and start an agent under a specific ID (checkpoint
+    // restore); the ID counter is advanced so it can't be reissued
+    std::shared_ptr<AgentProcess> spawn_agent(const AgentConfig& config,
+                                              uint32_t preserved_id);
+
+    // Create and start a batch of agents, running the per-agent sandbox
+    // setup and start in parallel. Returns one entry per config, in
+    // order; null entries are agents that failed to spawn.
+    std::vector<std::shared_ptr<AgentProcess>> spawn_agents(const std::vector<AgentConfig>& configs);
+
     // Get agent by name or ID
     std::shared_ptr<AgentProcess> get_agent(const std::string& name);
     std::shared_ptr<AgentProcess> get_agent(uint32_t id);
@@ -51,6 +63,11 @@ public:
                                                      int exit_code)>;
     void set_restart_event_callback(RestartEventCallback callback);
 
+    // Observer invoked with the new pid after every successful spawn or
+    // restart; lets the kernel register a pidfd for event-driven reaping
+    using SpawnObserver = std::function<void(const std::string& agent_name, pid_t pid)>;
+    void set_spawn_observer(SpawnObserver observer);
+
     // Legacy method (now calls reap_and_restart_agents)
     void reap_agents() { reap_and_restart_agents(); }
 
@@ -60,6 +77,10 @@ private:
     std::unordered_map<uint32_t, std::shared_ptr<AgentProcess>> agents_by_id_;
     SandboxManager sandbox_manager_;
 
+    // Pre-forked sandbox processes for fast spawn; sized by
+    // CLOVE_ZYGOTE_POOL (0 = disabled), null when disabled
+    std::unique_ptr<ZygotePool> zygote_pool_;
+
     // Restart state tracking (survives agent death)
     struct RestartState {
         uint32_t restart_count = 0;
@@ -81,8 +102,14 @@ private:
     // Event callback for restart notifications
     RestartEventCallback restart_event_callback_;
 
+    // Notified after each successful start (may be null)
+    SpawnObserver spawn_observer_;
+
     // Helper to calculate backoff delay
     uint32_t calculate_backoff_delay(const RestartConfig& config, uint32_t consecutive_failures);
+
+    std::shared_ptr<AgentProcess> spawn_agent_internal(const AgentConfig& config,
+                                                       std::optional<uint32_t> preserved_id);
 };
 
 } // namespace clove::runtime
@@ -17,8 +17,11 @@ uint32_t AgentProcess::generate_id() {
 }
 
 AgentProcess::AgentProcess(const AgentConfig& config)
+    : AgentProcess(config, generate_id()) {}
+
+AgentProcess::AgentProcess(const AgentConfig& config, uint32_t preserved_id)
     : config_(config)
-    , id_(generate_id()) {
+    , id_(preserved_id) {
     // Record creation timestamp
     auto now = std::chrono::system_clock::now();
     created_at_ms_ = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -27,6 +30,13 @@ AgentProcess::AgentProcess(const AgentConfig& config)
     spdlog::debug("AgentProcess created: {} (id={})", config_.name, id_);
 }
 
+void AgentProcess::reserve_ids_through(uint32_t max_id) {
+    uint32_t current = g_next_agent_id.load();
+    while (current <= max_id &&
+           !g_next_agent_id.compare_exchange_weak(current, max_id + 1)) {
+    }
+}
+
 AgentProcess::~AgentProcess() {
     if (state_ == AgentState::RUNNING || state_ == AgentState::STARTING || state_ == AgentState::PAUSED) {
         stop();
@@ -52,6 +62,7 @@ bool AgentProcess::start() {
     sandbox_config.enable_pid_namespace = config_.sandboxed;
     sandbox_config.enable_mount_namespace = config_.sandboxed;
     sandbox_config.enable_uts_namespace = config_.sandboxed;
+    sandbox_config.image = config_.image;
 
     // Create sandbox
     sandbox_ = std::make_unique<Sandbox>(sandbox_config);
@@ -65,8 +76,14 @@ bool AgentProcess::start() {
     // Build command arguments
     auto args = build_args();
 
-    // Start the process
-    if (!sandbox_->start(config_.python_path, args)) {
+    // Try the zygote fast path first; fall back to a cold spawn when
+    // the pool is empty, disabled, or built for a different profile.
+    // Agents with an overlay root take the cold path - zygotes are cloned
+    // before the root exists and cannot chroot into it afterwards.
+    bool started = zygote_pool_ && config_.image.empty() &&
+                   sandbox_->start_from_zygote(*zygote_pool_, config_.python_path, args);
+
+    if (!started && !sandbox_->start(config_.python_path, args)) {
         spdlog::error("Failed to start agent {}", config_.name);
         set_state(AgentState::FAILED);
         return false;
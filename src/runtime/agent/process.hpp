@@ -9,8 +9,9 @@
 
 namespace clove::runtime {
 
-// Forward declaration
+// Forward declarations
 class AgentProcess;
+class ZygotePool;
 
 // Callback for agent events
 using AgentEventCallback = std::function<void(AgentProcess*, AgentState)>;
@@ -18,8 +19,15 @@ using AgentEventCallback = std::function<void(AgentProcess*, AgentState)>;
 class AgentProcess {
 public:
     explicit AgentProcess(const AgentConfig& config);
+    // Checkpoint restore: adopt a specific agent ID instead of drawing a
+    // fresh one. Call reserve_ids_through() first so the counter never
+    // hands the adopted ID out again.
+    AgentProcess(const AgentConfig& config, uint32_t preserved_id);
     ~AgentProcess();
 
+    // Advance the global ID counter past IDs adopted from a checkpoint
+    static void reserve_ids_through(uint32_t max_id);
+
     // Non-copyable
     AgentProcess(const AgentProcess&) = delete;
     AgentProcess& operator=(const AgentProcess&) = delete;
@@ -34,6 +42,7 @@ public:
     // Status
     AgentState state() const { return state_; }
     const std::string& name() const { return config_.name; }
+    const AgentConfig& config() const { return config_; }
     uint32_t id() const { return id_; }
     pid_t pid() const;
 
@@ -62,6 +71,9 @@ public:
     void add_child(uint32_t child_id);
     const std::vector<uint32_t>& child_ids() const { return child_ids_; }
 
+    // Zygote pool to try before a cold spawn (may be null)
+    void set_zygote_pool(ZygotePool* pool) { zygote_pool_ = pool; }
+
     // Static: generate unique ID
     static uint32_t generate_id();
 
@@ -72,6 +84,7 @@ private:
     int exit_code_ = -1;
 
     std::unique_ptr<Sandbox> sandbox_;
+    ZygotePool* zygote_pool_ = nullptr;
     AgentEventCallback event_callback_;
 
     // Metrics tracking
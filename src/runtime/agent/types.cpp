@@ -15,4 +15,64 @@ const char* agent_state_to_string(AgentState state) {
     }
 }
 
+nlohmann::json AgentConfig::to_json() const {
+    return {
+        {"name", name},
+        {"script_path", script_path},
+        {"python_path", python_path},
+        {"socket_path", socket_path},
+        {"limits", {
+            {"memory_limit_bytes", limits.memory_limit_bytes},
+            {"cpu_shares", limits.cpu_shares},
+            {"cpu_quota_us", limits.cpu_quota_us},
+            {"cpu_period_us", limits.cpu_period_us},
+            {"max_pids", limits.max_pids},
+        }},
+        {"sandboxed", sandboxed},
+        {"enable_network", enable_network},
+        {"image", image},
+        {"restart", {
+            {"policy", restart_policy_to_string(restart.policy)},
+            {"max_restarts", restart.max_restarts},
+            {"restart_window_sec", restart.restart_window_sec},
+            {"backoff_initial_ms", restart.backoff_initial_ms},
+            {"backoff_max_ms", restart.backoff_max_ms},
+            {"backoff_multiplier", restart.backoff_multiplier},
+        }},
+    };
+}
+
+AgentConfig AgentConfig::from_json(const nlohmann::json& j) {
+    AgentConfig config;
+    config.name = j.value("name", "");
+    config.script_path = j.value("script_path", "");
+    config.python_path = j.value("python_path", config.python_path);
+    config.socket_path = j.value("socket_path", "");
+
+    if (j.contains("limits")) {
+        const auto& l = j["limits"];
+        config.limits.memory_limit_bytes = l.value("memory_limit_bytes", config.limits.memory_limit_bytes);
+        config.limits.cpu_shares = l.value("cpu_shares", config.limits.cpu_shares);
+        config.limits.cpu_quota_us = l.value("cpu_quota_us", config.limits.cpu_quota_us);
+        config.limits.cpu_period_us = l.value("cpu_period_us", config.limits.cpu_period_us);
+        config.limits.max_pids = l.value("max_pids", config.limits.max_pids);
+    }
+
+    config.sandboxed = j.value("sandboxed", config.sandboxed);
+    config.enable_network = j.value("enable_network", config.enable_network);
+    config.image = j.value("image", "");
+
+    if (j.contains("restart")) {
+        const auto& r = j["restart"];
+        config.restart.policy = restart_policy_from_string(r.value("policy", "never"));
+        config.restart.max_restarts = r.value("max_restarts", config.restart.max_restarts);
+        config.restart.restart_window_sec = r.value("restart_window_sec", config.restart.restart_window_sec);
+        config.restart.backoff_initial_ms = r.value("backoff_initial_ms", config.restart.backoff_initial_ms);
+        config.restart.backoff_max_ms = r.value("backoff_max_ms", config.restart.backoff_max_ms);
+        config.restart.backoff_multiplier = r.value("backoff_multiplier", config.restart.backoff_multiplier);
+    }
+
+    return config;
+}
+
 } // namespace clove::runtime
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <sys/types.h>
+#include <nlohmann/json.hpp>
 #include "runtime/sandbox/sandbox.hpp"
 
 namespace clove::runtime {
@@ -51,9 +52,14 @@ struct AgentConfig {
     // Sandbox options
     bool sandboxed = true;
     bool enable_network = false;
+    std::string image;                     // Overlayfs base image ("" = host fs)
 
     // Restart configuration
     RestartConfig restart;
+
+    // Round-trip serialization (kernel checkpoint image)
+    nlohmann::json to_json() const;
+    static AgentConfig from_json(const nlohmann::json& j);
 };
 
 // Agent state
@@ -1,4 +1,6 @@
 #include "runtime/sandbox/sandbox.hpp"
+#include "runtime/sandbox/zygote.hpp"
+#include "core/config.hpp"
 #include <spdlog/spdlog.h>
 
 #include <sys/wait.h>
@@ -12,6 +14,7 @@
 #include <cstring>
 #include <fstream>
 #include <filesystem>
+#include <mutex>
 
 namespace fs = std::filesystem;
 
@@ -20,6 +23,32 @@ namespace clove::runtime {
 // Stack size for clone()
 constexpr size_t STACK_SIZE = 1024 * 1024; // 1MB
 
+// Base image layers are read-only and shared by every sandbox using the
+// same image, so each image directory is validated once and the result
+// cached for the lifetime of the kernel
+static std::string resolve_image_base(const std::string& image) {
+    static std::mutex cache_mutex;
+    static std::unordered_map<std::string, std::string> cache;
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = cache.find(image);
+    if (it != cache.end()) {
+        return it->second;
+    }
+
+    std::string base = core::config::get_env_or("CLOVE_IMAGE_DIR", "/var/lib/clove/images");
+    base += "/" + image;
+
+    std::error_code ec;
+    if (!fs::is_directory(base, ec)) {
+        spdlog::warn("Sandbox image {} not found at {}", image, base);
+        base.clear();
+    }
+
+    cache[image] = base;
+    return base;
+}
+
 // Child process arguments
 struct ChildArgs {
     Sandbox* sandbox;
@@ -61,10 +90,73 @@ bool Sandbox::create() {
         }
     }
 
+    // Build the root as an overlay over the shared image base: N sandboxes
+    // share one read-only lower layer and only pay for their own writes
+    if (!config_.image.empty() && config_.enable_mount_namespace) {
+        if (!setup_overlay_root()) {
+            spdlog::warn("DEGRADED ISOLATION: sandbox {} falling back to host filesystem",
+                config_.name);
+            isolation_status_.degraded_reason = "overlay root unavailable";
+        }
+    }
+
     spdlog::debug("Sandbox {} created successfully", config_.name);
     return true;
 }
 
+bool Sandbox::setup_overlay_root() {
+    std::string base = resolve_image_base(config_.image);
+    if (base.empty()) {
+        return false;
+    }
+
+    std::string dir = config_.root_path + "/clove-overlays/" + config_.name;
+    std::string upper = dir + "/upper";
+    std::string work = dir + "/work";
+    std::string merged = dir + "/merged";
+
+    try {
+        fs::create_directories(upper);
+        fs::create_directories(work);
+        fs::create_directories(merged);
+    } catch (const std::exception& e) {
+        spdlog::warn("Cannot create overlay dirs for {}: {}", config_.name, e.what());
+        return false;
+    }
+
+    std::string opts = "lowerdir=" + base + ",upperdir=" + upper + ",workdir=" + work;
+    if (mount("overlay", merged.c_str(), "overlay", 0, opts.c_str()) < 0) {
+        spdlog::warn("overlay mount failed for {} (need root): {}",
+            config_.name, strerror(errno));
+        return false;
+    }
+
+    overlay_root_ = merged;
+    isolation_status_.overlay_root = true;
+    spdlog::debug("Overlay root for {} mounted at {} (base={})",
+        config_.name, merged, base);
+    return true;
+}
+
+void Sandbox::teardown_overlay_root() {
+    if (overlay_root_.empty()) {
+        return;
+    }
+
+    if (umount2(overlay_root_.c_str(), MNT_DETACH) < 0 && errno != EINVAL && errno != ENOENT) {
+        spdlog::warn("Failed to unmount overlay root {}: {}",
+            overlay_root_, strerror(errno));
+    }
+
+    try {
+        fs::remove_all(config_.root_path + "/clove-overlays/" + config_.name);
+    } catch (const std::exception& e) {
+        spdlog::warn("Failed to cleanup overlay dirs for {}: {}", config_.name, e.what());
+    }
+
+    overlay_root_.clear();
+}
+
 bool Sandbox::setup_cgroups() {
     // Check if cgroup v2 is available
     if (!fs::exists("/sys/fs/cgroup/cgroup.controllers")) {
@@ -236,6 +328,14 @@ int Sandbox::child_entry(void* arg) {
         }
     }
 
+    // Enter the overlay root (mounted by the parent; the child sees it
+    // because CLONE_NEWNS copies the parent's mounts)
+    if (!sandbox->overlay_root_.empty()) {
+        if (chroot(sandbox->overlay_root_.c_str()) < 0 || chdir("/") < 0) {
+            spdlog::warn("Failed to enter overlay root: {}", strerror(errno));
+        }
+    }
+
     // Mount proc if PID namespace is enabled
     if (sandbox->config_.enable_pid_namespace && sandbox->config_.enable_mount_namespace) {
         // Create a new proc mount point
@@ -426,6 +526,81 @@ bool Sandbox::start(const std::string& command, const std::vector<std::string>&
     return true;
 }
 
+bool Sandbox::start_from_zygote(ZygotePool& pool, const std::string& command,
+                                const std::vector<std::string>& args) {
+    if (state_ == SandboxState::RUNNING) {
+        spdlog::error("Sandbox {} already running", config_.name);
+        return false;
+    }
+
+    bool sandboxed = config_.enable_pid_namespace && config_.enable_mount_namespace &&
+                     config_.enable_uts_namespace;
+    auto zygote = pool.claim(sandboxed, config_.enable_network);
+    if (!zygote) {
+        return false;  // cold path
+    }
+
+    // The zygote pre-paid clone() + namespaces; attach it to this
+    // agent's cgroup (limits were written by create()) before release
+    bool cgroup_assigned = false;
+    if (config_.enable_cgroups && fs::exists(cgroup_path_ + "/cgroup.procs")) {
+        try {
+            std::ofstream ofs(cgroup_path_ + "/cgroup.procs");
+            if (ofs.is_open()) {
+                ofs << zygote->pid;
+                if (ofs.good()) {
+                    cgroup_assigned = true;
+                    spdlog::debug("Added PID {} to cgroup {}", zygote->pid, cgroup_path_);
+                }
+            }
+        } catch (const std::exception& e) {
+            spdlog::warn("DEGRADED ISOLATION: Failed to add zygote to cgroup: {}", e.what());
+        }
+    }
+    if (config_.enable_cgroups && !cgroup_assigned) {
+        spdlog::warn("DEGRADED ISOLATION: Process {} not added to cgroup - resource limits NOT enforced",
+            zygote->pid);
+        isolation_status_.memory_limit_applied = false;
+        isolation_status_.cpu_quota_applied = false;
+        isolation_status_.pids_limit_applied = false;
+    }
+
+    // Specialize: hand over hostname and argv; the child execs
+    std::string hostname = config_.enable_uts_namespace ? "clove-" + config_.name : "";
+    bool sent = send_zygote_spec(zygote->control_fd, hostname, command, args);
+    close(zygote->control_fd);
+    if (!sent) {
+        spdlog::warn("Sandbox {}: zygote handover failed, falling back to cold spawn",
+            config_.name);
+        kill(zygote->pid, SIGKILL);
+        waitpid(zygote->pid, nullptr, 0);
+        return false;
+    }
+
+    child_pid_ = zygote->pid;
+    isolation_status_.pid_namespace = zygote->isolation.pid_namespace;
+    isolation_status_.mnt_namespace = zygote->isolation.mnt_namespace;
+    isolation_status_.uts_namespace = zygote->isolation.uts_namespace;
+    isolation_status_.net_namespace = zygote->isolation.net_namespace;
+
+    bool namespaces_ok = (!config_.enable_pid_namespace || isolation_status_.pid_namespace) &&
+                         (!config_.enable_mount_namespace || isolation_status_.mnt_namespace) &&
+                         (!config_.enable_uts_namespace || isolation_status_.uts_namespace) &&
+                         (config_.enable_network || isolation_status_.net_namespace);
+
+    bool cgroups_ok = !config_.enable_cgroups ||
+                      (isolation_status_.memory_limit_applied &&
+                       isolation_status_.cpu_quota_applied &&
+                       isolation_status_.pids_limit_applied);
+
+    isolation_status_.fully_isolated = namespaces_ok && cgroups_ok;
+
+    set_state(SandboxState::RUNNING);
+    spdlog::info("Sandbox {} started from zygote (PID={}, {})", config_.name, child_pid_,
+        isolation_status_.fully_isolated ? "full isolation" : "partial isolation");
+    return true;
+}
+
 bool Sandbox::stop(int timeout_ms) {
     if (state_ != SandboxState::RUNNING) {
         return true;
@@ -481,6 +656,7 @@ bool Sandbox::destroy() {
     }
 
     cleanup_cgroups();
+    teardown_overlay_root();
     spdlog::debug("Sandbox {} destroyed", config_.name);
     return true;
 }
@@ -29,6 +29,7 @@ struct ResourceLimits {
 struct SandboxConfig {
     std::string name;                    // Unique sandbox name
     std::string root_path = "/tmp";      // Root filesystem path
+    std::string image;                   // Base image for overlayfs root ("" = share host fs)
     std::string socket_path;             // Socket for IPC with kernel
     ResourceLimits limits;
 
@@ -56,6 +57,9 @@ struct IsolationStatus {
     bool mnt_namespace = false;
     bool uts_namespace = false;
 
+    // Filesystem isolation
+    bool overlay_root = false;  // Private overlayfs root over a shared image
+
     // Cgroup resource limits
     bool cgroups_available = false;
     bool memory_limit_applied = false;
@@ -70,8 +74,9 @@ struct IsolationStatus {
     bool is_degraded() const { return !fully_isolated && !degraded_reason.empty(); }
 };
 
-// Forward declaration
+// Forward declarations
 class Sandbox;
+class ZygotePool;
 
 // Callback for sandbox events
 using SandboxEventCallback = std::function<void(Sandbox*, SandboxState)>;
@@ -88,6 +93,12 @@ public:
     // Lifecycle
     bool create();
     bool start(const std::string& command, const std::vector<std::string>& args = {});
+
+    // Fast path: specialize a pre-forked zygote instead of paying
+    // clone() + namespace setup here. Returns false when the pool has
+    // nothing suitable — callers fall back to start().
+    bool start_from_zygote(ZygotePool& pool, const std::string& command,
+                           const std::vector<std::string>& args = {});
     bool stop(int timeout_ms = 5000);
     bool destroy();
     bool pause();
@@ -123,10 +134,15 @@ private:
     // cgroup paths
     std::string cgroup_path_;
 
+    // Merged overlayfs dir the child chroots into ("" = host fs)
+    std::string overlay_root_;
+
     // Internal methods
     bool setup_cgroups();
     bool cleanup_cgroups();
     bool setup_namespaces();
+    bool setup_overlay_root();
+    void teardown_overlay_root();
 
     // Child process entry point (runs in new namespaces)
     static int child_entry(void* arg);
@@ -0,0 +1,287 @@
+#include "runtime/sandbox/zygote.hpp"
+#include <spdlog/spdlog.h>
+
+#include <sys/wait.h>
+#include <sys/mount.h>
+#include <sched.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <cerrno>
+#include <cstring>
+
+namespace clove::runtime {
+
+namespace {
+
+// Stack size for clone(), matching the sandbox
+constexpr size_t ZYGOTE_STACK_SIZE = 1024 * 1024; // 1MB
+
+struct ZygoteArgs {
+    int control_fd;  // read end; the spec message arrives here
+    bool enable_pid_namespace;
+    bool enable_mount_namespace;
+    bool enable_uts_namespace;
+};
+
+bool read_full(int fd, void* data, size_t len) {
+    char* p = static_cast<char*>(data);
+    while (len > 0) {
+        ssize_t n = ::read(fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (n == 0) {
+            return false;  // pool shut down before specialization
+        }
+        p += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool write_full(int fd, const void* data, size_t len) {
+    const char* p = static_cast<const char*>(data);
+    while (len > 0) {
+        ssize_t n = ::write(fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        p += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Child side: do the namespace setup that doesn't depend on the agent,
+// then block until the spec message arrives and exec it
+int zygote_entry(void* arg) {
+    ZygoteArgs* zargs = static_cast<ZygoteArgs*>(arg);
+
+    // Mount proc if PID namespace is enabled (same caveat as the
+    // sandbox: may fail without root, that's ok)
+    if (zargs->enable_pid_namespace && zargs->enable_mount_namespace) {
+        if (mount("proc", "/proc", "proc", 0, nullptr) < 0) {
+            spdlog::debug("Zygote: could not mount /proc (may need root)");
+        }
+    }
+
+    // Block here until SYS_SPAWN hands over an agent, or the pool
+    // closes the pipe on shutdown
+    uint32_t count = 0;
+    if (!read_full(zargs->control_fd, &count, sizeof(count)) ||
+        count < 2 || count > 64) {
+        _exit(0);
+    }
+
+    std::vector<std::string> strings;
+    strings.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t len = 0;
+        if (!read_full(zargs->control_fd, &len, sizeof(len)) || len > 65536) {
+            _exit(0);
+        }
+        std::string s(len, '\0');
+        if (len > 0 && !read_full(zargs->control_fd, s.data(), len)) {
+            _exit(0);
+        }
+        strings.push_back(std::move(s));
+    }
+    close(zargs->control_fd);
+
+    // strings[0] = hostname, strings[1..] = argv
+    if (zargs->enable_uts_namespace && !strings[0].empty()) {
+        if (sethostname(strings[0].c_str(), strings[0].length()) < 0) {
+            spdlog::warn("Zygote: failed to set hostname: {}", strerror(errno));
+        }
+    }
+
+    std::vector<char*> argv;
+    for (size_t i = 1; i < strings.size(); i++) {
+        argv.push_back(const_cast<char*>(strings[i].c_str()));
+    }
+    argv.push_back(nullptr);
+
+    execvp(argv[0], argv.data());
+    spdlog::error("Zygote: execvp failed: {}", strerror(errno));
+    _exit(127);
+}
+
+} // namespace
+
+bool send_zygote_spec(int control_fd, const std::string& hostname,
+                      const std::string& command,
+                      const std::vector<std::string>& args) {
+    uint32_t count = static_cast<uint32_t>(2 + args.size());
+    if (!write_full(control_fd, &count, sizeof(count))) {
+        return false;
+    }
+
+    auto send_string = [control_fd](const std::string& s) {
+        uint32_t len = static_cast<uint32_t>(s.size());
+        return write_full(control_fd, &len, sizeof(len)) &&
+               (len == 0 || write_full(control_fd, s.data(), len));
+    };
+
+    if (!send_string(hostname) || !send_string(command)) {
+        return false;
+    }
+    for (const auto& arg : args) {
+        if (!send_string(arg)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ZygotePool::ZygotePool(size_t target_size, bool sandboxed, bool enable_network)
+    : target_size_(target_size)
+    , sandboxed_(sandboxed)
+    , enable_network_(enable_network) {
+    if (target_size_ == 0) {
+        return;
+    }
+
+    // Prefill synchronously so the first burst hits a full pool, then
+    // let the background thread keep it topped up
+    for (size_t i = 0; i < target_size_ && !spawn_failed_; i++) {
+        auto z = spawn_zygote();
+        if (z) {
+            pool_.push_back(*z);
+        }
+    }
+    spdlog::info("ZygotePool: prefilled {}/{} zygotes", pool_.size(), target_size_);
+
+    refill_thread_ = std::thread([this] { refill_loop(); });
+}
+
+ZygotePool::~ZygotePool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (refill_thread_.joinable()) {
+        refill_thread_.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& z : pool_) {
+        discard(z);
+    }
+    pool_.clear();
+}
+
+void ZygotePool::discard(Zygote& z) {
+    // Closing the pipe unblocks the child's read; it exits cleanly
+    if (z.control_fd >= 0) {
+        close(z.control_fd);
+    }
+    if (z.pid > 0) {
+        kill(z.pid, SIGKILL);
+        waitpid(z.pid, nullptr, 0);
+    }
+}
+
+std::optional<ZygotePool::Zygote> ZygotePool::claim(bool sandboxed, bool enable_network) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (sandboxed != sandboxed_ || enable_network != enable_network_) {
+        return std::nullopt;  // pool built for a different profile
+    }
+
+    while (!pool_.empty()) {
+        Zygote z = pool_.back();
+        pool_.pop_back();
+        cv_.notify_one();  // wake the refill thread
+
+        // Skip zygotes that died while parked
+        if (waitpid(z.pid, nullptr, WNOHANG) != 0) {
+            spdlog::warn("ZygotePool: discarding dead zygote (pid={})", z.pid);
+            close(z.control_fd);
+            continue;
+        }
+        return z;
+    }
+    return std::nullopt;
+}
+
+void ZygotePool::refill_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this] {
+            return stop_ || (pool_.size() < target_size_ && !spawn_failed_);
+        });
+        if (stop_) {
+            return;
+        }
+
+        lock.unlock();
+        auto z = spawn_zygote();
+        lock.lock();
+
+        if (z) {
+            pool_.push_back(*z);
+        }
+    }
+}
+
+std::optional<ZygotePool::Zygote> ZygotePool::spawn_zygote() {
+    int pipe_fd[2];
+    if (pipe2(pipe_fd, O_CLOEXEC) < 0) {
+        spdlog::error("ZygotePool: pipe2 failed: {}", strerror(errno));
+        spawn_failed_ = true;
+        return std::nullopt;
+    }
+
+    ZygoteArgs zargs;
+    zargs.control_fd = pipe_fd[0];
+    zargs.enable_pid_namespace = sandboxed_;
+    zargs.enable_mount_namespace = sandboxed_;
+    zargs.enable_uts_namespace = sandboxed_;
+
+    int clone_flags = SIGCHLD;
+    if (sandboxed_) {
+        clone_flags |= CLONE_NEWPID | CLONE_NEWNS | CLONE_NEWUTS;
+    }
+    if (!enable_network_) {
+        clone_flags |= CLONE_NEWNET;
+    }
+
+    char* stack = new char[ZYGOTE_STACK_SIZE];
+    pid_t pid = clone(zygote_entry, stack + ZYGOTE_STACK_SIZE, clone_flags, &zargs);
+    delete[] stack;
+    close(pipe_fd[0]);
+
+    if (pid < 0) {
+        // No namespaces without root/CAP_SYS_ADMIN; the cold path's
+        // fork() fallback covers that, so the pool stands down
+        spdlog::warn("ZygotePool: clone() failed ({}), pool disabled", strerror(errno));
+        close(pipe_fd[1]);
+        spawn_failed_ = true;
+        return std::nullopt;
+    }
+
+    Zygote z;
+    z.pid = pid;
+    z.control_fd = pipe_fd[1];
+    if (sandboxed_) {
+        z.isolation.pid_namespace = true;
+        z.isolation.mnt_namespace = true;
+        z.isolation.uts_namespace = true;
+    }
+    if (!enable_network_) {
+        z.isolation.net_namespace = true;
+    }
+
+    spdlog::debug("ZygotePool: spawned zygote (pid={})", pid);
+    return z;
+}
+
+} // namespace clove::runtime
@@ -0,0 +1,87 @@
+/**
+ * AgentOS Zygote Pool
+ *
+ * Pre-forked blank sandbox processes for fast agent spawn. Each zygote
+ * has already paid clone() with the namespace set the pool is built
+ * for; the child then blocks on a control pipe. SYS_SPAWN specializes
+ * one by writing the agent's hostname and argv down the pipe (and
+ * attaching the pid to the agent's cgroup), turning a 300-900ms cold
+ * spawn into a handful of file writes. A background thread refills the
+ * pool to its target size after every claim.
+ *
+ * The interpreter itself still starts at specialization time: the
+ * script to run is only known then, so the pool pre-pays the fork and
+ * namespace setup, not the exec.
+ */
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/types.h>
+#include "runtime/sandbox/sandbox.hpp"
+
+namespace clove::runtime {
+
+/**
+ * Write the specialization message to a claimed zygote's control pipe:
+ * the hostname to adopt (empty = keep), then the argv to exec. Returns
+ * false if the zygote is gone or the pipe write fails.
+ */
+bool send_zygote_spec(int control_fd, const std::string& hostname,
+                      const std::string& command,
+                      const std::vector<std::string>& args);
+
+class ZygotePool {
+public:
+    // A claimed pre-forked process, ready to specialize
+    struct Zygote {
+        pid_t pid = -1;
+        int control_fd = -1;
+        IsolationStatus isolation;  // namespace bits only
+    };
+
+    /**
+     * Pool of `target_size` zygotes with a fixed sandbox profile.
+     * target_size 0 disables the pool entirely.
+     */
+    ZygotePool(size_t target_size, bool sandboxed, bool enable_network);
+    ~ZygotePool();
+
+    // Non-copyable
+    ZygotePool(const ZygotePool&) = delete;
+    ZygotePool& operator=(const ZygotePool&) = delete;
+
+    bool enabled() const { return target_size_ > 0; }
+
+    /**
+     * Claim a zygote matching the requested profile. Returns nullopt if
+     * the pool is empty, disabled, or built for a different profile —
+     * the caller then takes the cold spawn path. The caller owns the
+     * control fd and must either specialize or kill the process.
+     */
+    std::optional<Zygote> claim(bool sandboxed, bool enable_network);
+
+private:
+    size_t target_size_;
+    bool sandboxed_;
+    bool enable_network_;
+
+    std::vector<Zygote> pool_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread refill_thread_;
+    bool stop_ = false;
+    // clone() with namespaces failed once; the cold path's fork()
+    // fallback handles that environment, so stop burning attempts
+    bool spawn_failed_ = false;
+
+    void refill_loop();
+    std::optional<Zygote> spawn_zygote();
+    static void discard(Zygote& z);
+};
+
+} // namespace clove::runtime
@@ -0,0 +1,507 @@
+#include "services/http/client.hpp"
+#include <spdlog/spdlog.h>
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+namespace clove::services::http {
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+int remaining_ms(Clock::time_point deadline) {
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - Clock::now()).count();
+    return left > 0 ? static_cast<int>(left) : 0;
+}
+
+std::string lowercase(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return s;
+}
+
+} // namespace
+
+// A pooled connection: plain TCP or TLS over the same fd. All I/O is
+// non-blocking with poll()-enforced deadlines.
+struct HttpClient::Connection {
+    int fd = -1;
+    SSL* ssl = nullptr;
+
+    ~Connection() {
+        if (ssl) {
+            SSL_free(ssl);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    bool wait_io(short events, Clock::time_point deadline) {
+        pollfd pfd{fd, events, 0};
+        int rc = ::poll(&pfd, 1, remaining_ms(deadline));
+        return rc > 0 && (pfd.revents & (events | POLLERR | POLLHUP)) != 0;
+    }
+
+    // Returns bytes read, 0 on clean EOF, -1 on error/timeout
+    ssize_t read_some(char* buf, size_t len, Clock::time_point deadline) {
+        while (true) {
+            ssize_t n;
+            if (ssl) {
+                n = SSL_read(ssl, buf, static_cast<int>(len));
+                if (n > 0) return n;
+                int err = SSL_get_error(ssl, static_cast<int>(n));
+                if (err == SSL_ERROR_ZERO_RETURN) return 0;
+                if (err == SSL_ERROR_WANT_READ) {
+                    if (!wait_io(POLLIN, deadline)) return -1;
+                    continue;
+                }
+                if (err == SSL_ERROR_WANT_WRITE) {
+                    if (!wait_io(POLLOUT, deadline)) return -1;
+                    continue;
+                }
+                return -1;
+            }
+            n = ::recv(fd, buf, len, 0);
+            if (n >= 0) return n;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                if (!wait_io(POLLIN, deadline)) return -1;
+                continue;
+            }
+            if (errno == EINTR) continue;
+            return -1;
+        }
+    }
+
+    bool write_all(const char* buf, size_t len, Clock::time_point deadline) {
+        size_t sent = 0;
+        while (sent < len) {
+            ssize_t n;
+            if (ssl) {
+                n = SSL_write(ssl, buf + sent, static_cast<int>(len - sent));
+                if (n <= 0) {
+                    int err = SSL_get_error(ssl, static_cast<int>(n));
+                    if (err == SSL_ERROR_WANT_READ) {
+                        if (!wait_io(POLLIN, deadline)) return false;
+                        continue;
+                    }
+                    if (err == SSL_ERROR_WANT_WRITE) {
+                        if (!wait_io(POLLOUT, deadline)) return false;
+                        continue;
+                    }
+                    return false;
+                }
+            } else {
+                n = ::send(fd, buf + sent, len - sent, MSG_NOSIGNAL);
+                if (n < 0) {
+                    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                        if (!wait_io(POLLOUT, deadline)) return false;
+                        continue;
+                    }
+                    if (errno == EINTR) continue;
+                    return false;
+                }
+            }
+            sent += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    // An idle keep-alive connection is dead if the peer closed it (or
+    // sent stray bytes) while it sat in the pool
+    bool still_alive() const {
+        pollfd pfd{fd, POLLIN, 0};
+        return ::poll(&pfd, 1, 0) == 0;
+    }
+};
+
+HttpClient::HttpClient() {
+    ssl_ctx_ = SSL_CTX_new(TLS_client_method());
+    if (ssl_ctx_) {
+        SSL_CTX_set_default_verify_paths(ssl_ctx_);
+        SSL_CTX_set_verify(ssl_ctx_, SSL_VERIFY_PEER, nullptr);
+        SSL_CTX_set_min_proto_version(ssl_ctx_, TLS1_2_VERSION);
+    } else {
+        spdlog::error("HttpClient: failed to create SSL context, HTTPS disabled");
+    }
+}
+
+HttpClient::~HttpClient() {
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        pool_.clear();
+    }
+    if (ssl_ctx_) {
+        SSL_CTX_free(ssl_ctx_);
+    }
+}
+
+HttpClient& HttpClient::instance() {
+    static HttpClient client;
+    return client;
+}
+
+std::optional<HttpClient::ParsedUrl> HttpClient::parse_url(const std::string& url) {
+    ParsedUrl parsed;
+    std::string rest;
+    if (url.rfind("https://", 0) == 0) {
+        parsed.tls = true;
+        parsed.port = 443;
+        rest = url.substr(8);
+    } else if (url.rfind("http://", 0) == 0) {
+        parsed.tls = false;
+        parsed.port = 80;
+        rest = url.substr(7);
+    } else {
+        return std::nullopt;
+    }
+
+    size_t slash = rest.find('/');
+    std::string authority = rest.substr(0, slash);
+    parsed.target = (slash == std::string::npos) ? "/" : rest.substr(slash);
+
+    size_t colon = authority.rfind(':');
+    if (colon != std::string::npos) {
+        parsed.host = authority.substr(0, colon);
+        try {
+            parsed.port = static_cast<uint16_t>(std::stoi(authority.substr(colon + 1)));
+        } catch (...) {
+            return std::nullopt;
+        }
+    } else {
+        parsed.host = authority;
+    }
+
+    if (parsed.host.empty()) {
+        return std::nullopt;
+    }
+
+    parsed.pool_key = parsed.host + ":" + std::to_string(parsed.port) +
+                      (parsed.tls ? ":tls" : ":tcp");
+    return parsed;
+}
+
+std::unique_ptr<HttpClient::Connection> HttpClient::dial(
+        const ParsedUrl& url, int timeout_secs, std::string& error) {
+    auto deadline = Clock::now() + std::chrono::seconds(timeout_secs);
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addrs = nullptr;
+    std::string port_str = std::to_string(url.port);
+    int rc = ::getaddrinfo(url.host.c_str(), port_str.c_str(), &hints, &addrs);
+    if (rc != 0) {
+        error = "DNS resolution failed for " + url.host + ": " + gai_strerror(rc);
+        return nullptr;
+    }
+
+    auto conn = std::make_unique<Connection>();
+    for (addrinfo* ai = addrs; ai; ai = ai->ai_next) {
+        int fd = ::socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                          ai->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+
+        if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+            conn->fd = fd;
+            break;
+        }
+        if (errno == EINPROGRESS) {
+            pollfd pfd{fd, POLLOUT, 0};
+            if (::poll(&pfd, 1, remaining_ms(deadline)) > 0) {
+                int so_error = 0;
+                socklen_t len = sizeof(so_error);
+                ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &so_error, &len);
+                if (so_error == 0) {
+                    conn->fd = fd;
+                    break;
+                }
+            }
+        }
+        ::close(fd);
+    }
+    ::freeaddrinfo(addrs);
+
+    if (conn->fd < 0) {
+        error = "connection to " + url.host + ":" + port_str + " failed";
+        return nullptr;
+    }
+
+    if (url.tls) {
+        if (!ssl_ctx_) {
+            error = "HTTPS unavailable: no SSL context";
+            return nullptr;
+        }
+        conn->ssl = SSL_new(ssl_ctx_);
+        if (!conn->ssl) {
+            error = "SSL_new failed";
+            return nullptr;
+        }
+        SSL_set_fd(conn->ssl, conn->fd);
+        SSL_set_tlsext_host_name(conn->ssl, url.host.c_str());
+        SSL_set1_host(conn->ssl, url.host.c_str());
+
+        while (true) {
+            int ret = SSL_connect(conn->ssl);
+            if (ret == 1) {
+                break;
+            }
+            int err = SSL_get_error(conn->ssl, ret);
+            bool waited = false;
+            if (err == SSL_ERROR_WANT_READ) {
+                waited = conn->wait_io(POLLIN, deadline);
+            } else if (err == SSL_ERROR_WANT_WRITE) {
+                waited = conn->wait_io(POLLOUT, deadline);
+            }
+            if (!waited) {
+                error = "TLS handshake with " + url.host + " failed";
+                return nullptr;
+            }
+        }
+    }
+
+    return conn;
+}
+
+std::unique_ptr<HttpClient::Connection> HttpClient::acquire(
+        const ParsedUrl& url, int timeout_secs, std::string& error) {
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        auto it = pool_.find(url.pool_key);
+        if (it != pool_.end()) {
+            auto& idle = it->second;
+            while (!idle.empty()) {
+                auto conn = std::move(idle.back());
+                idle.pop_back();
+                if (conn->still_alive()) {
+                    return conn;
+                }
+            }
+        }
+    }
+    return dial(url, timeout_secs, error);
+}
+
+void HttpClient::release(const std::string& pool_key, std::unique_ptr<Connection> conn) {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    auto& idle = pool_[pool_key];
+    if (idle.size() < MAX_IDLE_PER_HOST) {
+        idle.push_back(std::move(conn));
+    }
+}
+
+HttpResponse HttpClient::request(const HttpRequest& req) {
+    return request(req, nullptr);
+}
+
+HttpResponse HttpClient::request(const HttpRequest& req, const BodyChunkFn& on_chunk) {
+    HttpResponse resp;
+
+    auto url = parse_url(req.url);
+    if (!url) {
+        resp.error = "invalid URL: " + req.url;
+        return resp;
+    }
+
+    auto deadline = Clock::now() + std::chrono::seconds(req.timeout_secs);
+    auto conn = acquire(*url, req.timeout_secs, resp.error);
+    if (!conn) {
+        return resp;
+    }
+
+    // Build the request; our own Host/Connection/Content-Length win over
+    // any caller-supplied duplicates
+    std::string wire = req.method + " " + url->target + " HTTP/1.1\r\n";
+    wire += "Host: " + url->host + "\r\n";
+    wire += "Connection: keep-alive\r\n";
+    for (const auto& [key, value] : req.headers) {
+        std::string lower = lowercase(key);
+        if (lower == "host" || lower == "connection" || lower == "content-length") {
+            continue;
+        }
+        wire += key + ": " + value + "\r\n";
+    }
+    if (!req.body.empty() || req.method == "POST" || req.method == "PUT" ||
+        req.method == "PATCH") {
+        wire += "Content-Length: " + std::to_string(req.body.size()) + "\r\n";
+    }
+    wire += "\r\n";
+    wire += req.body;
+
+    if (!conn->write_all(wire.data(), wire.size(), deadline)) {
+        // A pooled connection may have died between the liveness check
+        // and the write; retry once on a fresh one
+        conn = dial(*url, req.timeout_secs, resp.error);
+        if (!conn || !conn->write_all(wire.data(), wire.size(), deadline)) {
+            if (resp.error.empty()) {
+                resp.error = "failed to send request";
+            }
+            return resp;
+        }
+    }
+
+    // Read headers
+    std::string raw;
+    size_t header_end;
+    char buf[8192];
+    while ((header_end = raw.find("\r\n\r\n")) == std::string::npos) {
+        ssize_t n = conn->read_some(buf, sizeof(buf), deadline);
+        if (n <= 0) {
+            resp.error = n == 0 ? "connection closed before response"
+                                : "timed out reading response";
+            return resp;
+        }
+        raw.append(buf, static_cast<size_t>(n));
+        if (raw.size() > 1 << 20) {
+            resp.error = "response headers too large";
+            return resp;
+        }
+    }
+
+    std::string head = raw.substr(0, header_end);
+    std::string body = raw.substr(header_end + 4);
+
+    // Status line: "HTTP/1.1 200 OK"
+    size_t line_end = head.find("\r\n");
+    std::string status_line = head.substr(0, line_end);
+    size_t sp = status_line.find(' ');
+    if (sp == std::string::npos || status_line.rfind("HTTP/", 0) != 0) {
+        resp.error = "malformed status line";
+        return resp;
+    }
+    resp.status_code = std::atoi(status_line.c_str() + sp + 1);
+
+    size_t pos = (line_end == std::string::npos) ? head.size() : line_end + 2;
+    while (pos < head.size()) {
+        size_t eol = head.find("\r\n", pos);
+        std::string line = head.substr(pos, eol == std::string::npos ? std::string::npos
+                                                                     : eol - pos);
+        pos = (eol == std::string::npos) ? head.size() : eol + 2;
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+        std::string key = lowercase(line.substr(0, colon));
+        size_t vstart = line.find_first_not_of(' ', colon + 1);
+        resp.headers[key] = (vstart == std::string::npos) ? "" : line.substr(vstart);
+    }
+
+    bool reusable = resp.headers.count("connection") == 0 ||
+                    lowercase(resp.headers["connection"]) != "close";
+
+    // Body framing: chunked, Content-Length, or read-to-close
+    if (resp.headers.count("transfer-encoding") &&
+        lowercase(resp.headers["transfer-encoding"]).find("chunked") != std::string::npos) {
+        std::string decoded;
+        while (true) {
+            size_t eol;
+            while ((eol = body.find("\r\n")) == std::string::npos) {
+                ssize_t n = conn->read_some(buf, sizeof(buf), deadline);
+                if (n <= 0) {
+                    resp.error = "truncated chunked response";
+                    return resp;
+                }
+                body.append(buf, static_cast<size_t>(n));
+            }
+            size_t chunk_len = std::strtoul(body.substr(0, eol).c_str(), nullptr, 16);
+            body.erase(0, eol + 2);
+            if (chunk_len == 0) {
+                // Consume (and ignore) any trailers up to the final CRLF
+                // so the connection is clean for reuse
+                while (true) {
+                    size_t teol = body.find("\r\n");
+                    if (teol == std::string::npos) {
+                        ssize_t n = conn->read_some(buf, sizeof(buf), deadline);
+                        if (n <= 0) {
+                            reusable = false;
+                            break;
+                        }
+                        body.append(buf, static_cast<size_t>(n));
+                        continue;
+                    }
+                    bool last = (teol == 0);
+                    body.erase(0, teol + 2);
+                    if (last) {
+                        break;
+                    }
+                }
+                break;
+            }
+            while (body.size() < chunk_len + 2) {
+                ssize_t n = conn->read_some(buf, sizeof(buf), deadline);
+                if (n <= 0) {
+                    resp.error = "truncated chunked response";
+                    return resp;
+                }
+                body.append(buf, static_cast<size_t>(n));
+            }
+            if (on_chunk) {
+                on_chunk(body.data(), chunk_len);
+            } else {
+                decoded.append(body, 0, chunk_len);
+            }
+            body.erase(0, chunk_len + 2);
+        }
+        resp.body = std::move(decoded);
+    } else if (resp.headers.count("content-length")) {
+        size_t want = std::strtoul(resp.headers["content-length"].c_str(), nullptr, 10);
+        size_t got = std::min(body.size(), want);
+        if (on_chunk && got > 0) {
+            on_chunk(body.data(), got);
+        }
+        while (got < want) {
+            ssize_t n = conn->read_some(buf, sizeof(buf), deadline);
+            if (n <= 0) {
+                resp.error = "truncated response body";
+                return resp;
+            }
+            size_t take = std::min(static_cast<size_t>(n), want - got);
+            if (on_chunk) {
+                on_chunk(buf, take);
+            } else {
+                body.append(buf, take);
+            }
+            got += take;
+        }
+        if (!on_chunk) {
+            body.resize(want);
+            resp.body = std::move(body);
+        }
+    } else {
+        // No framing: the server will close the connection when done
+        reusable = false;
+        if (on_chunk && !body.empty()) {
+            on_chunk(body.data(), body.size());
+            body.clear();
+        }
+        ssize_t n;
+        while ((n = conn->read_some(buf, sizeof(buf), deadline)) > 0) {
+            if (on_chunk) {
+                on_chunk(buf, static_cast<size_t>(n));
+            } else {
+                body.append(buf, static_cast<size_t>(n));
+            }
+        }
+        resp.body = std::move(body);
+    }
+
+    resp.success = true;
+    if (reusable) {
+        release(url->pool_key, std::move(conn));
+    }
+    return resp;
+}
+
+} // namespace clove::services::http
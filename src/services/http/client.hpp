@@ -0,0 +1,92 @@
+/**
+ * Clove HTTP Client
+ *
+ * In-process HTTP/1.1 client with a keep-alive connection pool keyed by
+ * host. Replaces the old popen("curl ...") path: no fork/exec per
+ * request, and repeat calls to the same API reuse an established (and
+ * TLS-handshaken) connection. Requests run with poll()-based deadlines,
+ * so callers block only up to their own timeout, never indefinitely.
+ */
+#pragma once
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+typedef struct ssl_ctx_st SSL_CTX;
+
+namespace clove::services::http {
+
+struct HttpRequest {
+    std::string method = "GET";
+    std::string url;
+    std::map<std::string, std::string> headers;
+    std::string body;
+    int timeout_secs = 30;
+};
+
+struct HttpResponse {
+    bool success = false;       // transport-level success (got a response)
+    int status_code = 0;
+    std::string body;
+    std::map<std::string, std::string> headers; // keys lowercased
+    std::string error;
+};
+
+class HttpClient {
+public:
+    HttpClient();
+    ~HttpClient();
+
+    HttpClient(const HttpClient&) = delete;
+    HttpClient& operator=(const HttpClient&) = delete;
+
+    // Process-wide client so every syscall shares one pool
+    static HttpClient& instance();
+
+    // Body bytes delivered as they arrive (after de-chunking); used for
+    // server-sent-event streams
+    using BodyChunkFn = std::function<void(const char* data, size_t len)>;
+
+    HttpResponse request(const HttpRequest& req);
+
+    // Streaming variant: body bytes go to on_chunk instead of
+    // HttpResponse::body, which stays empty. Status and headers are
+    // still returned once the response completes.
+    HttpResponse request(const HttpRequest& req, const BodyChunkFn& on_chunk);
+
+private:
+    struct Connection;
+
+    struct ParsedUrl {
+        bool tls = false;
+        std::string host;
+        uint16_t port = 80;
+        std::string target;     // path + query, always starts with '/'
+        std::string pool_key;   // "host:port:tls"
+    };
+
+    static std::optional<ParsedUrl> parse_url(const std::string& url);
+
+    // Pool checkout: reuses an idle connection to the same host if it is
+    // still alive, otherwise dials a new one. Returns nullptr with
+    // `error` set on connect/handshake failure.
+    std::unique_ptr<Connection> acquire(const ParsedUrl& url, int timeout_secs,
+                                        std::string& error);
+    void release(const std::string& pool_key, std::unique_ptr<Connection> conn);
+
+    std::unique_ptr<Connection> dial(const ParsedUrl& url, int timeout_secs,
+                                     std::string& error);
+
+    SSL_CTX* ssl_ctx_ = nullptr;
+    std::mutex pool_mutex_;
+    std::unordered_map<std::string, std::vector<std::unique_ptr<Connection>>> pool_;
+
+    static constexpr size_t MAX_IDLE_PER_HOST = 4;
+};
+
+} // namespace clove::services::http
@@ -1,20 +1,137 @@
 #include "services/llm/client.hpp"
-#include "core/paths.hpp"
+#include "services/http/client.hpp"
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
-#include <sys/types.h>
-#include <sys/wait.h>
-#include <unistd.h>
-#include <fcntl.h>
-#include <signal.h>
-#include <filesystem>
-#include <cstring>
-
-namespace fs = std::filesystem;
+#include <cstdlib>
+
 using json = nlohmann::json;
 
 namespace clove::services::llm {
 
+namespace {
+
+constexpr const char* GEMINI_BASE =
+    "https://generativelanguage.googleapis.com/v1beta/models/";
+
+// Translate the SYS_THINK request schema into a generateContent body
+json build_gemini_body(const json& request) {
+    json body;
+
+    json parts = json::array();
+    std::string prompt = request.value("prompt", "");
+    if (!prompt.empty()) {
+        parts.push_back({{"text", prompt}});
+    }
+    if (request.contains("image") && request["image"].is_object()) {
+        parts.push_back({{"inline_data", {
+            {"mime_type", request["image"].value("mime_type", "image/jpeg")},
+            {"data", request["image"].value("data", "")}
+        }}});
+    }
+    body["contents"] = json::array({{{"parts", parts}}});
+
+    json gen_config;
+    if (request.contains("temperature")) {
+        gen_config["temperature"] = request["temperature"];
+    }
+    if (request.contains("max_tokens")) {
+        gen_config["maxOutputTokens"] = request["max_tokens"];
+    }
+    if (!gen_config.empty()) {
+        body["generationConfig"] = gen_config;
+    }
+
+    // Request fields come straight off the wire, so a wrong type must
+    // degrade (the provider rejects what it dislikes), never throw —
+    // this runs on a queue worker with no enclosing handler
+    if (request.contains("system_instruction")) {
+        const json& instruction = request["system_instruction"];
+        body["systemInstruction"] = {
+            {"parts", json::array({{{"text",
+                instruction.is_string() ? instruction.get<std::string>()
+                                        : instruction.dump()}}})}
+        };
+    }
+
+    if (request.contains("tools") && request["tools"].is_array() && !request["tools"].empty()) {
+        json declarations = json::array();
+        for (const auto& tool : request["tools"]) {
+            if (!tool.is_object()) {
+                continue;
+            }
+            json decl;
+            decl["name"] = tool.value("name", "");
+            decl["description"] = tool.value("description", "");
+            if (tool.contains("parameters")) {
+                decl["parameters"] = tool["parameters"];
+            }
+            declarations.push_back(std::move(decl));
+        }
+        body["tools"] = json::array({{{"functionDeclarations", declarations}}});
+    }
+
+    return body;
+}
+
+// value("timeout", n) throws on a non-numeric field; tolerate it
+int timeout_or(const json& request, int fallback) {
+    auto it = request.find("timeout");
+    return it != request.end() && it->is_number() ? it->get<int>() : fallback;
+}
+
+LLMResponse parse_gemini_response(const http::HttpResponse& http_response) {
+    LLMResponse result;
+
+    json j = json::parse(http_response.body, nullptr, false);
+    if (j.is_discarded()) {
+        result.error = "invalid response from provider";
+        return result;
+    }
+
+    if (http_response.status_code < 200 || http_response.status_code >= 300) {
+        result.error = "provider returned HTTP " + std::to_string(http_response.status_code);
+        if (j.contains("error") && j["error"].is_object()) {
+            result.error += ": " + j["error"].value("message", "");
+        }
+        return result;
+    }
+
+    // Concatenate text parts; surface function calls as serialized JSON
+    // the same way the old subprocess wrapper did
+    std::string content;
+    json function_calls = json::array();
+    if (j.contains("candidates") && j["candidates"].is_array()) {
+        for (const auto& candidate : j["candidates"]) {
+            if (!candidate.contains("content")) continue;
+            const auto& parts = candidate["content"].value("parts", json::array());
+            for (const auto& part : parts) {
+                if (part.contains("text")) {
+                    content += part["text"].get<std::string>();
+                }
+                if (part.contains("functionCall")) {
+                    function_calls.push_back({
+                        {"name", part["functionCall"].value("name", "")},
+                        {"arguments", part["functionCall"].value("args", json::object())}
+                    });
+                }
+            }
+        }
+    }
+
+    if (content.empty() && !function_calls.empty()) {
+        content = json({{"function_calls", function_calls}}).dump();
+    }
+
+    result.success = true;
+    result.content = std::move(content);
+    if (j.contains("usageMetadata")) {
+        result.tokens_used = j["usageMetadata"].value("totalTokenCount", 0u);
+    }
+    return result;
+}
+
+} // namespace
+
 LLMClient::LLMClient(const LLMConfig& config)
     : config_(config) {
     if (config_.api_key.empty()) {
@@ -25,9 +142,7 @@ LLMClient::LLMClient(const LLMConfig& config)
     }
 }
 
-LLMClient::~LLMClient() {
-    stop_subprocess();
-}
+LLMClient::~LLMClient() = default;
 
 bool LLMClient::is_configured() const {
     return !config_.api_key.empty();
@@ -46,138 +161,116 @@ std::string LLMClient::get_model_from_env() {
     return model ? std::string(model) : "";
 }
 
-bool LLMClient::start_subprocess() {
-    if (subprocess_pid_ > 0) {
-        return true;
-    }
-
-    auto script_path = clove::core::paths::find_relative("agents/llm_service/llm_service.py");
-    if (!script_path || !fs::exists(*script_path)) {
-        spdlog::error("Could not find agents/llm_service/llm_service.py");
-        return false;
-    }
-
-    int stdin_pipe[2];
-    int stdout_pipe[2];
-    if (pipe(stdin_pipe) < 0 || pipe(stdout_pipe) < 0) {
-        spdlog::error("Failed to create pipes for LLM subprocess");
-        return false;
+LLMResponse LLMClient::complete_with_options(const std::string& json_payload) {
+    if (!is_configured()) {
+        return {false, "", 0, "LLM not configured (set GEMINI_API_KEY)"};
     }
 
-    pid_t pid = fork();
-    if (pid < 0) {
-        spdlog::error("Failed to fork LLM subprocess");
-        close(stdin_pipe[0]);
-        close(stdin_pipe[1]);
-        close(stdout_pipe[0]);
-        close(stdout_pipe[1]);
-        return false;
+    json request = json::parse(json_payload, nullptr, false);
+    if (request.is_discarded()) {
+        request = json::object();
     }
 
-    if (pid == 0) {
-        close(stdin_pipe[1]);
-        close(stdout_pipe[0]);
+    std::string model = request.value("model", config_.model);
 
-        dup2(stdin_pipe[0], STDIN_FILENO);
-        dup2(stdout_pipe[1], STDOUT_FILENO);
+    http::HttpRequest http_request;
+    http_request.method = "POST";
+    http_request.url = std::string(GEMINI_BASE) + model + ":generateContent";
+    http_request.headers["Content-Type"] = "application/json";
+    http_request.headers["x-goog-api-key"] = config_.api_key;
+    http_request.body = build_gemini_body(request).dump();
+    http_request.timeout_secs = timeout_or(request, 120);
 
-        close(stdin_pipe[0]);
-        close(stdout_pipe[1]);
-
-        if (!config_.api_key.empty()) {
-            setenv("GEMINI_API_KEY", config_.api_key.c_str(), 1);
-        }
-        if (!config_.model.empty()) {
-            setenv("GEMINI_MODEL", config_.model.c_str(), 1);
-        }
-
-        execlp("python3", "python3", script_path->c_str(), nullptr);
-        _exit(1);
+    auto http_response = http::HttpClient::instance().request(http_request);
+    if (!http_response.success) {
+        spdlog::warn("LLM request failed: {}", http_response.error);
+        return {false, "", 0, http_response.error};
     }
 
-    close(stdin_pipe[0]);
-    close(stdout_pipe[1]);
-
-    subprocess_pid_ = pid;
-    stdin_fd_ = stdin_pipe[1];
-    stdout_fd_ = stdout_pipe[0];
-
-    return true;
+    return parse_gemini_response(http_response);
 }
 
-void LLMClient::stop_subprocess() {
-    if (subprocess_pid_ <= 0) {
-        return;
+LLMResponse LLMClient::complete_streaming(const std::string& json_payload,
+                                          const std::function<void(const std::string&)>& on_delta) {
+    if (!is_configured()) {
+        return {false, "", 0, "LLM not configured (set GEMINI_API_KEY)"};
     }
 
-    kill(subprocess_pid_, SIGTERM);
-    int status = 0;
-    waitpid(subprocess_pid_, &status, 0);
+    json request = json::parse(json_payload, nullptr, false);
+    if (request.is_discarded()) {
+        request = json::object();
+    }
 
-    if (stdin_fd_ >= 0) close(stdin_fd_);
-    if (stdout_fd_ >= 0) close(stdout_fd_);
+    std::string model = request.value("model", config_.model);
 
-    subprocess_pid_ = -1;
-    stdin_fd_ = -1;
-    stdout_fd_ = -1;
-}
+    http::HttpRequest http_request;
+    http_request.method = "POST";
+    http_request.url = std::string(GEMINI_BASE) + model + ":streamGenerateContent?alt=sse";
+    http_request.headers["Content-Type"] = "application/json";
+    http_request.headers["x-goog-api-key"] = config_.api_key;
+    http_request.body = build_gemini_body(request).dump();
+    http_request.timeout_secs = timeout_or(request, 300);
 
-LLMResponse LLMClient::parse_subprocess_response(const std::string& response_json) {
+    // Each SSE event is one "data: {json}" line carrying a partial
+    // generateContent response; text parts are forwarded the moment the
+    // line completes, usage arrives with the final event
     LLMResponse result;
-    try {
-        auto j = json::parse(response_json);
-        result.success = j.value("success", false);
-        result.content = j.value("content", "");
-        result.tokens_used = j.value("tokens", 0);
-        result.error = j.value("error", "");
-    } catch (const std::exception& e) {
-        result.success = false;
-        result.error = std::string("invalid response: ") + e.what();
-    }
-    return result;
-}
-
-LLMResponse LLMClient::call_subprocess(const std::string& request_json) {
-    if (!start_subprocess()) {
-        return {false, "", 0, "LLM subprocess unavailable"};
-    }
-
-    std::string line = request_json;
-    if (line.empty() || line.back() != '\n') {
-        line.push_back('\n');
-    }
+    std::string sse_buf;
+    std::string error_body;
+    auto on_chunk = [&](const char* data, size_t len) {
+        sse_buf.append(data, len);
+        size_t eol;
+        while ((eol = sse_buf.find('\n')) != std::string::npos) {
+            std::string line = sse_buf.substr(0, eol);
+            sse_buf.erase(0, eol + 1);
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.rfind("data: ", 0) != 0) {
+                continue;
+            }
+            json event = json::parse(line.substr(6), nullptr, false);
+            if (event.is_discarded()) {
+                continue;
+            }
+            if (event.contains("candidates") && event["candidates"].is_array()) {
+                for (const auto& candidate : event["candidates"]) {
+                    if (!candidate.contains("content")) continue;
+                    for (const auto& part : candidate["content"].value("parts", json::array())) {
+                        if (part.contains("text")) {
+                            std::string delta = part["text"].get<std::string>();
+                            result.content += delta;
+                            if (on_delta && !delta.empty()) {
+                                on_delta(delta);
+                            }
+                        }
+                    }
+                }
+            }
+            if (event.contains("usageMetadata")) {
+                result.tokens_used = event["usageMetadata"].value("totalTokenCount", 0u);
+            }
+            if (event.contains("error")) {
+                error_body = event["error"].value("message", "provider error");
+            }
+        }
+    };
 
-    ssize_t wrote = write(stdin_fd_, line.data(), line.size());
-    if (wrote < 0) {
-        return {false, "", 0, "failed to write to LLM subprocess"};
+    auto http_response = http::HttpClient::instance().request(http_request, on_chunk);
+    if (!http_response.success) {
+        spdlog::warn("LLM stream failed: {}", http_response.error);
+        return {false, "", 0, http_response.error};
     }
-
-    std::string response;
-    char buf[4096];
-    while (true) {
-        ssize_t n = read(stdout_fd_, buf, sizeof(buf));
-        if (n <= 0) {
-            break;
-        }
-        response.append(buf, buf + n);
-        if (response.find('\n') != std::string::npos) {
-            break;
+    if (http_response.status_code < 200 || http_response.status_code >= 300) {
+        std::string error = "provider returned HTTP " + std::to_string(http_response.status_code);
+        if (!error_body.empty()) {
+            error += ": " + error_body;
         }
+        return {false, "", 0, error};
     }
 
-    auto newline = response.find('\n');
-    if (newline != std::string::npos) {
-        response = response.substr(0, newline);
-    }
-
-    return parse_subprocess_response(response);
-}
-
-LLMResponse LLMClient::complete_with_options(const std::string& json_payload) {
-    if (!is_configured()) {
-        return {false, "", 0, "LLM not configured (set GEMINI_API_KEY)"};
-    }
-    return call_subprocess(json_payload);
+    result.success = true;
+    return result;
 }
 
 } // namespace clove::services::llm
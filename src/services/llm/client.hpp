@@ -1,7 +1,8 @@
 #pragma once
+#include <cstdint>
+#include <functional>
 #include <string>
-#include <vector>
-#include<cstdint>
+
 namespace clove::services::llm {
 
 struct LLMConfig {
@@ -16,6 +17,10 @@ struct LLMResponse {
     std::string error;
 };
 
+// Gemini completion client. Calls the generateContent REST endpoint
+// directly over the kernel's pooled HTTP client, so the TLS connection
+// stays warm across requests — no subprocess, no pipe copies, no
+// per-call handshake.
 class LLMClient {
 public:
     explicit LLMClient(const LLMConfig& config);
@@ -27,18 +32,18 @@ public:
     bool is_configured() const;
     const LLMConfig& config() const { return config_; }
 
+    // json_payload uses the SYS_THINK request schema: prompt, model,
+    // temperature, max_tokens, system_instruction, tools, image
     LLMResponse complete_with_options(const std::string& json_payload);
 
+    // Streaming variant: text deltas are delivered through on_delta as
+    // the provider produces them (streamGenerateContent over SSE); the
+    // returned response carries the assembled content and token count
+    LLMResponse complete_streaming(const std::string& json_payload,
+                                   const std::function<void(const std::string&)>& on_delta);
+
 private:
     LLMConfig config_;
-    pid_t subprocess_pid_ = -1;
-    int stdin_fd_ = -1;
-    int stdout_fd_ = -1;
-
-    bool start_subprocess();
-    void stop_subprocess();
-    LLMResponse call_subprocess(const std::string& request_json);
-    LLMResponse parse_subprocess_response(const std::string& response_json);
 
     static std::string get_api_key_from_env();
     static std::string get_model_from_env();
@@ -1,200 +1,155 @@
 #include "services/tunnel/client.hpp"
-#include "core/paths.hpp"
 #include <spdlog/spdlog.h>
-#include <sys/types.h>
-#include <sys/wait.h>
-#include <unistd.h>
-#include <fcntl.h>
-#include <signal.h>
-#include <poll.h>
-#include <cstring>
+#include <zlib.h>
+#include <algorithm>
 #include <chrono>
-#include <filesystem>
 
-namespace fs = std::filesystem;
 using json = nlohmann::json;
 
 namespace clove::services::tunnel {
 
-TunnelClient::TunnelClient() = default;
+namespace {
 
-TunnelClient::~TunnelClient() {
-    shutdown();
-}
+std::string base64_encode(const std::vector<uint8_t>& data) {
+    static const char base64_chars[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-bool TunnelClient::init(const std::string& scripts_dir) {
-    if (running_) {
-        return true;
-    }
+    std::string out;
+    out.reserve(((data.size() + 2) / 3) * 4);
+    for (size_t i = 0; i < data.size(); i += 3) {
+        uint32_t n = (static_cast<uint32_t>(data[i]) << 16);
+        if (i + 1 < data.size()) n |= (static_cast<uint32_t>(data[i + 1]) << 8);
+        if (i + 2 < data.size()) n |= static_cast<uint32_t>(data[i + 2]);
 
-    std::string dir = scripts_dir;
-    if (dir.empty()) {
-        auto script_path = clove::core::paths::find_relative("scripts/tunnel_client.py");
-        if (script_path) {
-            dir = script_path->parent_path().string();
-        }
+        out += base64_chars[(n >> 18) & 0x3F];
+        out += base64_chars[(n >> 12) & 0x3F];
+        out += (i + 1 < data.size()) ? base64_chars[(n >> 6) & 0x3F] : '=';
+        out += (i + 2 < data.size()) ? base64_chars[n & 0x3F] : '=';
     }
+    return out;
+}
 
-    if (dir.empty()) {
-        spdlog::warn("Could not find tunnel_client.py - tunnel disabled");
-        return false;
-    }
+std::vector<uint8_t> base64_decode(const std::string& encoded) {
+    static const std::string base64_chars =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-    return spawn_subprocess(dir);
-}
+    std::vector<uint8_t> out;
+    out.reserve(encoded.size() * 3 / 4);
+    uint32_t val = 0;
+    int bits = -8;
 
-bool TunnelClient::spawn_subprocess(const std::string& scripts_dir) {
-    std::string script_path = scripts_dir + "/tunnel_client.py";
+    for (char c : encoded) {
+        if (c == '=') break;
+        auto pos = base64_chars.find(c);
+        if (pos == std::string::npos) continue;
 
-    if (!fs::exists(script_path)) {
-        spdlog::error("Tunnel client script not found: {}", script_path);
-        return false;
-    }
+        val = (val << 6) | static_cast<uint32_t>(pos);
+        bits += 6;
 
-    // Create pipes for stdin/stdout
-    int stdin_pipe[2];
-    int stdout_pipe[2];
+        if (bits >= 0) {
+            out.push_back((val >> bits) & 0xFF);
+            bits -= 8;
+        }
+    }
+    return out;
+}
 
-    if (pipe(stdin_pipe) < 0 || pipe(stdout_pipe) < 0) {
-        spdlog::error("Failed to create pipes for tunnel subprocess");
-        return false;
+std::vector<uint8_t> deflate_bytes(const std::vector<uint8_t>& in) {
+    uLongf bound = compressBound(in.size());
+    std::vector<uint8_t> out(bound);
+    if (compress2(out.data(), &bound, in.data(), in.size(),
+                  Z_DEFAULT_COMPRESSION) != Z_OK) {
+        return {};
     }
+    out.resize(bound);
+    return out;
+}
 
-    pid_t pid = fork();
-    if (pid < 0) {
-        spdlog::error("Failed to fork tunnel subprocess");
-        close(stdin_pipe[0]);
-        close(stdin_pipe[1]);
-        close(stdout_pipe[0]);
-        close(stdout_pipe[1]);
+bool inflate_bytes(const std::vector<uint8_t>& in, size_t raw_len,
+                   std::vector<uint8_t>& out) {
+    if (raw_len > (64ull << 20)) {
+        return false;  // refuse pathological raw_len claims
+    }
+    out.resize(raw_len);
+    uLongf len = raw_len;
+    if (uncompress(out.data(), &len, in.data(), in.size()) != Z_OK ||
+        len != raw_len) {
         return false;
     }
+    return true;
+}
 
-    if (pid == 0) {
-        // Child process
-        close(stdin_pipe[1]);   // Close write end of stdin
-        close(stdout_pipe[0]);  // Close read end of stdout
+} // namespace
 
-        // Redirect stdin/stdout
-        dup2(stdin_pipe[0], STDIN_FILENO);
-        dup2(stdout_pipe[1], STDOUT_FILENO);
+TunnelClient::TunnelClient() = default;
 
-        close(stdin_pipe[0]);
-        close(stdout_pipe[1]);
+TunnelClient::~TunnelClient() {
+    shutdown();
+}
 
-        // Execute Python script
-        execlp("python3", "python3", script_path.c_str(), nullptr);
+bool TunnelClient::init(const std::string& scripts_dir) {
+    (void)scripts_dir;  // legacy parameter from the subprocess bridge
 
-        // If exec fails
-        _exit(1);
+    if (running_) {
+        return true;
     }
 
-    // Parent process
-    close(stdin_pipe[0]);   // Close read end of stdin
-    close(stdout_pipe[1]);  // Close write end of stdout
-
-    subprocess_pid_ = pid;
-    stdin_fd_ = stdin_pipe[1];
-    stdout_fd_ = stdout_pipe[0];
-
-    // Set stdout to non-blocking for polling
-    int flags = fcntl(stdout_fd_, F_GETFL, 0);
-    fcntl(stdout_fd_, F_SETFL, flags | O_NONBLOCK);
-
     running_ = true;
-
-    // Start reader thread
     reader_thread_ = std::thread(&TunnelClient::reader_loop, this);
-
-    // Wait for ready event
-    auto start = std::chrono::steady_clock::now();
-    while (running_) {
-        auto events = poll_events();
-        for (const auto& ev : events) {
-            if (ev.type == TunnelEvent::Type::ERROR) {
-                spdlog::info("Tunnel client ready");
-                return true;
-            }
-        }
-
-        auto elapsed = std::chrono::steady_clock::now() - start;
-        if (elapsed > std::chrono::seconds(5)) {
-            spdlog::warn("Timeout waiting for tunnel client ready");
-            break;
-        }
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
-
-    spdlog::info("Tunnel client subprocess started (pid={})", subprocess_pid_);
+    sender_thread_ = std::thread(&TunnelClient::sender_loop, this);
     return true;
 }
 
 bool TunnelClient::configure(const TunnelConfig& config) {
     config_ = config;
-
-    json request;
-    request["id"] = next_request_id_++;
-    request["method"] = "configure";
-    request["params"] = {
-        {"relay_url", config.relay_url},
-        {"machine_id", config.machine_id},
-        {"token", config.token},
-        {"reconnect_interval", config.reconnect_interval}
-    };
-
-    auto response = send_request_and_wait(request);
-    if (!response) {
-        return false;
-    }
-
-    return response->value("result", json{}).value("success", false);
+    return true;
 }
 
 bool TunnelClient::connect() {
     if (!running_) {
         return false;
     }
-
-    json request;
-    request["id"] = next_request_id_++;
-    request["method"] = "connect";
-    request["params"] = json::object();
-
-    auto response = send_request_and_wait(request, 30000);  // 30s timeout
-    if (!response) {
+    if (config_.relay_url.empty()) {
+        spdlog::error("Tunnel connect failed: no relay URL configured");
         return false;
     }
 
-    if (response->value("result", json{}).value("success", false)) {
-        connected_ = true;
-        spdlog::info("Tunnel connected to {}", config_.relay_url);
-        return true;
+    want_connection_ = true;
+
+    // The reader thread owns the socket's receive side, so it performs
+    // the actual dial; wait here for it to report an outcome.
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (connected_) {
+            return true;
+        }
+        if (!want_connection_) {
+            break;  // establish() gave up (e.g. auth rejected)
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
     }
 
-    auto error = response->value("error", json{}).value("message", "Unknown error");
-    spdlog::error("Tunnel connect failed: {}", error);
-    return false;
+    if (!last_error_.empty()) {
+        spdlog::error("Tunnel connect failed: {}", last_error_);
+    }
+    return connected_;
 }
 
 void TunnelClient::disconnect() {
-    if (!running_) {
-        return;
-    }
-
-    json request;
-    request["id"] = next_request_id_++;
-    request["method"] = "disconnect";
-    request["params"] = json::object();
-
-    send_request_and_wait(request);
+    want_connection_ = false;
     connected_ = false;
+    compression_active_ = false;
+
+    {
+        std::lock_guard<std::mutex> lock(ws_mutex_);
+        ws_.close();
+    }
 
-    // Clear remote agents
     {
         std::lock_guard<std::mutex> lock(agents_mutex_);
         remote_agents_.clear();
     }
+    clear_outbound();
 
     spdlog::info("Tunnel disconnected");
 }
@@ -204,6 +159,11 @@ TunnelStatus TunnelClient::get_status() const {
     status.connected = connected_;
     status.relay_url = config_.relay_url;
     status.machine_id = config_.machine_id;
+    status.compression = compression_active_ ? "deflate" : "";
+    status.tx_payload_bytes = tx_payload_bytes_;
+    status.tx_wire_bytes = tx_wire_bytes_;
+    status.rx_payload_bytes = rx_payload_bytes_;
+    status.rx_wire_bytes = rx_wire_bytes_;
 
     {
         std::lock_guard<std::mutex> lock(agents_mutex_);
@@ -229,36 +189,150 @@ bool TunnelClient::send_response(uint32_t agent_id, uint8_t opcode,
         return false;
     }
 
-    // Base64 encode payload
-    std::string payload_b64;
-    if (!payload.empty()) {
-        static const char base64_chars[] =
-            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    tx_payload_bytes_ += payload.size();
+
+    // Deflate when the relay agreed to it and it actually helps
+    const std::vector<uint8_t>* wire = &payload;
+    std::vector<uint8_t> compressed;
+    bool deflated = false;
+    if (compression_active_ && payload.size() >= COMPRESS_MIN_BYTES) {
+        compressed = deflate_bytes(payload);
+        if (!compressed.empty() && compressed.size() < payload.size()) {
+            wire = &compressed;
+            deflated = true;
+        }
+    }
+
+    std::vector<OutFrame> frames;
 
-        payload_b64.reserve(((payload.size() + 2) / 3) * 4);
-        for (size_t i = 0; i < payload.size(); i += 3) {
-            uint32_t n = (static_cast<uint32_t>(payload[i]) << 16);
-            if (i + 1 < payload.size()) n |= (static_cast<uint32_t>(payload[i + 1]) << 8);
-            if (i + 2 < payload.size()) n |= static_cast<uint32_t>(payload[i + 2]);
+    if (wire->size() <= STREAM_CHUNK_BYTES) {
+        json message;
+        message["type"] = "response";
+        message["agent_id"] = agent_id;
+        message["opcode"] = opcode;
+        message["payload"] = base64_encode(*wire);
+        if (deflated) {
+            message["c"] = "deflate";
+            message["raw_len"] = payload.size();
+        }
+        frames.push_back(OutFrame{message.dump(), wire->size()});
+    } else {
+        // Split into stream chunks the relay reassembles; the sender
+        // interleaves them with other agents' frames
+        uint64_t stream_id;
+        {
+            std::lock_guard<std::mutex> lock(out_mutex_);
+            stream_id = next_stream_id_++;
+        }
 
-            payload_b64 += base64_chars[(n >> 18) & 0x3F];
-            payload_b64 += base64_chars[(n >> 12) & 0x3F];
-            payload_b64 += (i + 1 < payload.size()) ? base64_chars[(n >> 6) & 0x3F] : '=';
-            payload_b64 += (i + 2 < payload.size()) ? base64_chars[n & 0x3F] : '=';
+        size_t chunks = (wire->size() + STREAM_CHUNK_BYTES - 1) / STREAM_CHUNK_BYTES;
+        frames.reserve(chunks);
+        for (size_t offset = 0, seq = 0; offset < wire->size();
+             offset += STREAM_CHUNK_BYTES, ++seq) {
+            size_t len = std::min(STREAM_CHUNK_BYTES, wire->size() - offset);
+            std::vector<uint8_t> chunk(wire->begin() + offset,
+                                       wire->begin() + offset + len);
+            json message;
+            message["type"] = "response_chunk";
+            message["agent_id"] = agent_id;
+            message["opcode"] = opcode;
+            message["stream_id"] = stream_id;
+            message["seq"] = seq;
+            message["final"] = (seq + 1 == chunks);
+            message["payload"] = base64_encode(chunk);
+            if (deflated) {
+                message["c"] = "deflate";
+                message["raw_len"] = payload.size();
+            }
+            frames.push_back(OutFrame{message.dump(), len});
         }
     }
 
-    json request;
-    request["id"] = next_request_id_++;
-    request["method"] = "send_response";
-    request["params"] = {
-        {"agent_id", agent_id},
-        {"opcode", opcode},
-        {"payload", payload_b64}
-    };
+    {
+        std::unique_lock<std::mutex> lock(out_mutex_);
+
+        // Flow control: don't let one agent queue unbounded bytes
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        if (!window_cv_.wait_until(lock, deadline, [&]() {
+                return !running_ || !connected_ ||
+                       out_bytes_[agent_id] + wire->size() <= AGENT_WINDOW_BYTES;
+            })) {
+            return false;  // window stayed full
+        }
+        if (!running_ || !connected_) {
+            return false;
+        }
 
-    auto response = send_request_and_wait(request);
-    return response && response->value("result", json{}).value("success", false);
+        auto& q = out_queues_[agent_id];
+        for (auto& frame : frames) {
+            out_bytes_[agent_id] += frame.payload_bytes;
+            q.push_back(std::move(frame));
+        }
+        if (!in_out_rotation_.count(agent_id)) {
+            out_rotation_.push_back(agent_id);
+            in_out_rotation_.insert(agent_id);
+        }
+    }
+    out_cv_.notify_one();
+    return true;
+}
+
+void TunnelClient::sender_loop() {
+    while (running_) {
+        OutFrame frame;
+        uint32_t agent_id;
+        {
+            std::unique_lock<std::mutex> lock(out_mutex_);
+            out_cv_.wait(lock, [this]() { return !running_ || !out_rotation_.empty(); });
+            if (!running_) {
+                break;
+            }
+
+            agent_id = out_rotation_.front();
+            out_rotation_.pop_front();
+            in_out_rotation_.erase(agent_id);
+
+            auto it = out_queues_.find(agent_id);
+            if (it == out_queues_.end() || it->second.empty()) {
+                continue;  // queue was cleared while we waited
+            }
+            frame = std::move(it->second.front());
+            it->second.pop_front();
+
+            if (it->second.empty()) {
+                out_queues_.erase(it);
+                out_bytes_.erase(agent_id);
+            } else {
+                out_bytes_[agent_id] -= frame.payload_bytes;
+                // One frame per turn: back of the line for the rest
+                out_rotation_.push_back(agent_id);
+                in_out_rotation_.insert(agent_id);
+            }
+        }
+        window_cv_.notify_all();
+
+        bool sent;
+        {
+            std::lock_guard<std::mutex> lock(ws_mutex_);
+            sent = ws_.is_open() && ws_.send_text(frame.text);
+        }
+        if (sent) {
+            tx_wire_bytes_ += frame.text.size();
+        } else {
+            spdlog::debug("Tunnel send failed for agent {}", agent_id);
+        }
+    }
+}
+
+void TunnelClient::clear_outbound() {
+    {
+        std::lock_guard<std::mutex> lock(out_mutex_);
+        out_queues_.clear();
+        out_bytes_.clear();
+        out_rotation_.clear();
+        in_out_rotation_.clear();
+    }
+    window_cv_.notify_all();
 }
 
 std::vector<TunnelEvent> TunnelClient::poll_events() {
@@ -283,157 +357,189 @@ void TunnelClient::shutdown() {
     }
 
     running_ = false;
+    want_connection_ = false;
+    out_cv_.notify_all();
+    window_cv_.notify_all();
 
-    // Send shutdown request
-    json request;
-    request["id"] = next_request_id_++;
-    request["method"] = "shutdown";
-    request["params"] = json::object();
-    send_request(request);
-
-    // Wait for reader thread
     if (reader_thread_.joinable()) {
         reader_thread_.join();
     }
-
-    // Close pipes
-    if (stdin_fd_ >= 0) {
-        close(stdin_fd_);
-        stdin_fd_ = -1;
-    }
-    if (stdout_fd_ >= 0) {
-        close(stdout_fd_);
-        stdout_fd_ = -1;
+    if (sender_thread_.joinable()) {
+        sender_thread_.join();
     }
 
-    // Kill subprocess
-    if (subprocess_pid_ > 0) {
-        kill(subprocess_pid_, SIGTERM);
-        int status;
-        waitpid(subprocess_pid_, &status, 0);
-        subprocess_pid_ = -1;
+    {
+        std::lock_guard<std::mutex> lock(ws_mutex_);
+        ws_.close();
     }
 
     connected_ = false;
     spdlog::info("Tunnel client shutdown");
 }
 
-bool TunnelClient::send_request(const nlohmann::json& request) {
-    if (stdin_fd_ < 0) {
+bool TunnelClient::send_json(const nlohmann::json& message) {
+    std::lock_guard<std::mutex> lock(ws_mutex_);
+    if (!ws_.is_open()) {
         return false;
     }
-
-    std::string line = request.dump() + "\n";
-    ssize_t written = write(stdin_fd_, line.c_str(), line.size());
-    return written == static_cast<ssize_t>(line.size());
+    return ws_.send_text(message.dump());
 }
 
-std::optional<nlohmann::json> TunnelClient::send_request_and_wait(
-    const nlohmann::json& request, int timeout_ms) {
-
-    int req_id = request.value("id", 0);
-
-    // Prepare for response
+// Reader-thread only: dial the relay, authenticate, and mark connected
+bool TunnelClient::establish() {
+    std::string error;
     {
-        std::lock_guard<std::mutex> lock(response_mutex_);
-        pending_responses_[req_id] = json{};
+        std::lock_guard<std::mutex> lock(ws_mutex_);
+        if (!ws_.connect(config_.relay_url, 10, error)) {
+            last_error_ = error;
+            spdlog::debug("Tunnel dial failed: {}", error);
+            return false;
+        }
     }
 
-    // Send request
-    if (!send_request(request)) {
-        std::lock_guard<std::mutex> lock(response_mutex_);
-        pending_responses_.erase(req_id);
-        return std::nullopt;
+    json auth;
+    auth["type"] = "kernel_auth";
+    auth["machine_id"] = config_.machine_id;
+    auth["token"] = config_.token;
+    if (config_.compression) {
+        auth["compression"] = json::array({"deflate"});
+    }
+    if (!send_json(auth)) {
+        last_error_ = "failed to send auth message";
+        return false;
     }
 
-    // Wait for response
-    std::unique_lock<std::mutex> lock(response_mutex_);
-    auto deadline = std::chrono::steady_clock::now() +
-                   std::chrono::milliseconds(timeout_ms);
-
-    while (running_) {
-        if (response_cv_.wait_until(lock, deadline,
-            [&]() { return !pending_responses_[req_id].empty(); })) {
+    // Wait for the relay's auth verdict; anything else arriving in the
+    // meantime is dispatched normally
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (std::chrono::steady_clock::now() < deadline) {
+        std::string text;
+        auto result = ws_.recv_text(text, 500);
+        if (result == WebSocket::RecvResult::CLOSED) {
+            last_error_ = "relay closed connection during auth";
+            return false;
+        }
+        if (result == WebSocket::RecvResult::TIMEOUT) {
+            continue;
+        }
 
-            auto response = std::move(pending_responses_[req_id]);
-            pending_responses_.erase(req_id);
-            return response;
+        json data;
+        try {
+            data = json::parse(text);
+        } catch (const json::exception&) {
+            continue;
         }
 
-        if (std::chrono::steady_clock::now() >= deadline) {
-            pending_responses_.erase(req_id);
-            return std::nullopt;
+        std::string type = data.value("type", "");
+        if (type == "auth_ok") {
+            last_error_.clear();
+            compression_active_ = (data.value("compression", "") == "deflate");
+            connected_ = true;
+            spdlog::info("Tunnel connected to {}{}", config_.relay_url,
+                         compression_active_ ? " (deflate)" : "");
+            // Prime the remote agent list
+            send_json(json{{"type", "list_remotes"}});
+            return true;
+        }
+        if (type == "auth_error") {
+            last_error_ = data.value("error", "authentication rejected");
+            spdlog::error("Tunnel auth rejected: {}", last_error_);
+            want_connection_ = false;  // bad credentials won't fix themselves
+            return false;
         }
+        handle_relay_message(data);
     }
 
-    return std::nullopt;
+    last_error_ = "timed out waiting for auth response";
+    return false;
 }
 
 void TunnelClient::reader_loop() {
-    std::string buffer;
-    char chunk[4096];
+    bool was_connected = false;
+    auto last_ping = std::chrono::steady_clock::now();
+    auto last_attempt = std::chrono::steady_clock::now() -
+                        std::chrono::seconds(config_.reconnect_interval);
 
     while (running_) {
-        // Poll for data
-        struct pollfd pfd;
-        pfd.fd = stdout_fd_;
-        pfd.events = POLLIN;
+        if (!connected_) {
+            if (!want_connection_) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                continue;
+            }
 
-        int ret = poll(&pfd, 1, 100);  // 100ms timeout
-        if (ret <= 0) {
+            auto now = std::chrono::steady_clock::now();
+            auto interval = std::chrono::seconds(
+                config_.reconnect_interval > 0 ? config_.reconnect_interval : 5);
+            if (now - last_attempt < interval) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                continue;
+            }
+            last_attempt = now;
+
+            if (establish()) {
+                last_ping = std::chrono::steady_clock::now();
+                if (was_connected) {
+                    TunnelEvent event;
+                    event.type = TunnelEvent::Type::RECONNECTED;
+                    emit_event(std::move(event));
+                    spdlog::info("Tunnel reconnected to relay");
+                }
+                was_connected = true;
+            }
             continue;
         }
 
-        if (!(pfd.revents & POLLIN)) {
-            continue;
-        }
+        std::string text;
+        auto result = ws_.recv_text(text, 100);
 
-        ssize_t n = read(stdout_fd_, chunk, sizeof(chunk) - 1);
-        if (n <= 0) {
-            if (n < 0 && errno == EAGAIN) {
-                continue;
+        if (result == WebSocket::RecvResult::CLOSED) {
+            connected_ = false;
+            compression_active_ = false;
+            {
+                std::lock_guard<std::mutex> lock(ws_mutex_);
+                ws_.close();
+            }
+            {
+                std::lock_guard<std::mutex> lock(agents_mutex_);
+                remote_agents_.clear();
             }
-            break;  // EOF or error
+            clear_outbound();
+            if (want_connection_) {
+                spdlog::warn("Tunnel disconnected from relay");
+                TunnelEvent event;
+                event.type = TunnelEvent::Type::DISCONNECTED;
+                emit_event(std::move(event));
+            }
+            continue;
         }
 
-        chunk[n] = '\0';
-        buffer += chunk;
-
-        // Process complete lines
-        size_t pos;
-        while ((pos = buffer.find('\n')) != std::string::npos) {
-            std::string line = buffer.substr(0, pos);
-            buffer.erase(0, pos + 1);
-
-            if (line.empty()) continue;
-
+        if (result == WebSocket::RecvResult::MESSAGE) {
+            rx_wire_bytes_ += text.size();
             try {
-                json data = json::parse(line);
-
-                if (data.contains("event")) {
-                    handle_event(data);
-                } else if (data.contains("id")) {
-                    handle_response(data);
-                }
-            } catch (const json::exception& e) {
-                spdlog::debug("Invalid JSON from tunnel: {}", line);
+                handle_relay_message(json::parse(text));
+            } catch (const json::exception&) {
+                spdlog::debug("Invalid JSON from relay: {}", text);
             }
         }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - last_ping > std::chrono::seconds(20)) {
+            last_ping = now;
+            send_json(json{{"type", "ping"}});
+        }
     }
 }
 
-void TunnelClient::handle_event(const nlohmann::json& data) {
-    std::string event_type = data.value("event", "");
-    json event_data = data.value("data", json{});
+void TunnelClient::handle_relay_message(const nlohmann::json& data) {
+    std::string type = data.value("type", "");
 
     TunnelEvent event;
 
-    if (event_type == "agent_connected") {
+    if (type == "agent_connected") {
         event.type = TunnelEvent::Type::AGENT_CONNECTED;
-        event.agent_id = event_data.value("agent_id", 0);
-        event.agent_name = event_data.value("name", "");
+        event.agent_id = data.value("agent_id", 0);
+        event.agent_name = data.value("name", "");
 
-        // Track remote agent
         {
             std::lock_guard<std::mutex> lock(agents_mutex_);
             remote_agents_[event.agent_id] = RemoteAgentInfo{
@@ -446,11 +552,10 @@ void TunnelClient::handle_event(const nlohmann::json& data) {
         spdlog::info("Remote agent connected: {} (id={})",
                     event.agent_name, event.agent_id);
 
-    } else if (event_type == "agent_disconnected") {
+    } else if (type == "agent_disconnected") {
         event.type = TunnelEvent::Type::AGENT_DISCONNECTED;
-        event.agent_id = event_data.value("agent_id", 0);
+        event.agent_id = data.value("agent_id", 0);
 
-        // Remove from tracking
         {
             std::lock_guard<std::mutex> lock(agents_mutex_);
             remote_agents_.erase(event.agent_id);
@@ -458,83 +563,62 @@ void TunnelClient::handle_event(const nlohmann::json& data) {
 
         spdlog::info("Remote agent disconnected: id={}", event.agent_id);
 
-    } else if (event_type == "syscall") {
+    } else if (type == "syscall") {
         event.type = TunnelEvent::Type::SYSCALL;
-        event.agent_id = event_data.value("agent_id", 0);
-        event.opcode = event_data.value("opcode", 0);
-
-        // Base64 decode payload
-        std::string payload_b64 = event_data.value("payload", "");
-        if (!payload_b64.empty()) {
-            static const std::string base64_chars =
-                "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
-            event.payload.reserve(payload_b64.size() * 3 / 4);
-            uint32_t val = 0;
-            int bits = -8;
-
-            for (char c : payload_b64) {
-                if (c == '=') break;
-                auto pos = base64_chars.find(c);
-                if (pos == std::string::npos) continue;
-
-                val = (val << 6) | pos;
-                bits += 6;
-
-                if (bits >= 0) {
-                    event.payload.push_back((val >> bits) & 0xFF);
-                    bits -= 8;
-                }
+        event.agent_id = data.value("agent_id", 0);
+        event.opcode = data.value("opcode", 0);
+        event.payload = base64_decode(data.value("payload", ""));
+
+        if (data.value("c", "") == "deflate") {
+            std::vector<uint8_t> raw;
+            if (!inflate_bytes(event.payload, data.value("raw_len", size_t{0}), raw)) {
+                spdlog::warn("Dropping undecodable compressed syscall from agent {}",
+                             event.agent_id);
+                return;
             }
+            event.payload = std::move(raw);
         }
+        rx_payload_bytes_ += event.payload.size();
 
         spdlog::debug("Syscall from remote agent {}: opcode=0x{:02x}",
                      event.agent_id, event.opcode);
 
-    } else if (event_type == "disconnected") {
-        event.type = TunnelEvent::Type::DISCONNECTED;
-        connected_ = false;
-        spdlog::warn("Tunnel disconnected from relay");
+    } else if (type == "remote_list") {
+        std::lock_guard<std::mutex> lock(agents_mutex_);
+        remote_agents_.clear();
+        for (const auto& remote : data.value("remotes", json::array())) {
+            RemoteAgentInfo info;
+            info.agent_id = remote.value("agent_id", 0);
+            info.name = remote.value("name", "");
+            info.connected_at = remote.value("connected_at", "");
+            remote_agents_[info.agent_id] = std::move(info);
+        }
+        return;  // bookkeeping only, no event
 
-    } else if (event_type == "reconnected") {
-        event.type = TunnelEvent::Type::RECONNECTED;
-        connected_ = true;
-        spdlog::info("Tunnel reconnected to relay");
+    } else if (type == "pong") {
+        return;
 
-    } else if (event_type == "error") {
+    } else if (type == "error") {
         event.type = TunnelEvent::Type::ERROR;
-        event.error = event_data.value("message", "Unknown error");
+        event.error = data.value("error", data.value("message", "Unknown error"));
         spdlog::error("Tunnel error: {}", event.error);
 
-    } else if (event_type == "ready") {
-        // Tunnel subprocess ready
-        spdlog::debug("Tunnel subprocess ready");
-        event.type = TunnelEvent::Type::ERROR;  // Reuse for ready signal
-        event.error = "";
     } else {
-        return;  // Unknown event, ignore
+        return;  // Unknown message, ignore
     }
 
-    // Queue event
+    emit_event(std::move(event));
+}
+
+void TunnelClient::emit_event(TunnelEvent event) {
     {
         std::lock_guard<std::mutex> lock(event_mutex_);
         event_queue_.push(event);
     }
 
-    // Call callback if set
     if (event_callback_) {
         event_callback_(event);
     }
 }
 
-void TunnelClient::handle_response(const nlohmann::json& response) {
-    int req_id = response.value("id", 0);
-
-    std::lock_guard<std::mutex> lock(response_mutex_);
-    if (pending_responses_.count(req_id)) {
-        pending_responses_[req_id] = response;
-        response_cv_.notify_all();
-    }
-}
-
 } // namespace clove::services::tunnel
@@ -2,20 +2,24 @@
  * Clove Tunnel Client
  *
  * Manages connection to a relay server for remote agent connectivity.
- * Runs a Python subprocess (tunnel_client.py) and communicates via JSON.
+ * Speaks the relay's WebSocket protocol natively (see websocket.hpp);
+ * a dedicated reader thread dispatches relay messages and drives
+ * heartbeats and reconnection.
  */
 #pragma once
 #include <string>
-#include <memory>
 #include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <queue>
 #include <mutex>
 #include <functional>
 #include <thread>
 #include <unordered_map>
-#include <condition_variable>
-#include <optional>
+#include <unordered_set>
+#include <vector>
 #include <nlohmann/json.hpp>
+#include "services/tunnel/websocket.hpp"
 
 namespace clove::services::tunnel {
 
@@ -26,6 +30,7 @@ struct TunnelConfig {
     std::string token;
     int reconnect_interval = 5;
     bool auto_connect = false;
+    bool compression = true;  // offer payload compression at auth
 };
 
 // Information about a connected remote agent
@@ -42,6 +47,11 @@ struct TunnelStatus {
     std::string machine_id;
     int remote_agent_count = 0;
     std::string error;
+    std::string compression;        // negotiated codec, empty if none
+    uint64_t tx_payload_bytes = 0;  // logical response payload bytes
+    uint64_t tx_wire_bytes = 0;     // serialized bytes actually sent
+    uint64_t rx_payload_bytes = 0;  // logical syscall payload bytes
+    uint64_t rx_wire_bytes = 0;     // serialized bytes received
 };
 
 // Event from tunnel (syscall from remote agent)
@@ -72,7 +82,9 @@ public:
     TunnelClient(const TunnelClient&) = delete;
     TunnelClient& operator=(const TunnelClient&) = delete;
 
-    // Initialize the tunnel subprocess
+    // Initialize the tunnel (starts the reader thread; scripts_dir is
+    // accepted for compatibility with the old subprocess bridge and
+    // ignored)
     bool init(const std::string& scripts_dir = "");
 
     // Configure tunnel settings
@@ -110,11 +122,14 @@ private:
     TunnelConfig config_;
     std::atomic<bool> running_{false};
     std::atomic<bool> connected_{false};
+    std::atomic<bool> want_connection_{false};
 
-    // Subprocess handles
-    pid_t subprocess_pid_ = -1;
-    int stdin_fd_ = -1;
-    int stdout_fd_ = -1;
+    // WebSocket to the relay. Sends happen from both the kernel thread
+    // (send_response) and the reader thread (auth, heartbeats), so
+    // every send holds ws_mutex_; receives are reader-thread only.
+    WebSocket ws_;
+    std::mutex ws_mutex_;
+    std::string last_error_;
 
     // Event handling
     std::queue<TunnelEvent> event_queue_;
@@ -128,20 +143,51 @@ private:
     // Reader thread
     std::thread reader_thread_;
 
-    // Request-response tracking
-    int next_request_id_ = 1;
-    std::unordered_map<int, nlohmann::json> pending_responses_;
-    std::mutex response_mutex_;
-    std::condition_variable response_cv_;
+    // Outbound multiplexing. Every remote agent shares the one relay
+    // socket, so a multi-megabyte response written in one piece stalls
+    // every other agent's replies behind it. Responses instead go
+    // through per-agent queues (large payloads split into stream
+    // chunks) and a sender thread drains the queues round-robin, one
+    // chunk per turn — bulk transfers and small syscall replies
+    // interleave. A per-agent byte window bounds how much one agent
+    // can have queued; send_response blocks briefly when it is full.
+    static constexpr size_t STREAM_CHUNK_BYTES = 32 * 1024;
+    static constexpr size_t AGENT_WINDOW_BYTES = 4 * 1024 * 1024;
+
+    struct OutFrame {
+        std::string text;      // serialized relay message
+        size_t payload_bytes;  // raw payload size, for window accounting
+    };
+
+    std::mutex out_mutex_;
+    std::condition_variable out_cv_;      // sender: work available
+    std::condition_variable window_cv_;   // producers: window freed
+    std::unordered_map<uint32_t, std::deque<OutFrame>> out_queues_;
+    std::unordered_map<uint32_t, size_t> out_bytes_;
+    std::deque<uint32_t> out_rotation_;        // agents with queued frames
+    std::unordered_set<uint32_t> in_out_rotation_;
+    uint64_t next_stream_id_ = 1;
+    std::thread sender_thread_;
+
+    // Compression, negotiated during auth: payloads above a threshold
+    // are deflated before base64 encoding when the relay agreed to it.
+    // Traffic counters feed SYS_TUNNEL_STATUS so the compression ratio
+    // is observable.
+    static constexpr size_t COMPRESS_MIN_BYTES = 512;
+    std::atomic<bool> compression_active_{false};
+    std::atomic<uint64_t> tx_payload_bytes_{0};
+    std::atomic<uint64_t> tx_wire_bytes_{0};
+    std::atomic<uint64_t> rx_payload_bytes_{0};
+    std::atomic<uint64_t> rx_wire_bytes_{0};
 
     // Internal methods
-    bool spawn_subprocess(const std::string& scripts_dir);
-    bool send_request(const nlohmann::json& request);
-    std::optional<nlohmann::json> send_request_and_wait(
-        const nlohmann::json& request, int timeout_ms = 5000);
+    bool establish();
+    bool send_json(const nlohmann::json& message);
     void reader_loop();
-    void handle_event(const nlohmann::json& event);
-    void handle_response(const nlohmann::json& response);
+    void sender_loop();
+    void clear_outbound();
+    void handle_relay_message(const nlohmann::json& data);
+    void emit_event(TunnelEvent event);
 };
 
 } // namespace clove::services::tunnel
@@ -0,0 +1,453 @@
+#include "services/tunnel/websocket.hpp"
+#include <spdlog/spdlog.h>
+#include <openssl/sha.h>
+#include <openssl/ssl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cstring>
+#include <random>
+
+namespace clove::services::tunnel {
+
+namespace {
+
+constexpr const char* WS_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+std::string base64_encode(const unsigned char* data, size_t len) {
+    static const char chars[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    out.reserve(((len + 2) / 3) * 4);
+    for (size_t i = 0; i < len; i += 3) {
+        uint32_t n = static_cast<uint32_t>(data[i]) << 16;
+        if (i + 1 < len) n |= static_cast<uint32_t>(data[i + 1]) << 8;
+        if (i + 2 < len) n |= static_cast<uint32_t>(data[i + 2]);
+        out += chars[(n >> 18) & 0x3F];
+        out += chars[(n >> 12) & 0x3F];
+        out += (i + 1 < len) ? chars[(n >> 6) & 0x3F] : '=';
+        out += (i + 2 < len) ? chars[n & 0x3F] : '=';
+    }
+    return out;
+}
+
+struct ParsedWsUrl {
+    bool tls = false;
+    std::string host;
+    uint16_t port = 80;
+    std::string target;
+};
+
+bool parse_ws_url(const std::string& url, ParsedWsUrl& out) {
+    std::string rest;
+    if (url.rfind("wss://", 0) == 0) {
+        out.tls = true;
+        out.port = 443;
+        rest = url.substr(6);
+    } else if (url.rfind("ws://", 0) == 0) {
+        out.tls = false;
+        out.port = 80;
+        rest = url.substr(5);
+    } else {
+        return false;
+    }
+
+    size_t slash = rest.find('/');
+    std::string authority = rest.substr(0, slash);
+    out.target = (slash == std::string::npos) ? "/" : rest.substr(slash);
+
+    size_t colon = authority.rfind(':');
+    if (colon != std::string::npos) {
+        out.host = authority.substr(0, colon);
+        try {
+            out.port = static_cast<uint16_t>(std::stoi(authority.substr(colon + 1)));
+        } catch (...) {
+            return false;
+        }
+    } else {
+        out.host = authority;
+    }
+    return !out.host.empty();
+}
+
+} // namespace
+
+WebSocket::WebSocket() = default;
+
+WebSocket::~WebSocket() {
+    close();
+}
+
+void WebSocket::close() {
+    if (ssl_) {
+        SSL_free(ssl_);
+        ssl_ = nullptr;
+    }
+    if (ssl_ctx_) {
+        SSL_CTX_free(ssl_ctx_);
+        ssl_ctx_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    rx_.clear();
+    fragments_.clear();
+}
+
+ssize_t WebSocket::read_some(char* buf, size_t len, int timeout_ms) {
+    while (true) {
+        ssize_t n;
+        if (ssl_) {
+            n = SSL_read(ssl_, buf, static_cast<int>(len));
+            if (n > 0) {
+                return n;
+            }
+            int err = SSL_get_error(ssl_, static_cast<int>(n));
+            if (err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE) {
+                pollfd pfd{fd_, static_cast<short>(err == SSL_ERROR_WANT_READ ? POLLIN : POLLOUT), 0};
+                if (::poll(&pfd, 1, timeout_ms) <= 0) {
+                    return -2;  // timeout
+                }
+                continue;
+            }
+            return err == SSL_ERROR_ZERO_RETURN ? 0 : -1;
+        }
+
+        n = ::recv(fd_, buf, len, 0);
+        if (n >= 0) {
+            return n;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            pollfd pfd{fd_, POLLIN, 0};
+            if (::poll(&pfd, 1, timeout_ms) <= 0) {
+                return -2;  // timeout
+            }
+            continue;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        return -1;
+    }
+}
+
+bool WebSocket::write_all(const char* data, size_t len, int timeout_ms) {
+    size_t sent = 0;
+    while (sent < len) {
+        ssize_t n;
+        if (ssl_) {
+            n = SSL_write(ssl_, data + sent, static_cast<int>(len - sent));
+            if (n <= 0) {
+                int err = SSL_get_error(ssl_, static_cast<int>(n));
+                if (err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE) {
+                    pollfd pfd{fd_, static_cast<short>(err == SSL_ERROR_WANT_READ ? POLLIN : POLLOUT), 0};
+                    if (::poll(&pfd, 1, timeout_ms) <= 0) {
+                        return false;
+                    }
+                    continue;
+                }
+                return false;
+            }
+        } else {
+            n = ::send(fd_, data + sent, len - sent, MSG_NOSIGNAL);
+            if (n < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    pollfd pfd{fd_, POLLOUT, 0};
+                    if (::poll(&pfd, 1, timeout_ms) <= 0) {
+                        return false;
+                    }
+                    continue;
+                }
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool WebSocket::connect(const std::string& url, int timeout_secs, std::string& error) {
+    close();
+
+    ParsedWsUrl parsed;
+    if (!parse_ws_url(url, parsed)) {
+        error = "invalid WebSocket URL: " + url;
+        return false;
+    }
+
+    int timeout_ms = timeout_secs * 1000;
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addrs = nullptr;
+    std::string port_str = std::to_string(parsed.port);
+    int rc = ::getaddrinfo(parsed.host.c_str(), port_str.c_str(), &hints, &addrs);
+    if (rc != 0) {
+        error = "DNS resolution failed for " + parsed.host + ": " + gai_strerror(rc);
+        return false;
+    }
+
+    for (addrinfo* ai = addrs; ai; ai = ai->ai_next) {
+        int fd = ::socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                          ai->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+            fd_ = fd;
+            break;
+        }
+        if (errno == EINPROGRESS) {
+            pollfd pfd{fd, POLLOUT, 0};
+            if (::poll(&pfd, 1, timeout_ms) > 0) {
+                int so_error = 0;
+                socklen_t optlen = sizeof(so_error);
+                ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &so_error, &optlen);
+                if (so_error == 0) {
+                    fd_ = fd;
+                    break;
+                }
+            }
+        }
+        ::close(fd);
+    }
+    ::freeaddrinfo(addrs);
+
+    if (fd_ < 0) {
+        error = "connection to " + parsed.host + ":" + port_str + " failed";
+        return false;
+    }
+
+    if (parsed.tls) {
+        ssl_ctx_ = SSL_CTX_new(TLS_client_method());
+        if (!ssl_ctx_) {
+            error = "failed to create SSL context";
+            close();
+            return false;
+        }
+        SSL_CTX_set_default_verify_paths(ssl_ctx_);
+        SSL_CTX_set_verify(ssl_ctx_, SSL_VERIFY_PEER, nullptr);
+        SSL_CTX_set_min_proto_version(ssl_ctx_, TLS1_2_VERSION);
+
+        ssl_ = SSL_new(ssl_ctx_);
+        SSL_set_fd(ssl_, fd_);
+        SSL_set_tlsext_host_name(ssl_, parsed.host.c_str());
+        SSL_set1_host(ssl_, parsed.host.c_str());
+
+        while (true) {
+            int ret = SSL_connect(ssl_);
+            if (ret == 1) {
+                break;
+            }
+            int err = SSL_get_error(ssl_, ret);
+            pollfd pfd{fd_, static_cast<short>(err == SSL_ERROR_WANT_READ ? POLLIN : POLLOUT), 0};
+            if ((err != SSL_ERROR_WANT_READ && err != SSL_ERROR_WANT_WRITE) ||
+                ::poll(&pfd, 1, timeout_ms) <= 0) {
+                error = "TLS handshake with " + parsed.host + " failed";
+                close();
+                return false;
+            }
+        }
+    }
+
+    // Upgrade handshake
+    unsigned char key_bytes[16];
+    std::random_device rd;
+    for (auto& b : key_bytes) {
+        b = static_cast<unsigned char>(rd());
+    }
+    std::string key = base64_encode(key_bytes, sizeof(key_bytes));
+
+    std::string handshake =
+        "GET " + parsed.target + " HTTP/1.1\r\n"
+        "Host: " + parsed.host + ":" + port_str + "\r\n"
+        "Upgrade: websocket\r\n"
+        "Connection: Upgrade\r\n"
+        "Sec-WebSocket-Key: " + key + "\r\n"
+        "Sec-WebSocket-Version: 13\r\n"
+        "\r\n";
+
+    if (!write_all(handshake.data(), handshake.size(), timeout_ms)) {
+        error = "failed to send WebSocket handshake";
+        close();
+        return false;
+    }
+
+    std::string response;
+    char buf[4096];
+    size_t header_end;
+    while ((header_end = response.find("\r\n\r\n")) == std::string::npos) {
+        ssize_t n = read_some(buf, sizeof(buf), timeout_ms);
+        if (n <= 0) {
+            error = "WebSocket handshake failed: no response";
+            close();
+            return false;
+        }
+        response.append(buf, static_cast<size_t>(n));
+        if (response.size() > 64 * 1024) {
+            error = "WebSocket handshake response too large";
+            close();
+            return false;
+        }
+    }
+
+    if (response.find(" 101 ") == std::string::npos &&
+        response.rfind("HTTP/1.1 101", 0) != 0) {
+        error = "WebSocket upgrade refused";
+        close();
+        return false;
+    }
+
+    // Verify the accept token so we know the peer actually spoke the
+    // handshake rather than echoing bytes
+    std::string accept_input = key + WS_GUID;
+    unsigned char digest[SHA_DIGEST_LENGTH];
+    SHA1(reinterpret_cast<const unsigned char*>(accept_input.data()),
+         accept_input.size(), digest);
+    std::string expected = base64_encode(digest, sizeof(digest));
+    if (response.find(expected) == std::string::npos) {
+        error = "WebSocket handshake verification failed";
+        close();
+        return false;
+    }
+
+    // Bytes past the handshake are the first frames
+    rx_ = response.substr(header_end + 4);
+    return true;
+}
+
+bool WebSocket::send_frame(uint8_t opcode, const std::string& payload) {
+    if (fd_ < 0) {
+        return false;
+    }
+
+    std::string frame;
+    frame.reserve(payload.size() + 14);
+    frame.push_back(static_cast<char>(0x80 | opcode));  // FIN + opcode
+
+    // Client frames are always masked
+    if (payload.size() < 126) {
+        frame.push_back(static_cast<char>(0x80 | payload.size()));
+    } else if (payload.size() <= 0xFFFF) {
+        frame.push_back(static_cast<char>(0x80 | 126));
+        frame.push_back(static_cast<char>((payload.size() >> 8) & 0xFF));
+        frame.push_back(static_cast<char>(payload.size() & 0xFF));
+    } else {
+        frame.push_back(static_cast<char>(0x80 | 127));
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            frame.push_back(static_cast<char>((payload.size() >> shift) & 0xFF));
+        }
+    }
+
+    unsigned char mask[4];
+    std::random_device rd;
+    for (auto& b : mask) {
+        b = static_cast<unsigned char>(rd());
+    }
+    frame.append(reinterpret_cast<const char*>(mask), 4);
+
+    size_t offset = frame.size();
+    frame.append(payload);
+    for (size_t i = 0; i < payload.size(); ++i) {
+        frame[offset + i] = static_cast<char>(
+            static_cast<unsigned char>(frame[offset + i]) ^ mask[i & 3]);
+    }
+
+    return write_all(frame.data(), frame.size(), 10000);
+}
+
+bool WebSocket::send_text(const std::string& text) {
+    return send_frame(0x1, text);
+}
+
+WebSocket::RecvResult WebSocket::recv_text(std::string& out, int timeout_ms) {
+    if (fd_ < 0) {
+        return RecvResult::CLOSED;
+    }
+
+    char buf[8192];
+    while (true) {
+        // Parse as many complete frames as the buffer holds
+        while (rx_.size() >= 2) {
+            uint8_t b0 = static_cast<uint8_t>(rx_[0]);
+            uint8_t b1 = static_cast<uint8_t>(rx_[1]);
+            bool fin = (b0 & 0x80) != 0;
+            uint8_t opcode = b0 & 0x0F;
+            if (b1 & 0x80) {
+                // Server frames must not be masked
+                close();
+                return RecvResult::CLOSED;
+            }
+
+            size_t header_len = 2;
+            uint64_t payload_len = b1 & 0x7F;
+            if (payload_len == 126) {
+                if (rx_.size() < 4) break;
+                payload_len = (static_cast<uint8_t>(rx_[2]) << 8) |
+                              static_cast<uint8_t>(rx_[3]);
+                header_len = 4;
+            } else if (payload_len == 127) {
+                if (rx_.size() < 10) break;
+                payload_len = 0;
+                for (int i = 0; i < 8; ++i) {
+                    payload_len = (payload_len << 8) | static_cast<uint8_t>(rx_[2 + i]);
+                }
+                header_len = 10;
+            }
+
+            if (payload_len > (64ull << 20)) {
+                close();  // refuse pathological frames
+                return RecvResult::CLOSED;
+            }
+            if (rx_.size() < header_len + payload_len) {
+                break;  // frame incomplete
+            }
+
+            std::string payload = rx_.substr(header_len, payload_len);
+            rx_.erase(0, header_len + payload_len);
+
+            switch (opcode) {
+                case 0x1:  // text
+                case 0x2:  // binary (treated alike; the relay sends text)
+                case 0x0:  // continuation
+                    fragments_ += payload;
+                    if (fin) {
+                        out = std::move(fragments_);
+                        fragments_.clear();
+                        return RecvResult::MESSAGE;
+                    }
+                    break;
+                case 0x8:  // close
+                    send_frame(0x8, payload);
+                    close();
+                    return RecvResult::CLOSED;
+                case 0x9:  // ping
+                    send_frame(0xA, payload);
+                    break;
+                case 0xA:  // pong
+                    break;
+                default:
+                    close();
+                    return RecvResult::CLOSED;
+            }
+        }
+
+        ssize_t n = read_some(buf, sizeof(buf), timeout_ms);
+        if (n == -2) {
+            return RecvResult::TIMEOUT;
+        }
+        if (n <= 0) {
+            close();
+            return RecvResult::CLOSED;
+        }
+        rx_.append(buf, static_cast<size_t>(n));
+    }
+}
+
+} // namespace clove::services::tunnel
@@ -0,0 +1,57 @@
+/**
+ * Minimal WebSocket client (RFC 6455) for the tunnel.
+ *
+ * Client side only: HTTP upgrade handshake, masked outgoing frames,
+ * fragmented message reassembly, ping/pong and close handling. Supports
+ * ws:// and wss:// (OpenSSL). I/O is non-blocking with poll()-enforced
+ * timeouts, matching the HTTP client's transport conventions.
+ */
+#pragma once
+#include <cstdint>
+#include <string>
+
+typedef struct ssl_ctx_st SSL_CTX;
+typedef struct ssl_st SSL;
+
+namespace clove::services::tunnel {
+
+class WebSocket {
+public:
+    WebSocket();
+    ~WebSocket();
+
+    WebSocket(const WebSocket&) = delete;
+    WebSocket& operator=(const WebSocket&) = delete;
+
+    // Dial + upgrade handshake. Returns false with `error` set on
+    // failure; the socket is closed either way on failure.
+    bool connect(const std::string& url, int timeout_secs, std::string& error);
+
+    bool send_text(const std::string& text);
+
+    enum class RecvResult {
+        MESSAGE,  // out holds one complete text message
+        TIMEOUT,  // nothing arrived within timeout_ms
+        CLOSED    // peer closed (or protocol/transport error)
+    };
+
+    // Reads one message; control frames (ping/pong/close) are handled
+    // internally and never surface to the caller
+    RecvResult recv_text(std::string& out, int timeout_ms);
+
+    void close();
+    bool is_open() const { return fd_ >= 0; }
+
+private:
+    int fd_ = -1;
+    SSL* ssl_ = nullptr;
+    SSL_CTX* ssl_ctx_ = nullptr;
+    std::string rx_;        // raw bytes awaiting frame parsing
+    std::string fragments_; // payload assembled across continuation frames
+
+    bool write_all(const char* data, size_t len, int timeout_ms);
+    ssize_t read_some(char* buf, size_t len, int timeout_ms);
+    bool send_frame(uint8_t opcode, const std::string& payload);
+};
+
+} // namespace clove::services::tunnel
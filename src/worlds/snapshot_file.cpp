@@ -0,0 +1,295 @@
+/**
+ * AgentOS World Snapshot Files Implementation
+ */
+#include "worlds/snapshot_file.hpp"
+#include "worlds/world_engine.hpp"
+#include <spdlog/spdlog.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace clove::worlds::snapshot_file {
+
+namespace {
+
+// Delta chains reference parents by filename, resolved relative to the
+// child's directory; cap the chain so a corrupt parent field cannot
+// recurse forever
+constexpr size_t MAX_CHAIN_DEPTH = 64;
+
+bool write_all(int fd, const void* data, size_t len) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    while (len > 0) {
+        ssize_t n = ::write(fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        p += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+constexpr uint64_t FNV_BASIS = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+uint64_t fnv1a(uint64_t h, const void* data, size_t len) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+// Hash identity covers the flattened bytes, so chunk boundaries in the
+// rope never change a file's hash
+uint64_t hash_file(const VirtualFile& file) {
+    uint64_t h = FNV_BASIS;
+    for (const auto& chunk : file.chunks) {
+        h = fnv1a(h, chunk->data(), chunk->size());
+    }
+    return h;
+}
+
+} // namespace
+
+uint64_t content_hash(const std::string& data) {
+    // FNV-1a 64. Collisions would silently alias chunks across deltas;
+    // at 64 bits that is vanishingly unlikely for snapshot workloads.
+    return fnv1a(FNV_BASIS, data.data(), data.size());
+}
+
+MappedSnapshot::~MappedSnapshot() {
+    for (auto& region : regions_) {
+        if (region.base) {
+            ::munmap(region.base, region.len);
+        }
+    }
+}
+
+bool MappedSnapshot::read_content(uint64_t hash, std::string& out) const {
+    auto it = chunks_.find(hash);
+    if (it == chunks_.end()) {
+        return false;
+    }
+    out.assign(reinterpret_cast<const char*>(it->second.first), it->second.second);
+    return true;
+}
+
+std::shared_ptr<MappedSnapshot> open(const std::string& path, std::string& error) {
+    auto snap = std::shared_ptr<MappedSnapshot>(new MappedSnapshot());
+
+    std::string current = path;
+    for (size_t depth = 0; ; depth++) {
+        if (depth >= MAX_CHAIN_DEPTH) {
+            error = "snapshot parent chain too deep";
+            return nullptr;
+        }
+
+        int fd = ::open(current.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            error = "cannot open snapshot file: " + current;
+            return nullptr;
+        }
+
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+            ::close(fd);
+            error = "snapshot file truncated: " + current;
+            return nullptr;
+        }
+
+        size_t len = static_cast<size_t>(st.st_size);
+        void* base = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            error = "mmap failed: " + current;
+            return nullptr;
+        }
+        snap->regions_.push_back({base, len});
+
+        const auto* bytes = static_cast<const uint8_t*>(base);
+        Header header;
+        std::memcpy(&header, bytes, sizeof(header));
+
+        if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION) {
+            error = "not a CWS1 snapshot: " + current;
+            return nullptr;
+        }
+        if (header.meta_offset + header.meta_size > len) {
+            error = "snapshot metadata out of bounds: " + current;
+            return nullptr;
+        }
+
+        nlohmann::json meta;
+        try {
+            meta = nlohmann::json::parse(
+                bytes + header.meta_offset,
+                bytes + header.meta_offset + header.meta_size);
+        } catch (const std::exception& e) {
+            error = std::string("bad snapshot metadata: ") + e.what();
+            return nullptr;
+        }
+
+        // File table and world metadata come from the newest file only;
+        // ancestors just contribute chunks
+        if (depth == 0) {
+            snap->meta_ = meta;
+            snap->snapshot_time_ms_ = header.snapshot_time_ms;
+            if (meta.contains("files") && meta["files"].is_array()) {
+                for (const auto& f : meta["files"]) {
+                    MappedSnapshot::FileInfo info;
+                    info.path = f.value("path", "");
+                    info.mode = f.value("mode", "rw");
+                    info.hash = f.value("hash", 0ull);
+                    info.size = f.value("size", 0ull);
+                    snap->files_.push_back(std::move(info));
+                }
+            }
+        }
+
+        if (meta.contains("files") && meta["files"].is_array()) {
+            for (const auto& f : meta["files"]) {
+                if (!f.contains("offset")) {
+                    continue;  // chunk lives in an ancestor
+                }
+                uint64_t hash = f.value("hash", 0ull);
+                uint64_t offset = f["offset"].get<uint64_t>();
+                uint64_t size = f.value("size", 0ull);
+                if (offset + size > len) {
+                    error = "snapshot chunk out of bounds: " + current;
+                    return nullptr;
+                }
+                // Newest definition wins: emplace keeps the first insert
+                snap->chunks_.emplace(hash, std::make_pair(bytes + offset, size));
+            }
+        }
+
+        std::string parent = meta.value("parent", "");
+        if (parent.empty()) {
+            break;
+        }
+        current = (fs::path(current).parent_path() / parent).string();
+    }
+
+    // Validate the newest file table against the assembled chain
+    for (const auto& info : snap->files_) {
+        if (!snap->has_chunk(info.hash)) {
+            error = "snapshot chain missing chunk for " + info.path;
+            return nullptr;
+        }
+    }
+
+    return snap;
+}
+
+bool write(const std::string& path, const WorldSnapshot& snap,
+           const std::string& parent_path, std::string& error) {
+    // For a delta, learn which chunks the parent chain already holds
+    std::shared_ptr<MappedSnapshot> parent;
+    if (!parent_path.empty()) {
+        parent = open(parent_path, error);
+        if (!parent) {
+            return false;
+        }
+    }
+
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        error = "cannot create snapshot file: " + path;
+        return false;
+    }
+
+    Header header{};
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.flags = parent ? FLAG_DELTA : 0;
+    header.snapshot_time_ms = snap.snapshot_time_ms;
+
+    // Placeholder header; rewritten once offsets are known
+    if (!write_all(fd, &header, sizeof(header))) {
+        error = "write failed: " + path;
+        ::close(fd);
+        return false;
+    }
+
+    uint64_t offset = sizeof(header);
+    nlohmann::json file_table = nlohmann::json::array();
+    std::unordered_map<uint64_t, uint64_t> written;  // hash -> offset here
+
+    for (const auto& [file_path, file] : snap.vfs.files) {
+        uint64_t hash = hash_file(file);
+
+        nlohmann::json entry;
+        entry["path"] = file_path;
+        entry["mode"] = file.mode;
+        entry["hash"] = hash;
+        entry["size"] = file.size();
+
+        auto here = written.find(hash);
+        if (here != written.end()) {
+            entry["offset"] = here->second;
+        } else if (!parent || !parent->has_chunk(hash)) {
+            // Rope chunks land back to back, so on disk the file is
+            // one contiguous chunk again
+            for (const auto& chunk : file.chunks) {
+                if (!write_all(fd, chunk->data(), chunk->size())) {
+                    error = "write failed: " + path;
+                    ::close(fd);
+                    return false;
+                }
+            }
+            entry["offset"] = offset;
+            written.emplace(hash, offset);
+            offset += file.size();
+        }
+        // else: chunk resolved from the parent chain at open time
+
+        file_table.push_back(std::move(entry));
+    }
+
+    nlohmann::json meta;
+    meta["world_id"] = snap.world_id;
+    meta["name"] = snap.name;
+    meta["description"] = snap.description;
+    meta["config"] = snap.config;
+    meta["network"] = snap.network;
+    meta["chaos"] = snap.chaos;
+    meta["clock"] = snap.clock;
+    meta["readonly_patterns"] = snap.vfs.readonly_patterns;
+    meta["writable_patterns"] = snap.vfs.writable_patterns;
+    meta["intercept_patterns"] = snap.vfs.intercept_patterns;
+    meta["files"] = std::move(file_table);
+    if (parent) {
+        meta["parent"] = fs::path(parent_path).filename().string();
+    }
+
+    std::string meta_str = meta.dump();
+    header.meta_offset = offset;
+    header.meta_size = meta_str.size();
+
+    if (!write_all(fd, meta_str.data(), meta_str.size()) ||
+        ::pwrite(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+        ::fsync(fd) != 0) {
+        error = "write failed: " + path;
+        ::close(fd);
+        return false;
+    }
+
+    ::close(fd);
+    spdlog::info("Snapshot: wrote {} ({} files, {} new chunks, {})",
+                 path, snap.vfs.files.size(), written.size(),
+                 parent ? "delta" : "full");
+    return true;
+}
+
+} // namespace clove::worlds::snapshot_file
@@ -0,0 +1,114 @@
+/**
+ * AgentOS World Snapshot Files
+ *
+ * Binary on-disk format for persisted world snapshots ("CWS1").
+ * Content chunks are stored raw and addressed by hash, so a delta
+ * snapshot writes only chunks that its parent chain does not already
+ * hold, and restore mmaps the chain and copies bytes out lazily —
+ * no JSON escaping or parsing of file content in either direction.
+ *
+ * Layout: Header | raw content chunks | metadata JSON.
+ * The metadata JSON carries world config/network/chaos state, the VFS
+ * pattern lists, the parent snapshot filename (for deltas), and the
+ * file table: one entry per path with its content hash, size, mode and
+ * — when the chunk lives in this file — its offset.
+ */
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace clove::worlds {
+
+struct WorldSnapshot;
+
+namespace snapshot_file {
+
+constexpr uint32_t SNAPSHOT_MAGIC = 0x31535743;  // "CWS1" little-endian
+constexpr uint16_t SNAPSHOT_VERSION = 1;
+constexpr uint16_t FLAG_DELTA = 1 << 0;
+
+#pragma pack(push, 1)
+struct Header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;
+    uint64_t snapshot_time_ms;
+    uint64_t meta_offset;
+    uint64_t meta_size;
+};
+#pragma pack(pop)
+static_assert(sizeof(Header) == 32, "Header is 32 bytes on the wire");
+
+/**
+ * FNV-1a over content bytes; chunk identity for dedup across deltas
+ */
+uint64_t content_hash(const std::string& data);
+
+/**
+ * A snapshot file (plus its parent chain, for deltas) mapped into
+ * memory. Chunk bytes stay in the mapping until read_content copies
+ * them out, so holding one of these is cheap and restore can
+ * materialize files on first access.
+ */
+class MappedSnapshot {
+public:
+    struct FileInfo {
+        std::string path;
+        std::string mode;
+        uint64_t hash = 0;
+        uint64_t size = 0;
+    };
+
+    ~MappedSnapshot();
+    MappedSnapshot(const MappedSnapshot&) = delete;
+    MappedSnapshot& operator=(const MappedSnapshot&) = delete;
+
+    const nlohmann::json& meta() const { return meta_; }
+    const std::vector<FileInfo>& files() const { return files_; }
+    uint64_t snapshot_time_ms() const { return snapshot_time_ms_; }
+
+    /**
+     * Copy a chunk's bytes out of the mapping.
+     * Returns false if the hash is not present in the chain.
+     */
+    bool read_content(uint64_t hash, std::string& out) const;
+
+    bool has_chunk(uint64_t hash) const { return chunks_.count(hash) > 0; }
+
+private:
+    MappedSnapshot() = default;
+    friend std::shared_ptr<MappedSnapshot> open(const std::string& path,
+                                                std::string& error);
+
+    struct Region {
+        void* base = nullptr;
+        size_t len = 0;
+    };
+
+    std::vector<Region> regions_;  // this file first, then ancestors
+    std::unordered_map<uint64_t, std::pair<const uint8_t*, uint64_t>> chunks_;
+    std::vector<FileInfo> files_;
+    nlohmann::json meta_;
+    uint64_t snapshot_time_ms_ = 0;
+};
+
+/**
+ * Map a snapshot file and, for deltas, its parent chain.
+ * Returns nullptr and sets error on failure.
+ */
+std::shared_ptr<MappedSnapshot> open(const std::string& path, std::string& error);
+
+/**
+ * Write a snapshot to disk. When parent_path is non-empty the result
+ * is a delta: chunks already present in the parent chain are referenced
+ * by hash instead of rewritten.
+ */
+bool write(const std::string& path, const WorldSnapshot& snap,
+           const std::string& parent_path, std::string& error);
+
+} // namespace snapshot_file
+} // namespace clove::worlds
@@ -2,12 +2,148 @@
  * AgentOS Virtual Filesystem Implementation
  */
 #include "worlds/virtual_fs.hpp"
+#include "worlds/snapshot_file.hpp"
 #include <spdlog/spdlog.h>
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <filesystem>
 #include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 namespace clove::worlds {
 
+namespace {
+
+bool write_all_fd(int fd, const char* data, size_t len) {
+    while (len > 0) {
+        ssize_t n = ::write(fd, data, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Default spill location when the config names none; unique per VFS
+// instance so concurrent worlds never collide
+std::string default_spill_dir() {
+    static std::atomic<uint64_t> counter{0};
+    auto dir = std::filesystem::temp_directory_path() /
+               ("clove-vfs-" + std::to_string(::getpid()) + "-" +
+                std::to_string(counter.fetch_add(1)));
+    return dir.string();
+}
+
+std::string to_lower(const std::string& s) {
+    std::string out = s;
+    std::transform(out.begin(), out.end(), out.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return out;
+}
+
+// Glob-to-regex conversion shared by the compiled matchers and ad-hoc
+// list() patterns: * matches within a segment, ** crosses /, ? is one
+// non-/ character, everything else is literal
+std::string glob_to_regex_str(const std::string& pattern) {
+    std::string regex_str;
+    regex_str.reserve(pattern.size() * 2);
+
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        char c = pattern[i];
+        switch (c) {
+            case '*':
+                if (i + 1 < pattern.size() && pattern[i + 1] == '*') {
+                    // ** matches anything including /
+                    regex_str += ".*";
+                    ++i;  // Skip next *
+                } else {
+                    // * matches anything except /
+                    regex_str += "[^/]*";
+                }
+                break;
+            case '?':
+                regex_str += "[^/]";
+                break;
+            case '.':
+            case '(':
+            case ')':
+            case '[':
+            case ']':
+            case '{':
+            case '}':
+            case '^':
+            case '$':
+            case '|':
+            case '\\':
+            case '+':
+                regex_str += '\\';
+                regex_str += c;
+                break;
+            default:
+                regex_str += c;
+                break;
+        }
+    }
+
+    return regex_str;
+}
+
+} // namespace
+
+// ============================================================================
+// CompiledPatternList
+// ============================================================================
+
+CompiledPatternList::CompiledPatternList(const std::vector<std::string>& patterns) {
+    std::string alternation;
+
+    for (const auto& pattern : patterns) {
+        if (pattern.find_first_of("*?") == std::string::npos) {
+            // No wildcards: exact match modulo case, one hash probe
+            literals_.insert(to_lower(pattern));
+            continue;
+        }
+
+        std::string re_str = glob_to_regex_str(pattern);
+        try {
+            std::regex probe(re_str, std::regex::icase);
+        } catch (const std::regex_error& e) {
+            // Drop the bad pattern alone, as the per-operation path did
+            spdlog::error("VFS: Invalid pattern '{}': {}", pattern, e.what());
+            continue;
+        }
+
+        if (!alternation.empty()) {
+            alternation += "|";
+        }
+        alternation += "(?:" + re_str + ")";
+    }
+
+    if (!alternation.empty()) {
+        combined_.emplace(alternation, std::regex::icase | std::regex::optimize);
+    }
+}
+
+bool CompiledPatternList::matches(const std::string& path) const {
+    if (!literals_.empty() && literals_.count(to_lower(path)) > 0) {
+        return true;
+    }
+    return combined_.has_value() && std::regex_match(path, *combined_);
+}
+
+VirtualFilesystem::~VirtualFilesystem() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    drop_all_spilled_locked();
+}
+
 void VirtualFilesystem::configure(const nlohmann::json& config) {
     std::lock_guard<std::mutex> lock(mutex_);
 
@@ -55,42 +191,146 @@ void VirtualFilesystem::configure(const nlohmann::json& config) {
         }
     }
 
+    // Tiered storage: cap how much file content stays in the kernel heap
+    if (config.contains("spill") && config["spill"].is_object()) {
+        const auto& spill = config["spill"];
+        spill_enabled_ = spill.value("enabled", true);
+        spill_dir_ = spill.value("directory", default_spill_dir());
+        spill_threshold_bytes_ = spill.value("threshold_bytes", spill_threshold_bytes_);
+        max_resident_bytes_ = spill.value("max_resident_bytes", max_resident_bytes_);
+
+        std::error_code ec;
+        std::filesystem::create_directories(spill_dir_, ec);
+        if (ec) {
+            spdlog::error("VFS: Cannot create spill directory {}: {}",
+                          spill_dir_, ec.message());
+            spill_enabled_ = false;
+        }
+    }
+
+    compile_patterns_locked();
+    enforce_spill_locked();
+
     spdlog::info("VFS: Configured with {} files, {} readonly patterns, {} writable patterns",
                  files_.size(), readonly_patterns_.size(), writable_patterns_.size());
 }
 
 bool VirtualFilesystem::is_enabled() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return !files_.empty() || !readonly_patterns_.empty() ||
-           !writable_patterns_.empty() || !intercept_patterns_.empty();
+    return !files_.empty() || !pending_.empty() || !spilled_.empty() ||
+           !readonly_patterns_.empty() || !writable_patterns_.empty() ||
+           !intercept_patterns_.empty();
 }
 
 bool VirtualFilesystem::exists(const std::string& path) const {
     std::lock_guard<std::mutex> lock(mutex_);
     std::string normalized = normalize_path(path);
-    return files_.find(normalized) != files_.end();
+    return files_.find(normalized) != files_.end() ||
+           pending_.find(normalized) != pending_.end() ||
+           spilled_.find(normalized) != spilled_.end();
 }
 
 std::optional<std::string> VirtualFilesystem::read(const std::string& path) const {
     std::lock_guard<std::mutex> lock(mutex_);
     std::string normalized = normalize_path(path);
 
+    // Spilled files are served straight from the mapping, not faulted
+    // back into the heap
+    if (auto sit = spilled_.find(normalized); sit != spilled_.end()) {
+        read_count_++;
+        bytes_read_ += sit->second.len;
+        return std::string(sit->second.base, sit->second.len);
+    }
+
+    materialize_locked(normalized);
+
     auto it = files_.find(normalized);
     if (it == files_.end()) {
         spdlog::debug("VFS: File not found: {}", normalized);
         return std::nullopt;
     }
 
+    it->second.last_access = ++access_clock_;
     read_count_++;
-    bytes_read_ += it->second.content.size();
-    spdlog::debug("VFS: Read {} bytes from {}", it->second.content.size(), normalized);
-    return it->second.content;
+    bytes_read_ += it->second.size();
+    spdlog::debug("VFS: Read {} bytes from {}", it->second.size(), normalized);
+    return it->second.materialize();
+}
+
+std::optional<std::string> VirtualFilesystem::read_range(const std::string& path,
+                                                         size_t offset, size_t length) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string normalized = normalize_path(path);
+
+    if (auto sit = spilled_.find(normalized); sit != spilled_.end()) {
+        if (offset >= sit->second.len) {
+            read_count_++;
+            return std::string();
+        }
+        length = std::min(length, sit->second.len - offset);
+        read_count_++;
+        bytes_read_ += length;
+        return std::string(sit->second.base + offset, length);
+    }
+
+    materialize_locked(normalized);
+
+    auto it = files_.find(normalized);
+    if (it == files_.end()) {
+        spdlog::debug("VFS: File not found: {}", normalized);
+        return std::nullopt;
+    }
+
+    it->second.last_access = ++access_clock_;
+    std::string out = it->second.read_range(offset, length);
+    read_count_++;
+    bytes_read_ += out.size();
+    return out;
 }
 
 bool VirtualFilesystem::write(const std::string& path, const std::string& content, bool append) {
     std::lock_guard<std::mutex> lock(mutex_);
     std::string normalized = normalize_path(path);
 
+    // Writes to spilled files: appends fault the content back in,
+    // overwrites just discard the backing file
+    if (auto sit = spilled_.find(normalized); sit != spilled_.end()) {
+        if (sit->second.mode == "r") {
+            spdlog::warn("VFS: Attempted write to read-only file: {}", normalized);
+            return false;
+        }
+        if (append) {
+            fault_in_locked(normalized);
+        } else {
+            VirtualFile file(content, sit->second.mode);
+            file.created_at = sit->second.created_at;
+            drop_spilled_locked(normalized);
+            files_[normalized] = std::move(file);
+            write_count_++;
+            bytes_written_ += content.size();
+            enforce_spill_locked();
+            return true;
+        }
+    }
+
+    // Appends need the old bytes; plain overwrites of a pending file
+    // only need its metadata, so skip the copy and replace in place
+    if (auto pending_it = pending_.find(normalized); pending_it != pending_.end()) {
+        if (append) {
+            materialize_locked(normalized);
+        } else if (pending_it->second.mode == "r") {
+            spdlog::warn("VFS: Attempted write to read-only file: {}", normalized);
+            return false;
+        } else {
+            VirtualFile file(content, pending_it->second.mode);
+            pending_.erase(pending_it);
+            files_[normalized] = std::move(file);
+            write_count_++;
+            bytes_written_ += content.size();
+            return true;
+        }
+    }
+
     // Check if file exists and is read-only
     auto it = files_.find(normalized);
     if (it != files_.end() && it->second.mode == "r") {
@@ -99,7 +339,7 @@ bool VirtualFilesystem::write(const std::string& path, const std::string& conten
     }
 
     // Check writable patterns
-    if (!matches_any(normalized, writable_patterns_) && it == files_.end()) {
+    if (!writable_matcher_.matches(normalized) && it == files_.end()) {
         // File doesn't exist and path doesn't match writable patterns
         // Allow creation only if there are no writable patterns (open access)
         if (!writable_patterns_.empty()) {
@@ -108,21 +348,24 @@ bool VirtualFilesystem::write(const std::string& path, const std::string& conten
         }
     }
 
-    // Create or update file
+    // Create or update file. Chunks are immutable, so updates push or
+    // swap in fresh chunks; any snapshot holding the old ones keeps them
     if (it == files_.end()) {
         files_[normalized] = VirtualFile(content, "rw");
     } else {
         if (append) {
-            it->second.content += content;
+            it->second.append(content);
         } else {
-            it->second.content = content;
+            it->second.assign(content);
         }
         it->second.modified_at = std::chrono::steady_clock::now();
     }
 
+    files_[normalized].last_access = ++access_clock_;
     write_count_++;
     bytes_written_ += content.size();
     spdlog::debug("VFS: Wrote {} bytes to {} (append={})", content.size(), normalized, append);
+    enforce_spill_locked();
     return true;
 }
 
@@ -130,6 +373,28 @@ bool VirtualFilesystem::remove(const std::string& path) {
     std::lock_guard<std::mutex> lock(mutex_);
     std::string normalized = normalize_path(path);
 
+    // Deleting a spilled file just drops its backing file
+    if (auto sit = spilled_.find(normalized); sit != spilled_.end()) {
+        if (sit->second.mode == "r") {
+            spdlog::warn("VFS: Attempted delete of read-only file: {}", normalized);
+            return false;
+        }
+        drop_spilled_locked(normalized);
+        spdlog::debug("VFS: Deleted file: {}", normalized);
+        return true;
+    }
+
+    // Deleting a pending file never needs its content
+    if (auto pending_it = pending_.find(normalized); pending_it != pending_.end()) {
+        if (pending_it->second.mode == "r") {
+            spdlog::warn("VFS: Attempted delete of read-only file: {}", normalized);
+            return false;
+        }
+        pending_.erase(pending_it);
+        spdlog::debug("VFS: Deleted file: {}", normalized);
+        return true;
+    }
+
     auto it = files_.find(normalized);
     if (it == files_.end()) {
         return false;
@@ -154,6 +419,16 @@ std::vector<std::string> VirtualFilesystem::list(const std::string& pattern) con
             result.push_back(path);
         }
     }
+    for (const auto& [path, _] : pending_) {
+        if (pattern == "*" || pattern == "/**" || matches_pattern(path, pattern)) {
+            result.push_back(path);
+        }
+    }
+    for (const auto& [path, _] : spilled_) {
+        if (pattern == "*" || pattern == "/**" || matches_pattern(path, pattern)) {
+            result.push_back(path);
+        }
+    }
 
     std::sort(result.begin(), result.end());
     return result;
@@ -163,6 +438,30 @@ std::optional<nlohmann::json> VirtualFilesystem::stat(const std::string& path) c
     std::lock_guard<std::mutex> lock(mutex_);
     std::string normalized = normalize_path(path);
 
+    // Spilled files answer from their mapping metadata
+    if (auto sit = spilled_.find(normalized); sit != spilled_.end()) {
+        nlohmann::json info;
+        info["path"] = normalized;
+        info["size"] = sit->second.len;
+        info["mode"] = sit->second.mode;
+        info["created_at"] = std::chrono::duration_cast<std::chrono::milliseconds>(
+            sit->second.created_at.time_since_epoch()).count();
+        info["modified_at"] = std::chrono::duration_cast<std::chrono::milliseconds>(
+            sit->second.modified_at.time_since_epoch()).count();
+        return info;
+    }
+
+    // Pending files answer from the snapshot table; no content copy
+    if (auto pending_it = pending_.find(normalized); pending_it != pending_.end()) {
+        nlohmann::json info;
+        info["path"] = normalized;
+        info["size"] = pending_it->second.size;
+        info["mode"] = pending_it->second.mode;
+        info["created_at"] = 0;
+        info["modified_at"] = 0;
+        return info;
+    }
+
     auto it = files_.find(normalized);
     if (it == files_.end()) {
         return std::nullopt;
@@ -170,7 +469,7 @@ std::optional<nlohmann::json> VirtualFilesystem::stat(const std::string& path) c
 
     nlohmann::json info;
     info["path"] = normalized;
-    info["size"] = it->second.content.size();
+    info["size"] = it->second.size();
     info["mode"] = it->second.mode;
 
     auto created_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -193,13 +492,19 @@ bool VirtualFilesystem::is_writable(const std::string& path) const {
     if (it != files_.end()) {
         return it->second.mode != "r";
     }
+    if (auto pending_it = pending_.find(normalized); pending_it != pending_.end()) {
+        return pending_it->second.mode != "r";
+    }
+    if (auto sit = spilled_.find(normalized); sit != spilled_.end()) {
+        return sit->second.mode != "r";
+    }
 
     // Check writable patterns
     if (writable_patterns_.empty()) {
         return true;  // No restrictions = all writable
     }
 
-    return matches_any(normalized, writable_patterns_);
+    return writable_matcher_.matches(normalized);
 }
 
 bool VirtualFilesystem::is_readable(const std::string& path) const {
@@ -207,13 +512,15 @@ bool VirtualFilesystem::is_readable(const std::string& path) const {
     std::string normalized = normalize_path(path);
 
     // All existing files are readable
-    if (files_.find(normalized) != files_.end()) {
+    if (files_.find(normalized) != files_.end() ||
+        pending_.find(normalized) != pending_.end() ||
+        spilled_.find(normalized) != spilled_.end()) {
         return true;
     }
 
     // If file doesn't exist, check if it would be in a readable location
-    return matches_any(normalized, readonly_patterns_) ||
-           matches_any(normalized, writable_patterns_);
+    return readonly_matcher_.matches(normalized) ||
+           writable_matcher_.matches(normalized);
 }
 
 bool VirtualFilesystem::should_intercept(const std::string& path) const {
@@ -221,23 +528,26 @@ bool VirtualFilesystem::should_intercept(const std::string& path) const {
     std::string normalized = normalize_path(path);
 
     // If file exists in VFS, always intercept
-    if (files_.find(normalized) != files_.end()) {
+    if (files_.find(normalized) != files_.end() ||
+        pending_.find(normalized) != pending_.end() ||
+        spilled_.find(normalized) != spilled_.end()) {
         return true;
     }
 
     // Check intercept patterns
-    return matches_any(normalized, intercept_patterns_);
+    return intercept_matcher_.matches(normalized);
 }
 
 nlohmann::json VirtualFilesystem::to_json() const {
     std::lock_guard<std::mutex> lock(mutex_);
+    materialize_all_locked();
 
     nlohmann::json j;
     nlohmann::json files_json = nlohmann::json::object();
 
     for (const auto& [path, file] : files_) {
         nlohmann::json file_json;
-        file_json["content"] = file.content;
+        file_json["content"] = file.materialize();
         file_json["mode"] = file.mode;
         file_json["created_at"] = std::chrono::duration_cast<std::chrono::milliseconds>(
             file.created_at.time_since_epoch()).count();
@@ -258,15 +568,15 @@ void VirtualFilesystem::from_json(const nlohmann::json& j) {
     std::lock_guard<std::mutex> lock(mutex_);
 
     files_.clear();
+    drop_all_spilled_locked();
     readonly_patterns_.clear();
     writable_patterns_.clear();
     intercept_patterns_.clear();
 
     if (j.contains("files") && j["files"].is_object()) {
         for (auto& [path, file_json] : j["files"].items()) {
-            VirtualFile file;
-            file.content = file_json.value("content", "");
-            file.mode = file_json.value("mode", "rw");
+            VirtualFile file(file_json.value("content", ""),
+                             file_json.value("mode", "rw"));
             // Timestamps from JSON or use current time
             files_[path] = file;
         }
@@ -290,15 +600,69 @@ void VirtualFilesystem::from_json(const nlohmann::json& j) {
         }
     }
 
+    compile_patterns_locked();
     spdlog::info("VFS: Restored {} files from snapshot", files_.size());
 }
 
+VfsSnapshot VirtualFilesystem::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    materialize_all_locked();
+
+    VfsSnapshot snap;
+    snap.files = files_;  // copies metadata; content chunks are shared
+    snap.readonly_patterns = readonly_patterns_;
+    snap.writable_patterns = writable_patterns_;
+    snap.intercept_patterns = intercept_patterns_;
+    return snap;
+}
+
+void VirtualFilesystem::restore(const VfsSnapshot& snap) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    pending_.clear();
+    lazy_source_.reset();
+    drop_all_spilled_locked();
+    files_ = snap.files;
+    readonly_patterns_ = snap.readonly_patterns;
+    writable_patterns_ = snap.writable_patterns;
+    intercept_patterns_ = snap.intercept_patterns;
+    compile_patterns_locked();
+
+    spdlog::info("VFS: Restored {} files from CoW snapshot", files_.size());
+}
+
+void VirtualFilesystem::restore_lazy(std::shared_ptr<snapshot_file::MappedSnapshot> source,
+                                     std::vector<std::string> readonly_patterns,
+                                     std::vector<std::string> writable_patterns,
+                                     std::vector<std::string> intercept_patterns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    files_.clear();
+    pending_.clear();
+    drop_all_spilled_locked();
+    readonly_patterns_ = std::move(readonly_patterns);
+    writable_patterns_ = std::move(writable_patterns);
+    intercept_patterns_ = std::move(intercept_patterns);
+
+    for (const auto& info : source->files()) {
+        pending_[info.path] = PendingFile{info.mode, info.hash, info.size};
+    }
+    lazy_source_ = std::move(source);
+    compile_patterns_locked();
+
+    spdlog::info("VFS: Restored {} files lazily from mapped snapshot", pending_.size());
+}
+
 void VirtualFilesystem::clear() {
     std::lock_guard<std::mutex> lock(mutex_);
     files_.clear();
+    pending_.clear();
+    lazy_source_.reset();
+    drop_all_spilled_locked();
     readonly_patterns_.clear();
     writable_patterns_.clear();
     intercept_patterns_.clear();
+    compile_patterns_locked();
     read_count_ = 0;
     write_count_ = 0;
     bytes_read_ = 0;
@@ -309,7 +673,7 @@ nlohmann::json VirtualFilesystem::get_metrics() const {
     std::lock_guard<std::mutex> lock(mutex_);
 
     nlohmann::json metrics;
-    metrics["file_count"] = files_.size();
+    metrics["file_count"] = files_.size() + pending_.size() + spilled_.size();
     metrics["read_count"] = read_count_;
     metrics["write_count"] = write_count_;
     metrics["bytes_read"] = bytes_read_;
@@ -317,57 +681,32 @@ nlohmann::json VirtualFilesystem::get_metrics() const {
 
     uint64_t total_size = 0;
     for (const auto& [_, file] : files_) {
-        total_size += file.content.size();
+        total_size += file.size();
+    }
+    for (const auto& [_, pending] : pending_) {
+        total_size += pending.size;
     }
+    uint64_t spilled_bytes = 0;
+    for (const auto& [_, spilled] : spilled_) {
+        spilled_bytes += spilled.len;
+    }
+    total_size += spilled_bytes;
+
     metrics["total_size_bytes"] = total_size;
+    metrics["pending_file_count"] = pending_.size();
+    metrics["spilled_file_count"] = spilled_.size();
+    metrics["spilled_bytes"] = spilled_bytes;
+    metrics["spill_count"] = spill_count_;
+    metrics["fault_in_count"] = fault_in_count_;
 
     return metrics;
 }
 
 bool VirtualFilesystem::matches_pattern(const std::string& path, const std::string& pattern) const {
-    // Convert glob pattern to regex
-    std::string regex_str;
-    regex_str.reserve(pattern.size() * 2);
-
-    for (size_t i = 0; i < pattern.size(); ++i) {
-        char c = pattern[i];
-        switch (c) {
-            case '*':
-                if (i + 1 < pattern.size() && pattern[i + 1] == '*') {
-                    // ** matches anything including /
-                    regex_str += ".*";
-                    ++i;  // Skip next *
-                } else {
-                    // * matches anything except /
-                    regex_str += "[^/]*";
-                }
-                break;
-            case '?':
-                regex_str += "[^/]";
-                break;
-            case '.':
-            case '(':
-            case ')':
-            case '[':
-            case ']':
-            case '{':
-            case '}':
-            case '^':
-            case '$':
-            case '|':
-            case '\\':
-            case '+':
-                regex_str += '\\';
-                regex_str += c;
-                break;
-            default:
-                regex_str += c;
-                break;
-        }
-    }
-
+    // Ad-hoc patterns (list()) still compile per call; the configured
+    // access-control lists go through the compiled matchers instead
     try {
-        std::regex re(regex_str, std::regex::icase);
+        std::regex re(glob_to_regex_str(pattern), std::regex::icase);
         return std::regex_match(path, re);
     } catch (const std::regex_error& e) {
         spdlog::error("VFS: Invalid pattern '{}': {}", pattern, e.what());
@@ -375,14 +714,160 @@ bool VirtualFilesystem::matches_pattern(const std::string& path, const std::stri
     }
 }
 
-bool VirtualFilesystem::matches_any(const std::string& path,
-                                    const std::vector<std::string>& patterns) const {
-    for (const auto& pattern : patterns) {
-        if (matches_pattern(path, pattern)) {
-            return true;
+void VirtualFilesystem::compile_patterns_locked() {
+    readonly_matcher_ = CompiledPatternList(readonly_patterns_);
+    writable_matcher_ = CompiledPatternList(writable_patterns_);
+    intercept_matcher_ = CompiledPatternList(intercept_patterns_);
+}
+
+void VirtualFilesystem::materialize_locked(const std::string& normalized) const {
+    auto it = pending_.find(normalized);
+    if (it == pending_.end()) {
+        return;
+    }
+
+    std::string content;
+    if (!lazy_source_ || !lazy_source_->read_content(it->second.hash, content)) {
+        // Chain was validated at open, so this indicates corruption;
+        // surface an empty file rather than wedge the world
+        spdlog::error("VFS: Failed to materialize {} from snapshot", normalized);
+    }
+
+    files_[normalized] = VirtualFile(content, it->second.mode);
+    pending_.erase(it);
+
+    if (pending_.empty()) {
+        lazy_source_.reset();  // drop the mapping once fully materialized
+    }
+}
+
+void VirtualFilesystem::materialize_all_locked() const {
+    while (!pending_.empty()) {
+        materialize_locked(pending_.begin()->first);
+    }
+    // Serialization needs every byte in the heap; spilled files fault
+    // back in and may re-spill on the next write
+    while (!spilled_.empty()) {
+        fault_in_locked(spilled_.begin()->first);
+    }
+}
+
+bool VirtualFilesystem::spill_locked(const std::string& normalized) const {
+    auto it = files_.find(normalized);
+    if (it == files_.end() || it->second.size() == 0) {
+        return false;
+    }
+
+    std::string backing = spill_dir_ + "/vfs-" + std::to_string(next_spill_num_++) + ".bin";
+    int fd = ::open(backing.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        spdlog::error("VFS: Cannot create spill file {}", backing);
+        return false;
+    }
+
+    for (const auto& chunk : it->second.chunks) {
+        if (!write_all_fd(fd, chunk->data(), chunk->size())) {
+            spdlog::error("VFS: Spill write failed for {}", normalized);
+            ::close(fd);
+            ::unlink(backing.c_str());
+            return false;
         }
     }
-    return false;
+
+    void* base = ::mmap(nullptr, it->second.size(), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        spdlog::error("VFS: mmap failed for spill file {}", backing);
+        ::unlink(backing.c_str());
+        return false;
+    }
+
+    SpilledFile spilled;
+    spilled.backing_path = std::move(backing);
+    spilled.base = static_cast<const char*>(base);
+    spilled.len = it->second.size();
+    spilled.mode = it->second.mode;
+    spilled.created_at = it->second.created_at;
+    spilled.modified_at = it->second.modified_at;
+    spilled_[normalized] = std::move(spilled);
+    files_.erase(it);
+    spill_count_++;
+
+    spdlog::debug("VFS: Spilled {} ({} bytes) to disk", normalized, spilled_[normalized].len);
+    return true;
+}
+
+void VirtualFilesystem::fault_in_locked(const std::string& normalized) const {
+    auto it = spilled_.find(normalized);
+    if (it == spilled_.end()) {
+        return;
+    }
+
+    VirtualFile file(std::string(it->second.base, it->second.len), it->second.mode);
+    file.created_at = it->second.created_at;
+    file.modified_at = it->second.modified_at;
+    file.last_access = ++access_clock_;
+    files_[normalized] = std::move(file);
+    fault_in_count_++;
+    drop_spilled_locked(normalized);
+}
+
+void VirtualFilesystem::enforce_spill_locked() const {
+    if (!spill_enabled_) {
+        return;
+    }
+
+    // Threshold pass: oversized files always live on disk
+    std::vector<std::string> oversized;
+    uint64_t resident = 0;
+    for (const auto& [path, file] : files_) {
+        if (file.size() >= spill_threshold_bytes_) {
+            oversized.push_back(path);
+        } else {
+            resident += file.size();
+        }
+    }
+    for (const auto& path : oversized) {
+        if (!spill_locked(path)) {
+            resident += files_.at(path).size();  // stays resident
+        }
+    }
+
+    // LRU pass: evict the coldest files until the heap budget holds
+    while (resident > max_resident_bytes_) {
+        const std::string* victim = nullptr;
+        uint64_t oldest = UINT64_MAX;
+        for (const auto& [path, file] : files_) {
+            if (file.size() > 0 && file.last_access < oldest) {
+                oldest = file.last_access;
+                victim = &path;
+            }
+        }
+        if (!victim) {
+            break;
+        }
+        uint64_t freed = files_.at(*victim).size();
+        if (!spill_locked(*victim)) {
+            break;  // disk is unhappy; keep the rest resident
+        }
+        resident -= freed;
+    }
+}
+
+void VirtualFilesystem::drop_spilled_locked(const std::string& normalized) const {
+    auto it = spilled_.find(normalized);
+    if (it == spilled_.end()) {
+        return;
+    }
+    ::munmap(const_cast<char*>(it->second.base), it->second.len);
+    ::unlink(it->second.backing_path.c_str());
+    spilled_.erase(it);
+}
+
+void VirtualFilesystem::drop_all_spilled_locked() const {
+    while (!spilled_.empty()) {
+        drop_spilled_locked(spilled_.begin()->first);
+    }
 }
 
 std::string VirtualFilesystem::normalize_path(const std::string& path) const {
@@ -5,8 +5,11 @@
  * Agents in a world see this virtual filesystem instead of the real one.
  */
 #pragma once
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <chrono>
 #include <optional>
@@ -16,12 +19,31 @@
 
 namespace clove::worlds {
 
+namespace snapshot_file {
+class MappedSnapshot;
+}
+
 /**
- * A virtual file stored in memory
+ * A virtual file stored in memory.
+ *
+ * Content is a rope: an ordered list of immutable refcounted chunks.
+ * Appends push a chunk instead of copying the file, so building a
+ * multi-megabyte log by repeated append is O(appended bytes) per
+ * write, and snapshots share chunks with the live filesystem
+ * (copy-on-write). Copying a VirtualFile copies pointers, never the
+ * bytes. The chunk list is compacted into a single fresh chunk once it
+ * grows past MAX_CHUNKS, which keeps reads cheap without touching
+ * chunks that snapshots may still reference.
  */
 struct VirtualFile {
-    std::string content;
+    // Compaction threshold: bounds per-file chunk count at the cost of
+    // one O(file size) collapse every MAX_CHUNKS appends
+    static constexpr size_t MAX_CHUNKS = 1024;
+
+    std::vector<std::shared_ptr<const std::string>> chunks;
+    size_t total_size = 0;
     std::string mode;  // "r" = readonly, "rw" = read-write
+    uint64_t last_access = 0;  // LRU stamp for spill eviction
     std::chrono::steady_clock::time_point created_at;
     std::chrono::steady_clock::time_point modified_at;
 
@@ -31,10 +53,101 @@ struct VirtualFile {
         , modified_at(std::chrono::steady_clock::now()) {}
 
     VirtualFile(const std::string& content_, const std::string& mode_ = "rw")
-        : content(content_)
-        , mode(mode_)
+        : mode(mode_)
         , created_at(std::chrono::steady_clock::now())
-        , modified_at(std::chrono::steady_clock::now()) {}
+        , modified_at(std::chrono::steady_clock::now()) {
+        assign(content_);
+    }
+
+    size_t size() const { return total_size; }
+
+    /** Replace content with a single fresh chunk */
+    void assign(const std::string& content) {
+        chunks.clear();
+        chunks.push_back(std::make_shared<const std::string>(content));
+        total_size = content.size();
+    }
+
+    /** Append a chunk; compacts when the list grows past MAX_CHUNKS */
+    void append(const std::string& content) {
+        chunks.push_back(std::make_shared<const std::string>(content));
+        total_size += content.size();
+        if (chunks.size() > MAX_CHUNKS) {
+            assign(materialize());
+        }
+    }
+
+    /** Flatten the rope into one string (O(file size)) */
+    std::string materialize() const {
+        std::string out;
+        out.reserve(total_size);
+        for (const auto& chunk : chunks) {
+            out += *chunk;
+        }
+        return out;
+    }
+
+    /** Copy out [offset, offset+length), clamped to the file size */
+    std::string read_range(size_t offset, size_t length) const {
+        std::string out;
+        if (offset >= total_size) {
+            return out;
+        }
+        length = std::min(length, total_size - offset);
+        out.reserve(length);
+        size_t pos = 0;
+        for (const auto& chunk : chunks) {
+            if (out.size() == length) {
+                break;
+            }
+            size_t chunk_end = pos + chunk->size();
+            if (chunk_end > offset) {
+                size_t start = offset > pos ? offset - pos : 0;
+                size_t take = std::min(chunk->size() - start, length - out.size());
+                out.append(*chunk, start, take);
+            }
+            pos = chunk_end;
+        }
+        return out;
+    }
+};
+
+/**
+ * A pattern list compiled once into a single matcher.
+ *
+ * Access-control checks used to convert every glob pattern to a
+ * std::regex per file operation; with long pattern lists that regex
+ * construction dominates VFS-heavy profiles. This compiles the list at
+ * configure time instead: wildcard-free patterns land in a hash set
+ * probed first, the rest fold into one alternation regex (a single
+ * automaton) evaluated in one pass per path. Same shape as the kernel
+ * permissions matcher, but per-world and rebuilt on reconfigure.
+ */
+class CompiledPatternList {
+public:
+    CompiledPatternList() = default;
+    explicit CompiledPatternList(const std::vector<std::string>& patterns);
+
+    /** Does the path match any pattern in the list? (case-insensitive) */
+    bool matches(const std::string& path) const;
+
+private:
+    std::unordered_set<std::string> literals_;  // lowercased
+    std::optional<std::regex> combined_;
+};
+
+/**
+ * A point-in-time capture of a VirtualFilesystem.
+ *
+ * Holds the file table and pattern lists by value, but file content is
+ * shared with the live filesystem via VirtualFile's refcounted chunks —
+ * taking one costs O(#files) map entries regardless of content size.
+ */
+struct VfsSnapshot {
+    std::unordered_map<std::string, VirtualFile> files;
+    std::vector<std::string> readonly_patterns;
+    std::vector<std::string> writable_patterns;
+    std::vector<std::string> intercept_patterns;
 };
 
 /**
@@ -44,6 +157,7 @@ struct VirtualFile {
 class VirtualFilesystem {
 public:
     VirtualFilesystem() = default;
+    ~VirtualFilesystem();
 
     /**
      * Initialize from JSON configuration
@@ -53,7 +167,12 @@ public:
      *     "/path/to/file": {"content": "...", "mode": "r"}
      *   },
      *   "readonly_patterns": ["/etc/*"],
-     *   "writable_patterns": ["/data/*", "/tmp/*"]
+     *   "writable_patterns": ["/data/*", "/tmp/*"],
+     *   "spill": {
+     *     "directory": "/var/tmp/clove-spill",   // default: under temp dir
+     *     "threshold_bytes": 4194304,            // spill files this big
+     *     "max_resident_bytes": 268435456        // LRU-spill beyond this
+     *   }
      * }
      */
     void configure(const nlohmann::json& config);
@@ -74,6 +193,14 @@ public:
      */
     std::optional<std::string> read(const std::string& path) const;
 
+    /**
+     * Read [offset, offset+length) of a file without flattening it.
+     * Returns nullopt if the file doesn't exist; the result is clamped
+     * to the file size.
+     */
+    std::optional<std::string> read_range(const std::string& path,
+                                          size_t offset, size_t length) const;
+
     /**
      * Write content to a virtual file
      * Creates the file if it doesn't exist
@@ -123,6 +250,28 @@ public:
      */
     void from_json(const nlohmann::json& j);
 
+    /**
+     * Capture a copy-on-write snapshot: file metadata is copied, file
+     * content is shared. Cost is independent of total content size.
+     */
+    VfsSnapshot snapshot() const;
+
+    /**
+     * Restore state from a copy-on-write snapshot
+     */
+    void restore(const VfsSnapshot& snap);
+
+    /**
+     * Restore from a mapped on-disk snapshot without copying content.
+     * Files stay as table entries backed by the mapping and are
+     * materialized into memory on first content access; exists/stat/
+     * list answer straight from the table.
+     */
+    void restore_lazy(std::shared_ptr<snapshot_file::MappedSnapshot> source,
+                      std::vector<std::string> readonly_patterns,
+                      std::vector<std::string> writable_patterns,
+                      std::vector<std::string> intercept_patterns);
+
     /**
      * Clear all files and patterns
      */
@@ -135,16 +284,59 @@ public:
 
 private:
     mutable std::mutex mutex_;
-    std::unordered_map<std::string, VirtualFile> files_;
+    // mutable: const readers may materialize lazily-restored files
+    mutable std::unordered_map<std::string, VirtualFile> files_;
+
+    // Files from a lazily-restored snapshot that have not been touched
+    // yet: metadata lives here, content stays in the mapped file until
+    // materialize_locked copies it into files_
+    struct PendingFile {
+        std::string mode;
+        uint64_t hash = 0;
+        uint64_t size = 0;
+    };
+    mutable std::unordered_map<std::string, PendingFile> pending_;
+    mutable std::shared_ptr<snapshot_file::MappedSnapshot> lazy_source_;
+
+    // Files evicted from the heap to per-file backing files. Reads are
+    // served straight from the read-only mapping (the page cache faults
+    // pages in and can drop them again under pressure), so a spilled
+    // file costs disk, not kernel heap. Writes fault the file back into
+    // files_ first; serialization and CoW snapshots do the same.
+    struct SpilledFile {
+        std::string backing_path;
+        const char* base = nullptr;
+        size_t len = 0;
+        std::string mode;
+        std::chrono::steady_clock::time_point created_at;
+        std::chrono::steady_clock::time_point modified_at;
+    };
+    mutable std::unordered_map<std::string, SpilledFile> spilled_;
+
+    bool spill_enabled_ = false;
+    std::string spill_dir_;
+    uint64_t spill_threshold_bytes_ = 4 * 1024 * 1024;
+    uint64_t max_resident_bytes_ = 256 * 1024 * 1024;
+    mutable uint64_t next_spill_num_ = 1;
+    mutable uint64_t access_clock_ = 0;
+
     std::vector<std::string> readonly_patterns_;
     std::vector<std::string> writable_patterns_;
     std::vector<std::string> intercept_patterns_;  // Paths to intercept
 
+    // Compiled forms of the three lists above; rebuilt whenever the
+    // pattern vectors change (configure, restore, from_json)
+    CompiledPatternList readonly_matcher_;
+    CompiledPatternList writable_matcher_;
+    CompiledPatternList intercept_matcher_;
+
     // Metrics
     mutable uint64_t read_count_ = 0;
     mutable uint64_t write_count_ = 0;
     mutable uint64_t bytes_read_ = 0;
     mutable uint64_t bytes_written_ = 0;
+    mutable uint64_t spill_count_ = 0;
+    mutable uint64_t fault_in_count_ = 0;
 
     /**
      * Check if path matches a glob pattern
@@ -153,14 +345,53 @@ private:
     bool matches_pattern(const std::string& path, const std::string& pattern) const;
 
     /**
-     * Check if path matches any pattern in a list
+     * Rebuild the compiled matchers from the pattern vectors.
+     * Caller holds mutex_.
      */
-    bool matches_any(const std::string& path, const std::vector<std::string>& patterns) const;
+    void compile_patterns_locked();
 
     /**
      * Normalize a path (remove ./, resolve ../, ensure leading /)
      */
     std::string normalize_path(const std::string& path) const;
+
+    /**
+     * Copy one pending file's content out of the mapped snapshot into
+     * files_. Caller holds mutex_.
+     */
+    void materialize_locked(const std::string& normalized) const;
+
+    /**
+     * Materialize every pending file (serialization, CoW snapshots).
+     * Caller holds mutex_.
+     */
+    void materialize_all_locked() const;
+
+    /**
+     * Evict one resident file to a backing file. Caller holds mutex_.
+     * Returns false if the file is missing or the disk write fails (the
+     * file then simply stays resident).
+     */
+    bool spill_locked(const std::string& normalized) const;
+
+    /**
+     * Copy a spilled file back into files_ and drop its backing file.
+     * Caller holds mutex_.
+     */
+    void fault_in_locked(const std::string& normalized) const;
+
+    /**
+     * Apply the spill policy: files over the size threshold spill, then
+     * the coldest files spill until the resident set fits the budget.
+     * Caller holds mutex_.
+     */
+    void enforce_spill_locked() const;
+
+    /**
+     * Unmap and unlink one / every backing file. Caller holds mutex_.
+     */
+    void drop_spilled_locked(const std::string& normalized) const;
+    void drop_all_spilled_locked() const;
 };
 
 } // namespace clove::worlds
@@ -2,6 +2,7 @@
  * AgentOS World Simulation Engine Implementation
  */
 #include "worlds/world_engine.hpp"
+#include "worlds/snapshot_file.hpp"
 #include <spdlog/spdlog.h>
 #include <algorithm>
 #include <sstream>
@@ -582,6 +583,80 @@ bool ChaosEngine::matches_pattern(const std::string& str, const std::string& pat
     }
 }
 
+// ============================================================================
+// VirtualClock Implementation
+// ============================================================================
+
+void VirtualClock::configure(const nlohmann::json& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    base_virtual_ms_ = now_ms_locked();
+    anchor_ = std::chrono::steady_clock::now();
+    scale_ = std::max(config.value("time_scale", 1.0), 0.0);
+}
+
+uint64_t VirtualClock::now_ms_locked() const {
+    auto wall_elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - anchor_).count();
+    return base_virtual_ms_ + static_cast<uint64_t>(wall_elapsed * scale_);
+}
+
+uint64_t VirtualClock::now_ms() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return now_ms_locked();
+}
+
+double VirtualClock::time_scale() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return scale_;
+}
+
+void VirtualClock::set_time_scale(double scale) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Re-anchor so time already elapsed keeps its old scale
+    base_virtual_ms_ = now_ms_locked();
+    anchor_ = std::chrono::steady_clock::now();
+    scale_ = std::max(scale, 0.0);
+}
+
+void VirtualClock::advance(uint64_t virtual_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    base_virtual_ms_ += virtual_ms;
+}
+
+std::chrono::milliseconds VirtualClock::wall_delay(uint64_t virtual_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (scale_ <= 0.0) {
+        // Frozen clock: the delay is consumed as a jump, not a sleep
+        base_virtual_ms_ += virtual_ms;
+        return std::chrono::milliseconds(0);
+    }
+
+    // Virtual time accrues from the scaled wall sleep itself; sub-ms
+    // remainders are dropped, which only matters at extreme scales
+    return std::chrono::milliseconds(
+        static_cast<int64_t>(static_cast<double>(virtual_ms) / scale_));
+}
+
+nlohmann::json VirtualClock::to_json() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    nlohmann::json j;
+    j["time_scale"] = scale_;
+    j["virtual_ms"] = now_ms_locked();
+    return j;
+}
+
+void VirtualClock::from_json(const nlohmann::json& j) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    scale_ = std::max(j.value("time_scale", 1.0), 0.0);
+    base_virtual_ms_ = j.value("virtual_ms", 0ull);
+    anchor_ = std::chrono::steady_clock::now();
+}
+
 // ============================================================================
 // World Implementation
 // ============================================================================
@@ -612,6 +687,10 @@ void World::configure(const nlohmann::json& config) {
         chaos_.configure(config["chaos"]);
     }
 
+    if (config.contains("clock")) {
+        clock_.configure(config["clock"]);
+    }
+
     spdlog::info("World '{}': Configured", id_);
 }
 
@@ -681,6 +760,7 @@ nlohmann::json World::to_json() const {
     j["vfs"] = vfs_.to_json();
     j["network"] = network_.to_json();
     j["chaos"] = chaos_.to_json();
+    j["clock"] = clock_.to_json();
     j["agents"] = agents_;
 
     return j;
@@ -708,6 +788,10 @@ void World::from_json(const nlohmann::json& j) {
         chaos_.from_json(j["chaos"]);
     }
 
+    if (j.contains("clock")) {
+        clock_.from_json(j["clock"]);
+    }
+
     agents_.clear();
     if (j.contains("agents") && j["agents"].is_array()) {
         for (const auto& a : j["agents"]) {
@@ -719,6 +803,76 @@ void World::from_json(const nlohmann::json& j) {
     spdlog::info("World '{}': Restored from snapshot", id_);
 }
 
+WorldSnapshot World::capture() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    WorldSnapshot snap;
+    snap.world_id = id_;
+    snap.name = name_;
+    snap.description = description_;
+    snap.config = config_;
+    snap.vfs = vfs_.snapshot();
+    snap.network = network_.to_json();
+    snap.chaos = chaos_.to_json();
+    snap.clock = clock_.to_json();
+    return snap;
+}
+
+void World::restore_from(const WorldSnapshot& snap) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    name_ = snap.name;
+    description_ = snap.description;
+    config_ = snap.config;
+    vfs_.restore(snap.vfs);
+    network_.from_json(snap.network);
+    chaos_.from_json(snap.chaos);
+    clock_.from_json(snap.clock);
+
+    agents_.clear();
+    metrics_.agent_count = 0;
+    spdlog::info("World '{}': Restored from CoW snapshot of '{}'", id_, snap.world_id);
+}
+
+void World::restore_lazy(const nlohmann::json& meta,
+                         std::shared_ptr<snapshot_file::MappedSnapshot> source) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    name_ = meta.value("name", id_);
+    description_ = meta.value("description", "");
+    if (meta.contains("config")) {
+        config_ = meta["config"];
+    }
+    if (meta.contains("network")) {
+        network_.from_json(meta["network"]);
+    }
+    if (meta.contains("chaos")) {
+        chaos_.from_json(meta["chaos"]);
+    }
+    if (meta.contains("clock")) {
+        clock_.from_json(meta["clock"]);
+    }
+
+    auto patterns = [&meta](const char* key) {
+        std::vector<std::string> out;
+        if (meta.contains(key) && meta[key].is_array()) {
+            for (const auto& p : meta[key]) {
+                out.push_back(p.get<std::string>());
+            }
+        }
+        return out;
+    };
+
+    vfs_.restore_lazy(std::move(source),
+                      patterns("readonly_patterns"),
+                      patterns("writable_patterns"),
+                      patterns("intercept_patterns"));
+
+    agents_.clear();
+    metrics_.agent_count = 0;
+    spdlog::info("World '{}': Restored lazily from snapshot file", id_);
+}
+
 // ============================================================================
 // WorldEngine Implementation
 // ============================================================================
@@ -729,7 +883,7 @@ std::optional<WorldId> WorldEngine::create_world(const std::string& name,
 
     WorldId id = generate_world_id(name);
 
-    auto world = std::make_unique<World>(id);
+    auto world = std::make_shared<World>(id);
     world->configure(config);
 
     worlds_[id] = std::move(world);
@@ -766,10 +920,18 @@ bool WorldEngine::destroy_world(const WorldId& world_id, bool force) {
 }
 
 std::vector<nlohmann::json> WorldEngine::list_worlds() const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    // Snapshot the map, then query each world outside the engine lock
+    std::vector<std::pair<WorldId, std::shared_ptr<World>>> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        snapshot.reserve(worlds_.size());
+        for (const auto& [id, world] : worlds_) {
+            snapshot.emplace_back(id, world);
+        }
+    }
 
     std::vector<nlohmann::json> result;
-    for (const auto& [id, world] : worlds_) {
+    for (const auto& [id, world] : snapshot) {
         nlohmann::json info;
         info["id"] = id;
         info["name"] = world->name();
@@ -788,16 +950,16 @@ std::vector<nlohmann::json> WorldEngine::list_worlds() const {
     return result;
 }
 
-World* WorldEngine::get_world(const WorldId& world_id) {
+std::shared_ptr<World> WorldEngine::get_world(const WorldId& world_id) {
     std::lock_guard<std::mutex> lock(mutex_);
     auto it = worlds_.find(world_id);
-    return (it != worlds_.end()) ? it->second.get() : nullptr;
+    return (it != worlds_.end()) ? it->second : nullptr;
 }
 
-const World* WorldEngine::get_world(const WorldId& world_id) const {
+std::shared_ptr<const World> WorldEngine::get_world(const WorldId& world_id) const {
     std::lock_guard<std::mutex> lock(mutex_);
     auto it = worlds_.find(world_id);
-    return (it != worlds_.end()) ? it->second.get() : nullptr;
+    return (it != worlds_.end()) ? it->second : nullptr;
 }
 
 bool WorldEngine::join_world(uint32_t agent_id, const WorldId& world_id) {
@@ -860,51 +1022,62 @@ std::optional<WorldId> WorldEngine::get_agent_world(uint32_t agent_id) const {
 
 bool WorldEngine::inject_event(const WorldId& world_id, const std::string& event_type,
                                const nlohmann::json& params) {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto it = worlds_.find(world_id);
-    if (it == worlds_.end()) {
+    auto world = get_world(world_id);
+    if (!world) {
         spdlog::warn("WorldEngine: World '{}' not found for event injection", world_id);
         return false;
     }
 
-    it->second->chaos().inject_event(event_type, params);
+    // Clock events steer the world's virtual clock rather than chaos
+    if (event_type == "clock_set_scale") {
+        world->clock().set_time_scale(params.value("scale", 1.0));
+        spdlog::info("WorldEngine: World '{}' time scale set to {}",
+                     world_id, world->clock().time_scale());
+        return true;
+    }
+    if (event_type == "clock_advance") {
+        uint64_t virtual_ms = params.value("virtual_ms", 0ull);
+        world->clock().advance(virtual_ms);
+        spdlog::info("WorldEngine: World '{}' fast-forwarded {} virtual ms",
+                     world_id, virtual_ms);
+        return true;
+    }
+
+    world->chaos().inject_event(event_type, params);
     return true;
 }
 
 std::optional<nlohmann::json> WorldEngine::get_world_state(const WorldId& world_id) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto it = worlds_.find(world_id);
-    if (it == worlds_.end()) {
+    auto world = get_world(world_id);
+    if (!world) {
         return std::nullopt;
     }
 
-    auto metrics = it->second->get_metrics();
+    auto metrics = world->get_metrics();
 
     nlohmann::json state;
     state["world_id"] = world_id;
-    state["name"] = it->second->name();
+    state["name"] = world->name();
     state["agent_count"] = metrics.agent_count;
     state["syscall_count"] = metrics.syscall_count;
-    state["vfs_metrics"] = it->second->vfs().get_metrics();
-    state["network_metrics"] = it->second->network().get_metrics();
-    state["chaos_metrics"] = it->second->chaos().get_metrics();
-    state["agents"] = it->second->get_agents();
+    state["vfs_metrics"] = world->vfs().get_metrics();
+    state["network_metrics"] = world->network().get_metrics();
+    state["chaos_metrics"] = world->chaos().get_metrics();
+    state["virtual_time_ms"] = world->clock().now_ms();
+    state["time_scale"] = world->clock().time_scale();
+    state["agents"] = world->get_agents();
 
     return state;
 }
 
 std::optional<nlohmann::json> WorldEngine::snapshot_world(const WorldId& world_id) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto it = worlds_.find(world_id);
-    if (it == worlds_.end()) {
+    auto world = get_world(world_id);
+    if (!world) {
         spdlog::warn("WorldEngine: World '{}' not found for snapshot", world_id);
         return std::nullopt;
     }
 
-    nlohmann::json snapshot = it->second->to_json();
+    nlohmann::json snapshot = world->to_json();
     snapshot["snapshot_time"] = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
 
@@ -926,7 +1099,7 @@ std::optional<WorldId> WorldEngine::restore_world(const nlohmann::json& snapshot
         return std::nullopt;
     }
 
-    auto world = std::make_unique<World>(id);
+    auto world = std::make_shared<World>(id);
     world->from_json(snapshot);
 
     worlds_[id] = std::move(world);
@@ -935,15 +1108,165 @@ std::optional<WorldId> WorldEngine::restore_world(const nlohmann::json& snapshot
     return id;
 }
 
-nlohmann::json WorldEngine::get_metrics() const {
+std::optional<std::string> WorldEngine::snapshot_world_cow(const WorldId& world_id) {
+    auto world = get_world(world_id);
+    if (!world) {
+        spdlog::warn("WorldEngine: World '{}' not found for snapshot", world_id);
+        return std::nullopt;
+    }
+
+    // Capture outside the engine lock; only registration needs it
+    WorldSnapshot snap = world->capture();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::stringstream ss;
+    ss << "snap-" << std::setfill('0') << std::setw(6) << next_snapshot_num_++;
+    snap.snapshot_id = ss.str();
+    snap.snapshot_time_ms = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+
+    if (snapshot_order_.size() >= MAX_RETAINED_SNAPSHOTS) {
+        snapshots_.erase(snapshot_order_.front());
+        snapshot_order_.erase(snapshot_order_.begin());
+    }
+
+    snapshot_order_.push_back(snap.snapshot_id);
+    std::string id = snap.snapshot_id;
+    snapshots_[id] = std::move(snap);
+
+    spdlog::info("WorldEngine: Created CoW snapshot '{}' of world '{}'", id, world_id);
+    return id;
+}
+
+std::optional<WorldId> WorldEngine::restore_world_cow(const std::string& snapshot_id,
+                                                       const std::string& new_world_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto snap_it = snapshots_.find(snapshot_id);
+    if (snap_it == snapshots_.end()) {
+        spdlog::warn("WorldEngine: Snapshot '{}' not found", snapshot_id);
+        return std::nullopt;
+    }
+
+    WorldId id = new_world_id.empty() ?
+                 generate_world_id(snap_it->second.name) :
+                 new_world_id;
+
+    if (worlds_.find(id) != worlds_.end()) {
+        spdlog::warn("WorldEngine: World '{}' already exists", id);
+        return std::nullopt;
+    }
+
+    auto world = std::make_unique<World>(id);
+    world->restore_from(snap_it->second);
+
+    worlds_[id] = std::move(world);
+
+    spdlog::info("WorldEngine: Restored snapshot '{}' as world '{}'", snapshot_id, id);
+    return id;
+}
+
+bool WorldEngine::drop_snapshot(const std::string& snapshot_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (snapshots_.erase(snapshot_id) == 0) {
+        return false;
+    }
+
+    snapshot_order_.erase(
+        std::remove(snapshot_order_.begin(), snapshot_order_.end(), snapshot_id),
+        snapshot_order_.end());
+
+    spdlog::debug("WorldEngine: Dropped snapshot '{}'", snapshot_id);
+    return true;
+}
+
+bool WorldEngine::persist_world(const WorldId& world_id, const std::string& path,
+                                std::string& error) {
+    auto world = get_world(world_id);
+    if (!world) {
+        error = "World not found";
+        return false;
+    }
+
+    WorldSnapshot snap = world->capture();
+    std::string parent;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        snap.snapshot_time_ms = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+
+        auto chain_it = persist_chains_.find(world_id);
+        if (chain_it != persist_chains_.end() &&
+            !chain_it->second.last_path.empty() &&
+            chain_it->second.last_path != path &&
+            chain_it->second.deltas_since_full < FULL_SNAPSHOT_INTERVAL) {
+            parent = chain_it->second.last_path;
+        }
+    }
+
+    // Write outside the engine lock: the CoW capture pins the content,
+    // so the world can keep running while bytes hit disk
+    if (!snapshot_file::write(path, snap, parent, error)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& chain = persist_chains_[world_id];
+    chain.last_path = path;
+    chain.deltas_since_full = parent.empty() ? 0 : chain.deltas_since_full + 1;
+    return true;
+}
+
+std::optional<WorldId> WorldEngine::restore_world_from_file(const std::string& path,
+                                                             const std::string& new_world_id) {
+    std::string error;
+    auto source = snapshot_file::open(path, error);
+    if (!source) {
+        spdlog::warn("WorldEngine: {}", error);
+        return std::nullopt;
+    }
+
     std::lock_guard<std::mutex> lock(mutex_);
 
+    WorldId id = new_world_id.empty() ?
+                 generate_world_id(source->meta().value("name", "restored")) :
+                 new_world_id;
+
+    if (worlds_.find(id) != worlds_.end()) {
+        spdlog::warn("WorldEngine: World '{}' already exists", id);
+        return std::nullopt;
+    }
+
+    auto world = std::make_shared<World>(id);
+    const nlohmann::json meta = source->meta();
+    world->restore_lazy(meta, std::move(source));
+
+    worlds_[id] = std::move(world);
+
+    spdlog::info("WorldEngine: Restored world '{}' from '{}'", id, path);
+    return id;
+}
+
+nlohmann::json WorldEngine::get_metrics() const {
+    std::vector<std::shared_ptr<World>> snapshot;
     nlohmann::json m;
-    m["world_count"] = worlds_.size();
-    m["total_agents_in_worlds"] = agent_to_world_.size();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        m["world_count"] = worlds_.size();
+        m["total_agents_in_worlds"] = agent_to_world_.size();
+        snapshot.reserve(worlds_.size());
+        for (const auto& [_, world] : worlds_) {
+            snapshot.push_back(world);
+        }
+    }
 
     uint64_t total_syscalls = 0;
-    for (const auto& [_, world] : worlds_) {
+    for (const auto& world : snapshot) {
         total_syscalls += world->get_metrics().syscall_count;
     }
     m["total_syscalls"] = total_syscalls;
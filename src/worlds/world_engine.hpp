@@ -239,6 +239,68 @@ private:
     bool matches_pattern(const std::string& str, const std::string& pattern) const;
 };
 
+/**
+ * Per-world virtual clock
+ *
+ * Simulated delays (MockResponse::latency_ms, chaos latency) consume
+ * virtual time. A time-scale factor maps virtual time onto wall time:
+ * at scale 60, a delay of one virtual minute sleeps one wall second, so
+ * an hour-long scenario replays in a minute while relative ordering of
+ * delayed operations is preserved. Scale 0 detaches the clock from wall
+ * time entirely: delays complete immediately but still advance virtual
+ * time, and SYS_WORLD_EVENT can fast-forward it in explicit jumps.
+ */
+class VirtualClock {
+public:
+    /**
+     * Configure from JSON: {"time_scale": 60.0}
+     */
+    void configure(const nlohmann::json& config);
+
+    /**
+     * Virtual milliseconds elapsed since world creation
+     */
+    uint64_t now_ms() const;
+
+    /**
+     * Get/set the time-scale factor (>= 0; 0 freezes wall-time flow)
+     */
+    double time_scale() const;
+    void set_time_scale(double scale);
+
+    /**
+     * Fast-forward the clock by a virtual duration
+     */
+    void advance(uint64_t virtual_ms);
+
+    /**
+     * Wall-clock sleep needed to realize a virtual delay. At scale 0
+     * the delay is credited to the clock directly and no sleep is due.
+     */
+    std::chrono::milliseconds wall_delay(uint64_t virtual_ms);
+
+    /**
+     * Serialize to JSON
+     */
+    nlohmann::json to_json() const;
+
+    /**
+     * Restore from JSON
+     */
+    void from_json(const nlohmann::json& j);
+
+private:
+    double scale_ = 1.0;
+    // Virtual time accrued before anchor_; current virtual time is
+    // base_virtual_ms_ plus the scaled wall time elapsed since anchor_
+    uint64_t base_virtual_ms_ = 0;
+    std::chrono::steady_clock::time_point anchor_ = std::chrono::steady_clock::now();
+
+    mutable std::mutex mutex_;
+
+    uint64_t now_ms_locked() const;
+};
+
 /**
  * World metrics
  */
@@ -253,6 +315,28 @@ struct WorldMetrics {
     std::chrono::steady_clock::time_point last_activity;
 };
 
+/**
+ * Copy-on-write snapshot of a world, retained kernel-side.
+ *
+ * VFS content is shared with the live world via VirtualFile's
+ * refcounted chunks, so capturing one is a metadata copy regardless of
+ * how much file content the world holds. Network and chaos state are
+ * small and captured as JSON. Agent membership is deliberately not
+ * captured: a restored world starts empty and agents join it fresh.
+ */
+struct WorldSnapshot {
+    std::string snapshot_id;
+    WorldId world_id;
+    std::string name;
+    std::string description;
+    nlohmann::json config;
+    VfsSnapshot vfs;
+    nlohmann::json network;
+    nlohmann::json chaos;
+    nlohmann::json clock;
+    uint64_t snapshot_time_ms = 0;
+};
+
 /**
  * A simulated world environment
  */
@@ -287,6 +371,9 @@ public:
     ChaosEngine& chaos() { return chaos_; }
     const ChaosEngine& chaos() const { return chaos_; }
 
+    VirtualClock& clock() { return clock_; }
+    const VirtualClock& clock() const { return clock_; }
+
     // Agent management
     void add_agent(uint32_t agent_id);
     void remove_agent(uint32_t agent_id);
@@ -302,6 +389,15 @@ public:
     nlohmann::json to_json() const;
     void from_json(const nlohmann::json& j);
 
+    // Copy-on-write capture/restore (see WorldSnapshot)
+    WorldSnapshot capture() const;
+    void restore_from(const WorldSnapshot& snap);
+
+    // Restore from a mapped on-disk snapshot; VFS content stays in the
+    // mapping and materializes on first access
+    void restore_lazy(const nlohmann::json& meta,
+                      std::shared_ptr<snapshot_file::MappedSnapshot> source);
+
     // Configuration
     nlohmann::json get_config() const { return config_; }
 
@@ -314,6 +410,7 @@ private:
     VirtualFilesystem vfs_;
     NetworkMock network_;
     ChaosEngine chaos_;
+    VirtualClock clock_;
 
     std::set<uint32_t> agents_;
     mutable WorldMetrics metrics_;
@@ -346,10 +443,12 @@ public:
     std::vector<nlohmann::json> list_worlds() const;
 
     /**
-     * Get world by ID
+     * Get world by ID. Returns a shared reference so callers can keep
+     * operating on the world after the engine lock is released (and
+     * across a concurrent destroy_world); worlds carry their own locks.
      */
-    World* get_world(const WorldId& world_id);
-    const World* get_world(const WorldId& world_id) const;
+    std::shared_ptr<World> get_world(const WorldId& world_id);
+    std::shared_ptr<const World> get_world(const WorldId& world_id) const;
 
     /**
      * Join an agent to a world
@@ -372,7 +471,9 @@ public:
     std::optional<WorldId> get_agent_world(uint32_t agent_id) const;
 
     /**
-     * Inject a chaos event into a world
+     * Inject an event into a world. Most event types go to the chaos
+     * engine; "clock_set_scale" {"scale": N} and "clock_advance"
+     * {"virtual_ms": N} steer the world's virtual clock instead.
      */
     bool inject_event(const WorldId& world_id, const std::string& event_type,
                       const nlohmann::json& params);
@@ -394,18 +495,74 @@ public:
     std::optional<WorldId> restore_world(const nlohmann::json& snapshot,
                                           const std::string& new_world_id = "");
 
+    /**
+     * Capture a copy-on-write snapshot retained by the engine.
+     * Cost is independent of world content size; only files modified
+     * after the capture pay a copy. Returns the snapshot id.
+     */
+    std::optional<std::string> snapshot_world_cow(const WorldId& world_id);
+
+    /**
+     * Restore a retained snapshot into a new world
+     */
+    std::optional<WorldId> restore_world_cow(const std::string& snapshot_id,
+                                              const std::string& new_world_id = "");
+
+    /**
+     * Drop a retained snapshot, releasing its content references
+     */
+    bool drop_snapshot(const std::string& snapshot_id);
+
+    /**
+     * Persist a world to a binary CWS1 snapshot file. Consecutive
+     * persists of the same world write deltas (only chunks not already
+     * in the chain); every FULL_SNAPSHOT_INTERVAL-th persist is a full
+     * snapshot so chains stay short. Delta parents are referenced by
+     * filename, so a world's snapshot files must share a directory.
+     */
+    bool persist_world(const WorldId& world_id, const std::string& path,
+                       std::string& error);
+
+    /**
+     * Restore a world from a CWS1 snapshot file. The file (and its
+     * delta chain) is mmapped and file content materializes lazily on
+     * first access, so restore cost is independent of content size.
+     */
+    std::optional<WorldId> restore_world_from_file(const std::string& path,
+                                                    const std::string& new_world_id = "");
+
     /**
      * Get overall engine metrics
      */
     nlohmann::json get_metrics() const;
 
 private:
-    std::unordered_map<WorldId, std::unique_ptr<World>> worlds_;
+    // The engine lock covers only the maps below; per-world work runs
+    // against a shared_ptr taken out under the lock, so 30+ independent
+    // worlds don't serialize through the engine
+    std::unordered_map<WorldId, std::shared_ptr<World>> worlds_;
     std::unordered_map<uint32_t, WorldId> agent_to_world_;
     mutable std::mutex mutex_;
 
     uint64_t next_world_num_ = 1;
 
+    // Retained CoW snapshots, oldest evicted beyond the cap. Snapshots
+    // are cheap to hold but pin content chunks, so the cap bounds how
+    // much dead content an aggressive snapshot cadence can keep alive.
+    static constexpr size_t MAX_RETAINED_SNAPSHOTS = 64;
+    std::unordered_map<std::string, WorldSnapshot> snapshots_;
+    std::vector<std::string> snapshot_order_;  // insertion order
+    uint64_t next_snapshot_num_ = 1;
+
+    // Per-world delta-chain bookkeeping for persist_world
+    static constexpr uint32_t FULL_SNAPSHOT_INTERVAL = 16;
+
+    struct PersistChain {
+        std::string last_path;
+        uint32_t deltas_since_full = 0;
+    };
+    std::unordered_map<WorldId, PersistChain> persist_chains_;
+
     /**
      * Generate a unique world ID
      */